@@ -30,6 +30,9 @@
 #import <Masonry.h>
 #import "CommendPopView.h"
 #import "CustomUrlProtocol.h"
+#import "WebViewPool.h"
+#import "H5OfflinePackage.h"
+#import "H5OfflineURLProtocol.h"
 
 #import "StockCodesAPI.h"
 #import "TaoAllDepartmentAPI.h"
@@ -47,6 +50,11 @@
 #import "UrlRedirectAction.h"
 #import "UserInfoInstance.h"
 #import "NativeUrlRedirectAction.h"
+#import "LaunchTaskScheduler.h"
+#import "ImagePipeline.h"
+#import "CacheStore.h"
+#import "StockMentionMatcher.h"
+#import "URLRouter.h"
 //#import <ShareSDK/ShareSDK.h>
 //#import <ShareSDKConnector/ShareSDKConnector.h>
 //
@@ -99,6 +107,9 @@
 
 - (BOOL)application:(UIApplication *)application didFinishLaunchingWithOptions:(NSDictionary *)launchOptions {
 
+    //启动任务调度，同时开始计时
+    LaunchTaskScheduler *scheduler = [LaunchTaskScheduler sharedLaunchTaskScheduler];
+    
     self.window = [[UIWindow alloc] initWithFrame:[UIScreen mainScreen].bounds];
     
     self.window.rootViewController = self.navigationController;
@@ -107,57 +118,113 @@
 //----------------------------------------------------------------------
     
     //网络设置，添加公共参数
-    [self setupRequestFilters];
+    [scheduler addTask:@"requestFilters" phase:LAUNCH_TASK_BLOCKING concurrent:NO block:^{
+        [self setupRequestFilters];
+    }];
     
-    //cookie
-    if ([SystemUtil isSignIn]) {
-        [SystemUtil setCookie];
-    }
+    //cookie，NSHTTPCookieStorage 线程安全，后台恢复，首帧前等它完成
+    [scheduler addTask:@"cookie" phase:LAUNCH_TASK_BLOCKING concurrent:YES block:^{
+        if ([SystemUtil isSignIn]) {
+            [SystemUtil setCookie];
+        }
+    }];
+    
+    //注册 urlprotocol 拦截请求
+    [scheduler addTask:@"urlProtocol" phase:LAUNCH_TASK_BLOCKING concurrent:NO block:^{
+        [NSURLProtocol registerClass:[CustomUrlProtocol class]];
+        //后注册的先询问，离线包命中的不再走 CustomUrlProtocol
+        [NSURLProtocol registerClass:[H5OfflineURLProtocol class]];
+    }];
+    
+    //限制 SDImageCache 内存缓存，列表图片改由 ImagePipeline 按显示尺寸缓存；只设置 NSCache，可在后台
+    [scheduler addTask:@"imageCache" phase:LAUNCH_TASK_BLOCKING concurrent:YES block:^{
+        [ImagePipeline configureSharedImageCache];
+    }];
+    
+    //注册 native://、component://、shortcut:// 和 H5 页面路由，推送和 3D Touch 启动时就要用
+    [scheduler addTask:@"routes" phase:LAUNCH_TASK_BLOCKING concurrent:NO block:^{
+        [NativeUrlRedirectAction registerRoutes];
+        [UrlRedirectAction registerRoutes];
+        [self registerShortcutRoutes];
+    }];
+    
+    //120s 定时弹出评论界面
+    [scheduler addTask:@"introView" phase:LAUNCH_TASK_BLOCKING concurrent:NO block:^{
+        [self showAppStoreCommentView];
+    }];
+    
+    //极光推送初始化，UNUserNotificationCenter 的 delegate 须在 didFinishLaunching 返回前设置，否则冷启动点通知的回调会丢
+    [scheduler addTask:@"jpush" phase:LAUNCH_TASK_BLOCKING concurrent:NO block:^{
+        [self initJPush:launchOptions];
+    }];
+    
+    //初始化分享功能，冷启动从分享/授权回调进来时 openURL 紧接着就会调用
+    [scheduler addTask:@"shareSDK" phase:LAUNCH_TASK_BLOCKING concurrent:NO block:^{
+        [self initShareSDK];
+    }];
+    
+    //初始化自选股，只在首次安装时写入默认指数；须在 loginState 拉取服务端自选股之前完成，否则默认指数会加到服务端列表上再被同步回去
+    [scheduler addTask:@"initMyStock" phase:LAUNCH_TASK_BLOCKING concurrent:NO block:^{
+        [StockHistoryUtil initMyStock];
+    }];
+    
+//----------------------------------------------------------------------
     
     //检查网络
-    [self checkNetState];
+    [scheduler addTask:@"netState" phase:LAUNCH_TASK_AFTER_FIRST_FRAME concurrent:NO block:^{
+        [self checkNetState];
+    }];
     
     //检查登录状态
-    [self getUserLoginStateFunc];
-    
-    //注册 urlprotocol 拦截请求
-    [NSURLProtocol registerClass:[CustomUrlProtocol class]];
+    [scheduler addTask:@"loginState" phase:LAUNCH_TASK_AFTER_FIRST_FRAME concurrent:NO block:^{
+        [self getUserLoginStateFunc];
+    }];
     
-    //请求码表
-    dispatch_async(dispatch_get_main_queue(), ^{
+    //请求码表，后台读本地版本号，请求由 APINetworkAgent 转回主线程发起
+    [scheduler addTask:@"codeTables" phase:LAUNCH_TASK_AFTER_FIRST_FRAME concurrent:YES block:^{
         [self checkAllUsers];
         [self checkStockCodes];
         [self checkAllDepartment];
-    });
+    }];
+    
+    //友盟初始化，SDK 要求在主线程
+    [scheduler addTask:@"umeng" phase:LAUNCH_TASK_AFTER_FIRST_FRAME concurrent:NO block:^{
+        [self initUMengAnalytice];
+    }];
+    
+    //查看是否有未读消息
+    [scheduler addTask:@"unreadMsg" phase:LAUNCH_TASK_AFTER_FIRST_FRAME concurrent:NO block:^{
+        [[MessageInstance sharedMessageInstance] requestUnReadMsg];
+    }];
     
 //----------------------------------------------------------------------
-   
-    //120s 定时弹出评论界面
-    [self showAppStoreCommentView];
-   
-    //友盟初始化
-    [self initUMengAnalytice];
-
-    //极光推送初始化
-    [self initJPush:launchOptions];
     
     //版本控制
-    [self checkVersion];
+    [scheduler addTask:@"version" phase:LAUNCH_TASK_IDLE concurrent:NO block:^{
+        [self checkVersion];
+    }];
     
-    //初始化自选股
-    [StockHistoryUtil initMyStock];
+    //3D touch
+    [scheduler addTask:@"3DTouch" phase:LAUNCH_TASK_IDLE concurrent:NO block:^{
+        [self add3DTouch];
+    }];
     
-    //初始化分享功能
-    [self initShareSDK];
+    //检查 H5 离线包更新，首次取单例时读清单，放在后台；H5_OFFLINE_ENABLED 为 0 时什么都不做
+    [scheduler addTask:@"h5Offline" phase:LAUNCH_TASK_IDLE concurrent:YES block:^{
+        [[H5OfflinePackage sharedH5OfflinePackage] update];
+    }];
     
-    //3D touch
-    [self add3DTouch];
+    //预热 WKWebView，个股页 H5 tab 首次打开不用再等 WebContent 进程启动
+    [scheduler addTask:@"webViewPool" phase:LAUNCH_TASK_IDLE concurrent:NO block:^{
+        [[WebViewPool sharedWebViewPool] prewarm];
+    }];
     
     //东莞证券开户插件
-    [[TKAppEngine shareInstance] start];
+    [scheduler addTask:@"TKAppEngine" phase:LAUNCH_TASK_IDLE concurrent:NO block:^{
+        [[TKAppEngine shareInstance] start];
+    }];
     
-    //查看是否有未读消息
-    [[MessageInstance sharedMessageInstance] requestUnReadMsg];
+    [scheduler start];
 
     return YES;
 }
@@ -184,28 +251,39 @@
     [UIApplication sharedApplication].shortcutItems = @[item1,item2,item3,item4];
 }
 
+- (void)registerShortcutRoutes {
+    URLRouter *router = [URLRouter sharedURLRouter];
+    __weak typeof(self) weakSelf = self;
+    
+    [router registerPattern:@"shortcut://zx" handler:^(URLRouteMatch *match) {
+        [weakSelf private_showOptional:2];
+    }];
+    [router registerPattern:@"shortcut://hq" handler:^(URLRouteMatch *match) {
+        [weakSelf private_showOptional:1];
+    }];
+    [router registerPattern:@"shortcut://ss" handler:^(URLRouteMatch *match) {
+        TigerSearchViewController *vc = [TigerSearchViewController new];
+        [weakSelf.navigationController pushViewController:vc animated:NO];
+    }];
+    [router registerPattern:@"shortcut://ns" handler:^(URLRouteMatch *match) {
+        TaoSearchPeopleViewController *vc = [TaoSearchPeopleViewController new];
+        [weakSelf.navigationController pushViewController:vc animated:NO];
+    }];
+}
+
+- (void)private_showOptional:(NSInteger)hangQing {
+    OptionalViewController *optVC = (OptionalViewController *)_tabBarController.backingViewControllers[1];
+    optVC.hangQing = hangQing;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [_tabBarController.tab btnClick:_tabBarController.tab.btn2];
+    });
+}
+
 - (void)application:(UIApplication *)application performActionForShortcutItem:(UIApplicationShortcutItem *)shortcutItem completionHandler:(void (^)(BOOL))completionHandler {
     [self.navigationController popToRootViewControllerAnimated:NO];
     [self.navigationController.visibleViewController.presentingViewController dismissViewControllerAnimated:NO completion:nil];
-    if ([shortcutItem.type isEqualToString:@"zx"]) {
-        OptionalViewController *optVC = (OptionalViewController *)_tabBarController.backingViewControllers[1];
-        optVC.hangQing = 2;
-        dispatch_async(dispatch_get_main_queue(), ^{
-            [_tabBarController.tab btnClick:_tabBarController.tab.btn2];
-        });
-    } else if ([shortcutItem.type isEqualToString:@"hq"]) {
-        OptionalViewController *optVC = (OptionalViewController *)_tabBarController.backingViewControllers[1];
-        optVC.hangQing = 1;
-        dispatch_async(dispatch_get_main_queue(), ^{
-            [_tabBarController.tab btnClick:_tabBarController.tab.btn2];
-        });
-    } else if ([shortcutItem.type isEqualToString:@"ss"]) {
-        TigerSearchViewController *vc = [TigerSearchViewController new];
-        [self.navigationController pushViewController:vc animated:NO];
-    } else if ([shortcutItem.type isEqualToString:@"ns"]) {
-        TaoSearchPeopleViewController *vc = [TaoSearchPeopleViewController new];
-        [self.navigationController pushViewController:vc animated:NO];
-    }
+    NSString *url = [@"shortcut://" stringByAppendingString:shortcutItem.type];
+    completionHandler([[URLRouter sharedURLRouter] routeURLString:url]);
 }
 
 #pragma mark 120s商店评论弹框  APP首次启动引导页
@@ -585,9 +663,8 @@ fetchCompletionHandler:
             NSString *urlStr = [userInfo objectForKey:@"url"];
             if(urlStr)
             {
-                NSURL *url = [[NSURL alloc] initWithString:[userInfo objectForKey:@"url"]];
-                [UrlRedirectAction redirectActionWithUrl:url from:@"" navigationType:UIWebViewNavigationTypeOther];
-                //[UrlRedirectAction redirectActionWithUrl:@"" from:@"" navigationType:UIWebViewNavigationTypeOther];
+                //和 iOS 10 一样走路由
+                [[NativeUrlRedirectAction sharedNativeUrlRedirectAction] redictNativeUrl:urlStr];
             }
         }
     }
@@ -760,7 +837,7 @@ didReceiveLocalNotification:(UILocalNotification *)notification {
 - (void)checkAllUsers {
     NSString *path = [StockHistoryUtil getallUserPath];
     
-    long long stockCodesVersion = [[SystemUtil getCache:@"allUserVersion"] longLongValue];
+    long long stockCodesVersion = [[CacheStore sharedCacheStore] longLongForKey:@"allUserVersion"];
     
     _allUserAPI = [[TaoAllUserAPI alloc] initWithLastModified:[NSString stringWithFormat:@"%lld", stockCodesVersion]];
     
@@ -795,7 +872,7 @@ didReceiveLocalNotification:(UILocalNotification *)notification {
 - (void)checkAllDepartment {
     NSString *path = [StockHistoryUtil getStockDepartsmentPath];
     
-    long long stockCodesVersion = [[SystemUtil getCache:@"departmentVersion"] longLongValue];
+    long long stockCodesVersion = [[CacheStore sharedCacheStore] longLongForKey:@"departmentVersion"];
     
     _departmentAllAPI = [[TaoAllDepartmentAPI alloc] initWithLastModified:[NSString stringWithFormat:@"%lld", stockCodesVersion]];
 
@@ -827,22 +904,32 @@ didReceiveLocalNotification:(UILocalNotification *)notification {
 }
 
 - (void)checkStockCodes {
+    //先监听码表更新，码表发布后在后台建帖子、资讯里的股票匹配表
+    [StockMentionMatcher sharedStockMentionMatcher];
+    
     NSString *path = [StockHistoryUtil getStockCodesPath];
     
-    long long stockCodesVersion = [[SystemUtil getCache:@"stockCodesVersion"] longLongValue];
+    long long stockCodesVersion = [[CacheStore sharedCacheStore] longLongForKey:@"stockCodesVersion"];
     
     _stockCodesInfoAPI = [[StockCodesAPI alloc] initWithLastModified:[NSString stringWithFormat:@"%lld", stockCodesVersion]];
 
     [_stockCodesInfoAPI startWithCompletionBlockWithSuccess:^(APIBaseRequest *request) {
         BOOL bModified = [[_stockCodesInfoAPI.responseJSONObject objectForKey:@"modified"] boolValue];
         if (bModified)  {
-            NSString *lastModified = [_stockCodesInfoAPI.responseJSONObject objectForKey:@"lastModified"];
-            dispatch_async(dispatch_get_global_queue(0, 0), ^{
-                [StockCodesInstance sharedStockCodesInstance].stockCodesArray = [MTLJSONAdapter modelsOfClass:[StockCodeInfo class] fromJSONArray:[_stockCodesInfoAPI.responseJSONObject objectForKey:@"gxCodeList"] error:nil];
-                self.stockCodesModel = [MTLJSONAdapter modelOfClass:[StockCodesModel class] fromJSONDictionary:_stockCodesInfoAPI.responseJSONObject error:nil];
-                [NSKeyedArchiver archiveRootObject:[StockCodesInstance sharedStockCodesInstance].stockCodesArray toFile:path];
-                [SystemUtil putCache:@"stockCodesVersion" value:lastModified];
-            });
+            NSDictionary *json = _stockCodesInfoAPI.responseJSONObject;
+            NSString *lastModified = [json objectForKey:@"lastModified"];
+            //分段解析，不再经过 Mantle，也不再重复解析一遍 gxCodeList
+            [[StockCodesInstance sharedStockCodesInstance] decodeStockCodes:[json objectForKey:@"gxCodeList"] completion:^(NSArray *array) {
+                StockCodesModel *model = [[StockCodesModel alloc] init];
+                model.modified = [json objectForKey:@"modified"];
+                model.lastModified = lastModified;
+                model.gxCodeList = array;
+                self.stockCodesModel = model;
+                dispatch_async(dispatch_get_global_queue(0, 0), ^{
+                    [NSKeyedArchiver archiveRootObject:array toFile:path];
+                    [SystemUtil putCache:@"stockCodesVersion" value:lastModified];
+                });
+            }];
         } else {
             if ([StockCodesInstance sharedStockCodesInstance].stockCodesArray.count > 1) {
                 return ;
@@ -0,0 +1,23 @@
+//
+//  UIImageView+Thumbnail.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+//列表里的头像、配图按显示尺寸取图，见 ImagePipeline
+@interface UIImageView (Thumbnail)
+
+//size 为控件显示尺寸(pt)；cell 复用后，之前请求的图片回来时会被丢弃
+- (void)setThumbnailWithURLString:(NSString *)urlString size:(CGSize)size placeholderImage:(UIImage *)placeholder;
+- (void)setThumbnailWithURLString:(NSString *)urlString size:(CGSize)size;
+
+- (void)cancelThumbnailLoad;
+
+//浏览大图前换成原图(一般已在磁盘缓存中)，完成后回调，失败时保留缩略图
+- (void)loadOriginalImageWithURLString:(NSString *)urlString completion:(dispatch_block_t)completion;
+
+@end
@@ -0,0 +1,80 @@
+//
+//  UIImageView+Thumbnail.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "UIImageView+Thumbnail.h"
+#import <objc/runtime.h>
+#import <SDWebImage/UIImageView+WebCache.h>
+#import <SDWebImage/SDWebImageManager.h>
+#import "ImagePipeline.h"
+
+static char kThumbnailTokenKey;
+
+@implementation UIImageView (Thumbnail)
+
+- (void)setThumbnailWithURLString:(NSString *)urlString size:(CGSize)size {
+    [self setThumbnailWithURLString:urlString size:size placeholderImage:nil];
+}
+
+- (void)setThumbnailWithURLString:(NSString *)urlString size:(CGSize)size placeholderImage:(UIImage *)placeholder {
+    //同一个控件之前可能用 sd_setImageWithURL 加载过
+    [self sd_cancelCurrentImageLoad];
+
+    //每次请求换一个 token，回调时不一致说明已被复用
+    NSObject *token = [NSObject new];
+    objc_setAssociatedObject(self, &kThumbnailTokenKey, token, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+
+    NSURL *url = urlString.length ? [NSURL URLWithString:urlString] : nil;
+    ImagePipeline *pipeline = [ImagePipeline sharedImagePipeline];
+    UIImage *cached = [pipeline cachedImageForURL:url size:size];
+    if (cached) {
+        self.image = cached;
+        return;
+    }
+    self.image = placeholder;
+    if (url == nil) {
+        return;
+    }
+
+    __weak typeof(self) weakSelf = self;
+    [pipeline loadImageWithURL:url size:size completion:^(UIImage *image, NSURL *url) {
+        if (image && objc_getAssociatedObject(weakSelf, &kThumbnailTokenKey) == token) {
+            weakSelf.image = image;
+        }
+    }];
+}
+
+- (void)cancelThumbnailLoad {
+    objc_setAssociatedObject(self, &kThumbnailTokenKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
+- (void)loadOriginalImageWithURLString:(NSString *)urlString completion:(dispatch_block_t)completion {
+    NSURL *url = urlString.length ? [NSURL URLWithString:urlString] : nil;
+    if (url == nil) {
+        if (completion) {
+            completion();
+        }
+        return;
+    }
+    NSObject *token = [NSObject new];
+    objc_setAssociatedObject(self, &kThumbnailTokenKey, token, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+
+    __weak typeof(self) weakSelf = self;
+    [[SDWebImageManager sharedManager] downloadImageWithURL:url options:0 progress:nil completed:^(UIImage *image, NSError *error, SDImageCacheType cacheType, BOOL finished, NSURL *imageURL) {
+        if (!finished) {
+            return;
+        }
+        if (image && objc_getAssociatedObject(weakSelf, &kThumbnailTokenKey) == token) {
+            weakSelf.image = image;
+        }
+        if (completion) {
+            completion();
+        }
+    }];
+}
+
+@end
@@ -574,9 +574,15 @@
         [nmA addObject:iv.image];
     }
     
-    self.postImgAPI.imageArray = nmA;
     [self.view endEditing:YES];
-    [self.postImgAPI start];
+    __weak typeof(self) weakSelf = self;
+    [[UploadImageEncoder sharedUploadImageEncoder] encodeImages:nmA maxPixel:kUploadImagePostMaxPixel quality:0.9 completion:^(NSArray<UploadImageFile *> *files) {
+        if (files == nil) {
+            return;
+        }
+        weakSelf.postImgAPI.imageFiles = files;
+        [weakSelf.postImgAPI start];
+    }];
 }
 
 - (void)deleteBtnClick:(UIButton *)btn {
@@ -158,8 +158,14 @@
     
     if (_selectedImg)
     {
-        _uploadImgAPI.image = _selectedImg;
-        [_uploadImgAPI start];
+        UploadImageAPI *uploadImgAPI = _uploadImgAPI;
+        [[UploadImageEncoder sharedUploadImageEncoder] encodeImages:@[_selectedImg] maxPixel:kUploadImageAvatarMaxPixel quality:0.9 completion:^(NSArray<UploadImageFile *> *files) {
+            if (files == nil) {
+                return;
+            }
+            uploadImgAPI.imageFile = files.firstObject;
+            [uploadImgAPI start];
+        }];
     }
     
 
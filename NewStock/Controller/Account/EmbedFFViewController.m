@@ -7,7 +7,6 @@
 //
 
 #import "EmbedFFViewController.h"
-#import <JavaScriptCore/JavaScriptCore.h>
 
 @interface EmbedFFViewController ()<EmbedWebViewDelegate,UIActionSheetDelegate>
 
@@ -37,30 +36,22 @@
     if (_webView == nil) {
         _webView = [[EmbedWebView alloc] initWithUrl:self.myUrl];
         _webView.delegate = self;
+
+        __weak typeof(self) weakSelf = self;
+        [_webView registerHandler:@"actionSheet" handler:^(NSArray *args) {
+            weakSelf.value1 = args.count > 0 ? [NSString stringWithFormat:@"%@", args[0]] : nil;
+            weakSelf.value2 = args.count > 1 ? [NSString stringWithFormat:@"%@", args[1]] : nil;
+            UIActionSheet *actionSheet = [[UIActionSheet alloc] initWithTitle:@"确定不再关注此人?" delegate:weakSelf cancelButtonTitle:@"取消" destructiveButtonTitle:@"确定" otherButtonTitles:nil];
+            [actionSheet showInView:weakSelf.view];
+        }];
+        [_webView setReturnValue:[SystemUtil getCache:USER_ID] forFunction:@"getUserId"];
     }
     return _webView;
 }
 
-- (void)didFinishLoadWebView {
-    
-    JSContext *context = [self.webView.webView valueForKeyPath:@"documentView.webView.mainFrame.javaScriptContext"];
-    context[@"actionSheet"] = ^(NSString *v1,NSString *v2){
-        self.value1 = v1;
-        self.value2 = v2;
-        dispatch_async(dispatch_get_main_queue(), ^{
-            UIActionSheet *actionSheet = [[UIActionSheet alloc] initWithTitle:@"确定不再关注此人?" delegate:self cancelButtonTitle:@"取消" destructiveButtonTitle:@"确定" otherButtonTitles:nil];
-            [actionSheet showInView:self.view];
-        });
-    };
-    
-    context[@"getUserId"] = ^{
-        return [SystemUtil getCache:USER_ID];
-    };
-}
-
 - (void)actionSheet:(UIActionSheet *)actionSheet clickedButtonAtIndex:(NSInteger)buttonIndex {
     if (buttonIndex == 0) {
-        [self.webView.webView stringByEvaluatingJavaScriptFromString:[NSString stringWithFormat:@"B('%@','%@')",self.value1,self.value2]];
+        [self.webView evaluateJavaScript:[NSString stringWithFormat:@"B('%@','%@')",self.value1,self.value2]];
     }
 }
 
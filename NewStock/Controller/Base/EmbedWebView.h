@@ -7,32 +7,46 @@
 //
 
 #import <UIKit/UIKit.h>
-#import "NJKWebViewProgress.h"
-#import "NJKWebViewProgressView.h"
+#import <WebKit/WebKit.h>
 #import "UrlRedirectAction.h"
 
 @protocol EmbedWebViewDelegate;
 
-@interface EmbedWebView : UIView<UIWebViewDelegate,UIScrollViewDelegate,NJKWebViewProgressDelegate,UrlRedirectActionDelegate>
-{
-    NJKWebViewProgress *_progressProxy;
-}
+//H5 调用注册的全局函数时回调，args 为调用参数
+typedef void(^EmbedWebViewHandler)(NSArray *args);
+
+/**
+ *  嵌在原生页面里的 H5，WKWebView 从 WebViewPool 取预热好的实例
+ */
+@interface EmbedWebView : UIView<WKNavigationDelegate,WKUIDelegate,WKScriptMessageHandler,UrlRedirectActionDelegate>
+
 @property (assign, nonatomic) id<EmbedWebViewDelegate>delegate;
 
-@property(nonatomic,strong)NJKWebViewProgressView *progressView;
-@property(nonatomic,strong)UIWebView *webView;
+@property(nonatomic,strong,readonly)WKWebView *webView;
 @property(nonatomic,strong)NSString *mytitle;//标题
 @property(nonatomic,strong)NSString *myUrl;//网页的连接
 
+//页面内容高度，页面回传高度后更新，之前为 0
+@property(nonatomic,assign,readonly)CGFloat contentHeight;
+
 @property(nonatomic,assign)int type;//强制跳转
 
 - (id)initWithUrl:(NSString *)url;
 - (void)setUrl:(NSString *)url;
+
+//定义供 H5 调用的全局函数 window.<name>(...)，对当前页面和之后加载的页面都有效
+- (void)registerHandler:(NSString *)name handler:(EmbedWebViewHandler)handler;
+
+//定义返回固定值的全局函数 window.<name>()，value 需能转成 JSON
+- (void)setReturnValue:(id)value forFunction:(NSString *)name;
+
+- (void)evaluateJavaScript:(NSString *)script;
 @end
 
 
 @protocol EmbedWebViewDelegate <UrlRedirectActionDelegate>
 @optional
+//页面高度变化时异步回调，一次加载中可能回调多次
 - (void)embedWebView:(EmbedWebView*)embedWebView webViewHeight:(CGFloat)height;
 - (void)scrollViewDidScroll:(UIScrollView *)scrollView;
 - (void)didFinishLoadWebView;
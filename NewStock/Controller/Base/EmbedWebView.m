@@ -10,119 +10,332 @@
 #import "Masonry.h"
 #import "WebViewController.h"
 #import "AppDelegate.h"
+#import "WebViewPool.h"
+#import "H5OfflinePackage.h"
+#import "URLRouter.h"
+
+static NSString * const kEmbedWebViewUserSelectScript = @"document.documentElement.style.webkitUserSelect='none';";
+
+//离线页面从本地目录树加载，相对路径的接口请求会落到 file://，改发到 API_URL 并带上 cookie；
+//%@ 为 [API_URL, 目录树根地址]，只对该目录树下的页面生效
+static NSString * const kEmbedWebViewAPIBaseScript =
+@"(function(){var c=%@,base=c[0],root=c[1];"
+"if(location.href.indexOf(root)!==0||window.H5_API_BASE){return;}"
+"window.H5_API_BASE=base;"
+"var origin=base.replace(/^([a-z]+:\\/\\/[^\\/]+).*$/i,'$1');"
+"function api(u){var h=new URL(u,location.href).href;"
+"if(h.indexOf(root)===0){return base+h.substring(root.length);}"
+"if(h.indexOf('file://')===0){return origin+h.substring(7);}"
+"return u;}"
+"var open=XMLHttpRequest.prototype.open;"
+"XMLHttpRequest.prototype.open=function(m,u){var args=Array.prototype.slice.call(arguments);args[1]=api(String(u));"
+"open.apply(this,args);if(args[1]!==String(u)){this.withCredentials=true;}};"
+"if(window.fetch){var f=window.fetch;window.fetch=function(u,o){if(typeof u==='string'){var t=api(u);"
+"if(t!==u){u=t;o=Object.assign({credentials:'include'},o);}}return f.call(this,u,o);};}"
+"})();";
+
+//UrlRedirectAction 仍按 UIWebView 的跳转类型判断
+static UIWebViewNavigationType EmbedWebViewNavigationType(WKNavigationType type) {
+    switch (type) {
+        case WKNavigationTypeLinkActivated:   return UIWebViewNavigationTypeLinkClicked;
+        case WKNavigationTypeFormSubmitted:   return UIWebViewNavigationTypeFormSubmitted;
+        case WKNavigationTypeBackForward:     return UIWebViewNavigationTypeBackForward;
+        case WKNavigationTypeReload:          return UIWebViewNavigationTypeReload;
+        case WKNavigationTypeFormResubmitted: return UIWebViewNavigationTypeFormResubmitted;
+        default:                              return UIWebViewNavigationTypeOther;
+    }
+}
+
+@interface EmbedWebView ()
+
+@property(nonatomic,assign,readwrite)CGFloat contentHeight;
+
+@end
 
 @implementation EmbedWebView
+{
+    WebScriptMessageProxy *_messageProxy;
+    NSMutableDictionary<NSString *, EmbedWebViewHandler> *_handlers;
+    //已注入 kEmbedWebViewAPIBaseScript 的目录树根
+    NSMutableSet<NSURL *> *_APIBaseSiteURLs;
+}
 @synthesize delegate;
 
 - (id)initWithUrl:(NSString *)url {
     self = [super init];
     if (self)  {
-        
+
         self.myUrl = url;
-        
-        _webView = [[UIWebView alloc] init];
+        _handlers = [NSMutableDictionary dictionary];
+        _messageProxy = [[WebScriptMessageProxy alloc] initWithTarget:self];
+
+        _webView = [[WebViewPool sharedWebViewPool] dequeueWebView];
         [_webView setUserInteractionEnabled: YES ];	 //是否支持交互
-        [_webView setDelegate:self];	 //委托
+        _webView.navigationDelegate = self;
+        _webView.UIDelegate = self;
         [_webView setOpaque:YES];	 //透明
         _webView.scrollView.scrollEnabled = NO;
         _webView.scrollView.bounces = NO;
-        _webView.scrollView.delegate = self;
+        //WKWebView 自己是 scrollView 的 delegate，滚动改用 KVO
+        [_webView.scrollView addObserver:self forKeyPath:@"contentOffset" options:NSKeyValueObservingOptionNew context:nil];
+
+        WKUserContentController *userContentController = _webView.configuration.userContentController;
+        [userContentController addScriptMessageHandler:_messageProxy name:kWebViewScrollHeightMessage];
+        [userContentController addUserScript:[[WKUserScript alloc] initWithSource:kEmbedWebViewUserSelectScript injectionTime:WKUserScriptInjectionTimeAtDocumentEnd forMainFrameOnly:YES]];
 
         [self addSubview:_webView];	 //加载到自己的view
         [_webView mas_makeConstraints:^(MASConstraintMaker *make) {
             make.edges.equalTo(_webView.superview).with.insets(UIEdgeInsetsMake(0,0,0,0));
-            
+
         }];
-        
-//        _progressProxy = [[NJKWebViewProgress alloc] init];
-//        _webView.delegate = _progressProxy;
-//        _progressProxy.webViewProxyDelegate = self;
-//        _progressProxy.progressDelegate = self;
-//        
-//        CGFloat progressBarHeight = 2.f;
-//        _progressView = [[NJKWebViewProgressView alloc] init];
-//        _progressView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleTopMargin;
-//        [self addSubview:_progressView];
-//        [_progressView mas_makeConstraints:^(MASConstraintMaker *make) {
-//            make.top.left.right.equalTo(_progressView.superview);
-//            make.height.mas_equalTo(progressBarHeight);
-//        }];
-        
-        if (_myUrl) {
-            NSString *urlStr = [_myUrl stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
 
-            NSURL *url = [[NSURL alloc] initWithString:urlStr];
-            [_webView loadRequest:[ NSURLRequest requestWithURL:url]];
+        if (_myUrl) {
+            [self setUrl:_myUrl];
         }
-    
+
     }
-    
+
     return self;
 
 }
 
 - (void)setUrl:(NSString *)url {
     self.myUrl = url;
+    self.contentHeight = 0;
     NSString *urlStr = [_myUrl stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
     NSURL *newUrl = [[NSURL alloc] initWithString:urlStr];
-    [_webView loadRequest:[ NSURLRequest requestWithURL:newUrl]];
+
+    //WKWebView 的请求不经过 NSURLProtocol，离线包里有这个页面时从本地目录树整页加载，js、css、图片都是本地文件；
+    //接口请求要带的 cookie 只能通过 iOS 11 的 WKHTTPCookieStore 给到，更早的系统照常走网络
+    NSURL *readAccessURL = nil;
+    NSURL *fileURL = [[H5OfflinePackage sharedH5OfflinePackage] fileURLForURL:newUrl readAccessURL:&readAccessURL];
+    if (fileURL) {
+        if (@available(iOS 11.0, *)) {
+            [self private_loadFileURL:fileURL readAccessURL:readAccessURL];
+            return;
+        }
+    }
+    [_webView loadRequest:[WebViewPool requestWithURL:newUrl]];
 }
 
-#pragma mark - NJKWebViewProgressDelegate
-- (void)webViewProgress:(NJKWebViewProgress *)webViewProgress updateProgress:(float)progress {
-    [_progressView setProgress:progress animated:YES];
-    
+- (void)registerHandler:(NSString *)name handler:(EmbedWebViewHandler)handler {
+    if (name.length == 0 || handler == nil) {
+        return;
+    }
+    if (_handlers[name] == nil) {
+        [_webView.configuration.userContentController addScriptMessageHandler:_messageProxy name:name];
+    }
+    _handlers[name] = [handler copy];
+
+    NSString *source = [NSString stringWithFormat:@"window.%@=function(){window.webkit.messageHandlers.%@.postMessage(Array.prototype.slice.call(arguments));};", name, name];
+    [self private_addScript:source];
+}
+
+- (void)setReturnValue:(id)value forFunction:(NSString *)name {
+    if (name.length == 0) {
+        return;
+    }
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@[value ?: [NSNull null]] options:0 error:nil];
+    if (data == nil) {
+        return;
+    }
+    NSString *json = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+    NSString *source = [NSString stringWithFormat:@"window.%@=function(){return %@[0];};", name, json];
+    [self private_addScript:source];
 }
 
-- (void)scrollViewDidScroll:(UIScrollView *)scrollView {
-    if([self.delegate respondsToSelector:@selector(scrollViewDidScroll:)]) {
-        [self.delegate scrollViewDidScroll:_webView.scrollView];
+- (void)evaluateJavaScript:(NSString *)script {
+    [_webView evaluateJavaScript:script completionHandler:nil];
+}
+
+- (void)dealloc {
+    [_webView.scrollView removeObserver:self forKeyPath:@"contentOffset"];
+    _webView.navigationDelegate = nil;
+    _webView.UIDelegate = nil;
+    WKUserContentController *userContentController = _webView.configuration.userContentController;
+    [userContentController removeScriptMessageHandlerForName:kWebViewScrollHeightMessage];
+    for (NSString *name in _handlers) {
+        [userContentController removeScriptMessageHandlerForName:name];
     }
 }
 
-- (void)webViewDidFinishLoad:(UIWebView *)wb {
-    NSInteger height = [[_webView stringByEvaluatingJavaScriptFromString:@"document.body.scrollHeight"] integerValue];
+#pragma mark private
+
+//登录 cookie 写进 WKWebView 的 cookie 存储后再加载，本地页面发往 API_URL 的跨域请求才会带上
+- (void)private_loadFileURL:(NSURL *)fileURL readAccessURL:(NSURL *)readAccessURL API_AVAILABLE(ios(11.0)) {
+    if (_APIBaseSiteURLs == nil) {
+        _APIBaseSiteURLs = [NSMutableSet set];
+    }
+    if (![_APIBaseSiteURLs containsObject:readAccessURL]) {
+        [_APIBaseSiteURLs addObject:readAccessURL];
+        NSData *data = [NSJSONSerialization dataWithJSONObject:@[API_URL, readAccessURL.absoluteString] options:0 error:nil];
+        NSString *json = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+        [self private_addScript:[NSString stringWithFormat:kEmbedWebViewAPIBaseScript, json]];
+    }
 
-    NSLog(@"~~~~~~~contentSize width:%lf, height:%lf",wb.scrollView.contentSize.width,wb.scrollView.contentSize.height);
-    
-    if([self.delegate respondsToSelector:@selector(embedWebView:webViewHeight:)]) {
-        [self.delegate embedWebView:self webViewHeight:height];
+    WKHTTPCookieStore *cookieStore = _webView.configuration.websiteDataStore.httpCookieStore;
+    dispatch_group_t group = dispatch_group_create();
+    for (NSHTTPCookie *cookie in [[NSHTTPCookieStorage sharedHTTPCookieStorage] cookiesForURL:[NSURL URLWithString:API_URL]]) {
+        dispatch_group_enter(group);
+        [cookieStore setCookie:cookie completionHandler:^{
+            dispatch_group_leave(group);
+        }];
     }
-    
+
+    NSString *url = _myUrl;
+    __weak typeof(self)weakSelf = self;
+    dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+        //等 cookie 期间又换了页面
+        if (![weakSelf.myUrl isEqualToString:url]) {
+            return;
+        }
+        [weakSelf.webView loadFileURL:fileURL allowingReadAccessToURL:readAccessURL];
+    });
+}
+
+//之后加载的页面由 user script 注入，当前页面直接执行一次
+- (void)private_addScript:(NSString *)source {
+    WKUserScript *script = [[WKUserScript alloc] initWithSource:source injectionTime:WKUserScriptInjectionTimeAtDocumentStart forMainFrameOnly:YES];
+    [_webView.configuration.userContentController addUserScript:script];
+    [_webView evaluateJavaScript:source completionHandler:nil];
+}
+
+//type 为 1 时这些页面直接在当前 webView 里打开
++ (BOOL)private_isInPageURL:(NSString *)url {
+    static URLRouter *router = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        router = [[URLRouter alloc] init];
+        URLRouteHandler handler = ^(URLRouteMatch *match) {};
+        for (NSString *path in @[H5_FM0200, H5_FM0100, H5_ACCOUNT_MY_ASSET, H5_ACCOUNT_MY_ASSET_UNLOGIN, H5_ACCOUNT_MY_HISTORY, H5_ACCOUNT_MY_HISTORY_UNLOGIN]) {
+            [router registerPattern:[API_URL stringByAppendingString:path] handler:handler];
+        }
+    });
+    return [router matchURLString:url] != nil;
+}
+
+- (UIViewController *)private_presentingViewController {
+    AppDelegate *appdelegate = (AppDelegate *)[UIApplication sharedApplication].delegate;
+    UIViewController *vc = appdelegate.navigationController;
+    while (vc.presentedViewController) {
+        vc = vc.presentedViewController;
+    }
+    return vc;
+}
+
+#pragma mark - scroll
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary<NSKeyValueChangeKey,id> *)change context:(void *)context {
+    if (object == _webView.scrollView && [keyPath isEqualToString:@"contentOffset"]) {
+        if([self.delegate respondsToSelector:@selector(scrollViewDidScroll:)]) {
+            [self.delegate scrollViewDidScroll:_webView.scrollView];
+        }
+    } else {
+        [super observeValueForKeyPath:keyPath ofObject:object change:change context:context];
+    }
+}
+
+#pragma mark - WKScriptMessageHandler
+
+- (void)userContentController:(WKUserContentController *)userContentController didReceiveScriptMessage:(WKScriptMessage *)message {
+    if ([message.name isEqualToString:kWebViewScrollHeightMessage]) {
+        CGFloat height = [message.body doubleValue];
+        if (height <= 0 || height == self.contentHeight) {
+            return;
+        }
+        self.contentHeight = height;
+        if([self.delegate respondsToSelector:@selector(embedWebView:webViewHeight:)]) {
+            [self.delegate embedWebView:self webViewHeight:height];
+        }
+        return;
+    }
+
+    EmbedWebViewHandler handler = _handlers[message.name];
+    if (handler) {
+        handler([message.body isKindOfClass:[NSArray class]] ? message.body : @[]);
+    }
+}
+
+#pragma mark - WKNavigationDelegate
+
+- (void)webView:(WKWebView *)webView didFinishNavigation:(WKNavigation *)navigation {
     if ([self.delegate respondsToSelector:@selector(didFinishLoadWebView)]) {
         [self.delegate didFinishLoadWebView];
     }
-
-    [_webView stringByEvaluatingJavaScriptFromString:@"document.documentElement.style.webkitUserSelect='none';"];
 }
 
-- (void)webView:(UIWebView *)webView didFailLoadWithError:(NSError *)error {
+- (void)webView:(WKWebView *)webView didFailNavigation:(WKNavigation *)navigation withError:(NSError *)error {
     NSLog(@"didFailLoadWithError");
 }
 
-- (BOOL)webView:(UIWebView *)webView shouldStartLoadWithRequest:(NSURLRequest *)request navigationType:(UIWebViewNavigationType)navigationType {
+- (void)webViewWebContentProcessDidTerminate:(WKWebView *)webView {
+    //WebContent 进程被系统杀掉后页面会白屏
+    [webView reload];
+}
 
-    
-    [UrlRedirectAction sharedUrlRedirectAction].delegate = self.delegate;
-    
-
-    if(self.type == 1) {
-        NSRange urlRange = [[request.URL path]  rangeOfString:H5_FM0200];
-        NSRange urlRange2 = [[request.URL path] rangeOfString:H5_FM0100];
-        NSRange urlRange3 = [[request.URL path] rangeOfString:H5_ACCOUNT_MY_ASSET];
-        NSRange urlRange4 = [[request.URL path] rangeOfString:H5_ACCOUNT_MY_HISTORY];
-        if ((urlRange.length >0)||
-            (urlRange2.length >0)||
-            (urlRange3.length >0)||
-            (urlRange4.length >0)) {
-            return YES;
-        } else {
-            return [UrlRedirectAction redirectActionWithUrl:request.URL from:self.myUrl navigationType:navigationType];
+- (void)webView:(WKWebView *)webView decidePolicyForNavigationAction:(WKNavigationAction *)navigationAction decisionHandler:(void (^)(WKNavigationActionPolicy))decisionHandler {
+
+    NSURL *url = navigationAction.request.URL;
+    UIWebViewNavigationType navigationType = EmbedWebViewNavigationType(navigationAction.navigationType);
+
+    //离线页面里的地址换回线上地址再判断，目录树外的本地文件不打开
+    NSURL *fileURL = nil;
+    if (url.isFileURL) {
+        fileURL = url;
+        url = [[H5OfflinePackage sharedH5OfflinePackage] remoteURLForFileURL:fileURL];
+        if (url == nil) {
+            decisionHandler(WKNavigationActionPolicyCancel);
+            return;
         }
     }
-    
-    return [UrlRedirectAction redirectActionWithUrl:request.URL from:self.myUrl navigationType:navigationType];
 
+    [UrlRedirectAction sharedUrlRedirectAction].delegate = self.delegate;
+
+
+    BOOL allow = NO;
+    if(self.type == 1 && [EmbedWebView private_isInPageURL:url.absoluteString]) {
+        allow = YES;
+    } else {
+        allow = [UrlRedirectAction redirectActionWithUrl:url from:self.myUrl navigationType:navigationType];
+    }
+
+    //目录树里没有的页面改走网络
+    if (allow && fileURL && ![[NSFileManager defaultManager] fileExistsAtPath:fileURL.path]) {
+        [webView loadRequest:[WebViewPool requestWithURL:url]];
+        allow = NO;
+    }
+
+    decisionHandler(allow ? WKNavigationActionPolicyAllow : WKNavigationActionPolicyCancel);
+
+}
+
+#pragma mark - WKUIDelegate
+
+//target="_blank" 和 window.open 在当前页打开
+- (WKWebView *)webView:(WKWebView *)webView createWebViewWithConfiguration:(WKWebViewConfiguration *)configuration forNavigationAction:(WKNavigationAction *)navigationAction windowFeatures:(WKWindowFeatures *)windowFeatures {
+    if (navigationAction.targetFrame == nil) {
+        [webView loadRequest:navigationAction.request];
+    }
+    return nil;
+}
+
+- (void)webView:(WKWebView *)webView runJavaScriptAlertPanelWithMessage:(NSString *)message initiatedByFrame:(WKFrameInfo *)frame completionHandler:(void (^)(void))completionHandler {
+    UIAlertController *alert = [UIAlertController alertControllerWithTitle:nil message:message preferredStyle:UIAlertControllerStyleAlert];
+    [alert addAction:[UIAlertAction actionWithTitle:@"确定" style:UIAlertActionStyleDefault handler:^(UIAlertAction *action) {
+        completionHandler();
+    }]];
+    [[self private_presentingViewController] presentViewController:alert animated:YES completion:nil];
+}
+
+- (void)webView:(WKWebView *)webView runJavaScriptConfirmPanelWithMessage:(NSString *)message initiatedByFrame:(WKFrameInfo *)frame completionHandler:(void (^)(BOOL))completionHandler {
+    UIAlertController *alert = [UIAlertController alertControllerWithTitle:nil message:message preferredStyle:UIAlertControllerStyleAlert];
+    [alert addAction:[UIAlertAction actionWithTitle:@"取消" style:UIAlertActionStyleCancel handler:^(UIAlertAction *action) {
+        completionHandler(NO);
+    }]];
+    [alert addAction:[UIAlertAction actionWithTitle:@"确定" style:UIAlertActionStyleDefault handler:^(UIAlertAction *action) {
+        completionHandler(YES);
+    }]];
+    [[self private_presentingViewController] presentViewController:alert animated:YES completion:nil];
 }
 
 - (void)commentDidFinished {
@@ -152,35 +152,13 @@
     
     dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
     dispatch_async(queue, ^{
-        NSArray *array = [StockCodesInstance sharedStockCodesInstance].stockCodesArray;
-        //NSArray *array = appDelegate.stockCodesModel.gxCodeList;
-        
-        NSString *text = [searchText lowercaseString];
-        for (int i = 0; i < [array count]; i++) {
-            StockCodeInfo* item = [array objectAtIndex:i];
-            
-            NSString *code = item.s;
-            NSString *name = item.n;
-            NSString *pin = item.p;
-            if([code containsString:searchText])//hasPrefix
-            {
-                [_resultArray addObject:item];
-            }
-            else if([name containsString:searchText])
-            {
-                [_resultArray addObject:item];
-            }
-            else if([pin containsString:text])
-            {
-                [_resultArray addObject:item];
-            }
-            
-            if([_resultArray count] > 20)
-            {
-                break;
-            }
-        }
+        NSArray *result = [[StockCodesInstance sharedStockCodesInstance] searchStockCodes:searchText limit:21];
         dispatch_async(dispatch_get_main_queue(), ^{
+            //输入已变化，丢弃旧结果
+            if (![searchText isEqualToString:_searchBar.text]) {
+                return;
+            }
+            [_resultArray setArray:result];
             [_tableView reloadData];
         });
     });
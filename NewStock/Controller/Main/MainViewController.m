@@ -15,6 +15,7 @@
 #import "AppDelegate.h"
 #import "StockHistoryUtil.h"
 #import "NativeUrlRedirectAction.h"
+#import "LaunchTaskScheduler.h"
 
 #import "MainPageAPI.h"
 #import "FeedLikeAPI.h"
@@ -376,6 +377,8 @@ static NSString *baguaCellID = @"baguaCellID";
                 [_szIndex setCode:@"" title:model.symbolName value:[SystemUtil getPrecisionPrice:[model.consecutivePresentPrice doubleValue] precision:[model.pricePrecision intValue]] change:[NSString stringWithFormat:@"%.2f",[model.stockUD doubleValue]] changeRate:[SystemUtil getPercentage:[model.tradeIncrease doubleValue]]];
             }
         }
+        //首页指数行情展示即视为启动完成
+        [[LaunchTaskScheduler sharedLaunchTaskScheduler] markFirstScreenReady];
     } failure:nil];
     
     [_talkNewsAPI startWithCompletionBlockWithSuccess:^(__kindof APIBaseRequest *request) {
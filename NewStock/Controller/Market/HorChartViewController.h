@@ -10,6 +10,7 @@
 #import "StockListModel.h"
 #import "Y_KLineGroupModel.h"
 #import "Y_StockChartConstant.h"
+#import "Y_StockChartConfig.h"
 
 @interface HorChartViewController : BaseViewController
 {
@@ -18,8 +19,10 @@
 }
 
 @property (nonatomic, strong) StockListModel *stockListModel;
-@property (nonatomic, copy) NSMutableDictionary <NSString*, Y_KLineGroupModel*> *modelsDict;
 
 @property (nonatomic, assign) Y_StockType currentStockType;
 
+//竖屏图表的配置，横屏沿用五档宽度等设置，之后的缩放互不影响
+@property (nonatomic, strong) Y_StockChartConfig *chartConfig;
+
 @end
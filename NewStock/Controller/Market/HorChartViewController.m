@@ -16,7 +16,7 @@
 #import "MarketConfig.h"
 
 #import "StockBaseInfoAPI.h"
-#import "KLineInfoAPI.h"
+#import "Y_KLineDataSession.h"
 #import "FifthPosAPI.h"
 #import "FinanceInfoAPI.h"
 #import "SymbolnewsAPI.h"
@@ -30,8 +30,8 @@
 #import "ListPopView.h"
 #import "FifthPosView.h"
 #import "ProductSelView.h"
+#import "Y_KLineIndicator.h"
 
-#import "Y_StockChartGlobalVariable.h"
 
 #import "APIBaseRequest+AnimatingAccessory.h"
 
@@ -46,12 +46,12 @@
 @property (nonatomic, strong) ProductSelView *productSelView;
 
 @property (nonatomic, strong) Y_KLineGroupModel *groupModel;
+@property (nonatomic, strong) Y_KLineDataSession *session;
 @property (nonatomic, strong) StockBaseInfoModel *stockBaseInfoModel;
 @property (nonatomic, strong) NSMutableArray *tradeDetailArray;
 
 //api
 @property (nonatomic, strong) StockBaseInfoAPI *stockBaseInfoAPI;
-@property (nonatomic, strong) KLineInfoAPI *klineInfoAPI;
 @property (nonatomic, strong) FifthPosAPI *fifthPosAPI;
 @property (nonatomic, strong) TradesDetailAPI *tradeDetailAPI;
 
@@ -76,6 +76,17 @@
 - (void)viewDidLoad {
     [super viewDidLoad];
     // Do any additional setup after loading the view.
+    //K 线数据与详情页共用，有新数据时刷新当前周期
+    __weak typeof(self) weakSelf = self;
+    [self.session addObserver:self usingBlock:^(NSString *chartTyp, Y_KLineGroupModel *groupModel) {
+        HorChartViewController *strongSelf = weakSelf;
+        if (![chartTyp isEqualToString:strongSelf.type]) {
+            return;
+        }
+        strongSelf.groupModel = groupModel;
+        [strongSelf.stockChartView reloadData];
+    }];
+
     _navBar.hidden = YES;
     self.stockInfoViewHeight = 44 * kScale;
     self.stockChartViewHeight = _nMainViewWidth - 44 * kScale;
@@ -121,6 +132,9 @@
 - (Y_StockChartView *)stockChartView {
     if(!_stockChartView) {
         _stockChartView = [Y_StockChartView new];
+        if (self.chartConfig) {
+            _stockChartView.config = self.chartConfig;
+        }
         _stockChartView.currentStockType = self.currentStockType;
 
         _stockChartView.itemModels = @[
@@ -155,8 +169,7 @@
         
         
         if (self.currentStockType == Y_StockType_AStock) {
-            //int viewWidth = MAIN_SCREEN_WIDTH * [Y_StockChartGlobalVariable fifthPosViewRadio];
-            int viewWidth = [Y_StockChartGlobalVariable fifthPosViewWidth];
+            int viewWidth = _stockChartView.config.fifthPosViewWidth;
             _fifthPosView = [[FifthPosView alloc] initWithWidth:viewWidth height:self.stockChartViewHeight - 44 * kScale];
             _fifthPosView.delegate = self;
             _fifthPosView.layer.borderWidth = 0.5;
@@ -170,7 +183,12 @@
             }];
         }
         
-        _productSelView = [[ProductSelView alloc] init];
+        //成交量 + 注册表中的副图指标
+        NSMutableArray *titles = [NSMutableArray arrayWithObject:@"成交量"];
+        for (Y_KLineIndicator *indicator in [Y_KLineIndicator registeredIndicators]) {
+            [titles addObject:indicator.name];
+        }
+        _productSelView = [[ProductSelView alloc] initWithTitles:titles];
         _productSelView.delegate = self;
         _productSelView.layer.borderWidth = 0.5;
         _productSelView.layer.borderColor = kUIColorFromRGB(0xd3d3d3).CGColor;//SEP_BG_COLOR.CGColor;
@@ -383,13 +401,12 @@
     
     self.currentIndex = index;
     self.type = type;
-    if(![self.modelsDict objectForKey:type]) {
+    //没有数据或只是本地聚合的，加载服务端数据
+    Y_KLineGroupModel *groupModel = [self.session groupModelForChartType:type];
+    if (!groupModel || groupModel.isDerived) {
         [self loadStockData];
-        //[self reloadData];
-    } else {
-        return [self.modelsDict objectForKey:type].models;
     }
-    return nil;
+    return groupModel.models;
 }
 
 - (void)reloadData {
@@ -417,56 +434,7 @@
      15:年K线
      16:1分
      */
-    if(!_klineInfoAPI)_klineInfoAPI = [[KLineInfoAPI alloc] initWithSymbolTyp:_stockListModel.symbolTyp symbol:_stockListModel.symbol marketCd:_stockListModel.marketCd chartTyp:self.type];
-    [_klineInfoAPI setChartTyp:self.type];
-    
-    _klineInfoAPI.ignoreCache = YES;
-    
-    if(![self.modelsDict objectForKey:self.type])
-    {
-        _klineInfoAPI.animatingView = _scrollView;//self.view;//self.stockChartView;//
-        _klineInfoAPI.animatingText = @"数据加载中...";//@"正在加载";
-    }
-    else
-    {
-        _klineInfoAPI.animatingView = nil;//self.view;
-        _klineInfoAPI.animatingText = @"";
-    }
-    
-    
-    [_klineInfoAPI startWithCompletionBlockWithSuccess:^(APIBaseRequest *request) {
-        //NSLog(@"update ui");
-        NSLog(@"%@",_klineInfoAPI.responseJSONObject);
-        
-        Y_KLineGroupModel *groupModel;
-        
-        if ([self.type isEqualToString:@"13"])
-        {
-            
-            groupModel = [Y_KLineGroupModel objectWith5MinArray:_klineInfoAPI.responseJSONObject[@"chartInfLst"]];
-            
-        }
-        else
-        {
-            groupModel = [Y_KLineGroupModel objectWithArray:_klineInfoAPI.responseJSONObject[@"chartInfLst"]];
-        }
-        
-        if(groupModel)
-        {
-            self.groupModel = groupModel;
-            [self.modelsDict setObject:groupModel forKey:self.type];
-            NSLog(@"%@",groupModel);
-            [self.stockChartView reloadData];
-        }
-        else
-        {
-            [self.stockChartView reloadData];
-        }
-        
-        
-    } failure:^(APIBaseRequest *request) {
-        NSLog(@"failed");
-    }];
+    [self.session loadChartType:self.type animatingView:_scrollView completion:nil];
     
     if (self.currentIndex == 0) {
         if (self.currentStockType == Y_StockType_AStock) {
@@ -523,11 +491,11 @@
     }];
 }
 
-- (NSMutableDictionary<NSString *,Y_KLineGroupModel *> *)modelsDict {
-    if (!_modelsDict) {
-        _modelsDict = @{}.mutableCopy;
+- (Y_KLineDataSession *)session {
+    if (!_session) {
+        _session = [Y_KLineDataSession acquireSessionWithSymbolTyp:_stockListModel.symbolTyp symbol:_stockListModel.symbol marketCd:_stockListModel.marketCd];
     }
-    return _modelsDict;
+    return _session;
 }
 
 #pragma mark - ProductSelViewDelegate
@@ -540,6 +508,73 @@
     }
 }
 
+//长按副图指标修改参数，index 从 1 开始对应 [Y_KLineIndicator registeredIndicators]
+- (void)productSelView:(ProductSelView *)productSelView longPressedIndex:(int)index {
+    NSArray<Y_KLineIndicator *> *indicators = [Y_KLineIndicator registeredIndicators];
+    if (index < 1 || index > (int)indicators.count || indicators[index - 1].params.count == 0) {
+        return;
+    }
+    [self private_editIndicator:indicators[index - 1] atIndex:index message:nil];
+}
+
+- (void)private_editIndicator:(Y_KLineIndicator *)indicator atIndex:(int)index message:(NSString *)message {
+    //提示各参数的范围
+    NSMutableArray *ranges = [NSMutableArray array];
+    for (NSUInteger p = 0; p < indicator.params.count; p++) {
+        [ranges addObject:[NSString stringWithFormat:@"%@: %g~%g", indicator.paramNames[p], indicator.minParams[p].doubleValue, indicator.maxParams[p].doubleValue]];
+    }
+    NSString *text = [ranges componentsJoinedByString:@"\n"];
+    if (message) {
+        text = [NSString stringWithFormat:@"%@\n%@", message, text];
+    }
+
+    UIAlertController *alert = [UIAlertController alertControllerWithTitle:[NSString stringWithFormat:@"%@ 参数", indicator.name] message:text preferredStyle:UIAlertControllerStyleAlert];
+    for (NSUInteger p = 0; p < indicator.params.count; p++) {
+        BOOL integral = [indicator isIntegralParamAtIndex:p];
+        NSNumber *value = indicator.params[p];
+        NSString *placeholder = indicator.paramNames[p];
+        [alert addTextFieldWithConfigurationHandler:^(UITextField *textField) {
+            textField.placeholder = placeholder;
+            textField.text = [NSString stringWithFormat:@"%g", value.doubleValue];
+            textField.keyboardType = integral ? UIKeyboardTypeNumberPad : UIKeyboardTypeDecimalPad;
+        }];
+    }
+
+    __weak typeof(self) weakSelf = self;
+    __weak UIAlertController *weakAlert = alert;
+    [alert addAction:[UIAlertAction actionWithTitle:@"取消" style:UIAlertActionStyleCancel handler:nil]];
+    [alert addAction:[UIAlertAction actionWithTitle:@"恢复默认" style:UIAlertActionStyleDefault handler:^(UIAlertAction *action) {
+        [weakSelf private_applyIndicator:[indicator indicatorWithParams:indicator.defaultParams] atIndex:index];
+    }]];
+    [alert addAction:[UIAlertAction actionWithTitle:@"确定" style:UIAlertActionStyleDefault handler:^(UIAlertAction *action) {
+        NSMutableArray *params = [NSMutableArray array];
+        for (UITextField *textField in weakAlert.textFields) {
+            NSScanner *scanner = [NSScanner scannerWithString:textField.text];
+            double value;
+            if (![scanner scanDouble:&value] || !scanner.isAtEnd) {
+                params = nil;
+                break;
+            }
+            [params addObject:@(value)];
+        }
+        Y_KLineIndicator *edited = params ? [indicator indicatorWithParams:params] : nil;
+        if (!edited) {
+            [weakSelf private_editIndicator:indicator atIndex:index message:@"参数超出范围"];
+            return;
+        }
+        [weakSelf private_applyIndicator:edited atIndex:index];
+    }]];
+    [self presentViewController:alert animated:YES completion:nil];
+}
+
+- (void)private_applyIndicator:(Y_KLineIndicator *)indicator atIndex:(int)index {
+    [indicator saveAsPreferred];
+    //旧参数算出的结果不再用到
+    [self.session removeIndicatorSeriesNamed:indicator.name];
+    //切到该指标，副图按新参数重画
+    [_productSelView setSelectedIndex:index];
+}
+
 #pragma mark - FifthPosViewDelegate
 - (void)fifthPosView:(FifthPosView*)fifthPosView selectIndex:(NSInteger)index {
     if (index == 1)
@@ -569,4 +604,8 @@
 }
 
 
+- (void)dealloc {
+    [_session relinquish];
+}
+
 @end
@@ -12,13 +12,13 @@
 #import "Y_StockChartView.h"
 #import "Y_StockChartView.h"
 #import "Y_KLineGroupModel.h"
+#import "Y_KLineDataSession.h"
 #import "UIColor+Y_StockChart.h"
 #import "NetWorking.h"
 #import "StockInfoView.h"
 #import "MarketConfig.h"
 
 #import "StockBaseInfoAPI.h"
-#import "KLineInfoAPI.h"
 #import "FinanceInfoAPI.h"
 #import "SymbolnewsAPI.h"
 
@@ -55,7 +55,6 @@
 #import "HorChartViewController.h"
 
 #import "SharedInstance.h"
-#import <JavaScriptCore/JavaScriptCore.h>
 
 @interface IndexChartViewController ()<Y_StockChartViewDataSource,StockInfoViewDelegate,ListPopViewDelegate,EmbedWebViewDelegate,UMSocialUIDelegate,BlurCommentViewDelegate,StockBottomBarDelegate>
 
@@ -70,11 +69,10 @@
 
 //api
 @property (nonatomic, strong) StockBaseInfoAPI *stockBaseInfoAPI;
-@property (nonatomic, strong) KLineInfoAPI *klineInfoAPI;
 @property (nonatomic, strong) FinanceInfoAPI *financeInfoAPI;
 @property (nonatomic, strong) SymbolnewsAPI *symbolnewsAPI;
 
-@property (nonatomic, copy) NSMutableDictionary <NSString*, Y_KLineGroupModel*> *modelsDict;
+@property (nonatomic, strong) Y_KLineDataSession *session;
 
 @property (nonatomic, assign) NSInteger currentIndex;
 
@@ -97,7 +95,6 @@
 
 @property (nonatomic, assign) CGFloat totalHeight;
 
-@property (nonatomic, strong) JSContext *context;
 
 @property (nonatomic, strong) UIView *sepView;
 
@@ -109,6 +106,17 @@
 - (void)viewDidLoad {
     [super viewDidLoad];
     // Do any additional setup after loading the view.
+    //K 线数据与横屏页共用，有新数据时刷新当前周期
+    __weak typeof(self) weakSelf = self;
+    [self.session addObserver:self usingBlock:^(NSString *chartTyp, Y_KLineGroupModel *groupModel) {
+        IndexChartViewController *strongSelf = weakSelf;
+        if (![chartTyp isEqualToString:strongSelf.type]) {
+            return;
+        }
+        strongSelf.groupModel = groupModel;
+        [strongSelf.stockChartView reloadData];
+    }];
+
     self.title = _indexModel.symbolName;
     [_navBar setTitle:self.title];
     [_navBar setSubTitle:_indexModel.symbol];
@@ -262,7 +270,6 @@
     AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
     appDelegate.isEable = YES;
     HorChartViewController *stockChartVC = [HorChartViewController new];
-    //stockChartVC.modelsDict = self.modelsDict;
     
     StockListModel *model = [[StockListModel alloc] init];
     model.symbolName = self.indexModel.symbolName;
@@ -384,14 +391,12 @@
     
     self.currentIndex = index;
     self.type = type;
-    if(![self.modelsDict objectForKey:type]) {
+    //没有数据或只是本地聚合的，加载服务端数据
+    Y_KLineGroupModel *groupModel = [self.session groupModelForChartType:type];
+    if (!groupModel || groupModel.isDerived) {
         [self loadStockData];
-
-        //[self reloadData];
-    } else {
-        return [self.modelsDict objectForKey:type].models;
     }
-    return nil;
+    return groupModel.models;
 }
 
 - (void)reloadData {
@@ -421,48 +426,7 @@
      15:年K线
      16:1分
      */
-    if(!_klineInfoAPI)_klineInfoAPI = [[KLineInfoAPI alloc] initWithSymbolTyp:_indexModel.symbolTyp symbol:_indexModel.symbol marketCd:_indexModel.marketCd chartTyp:self.type];
-    [_klineInfoAPI setChartTyp:self.type];
-    _klineInfoAPI.ignoreCache = YES;
-    
-    if(![self.modelsDict objectForKey:self.type])
-    {
-        _klineInfoAPI.animatingView = _scrollView;
-        _klineInfoAPI.animatingText = @"数据加载中...";//@"正在加载";
-    }
-    else
-    {
-        _klineInfoAPI.animatingView = nil;//self.view;
-        _klineInfoAPI.animatingText = @"";
-    }
-    
-    
-    [_klineInfoAPI startWithCompletionBlockWithSuccess:^(APIBaseRequest *request) {
-        //NSLog(@"update ui");
-        //NSLog(@"%@",_klineInfoAPI.responseJSONObject);
-        
-        Y_KLineGroupModel *groupModel;
-        
-        if ([self.type isEqualToString:@"13"])  {
-            
-            groupModel = [Y_KLineGroupModel objectWith5MinArray:_klineInfoAPI.responseJSONObject[@"chartInfLst"]];
-            
-        } else {
-            groupModel = [Y_KLineGroupModel objectWithArray:_klineInfoAPI.responseJSONObject[@"chartInfLst"]];
-        }
-        
-        if (groupModel) {
-            self.groupModel = groupModel;
-            [self.modelsDict setObject:groupModel forKey:self.type];
-            //NSLog(@"%@",groupModel);
-            [self.stockChartView reloadData];
-        }
-        
-        [_scrollView.mj_header endRefreshing];
-        
-    } failure:^(APIBaseRequest *request) {
-        NSLog(@"failed");
-        
+    [self.session loadChartType:self.type animatingView:_scrollView completion:^(BOOL success) {
         [_scrollView.mj_header endRefreshing];
     }];
     
@@ -500,11 +464,11 @@
 
 }
 
-- (NSMutableDictionary <NSString *,Y_KLineGroupModel *> *)modelsDict {
-    if (!_modelsDict) {
-        _modelsDict = @{}.mutableCopy;
+- (Y_KLineDataSession *)session {
+    if (!_session) {
+        _session = [Y_KLineDataSession acquireSessionWithSymbolTyp:_indexModel.symbolTyp symbol:_indexModel.symbol marketCd:_indexModel.marketCd];
     }
-    return _modelsDict;
+    return _session;
 }
 
 - (void)bottomPopBtnClick:(UIButton *)btn {
@@ -548,28 +512,18 @@
 //    }
 }
 
-- (void)didFinishLoadWebView {
-    __weak typeof(self)weakSelf = self;
-    UIScrollView *sc = [weakSelf valueForKey:@"_scrollView"];
-    self.context[@"getScrollHeight"] = ^() {
-        NSString *h = [weakSelf.webView.webView stringByEvaluatingJavaScriptFromString:@"document.body.clientHeight"];
-        if (h.floatValue > 40) {
-            sc.scrollEnabled = YES;
-        } else {
-            sc.scrollEnabled = NO;
-        }
-        dispatch_async(dispatch_get_main_queue(), ^{
-            [weakSelf updateContentSize];
-        });
-    };
+- (void)embedWebView:(EmbedWebView *)embedWebView webViewHeight:(CGFloat)height {
+    _scrollView.scrollEnabled = height > 40;
+    [self updateContentSize];
 }
 
 - (void)updateContentSize {
-    NSString *h = [self.webView.webView stringByEvaluatingJavaScriptFromString:@"document.body.clientHeight"];
-    if (h.floatValue <= 40) {
+    CGFloat h = self.webView.contentHeight;
+    if (h <= 40) {
         return;
     }
-    _totalHeight = _totalHeight - MAIN_SCREEN_HEIGHT + h.floatValue;
+    //高度会多次回传，每次从头部高度算起
+    _totalHeight = _stockInfoViewHeight + _stockChartViewHeight + 10 * kScale * 3 + h;
     self.webView.frame = CGRectMake(0, 0, MAIN_SCREEN_WIDTH, _totalHeight);
     [self viewDidLayoutSubviews];
 }
@@ -787,16 +741,8 @@
     return _sepView;
 }
 
-- (JSContext *)context {
-    if (_context == nil) {
-        _context = [self.webView.webView valueForKeyPath:@"documentView.webView.mainFrame.javaScriptContext"];
-    }
-    return _context;
-}
-
 - (void)dealloc {
-    _webView.webView.delegate = nil;
-    _webView.webView.scrollView.delegate = nil;
+    [_session relinquish];
 }
 
 @end
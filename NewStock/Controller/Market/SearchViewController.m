@@ -69,6 +69,9 @@
     _resultArray = [[NSMutableArray alloc] init];
     _historyArray = [[NSMutableArray alloc] init];
     
+    //码表首次解析时分段到达，刷新搜索结果
+    [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(stockCodesUpdated) name:STOCK_CODES_UPDATE_NOTIFICATION object:nil];
+    
     _tableView = [[UITableView alloc] init];
     _tableView.delegate = self;
     _tableView.dataSource = self;
@@ -129,6 +132,16 @@
     NSLog(@"search bar text did begin editing");
 }
 
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)stockCodesUpdated {
+    if (_bStartSearch) {
+        [self search:_searchBar.text];
+    }
+}
+
 - (void)search:(NSString *)searchText {
     if (searchText.length>0)
     {
@@ -144,35 +157,13 @@
     
     dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
     dispatch_async(queue, ^{
-        NSArray *array = [StockCodesInstance sharedStockCodesInstance].stockCodesArray;
-        //NSArray *array = appDelegate.stockCodesModel.gxCodeList;
-        
-        NSString *text = [searchText lowercaseString];
-        for (int i = 0; i < [array count]; i++) {
-            StockCodeInfo* item = [array objectAtIndex:i];
-            
-            NSString *code = item.s;
-            NSString *name = item.n;
-            NSString *pin = item.p;
-            if([code containsString:searchText])//hasPrefix
-            {
-                [_resultArray addObject:item];
-            }
-            else if([name containsString:searchText])
-            {
-                [_resultArray addObject:item];
-            }
-            else if([pin containsString:text])
-            {
-                [_resultArray addObject:item];
-            }
-            
-            if([_resultArray count] > 20)
-            {
-                break;
-            }
-        }
+        NSArray *result = [[StockCodesInstance sharedStockCodesInstance] searchStockCodes:searchText limit:21];
         dispatch_async(dispatch_get_main_queue(), ^{
+            //输入已变化，丢弃旧结果
+            if (![searchText isEqualToString:_searchBar.text]) {
+                return;
+            }
+            [_resultArray setArray:result];
             [_tableView reloadData];
         });
     });
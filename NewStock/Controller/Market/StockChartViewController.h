@@ -25,4 +25,10 @@
 }
 @property (nonatomic, strong) StockListModel *stockListModel;
 
+//所在列表中相邻的股票，图表加载完成后预取
+@property (nonatomic, copy) NSArray<StockListModel *> *neighbourStocks;
+
+//取 list 中 index 前后各两只，后面的优先
++ (NSArray<StockListModel *> *)neighboursOfIndex:(NSUInteger)index inList:(NSArray<StockListModel *> *)list;
+
 @end
@@ -14,8 +14,9 @@
 
 #import "Y_StockChartView.h"
 #import "Y_KLineGroupModel.h"
+#import "Y_KLineDataSession.h"
+#import "KLinePrefetchScheduler.h"
 #import "UIColor+Y_StockChart.h"
-#import "Y_StockChartGlobalVariable.h"
 
 #import "NetWorking.h"
 #import "NativeUrlRedirectAction.h"
@@ -25,10 +26,8 @@
 #import "StockHistoryUtil.h"
 #import "AppDelegate.h"
 #import "SharedInstance.h"
-#import <JavaScriptCore/JavaScriptCore.h>
 
 #import "StockBaseInfoAPI.h"
-#import "KLineInfoAPI.h"
 #import "FifthPosAPI.h"
 #import "FinanceInfoAPI.h"
 #import "SymbolnewsAPI.h"
@@ -69,7 +68,6 @@
 
 //api
 @property (nonatomic, strong) StockBaseInfoAPI *stockBaseInfoAPI;
-@property (nonatomic, strong) KLineInfoAPI *klineInfoAPI;
 @property (nonatomic, strong) FifthPosAPI *fifthPosAPI;
 @property (nonatomic, strong) TradesDetailAPI *tradeDetailAPI;
 @property (nonatomic, strong) IndexInfoAPI *indexInfoAPI;
@@ -77,7 +75,7 @@
 @property (nonatomic, strong) FinanceInfoAPI *financeInfoAPI;
 @property (nonatomic, strong) SymbolnewsAPI *symbolnewsAPI;
 
-@property (nonatomic, copy) NSMutableDictionary <NSString*, Y_KLineGroupModel*> *modelsDict;
+@property (nonatomic, strong) Y_KLineDataSession *session;
 
 @property (nonatomic, assign) NSInteger currentIndex;
 
@@ -104,15 +102,38 @@
 @property (nonatomic) UIImageView *bottomPopImg;
 @property (nonatomic) UIView *topBlockView;
 
-@property (nonatomic) JSContext *context;
-
 @end
 
 @implementation StockChartViewController
 
++ (NSArray<StockListModel *> *)neighboursOfIndex:(NSUInteger)index inList:(NSArray<StockListModel *> *)list {
+    NSMutableArray *neighbours = [NSMutableArray arrayWithCapacity:4];
+    NSInteger offsets[] = {1, -1, 2, -2};
+    for (int i = 0; i < 4; i++) {
+        NSInteger n = (NSInteger)index + offsets[i];
+        if (n >= 0 && n < (NSInteger)list.count && [list[n] isKindOfClass:[StockListModel class]]) {
+            [neighbours addObject:list[n]];
+        }
+    }
+    return neighbours;
+}
+
 - (void)viewDidLoad {
     [super viewDidLoad];
     // Do any additional setup after loading the view.
+    //K 线数据与横屏页共用，有新数据时刷新当前周期
+    __weak typeof(self) weakSelf = self;
+    [self.session addObserver:self usingBlock:^(NSString *chartTyp, Y_KLineGroupModel *groupModel) {
+        StockChartViewController *strongSelf = weakSelf;
+        if (![chartTyp isEqualToString:strongSelf.type]) {
+            return;
+        }
+        strongSelf.groupModel = groupModel;
+        [strongSelf.stockChartView reloadData];
+        //当前图表已显示，空闲时预取其他周期和相邻股票
+        [[KLinePrefetchScheduler sharedKLinePrefetchScheduler] scheduleForStock:strongSelf.stockListModel chartType:chartTyp chartTypes:@[@"2", @"13", @"10", @"11", @"12"] neighbours:strongSelf.neighbourStocks];
+    }];
+
     self.title = _stockListModel.symbolName;
     [_navBar setTitle:self.title];
     [_navBar setSubTitle:_stockListModel.symbol];
@@ -284,8 +305,8 @@
 
     HorChartViewController *stockChartVC = [HorChartViewController new];
     stockChartVC.modalTransitionStyle = UIModalTransitionStyleCrossDissolve;
-    //stockChartVC.modelsDict = self.modelsDict;
     stockChartVC.stockListModel = self.stockListModel;
+    stockChartVC.chartConfig = self.stockChartView.config;
     stockChartVC.modalTransitionStyle = UIModalTransitionStyleFlipHorizontal;    // 设置动画效果
 
     [self presentViewController:stockChartVC animated:YES completion:nil];
@@ -449,18 +470,17 @@
     }
 
     
+    if (self.type && type && ![type isEqualToString:self.type]) {
+        [[KLinePrefetchScheduler sharedKLinePrefetchScheduler] recordChartType:type];
+    }
     self.currentIndex = index;
     self.type = type;
-    if(![self.modelsDict objectForKey:type])
-    {
+    //没有数据或只是本地聚合的，加载服务端数据
+    Y_KLineGroupModel *groupModel = [self.session groupModelForChartType:type];
+    if (!groupModel || groupModel.isDerived) {
         [self loadStockData];
-
-        //[self reloadData];
-        
-    } else {
-        return [self.modelsDict objectForKey:type].models;
     }
-    return nil;
+    return groupModel.models;
 }
 
 #pragma mark loadData
@@ -491,59 +511,8 @@
      15:年K线
      16:1分
      */
-    if(!_klineInfoAPI)_klineInfoAPI = [[KLineInfoAPI alloc] initWithSymbolTyp:_stockListModel.symbolTyp symbol:_stockListModel.symbol marketCd:_stockListModel.marketCd chartTyp:self.type];
-    [_klineInfoAPI setChartTyp:self.type];
-    
-    _klineInfoAPI.ignoreCache = YES;
-    
-    if(![self.modelsDict objectForKey:self.type])
-    {
-        _klineInfoAPI.animatingView = _scrollView;//self.view;//self.stockChartView;//
-        _klineInfoAPI.animatingText = @"数据加载中...";//@"正在加载";
-    }
-    else
-    {
-        _klineInfoAPI.animatingView = nil;//self.view;
-        _klineInfoAPI.animatingText = @"";
-    }
-    
-    
-    [_klineInfoAPI startWithCompletionBlockWithSuccess:^(APIBaseRequest *request) {
-        //NSLog(@"update ui");
-        NSLog(@"%@",_klineInfoAPI.responseJSONObject);
-        
-        Y_KLineGroupModel *groupModel;
-        
-        if ([self.type isEqualToString:@"13"])
-        {
-            
-            groupModel = [Y_KLineGroupModel objectWith5MinArray:_klineInfoAPI.responseJSONObject[@"chartInfLst"]];
-
-        }
-        else
-        {
-            groupModel = [Y_KLineGroupModel objectWithArray:_klineInfoAPI.responseJSONObject[@"chartInfLst"]];
-        }
-        
-        if(groupModel)
-        {
-            self.groupModel = groupModel;
-            [self.modelsDict setObject:groupModel forKey:self.type];
-            NSLog(@"%@",groupModel);
-            [self.stockChartView reloadData];
-        }
-        else
-        {
-            [self.stockChartView reloadData];
-        }
-
+    [self.session loadChartType:self.type animatingView:_scrollView completion:^(BOOL success) {
         [_scrollView.mj_header endRefreshing];
-        
-    } failure:^(APIBaseRequest *request) {
-        NSLog(@"failed");
-        
-        [_scrollView.mj_header endRefreshing];
-        
     }];
     
     
@@ -697,22 +666,17 @@
 
 #pragma mark Webview delegate
 
-- (void)didFinishLoadWebView {
-    __weak typeof(self)weakSelf = self;
-    self.context[@"getScrollHeight"] = ^() {
-        dispatch_async(dispatch_get_main_queue(), ^{
-            [weakSelf updateContentSize];
-        });
-    };
+- (void)embedWebView:(EmbedWebView *)embedWebView webViewHeight:(CGFloat)height {
+    [self updateContentSize];
 }
 
 - (void)updateContentSize {
-    NSString *h = [self.webView.webView stringByEvaluatingJavaScriptFromString:@"document.body.clientHeight"];
-    if (h.floatValue <= 0) {
+    CGFloat h = self.webView.contentHeight;
+    if (h <= 0) {
         return;
     }
     [_mainView mas_updateConstraints:^(MASConstraintMaker *make) {
-        make.height.mas_equalTo(self.stockInfoViewHeight + 10 * kScale + self.stockChartViewHeight + 10 * kScale + self.segmentedControlNewsHeight + (h.floatValue) + 60 * kScale);
+        make.height.mas_equalTo(self.stockInfoViewHeight + 10 * kScale + self.stockChartViewHeight + 10 * kScale + self.segmentedControlNewsHeight + h + 60 * kScale);
     }];
 }
 
@@ -972,10 +936,11 @@
 - (Y_StockChartView *)stockChartView {
     if(!_stockChartView) {
         
-        int viewWidth = MAIN_SCREEN_WIDTH * [Y_StockChartGlobalVariable fifthPosViewRadio];
-        [Y_StockChartGlobalVariable setFifthPosViewWidth:viewWidth];
+        Y_StockChartConfig *config = [Y_StockChartConfig defaultConfig];
+        int viewWidth = MAIN_SCREEN_WIDTH * config.fifthPosViewRatio;
         
         _stockChartView = [Y_StockChartView new];
+        _stockChartView.config = [config configWithFifthPosViewWidth:viewWidth];
         _stockChartView.itemModels = @[
                                        //[Y_StockChartViewItemModel itemModelWithTitle:@"指标" type:Y_StockChartcenterViewTypeOther],
                                        [Y_StockChartViewItemModel itemModelWithTitle:@"分时" type:Y_StockChartcenterViewTypeTimeLine],
@@ -1050,11 +1015,11 @@
     return _bottomBar;
 }
 
-- (NSMutableDictionary<NSString *,Y_KLineGroupModel *> *)modelsDict {
-    if (!_modelsDict) {
-        _modelsDict = @{}.mutableCopy;
+- (Y_KLineDataSession *)session {
+    if (!_session) {
+        _session = [Y_KLineDataSession acquireSessionWithSymbolTyp:_stockListModel.symbolTyp symbol:_stockListModel.symbol marketCd:_stockListModel.marketCd];
     }
-    return _modelsDict;
+    return _session;
 }
 
 - (UIImageView *)bottomPopImg {
@@ -1075,11 +1040,8 @@
     return _bottomPopImg;
 }
 
-- (JSContext *)context {
-    if (_context == nil) {
-        _context = [self.webView.webView valueForKeyPath:@"documentView.webView.mainFrame.javaScriptContext"];
-    }
-    return _context;
+- (void)dealloc {
+    [_session relinquish];
 }
 
 @end
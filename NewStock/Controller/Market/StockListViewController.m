@@ -16,13 +16,18 @@
 
 #import "RankListAPI.h"
 #import "Mantle.h"
+#import "MJRefresh.h"
 #import "StockListModel.h"
 
 #import "StockChartViewController.h"
+#import "ListDiff.h"
 
 @interface StockListViewController () {
 
     UILabel *_changeRateLb;
+    
+    //下拉刷新时先保留旧数据，返回后和新数据做 diff
+    BOOL _isLoadingFirstPage;
 }
 
 @end
@@ -129,8 +134,66 @@
     return [StockListModel class];
 }
 
+- (void)loadNewData {
+    _isLoadingFirstPage = YES;
+    [_listRequestAPI loadFirstPage];
+}
+
+- (void)requestFinished:(APIBaseRequest *)request {
+    NSArray *array = [_listRequestAPI.responseJSONObject objectForKey:_resultListName];
+    _totalNum = [[_listRequestAPI.responseJSONObject objectForKey:@"total"] intValue];
+    _listRequestAPI.totalNum = _totalNum;
+    
+    [self analyzeData:_listRequestAPI.responseJSONObject];
+    
+    NSArray *modelArray = [MTLJSONAdapter modelsOfClass:[self getModelClass] fromJSONArray:array error:nil];
+    NSArray *oldArray = [_resultListArray copy];
+    if (_isLoadingFirstPage) {
+        _isLoadingFirstPage = NO;
+        [_resultListArray removeAllObjects];
+    }
+    [_resultListArray addObjectsFromArray:modelArray];
+    
+    //只动有变化的行，价格变了的 cell 原地重新填数据
+    ListDiffResult *diff = [ListDiff diffFromArray:oldArray toArray:_resultListArray identifier:^id<NSCopying>(StockListModel *model) {
+        return model.stockIdentifier;
+    }];
+    [diff applyToTableView:_tableView section:0 reconfigure:^(UITableViewCell *cell, NSIndexPath *indexPath) {
+        [self private_configureCell:(StockTableViewCell *)cell model:_resultListArray[indexPath.row]];
+    }];
+    
+    [_tableView.mj_header endRefreshing];
+    if (_totalNum > [_resultListArray count]) {
+        [_tableView.mj_footer endRefreshing];
+    } else {
+        //没有更多数据的状态
+        [_tableView.mj_footer endRefreshingWithNoMoreData];
+    }
+}
+
 - (void)requestFailed:(APIBaseRequest *)request {
     NSLog(@"failed");
+    //否则下一次加载更多会被当成首页整体替换
+    _isLoadingFirstPage = NO;
+    [_tableView.mj_header endRefreshing];
+    [_tableView.mj_footer endRefreshing];
+}
+
+- (void)private_configureCell:(StockTableViewCell *)cell model:(StockListModel *)model {
+    [cell setCode:model.symbol name:model.symbolName value:model.consecutivePresentPrice changeRate:[SystemUtil getPercentage:[model.tradeIncrease doubleValue]] marketCd:model.marketCd];
+    
+    if(self.RankType == RankType_VOLUME)
+    {
+        [cell setVoluem:model.volumePrice];
+    }
+    else if(self.RankType == RankType_TURNOVER)
+    {
+        [cell setTurnover:model.turnover];
+    }
+    else if(self.RankType == RankType_5MIN)
+    {
+        [cell setMin5UpDown:[SystemUtil getPercentage:[model.min5UpDown doubleValue]]];
+    }
 }
 
 #pragma UITableView
@@ -192,7 +255,8 @@
 //    else
 //    {
         static NSString *cellid=@"stockTableViewCell";
-        StockTableViewCell *cell = [tableView cellForRowAtIndexPath:indexPath];
+        //批量更新时 cellForRowAtIndexPath: 可能拿到正在移动的另一行，必须走复用池
+        StockTableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:cellid];
         
         if (cell==nil)
         {
@@ -202,21 +266,7 @@
 
         long index=[indexPath row] ;
         StockListModel *model = [_resultListArray objectAtIndex:index];
-
-        [cell setCode:model.symbol name:model.symbolName value:model.consecutivePresentPrice changeRate:[SystemUtil getPercentage:[model.tradeIncrease doubleValue]] marketCd:model.marketCd];
-
-        if(self.RankType == RankType_VOLUME)
-        {
-            [cell setVoluem:model.volumePrice];
-        }
-        else if(self.RankType == RankType_TURNOVER)
-        {
-            [cell setTurnover:model.turnover];
-        }
-        else if(self.RankType == RankType_5MIN)
-        {
-            [cell setMin5UpDown:[SystemUtil getPercentage:[model.min5UpDown doubleValue]]];
-        }
+        [self private_configureCell:cell model:model];
         
         return cell;
 //    }
@@ -235,6 +285,7 @@
     
 
     viewController.stockListModel = model;
+    viewController.neighbourStocks = [StockChartViewController neighboursOfIndex:index inList:_resultListArray];
     [appDelegate.navigationController pushViewController:viewController animated:YES];
 }
 
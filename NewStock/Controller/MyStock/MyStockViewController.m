@@ -31,6 +31,7 @@
 #import "IndexInfoAPI.h"
 #import "IndexInfoModel.h"
 #import "NativeUrlRedirectAction.h"
+#import "ListDiff.h"
 
 @interface MyStockViewController () <MyStockTopViewDelegate>
 {
@@ -169,6 +170,7 @@
 - (void)requestFinished:(APIBaseRequest *)request {
     [_tableView.mj_header endRefreshing];
     
+    NSArray *oldArray = [_resultListArray copy];
     [_resultListArray removeAllObjects];
     
     _array = [MTLJSONAdapter modelsOfClass:[StockListModel class] fromJSONArray:_myStockInfoAPI.responseJSONObject error:nil];
@@ -177,7 +179,8 @@
     
     [self sortStock:nil];
     
-    [_tableView reloadData];
+    //定时刷新大多只有价格变化，不整表 reload
+    [self private_applyDiffFromArray:oldArray];
     _isRefreshing = NO;
 }
 
@@ -256,17 +259,21 @@
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath {
     static NSString *cellid = @"stockTableViewCell";
-    StockTableViewCell *cell = [tableView cellForRowAtIndexPath:indexPath];
+    StockTableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:cellid];
     
     if (cell == nil) {
         cell = [[StockTableViewCell alloc] initWithStyle:UITableViewCellStyleDefault reuseIdentifier:cellid];
     }
     
-    NSInteger row = [indexPath row];
+    [self private_configureCell:cell row:[indexPath row]];
     
+    return cell;
+}
+
+- (void)private_configureCell:(StockTableViewCell *)cell row:(NSInteger)row {
     if([_resultListArray count] <= row) {
         [cell setCode:@"--" name:@"--" value:@"--" changeRate:@"--" marketCd:@"--"];
-        return cell;
+        return;
     }
     
     StockListModel *model = [_resultListArray objectAtIndex:row];
@@ -283,8 +290,6 @@
     }
     
     [cell setCode:code name:model.symbolName value:[SystemUtil get2decimal:[model.consecutivePresentPrice doubleValue]] changeRate:increase marketCd:model.marketCd];
-    
-    return cell;
 }
 
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath {
@@ -322,6 +327,7 @@
         model.symbolTyp = item.symbolTyp;
         
         viewController.stockListModel = model;
+        viewController.neighbourStocks = [StockChartViewController neighboursOfIndex:indexPath.row inList:_resultListArray];
         [appDelegate.navigationController pushViewController:viewController animated:YES];
     }
 }
@@ -335,9 +341,20 @@
 - (void)myStockTitle:(MyStockTitle *)cell sortType:(STOCK_SORT_STATE)type {
     _sortState = type;
     
+    NSArray *oldArray = [_resultListArray copy];
     [self sortStock:_array];
     
-    [_tableView reloadData];
+    //切换排序只是行移动
+    [self private_applyDiffFromArray:oldArray];
+}
+
+- (void)private_applyDiffFromArray:(NSArray *)oldArray {
+    ListDiffResult *diff = [ListDiff diffFromArray:oldArray toArray:_resultListArray identifier:^id<NSCopying>(StockListModel *model) {
+        return model.stockIdentifier;
+    }];
+    [diff applyToTableView:_tableView section:0 reconfigure:^(UITableViewCell *cell, NSIndexPath *indexPath) {
+        [self private_configureCell:(StockTableViewCell *)cell row:indexPath.row];
+    }];
 }
 
 - (void)sortStock:(NSArray *)array {
@@ -31,6 +31,7 @@
 #import "IndexViewController.h"
 #import "BoardViewController.h"
 #import "BoardDetailListViewController.h"
+#import "ListDiff.h"
 
 @interface QuotationViewController ()<PlateRankViewDelegate>
 {
@@ -59,6 +60,12 @@
     NSMutableArray *_5minRankListArray;
     NSMutableArray *_volumeRankListArray;
     NSMutableArray *_turnoverRankListArray;
+    
+    //五个榜单各自返回，同一帧内到达的合并成一次刷新
+    NSMutableDictionary<NSNumber *, NSArray *> *_pendingRankLists;
+    ListUpdateCoalescer *_rankUpdateCoalescer;
+    //cell -> @[row, index]，刷新时只重填内容有变化的 cell
+    NSMapTable<UITableViewCell *, NSArray *> *_subRowSlots;
 }
 @end
 
@@ -255,6 +262,13 @@
     _volumeRankListArray = [[NSMutableArray alloc] init];
     _turnoverRankListArray = [[NSMutableArray alloc] init];
     
+    _pendingRankLists = [[NSMutableDictionary alloc] init];
+    _subRowSlots = [NSMapTable weakToStrongObjectsMapTable];
+    __weak typeof(self) weakSelf = self;
+    _rankUpdateCoalescer = [[ListUpdateCoalescer alloc] initWithBlock:^{
+        [weakSelf private_applyPendingRankLists];
+    }];
+    
     
     //    [_shIndex setCode:@"" title:@"上证指数" value:@"--.--" change:@"--.--" changeRate:@"--.--"];
     //    [_szIndex setCode:@"" title:@"创业板指" value:@"--.--" change:@"--.--" changeRate:@"--.--"];
@@ -391,76 +405,28 @@
     //cell.accessoryType = UITableViewCellAccessoryDisclosureIndicator;
     
     long index = indexPath.subRow-1;
-    StockListModel *model;
-    if (indexPath.row == 0)
-    {
-        if ([_zfRankListArray count]<5)
-        {
-            model = nil;
-        }
-        else
-        {
-            model = [_zfRankListArray objectAtIndex:index];
-        }
-    }
-    else if (indexPath.row == 1)
-    {
-        if ([_dfRankListArray count]<5)
-        {
-            model = nil;
-        }
-        else
-        {
-            model = [_dfRankListArray objectAtIndex:index];
-        }
-    }
-    else if (indexPath.row == 2)
-    {
-        if ([_5minRankListArray count]<5)
-        {
-            model = nil;
-        }
-        else
-        {
-            model = [_5minRankListArray objectAtIndex:index];
-        }
-    }
-    else if (indexPath.row == 3)
-    {
-        if ([_turnoverRankListArray count]<5)
-        {
-            model = nil;
-        }
-        else
-        {
-            model = [_turnoverRankListArray objectAtIndex:index];
-        }
-    }
-    else if (indexPath.row == 4)
-    {
-        if ([_volumeRankListArray count]<5)
-        {
-            model = nil;
-        }
-        else
-        {
-            model = [_volumeRankListArray objectAtIndex:index];
-        }
-    }
+    [_subRowSlots setObject:@[@(indexPath.row), @(index)] forKey:cell];
+    [self private_configureCell:cell row:indexPath.row index:index];
+    
+    return cell;
+}
+
+- (void)private_configureCell:(StockTableViewCell *)cell row:(NSInteger)row index:(NSInteger)index {
+    StockListModel *model = [self private_modelAtRow:row index:index];
     
     if (model) {
         
         [cell setCode:model.symbol name:model.symbolName value:model.consecutivePresentPrice changeRate:[SystemUtil getPercentage:[model.tradeIncrease doubleValue]] marketCd:model.marketCd];
         
-        if (indexPath.row == 3)
+        if (row == 3)
         {
             [cell setTurnover:model.turnover];
         }
-        else if(indexPath.row == 4)
+        else if(row == 4)
         {
             [cell setVoluem:model.volumePrice];
         }
-        else if(indexPath.row == 2)
+        else if(row == 2)
         {
             [cell setMin5UpDown:[SystemUtil getPercentage:[model.min5UpDown doubleValue]]];
         }
@@ -470,8 +436,32 @@
     {
         [cell setCode:@"--" name:@"--" value:@"--" changeRate:@"--" marketCd:@"--"];
     }
-    
-    return cell;
+}
+
+- (NSMutableArray *)private_rankListAtRow:(NSInteger)row {
+    switch (row) {
+        case 0:
+            return _zfRankListArray;
+        case 1:
+            return _dfRankListArray;
+        case 2:
+            return _5minRankListArray;
+        case 3:
+            return _turnoverRankListArray;
+        case 4:
+            return _volumeRankListArray;
+        default:
+            return nil;
+    }
+}
+
+//不满 5 条的榜单整组显示 --
+- (StockListModel *)private_modelAtRow:(NSInteger)row index:(NSInteger)index {
+    NSArray *array = [self private_rankListAtRow:row];
+    if ([array count] < 5 || index < 0 || index >= [array count]) {
+        return nil;
+    }
+    return [array objectAtIndex:index];
 }
 
 - (CGFloat)tableView:(SKSTableView *)tableView heightForRowAtIndexPath:(NSIndexPath *)indexPath {
@@ -492,64 +482,14 @@
     StockChartViewController *viewController = [[StockChartViewController alloc] init];
     AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
     
-    StockListModel *model;
-    long index = indexPath.subRow-1;
-    if (indexPath.row == 0) {
-        if ([_zfRankListArray count]<5)
-        {
-            model = nil;
-        }
-        else
-        {
-            model = [_zfRankListArray objectAtIndex:index];
-        }
-    }
-    else if (indexPath.row == 1) {
-        if ([_dfRankListArray count]<5)
-        {
-            model = nil;
-        }
-        else
-        {
-            model = [_dfRankListArray objectAtIndex:index];
-        }
-    }
-    else if (indexPath.row == 2) {
-        if ([_5minRankListArray count]<5)
-        {
-            model = nil;
-        }
-        else
-        {
-            model = [_5minRankListArray objectAtIndex:index];
-        }
-    }
-    else if (indexPath.row == 3) {
-        if ([_turnoverRankListArray count]<5)
-        {
-            model = nil;
-        }
-        else
-        {
-            model = [_turnoverRankListArray objectAtIndex:index];
-        }
-    }
-    else if (indexPath.row == 4) {
-        if ([_volumeRankListArray count]<5)
-        {
-            model = nil;
-        }
-        else
-        {
-            model = [_volumeRankListArray objectAtIndex:index];
-        }
-    }
+    StockListModel *model = [self private_modelAtRow:indexPath.row index:indexPath.subRow-1];
     
     if(model) {
         if (!(model.symbol && model.symbolTyp && model.marketCd && model.symbolName)) {
             return;
         }
         viewController.stockListModel = model;
+        viewController.neighbourStocks = [StockChartViewController neighboursOfIndex:indexPath.subRow-1 inList:[self private_rankListAtRow:indexPath.row]];
         [appDelegate.navigationController pushViewController:viewController animated:YES];
     }
     
@@ -600,11 +540,9 @@
 //    NSLog(@"%@",_zfRankListAPI.requestHeaderFieldValueDictionary);
     [_zfRankListAPI startWithCompletionBlockWithSuccess:^(APIBaseRequest *request) {
         NSArray *array = [_zfRankListAPI.responseJSONObject objectForKey:@"rankingLst"];
-        [_zfRankListArray removeAllObjects];
         NSArray *modelArray = [MTLJSONAdapter modelsOfClass:[StockListModel class] fromJSONArray:array error:nil];
-        [_zfRankListArray addObjectsFromArray:modelArray];
-        
-        [_tableview reloadData];
+        _pendingRankLists[@(0)] = modelArray ?: @[];
+        [_rankUpdateCoalescer setNeedsUpdate];
     } failure:^(APIBaseRequest *request) {
         NSLog(@"failed");
     }];
@@ -613,12 +551,9 @@
     _dfRankListAPI.ignoreCache = YES;
     [_dfRankListAPI startWithCompletionBlockWithSuccess:^(APIBaseRequest *request) {
         NSArray *array = [_dfRankListAPI.responseJSONObject objectForKey:@"rankingLst"];
-        [_dfRankListArray removeAllObjects];
         NSArray *modelArray = [MTLJSONAdapter modelsOfClass:[StockListModel class] fromJSONArray:array error:nil];
-        [_dfRankListArray addObjectsFromArray:modelArray];
-        
-        [_tableview reloadData];
-        
+        _pendingRankLists[@(1)] = modelArray ?: @[];
+        [_rankUpdateCoalescer setNeedsUpdate];
     } failure:^(APIBaseRequest *request) {
         NSLog(@"failed");
     }];
@@ -627,12 +562,9 @@
     _5minRankListAPI.ignoreCache = YES;
     [_5minRankListAPI startWithCompletionBlockWithSuccess:^(APIBaseRequest *request) {
         NSArray *array = [_5minRankListAPI.responseJSONObject objectForKey:@"rankingLst"];
-        [_5minRankListArray removeAllObjects];
         NSArray *modelArray = [MTLJSONAdapter modelsOfClass:[StockListModel class] fromJSONArray:array error:nil];
-        [_5minRankListArray addObjectsFromArray:modelArray];
-        
-        [_tableview reloadData];
-        
+        _pendingRankLists[@(2)] = modelArray ?: @[];
+        [_rankUpdateCoalescer setNeedsUpdate];
     } failure:^(APIBaseRequest *request) {
         NSLog(@"failed");
     }];
@@ -641,12 +573,9 @@
     _volumeRankListAPI.ignoreCache = YES;
     [_volumeRankListAPI startWithCompletionBlockWithSuccess:^(APIBaseRequest *request) {
         NSArray *array = [_volumeRankListAPI.responseJSONObject objectForKey:@"rankingLst"];
-        [_volumeRankListArray removeAllObjects];
         NSArray *modelArray = [MTLJSONAdapter modelsOfClass:[StockListModel class] fromJSONArray:array error:nil];
-        [_volumeRankListArray addObjectsFromArray:modelArray];
-        
-        [_tableview reloadData];
-        
+        _pendingRankLists[@(4)] = modelArray ?: @[];
+        [_rankUpdateCoalescer setNeedsUpdate];
     } failure:^(APIBaseRequest *request) {
         NSLog(@"failed");
     }];
@@ -655,12 +584,9 @@
     _turnoverRankListAPI.ignoreCache = YES;
     [_turnoverRankListAPI startWithCompletionBlockWithSuccess:^(APIBaseRequest *request) {
         NSArray *array = [_turnoverRankListAPI.responseJSONObject objectForKey:@"rankingLst"];
-        [_turnoverRankListArray removeAllObjects];
         NSArray *modelArray = [MTLJSONAdapter modelsOfClass:[StockListModel class] fromJSONArray:array error:nil];
-        [_turnoverRankListArray addObjectsFromArray:modelArray];
-        
-        [_tableview reloadData];
-        
+        _pendingRankLists[@(3)] = modelArray ?: @[];
+        [_rankUpdateCoalescer setNeedsUpdate];
     } failure:^(APIBaseRequest *request) {
         NSLog(@"failed");
     }];
@@ -731,6 +657,36 @@
     }];
 }
 
+- (void)private_applyPendingRankLists {
+    NSMutableDictionary<NSNumber *, NSIndexSet *> *changedSlots = [NSMutableDictionary dictionary];
+    [_pendingRankLists enumerateKeysAndObjectsUsingBlock:^(NSNumber *row, NSArray *newArray, BOOL *stop) {
+        NSMutableArray *rankList = [self private_rankListAtRow:row.integerValue];
+        BOOL oldFull = [rankList count] >= 5;
+        BOOL newFull = [newArray count] >= 5;
+        NSIndexSet *changed;
+        if (oldFull && newFull) {
+            changed = [ListDiff changedIndexesFromArray:[rankList subarrayWithRange:NSMakeRange(0, 5)] toArray:[newArray subarrayWithRange:NSMakeRange(0, 5)]];
+        } else if (oldFull != newFull) {
+            changed = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 5)];
+        }
+        [rankList setArray:newArray];
+        if (changed.count) {
+            changedSlots[row] = changed;
+        }
+    }];
+    [_pendingRankLists removeAllObjects];
+    
+    //五行五个子行位置固定，不做增删动画，只重填变化的 cell；页面不在前台时也要填，回来时不会再走 cellForSubRow
+    for (StockTableViewCell *cell in _subRowSlots.keyEnumerator.allObjects) {
+        NSArray *slot = [_subRowSlots objectForKey:cell];
+        NSInteger row = [slot[0] integerValue];
+        NSInteger index = [slot[1] integerValue];
+        if ([changedSlots[@(row)] containsIndex:index]) {
+            [self private_configureCell:cell row:row index:index];
+        }
+    }
+}
+
 #pragma IndexBlockDelegate
 - (void)indexBlock:(IndexBlock*)indexBlock code:(NSString *)code {
     
@@ -8,6 +8,7 @@
 
 #import "FeedChildListViewController.h"
 #import "MomentSecretTableViewCell.h"
+#import "FeedListLayout.h"
 #import "NewMomentViewController.h"
 #import "DetailWebViewController.h"
 #import "TalkNoticeViewController.h"
@@ -34,7 +35,6 @@ static NSString *cellid = @"MomentFeedSecretListCell";
 
 @interface FeedChildListViewController ()<UITableViewDelegate,UITableViewDataSource,UIViewControllerPreviewingDelegate,MomentSecretTableViewCellDelegate>
 
-@property (nonatomic, strong) MomentSecretTableViewCell *cell;
 
 @property (nonatomic, assign) BOOL isfirstLoad;
 
@@ -173,15 +173,19 @@ static NSString *cellid = @"MomentFeedSecretListCell";
     //解析出其他需要的数据
     
     NSArray *modelArray = [MTLJSONAdapter modelsOfClass:[FeedListModel class] fromJSONArray:array error:nil];
-    if (self.isfirstLoad) {
-        NSMutableArray *nmArr = [NSMutableArray arrayWithObject:self.model];
-        [nmArr addObjectsFromArray:modelArray];
-        self.dataArray = nmArr;
-        self.isfirstLoad = NO;
-    }else {
-        [self.dataArray addObjectsFromArray:modelArray];
-    }
-    [_tableView reloadData];
+    
+    //后台排版完整页再刷新，heightForRow 只取缓存的行高
+    [FeedListLayout layoutModels:modelArray style:FeedListLayoutStyleSecret width:MAIN_SCREEN_WIDTH completion:^{
+        if (self.isfirstLoad) {
+            NSMutableArray *nmArr = [NSMutableArray arrayWithObject:self.model];
+            [nmArr addObjectsFromArray:modelArray];
+            self.dataArray = nmArr;
+            self.isfirstLoad = NO;
+        }else {
+            [self.dataArray addObjectsFromArray:modelArray];
+        }
+        [_tableView reloadData];
+    }];
     
     if (count >= 10) {
         [_tableView.mj_header endRefreshing];
@@ -224,12 +228,7 @@ static NSString *cellid = @"MomentFeedSecretListCell";
 #pragma UITableView
 - (CGFloat)tableView:(UITableView *)tableView heightForRowAtIndexPath:(NSIndexPath *)indexPath {
     FeedListModel *model = self.dataArray[indexPath.row];
-    if (model.height != 0) {
-        return model.height;
-    }
-    CGFloat h = [self.cell getRowHeight:model];
-    model.height = h;
-    return h;
+    return [FeedListLayout layoutForModel:model style:FeedListLayoutStyleSecret width:MAIN_SCREEN_WIDTH].height;
 }
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
@@ -301,12 +300,5 @@ static NSString *cellid = @"MomentFeedSecretListCell";
     return _listAPI;
 }
 
-- (MomentSecretTableViewCell *)cell {
-    if (_cell == nil) {
-        _cell = [MomentSecretTableViewCell new];
-    }
-    return _cell;
-}
-
 
 @end
@@ -9,6 +9,7 @@
 #import "MomentSecretViewController.h"
 #import "FeedChildListViewController.h"
 #import "MomentSecretTableViewCell.h"
+#import "FeedListLayout.h"
 #import "NewMomentViewController.h"
 #import "DetailWebViewController.h"
 #import "TalkNoticeViewController.h"
@@ -36,7 +37,6 @@ static NSString *cellid = @"MomentFeedSecretListCell";
 
 @interface MomentSecretViewController ()<UITableViewDelegate,UITableViewDataSource,UIViewControllerPreviewingDelegate,MomentSecretTableViewCellDelegate>
 
-@property (nonatomic, strong) MomentSecretTableViewCell *cell;
 
 @property (nonatomic, assign) BOOL isfirstLoad;
 
@@ -197,13 +197,17 @@ static NSString *cellid = @"MomentFeedSecretListCell";
     //解析出其他需要的数据
     
     NSArray *modelArray = [MTLJSONAdapter modelsOfClass:[FeedListModel class] fromJSONArray:array error:nil];
-    if (self.isfirstLoad) {
-        self.dataArray = [NSMutableArray arrayWithArray:modelArray];
-        self.isfirstLoad = NO;
-    }else {
-        [self.dataArray addObjectsFromArray:modelArray];
-    }
-    [_tableView reloadData];
+    
+    //后台排版完整页再刷新，heightForRow 只取缓存的行高
+    [FeedListLayout layoutModels:modelArray style:FeedListLayoutStyleSecret width:MAIN_SCREEN_WIDTH completion:^{
+        if (self.isfirstLoad) {
+            self.dataArray = [NSMutableArray arrayWithArray:modelArray];
+            self.isfirstLoad = NO;
+        }else {
+            [self.dataArray addObjectsFromArray:modelArray];
+        }
+        [_tableView reloadData];
+    }];
     
     if (count >= 10) {
         [_tableView.mj_header endRefreshing];
@@ -246,12 +250,7 @@ static NSString *cellid = @"MomentFeedSecretListCell";
 #pragma UITableView
 - (CGFloat)tableView:(UITableView *)tableView heightForRowAtIndexPath:(NSIndexPath *)indexPath {
     FeedListModel *model = self.dataArray[indexPath.row];
-    if (model.height != 0) {
-        return model.height;
-    }
-    CGFloat h = [self.cell getRowHeight:model];
-    model.height = h;
-    return h;
+    return [FeedListLayout layoutForModel:model style:FeedListLayoutStyleSecret width:MAIN_SCREEN_WIDTH].height;
 }
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
@@ -337,13 +336,6 @@ static NSString *cellid = @"MomentFeedSecretListCell";
     return _listAPI;
 }
 
-- (MomentSecretTableViewCell *)cell {
-    if (_cell == nil) {
-        _cell = [MomentSecretTableViewCell new];
-    }
-    return _cell;
-}
-
 - (UIView *)topNoticeView {
     if (_topNoticeView == nil) {
         _topNoticeView = [[UIView alloc] initWithFrame:CGRectMake(0, 64, MAIN_SCREEN_WIDTH, 80 * kScale)];
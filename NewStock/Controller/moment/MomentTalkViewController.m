@@ -21,6 +21,7 @@
 #import "MomentListAPI.h"
 #import "UserFollowedAPI.h"
 #import "FeedListModel.h"
+#import "FeedListLayout.h"
 #import "MomentFeedListCell.h"
 #import "MomentFeedListTopCell.h"
 
@@ -33,8 +34,6 @@ static NSString *topCellId = @"momentFeedListTopCell";
 
 @interface MomentTalkViewController ()<UITableViewDelegate,UITableViewDataSource,UIViewControllerPreviewingDelegate>
 
-@property (nonatomic, strong) MomentFeedListCell *cell;
-
 @property (nonatomic, assign) BOOL isfirstLoad;
 
 @property (nonatomic, strong) UITableView *tableView;
@@ -206,22 +205,26 @@ static NSString *topCellId = @"momentFeedListTopCell";
     //解析出其他需要的数据
     
     NSArray *modelArray = [MTLJSONAdapter modelsOfClass:[FeedListModel class] fromJSONArray:array error:nil];
-    if (self.isfirstLoad) {
-        self.dataArray = [NSMutableArray arrayWithArray:modelArray];
-        self.isfirstLoad = NO;
-    } else {
-        [self.dataArray addObjectsFromArray:modelArray];
-    }
     
-    if (count >= 20) {
-        [_tableView.mj_header endRefreshing];
-        [_tableView.mj_footer endRefreshing];
-    } else {
-        [_tableView.mj_header endRefreshing];
-        [_tableView.mj_footer endRefreshingWithNoMoreData];
-    }
-    
-    [_tableView reloadData];
+    //后台排版完整页再刷新，heightForRow 只取缓存的行高
+    [FeedListLayout layoutModels:modelArray style:FeedListLayoutStyleTalk width:MAIN_SCREEN_WIDTH completion:^{
+        if (self.isfirstLoad) {
+            self.dataArray = [NSMutableArray arrayWithArray:modelArray];
+            self.isfirstLoad = NO;
+        } else {
+            [self.dataArray addObjectsFromArray:modelArray];
+        }
+        
+        if (count >= 20) {
+            [_tableView.mj_header endRefreshing];
+            [_tableView.mj_footer endRefreshing];
+        } else {
+            [_tableView.mj_header endRefreshing];
+            [_tableView.mj_footer endRefreshingWithNoMoreData];
+        }
+        
+        [_tableView reloadData];
+    }];
 }
 
 - (void)requestFailed:(APIBaseRequest *)request {
@@ -261,12 +264,7 @@ static NSString *topCellId = @"momentFeedListTopCell";
         return 36 * kScale;
     }
     
-    self.cell.model = model;
-    [self.cell.contentView layoutIfNeeded];
-
-    UIView *ico = [self.cell valueForKeyPath:@"_readCountLb"];
-    CGFloat y = CGRectGetMaxY(ico.frame);
-    return y + 12 * kScale;
+    return [FeedListLayout layoutForModel:model style:FeedListLayoutStyleTalk width:MAIN_SCREEN_WIDTH].height;
 }
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
@@ -361,13 +359,6 @@ static NSString *topCellId = @"momentFeedListTopCell";
     return _listAPI;
 }
 
-- (MomentFeedListCell *)cell {
-    if (_cell == nil) {
-        _cell = [MomentFeedListCell new];
-    }
-    return _cell;
-}
-
 - (UIView *)topNoticeView {
     if (_topNoticeView == nil) {
         _topNoticeView = [[UIView alloc] initWithFrame:CGRectMake(0, 64, MAIN_SCREEN_WIDTH, 80 * kScale)];
@@ -12,13 +12,15 @@
 #import "WXTabBarController.h"
 #import "AppDelegate.h"
 #import "PostFeedAPI.h"
-#import "PostFeedPicAPI.h"
+#import "PostImageUploader.h"
+#import "MBProgressHUD.h"
 #import "UserInfoInstance.h"
 #import <UIImageView+WebCache.h>
 
 #import "EmotionKeyboardView.h"
 #import "EmotionButton.h"
 #import "EmotionAttachment.h"
+#import "EmotionManager.h"
 
 
 @interface PostSecretViewController ()<UITextViewDelegate, UIActionSheetDelegate, UIImagePickerControllerDelegate, UINavigationControllerDelegate>
@@ -27,7 +29,7 @@
 @property (nonatomic) UILabel *lb_contentPlaceHolder; //content 占位文本
 @property (nonatomic) UIView *input_view; // 键盘 inputacessaryView
 @property (nonatomic, strong) PostFeedAPI *postFeedAPI;
-@property (nonatomic, strong) PostFeedPicAPI *postFeedPicAPI;
+@property (nonatomic, strong) PostImageUploader *imageUploader;
 @property (nonatomic, strong) EmotionKeyboardView *keyboardView;
 @property (nonatomic, strong) UIButton *btn;
 
@@ -263,8 +265,7 @@
     if (self.imageView.image == nil) {
         [self postContentWithImg];
     } else {
-        self.postFeedPicAPI.imageArray = @[self.imageView.image];
-        [self.postFeedPicAPI start];
+        [self uploadImage:self.imageView.image];
     }
 }
 
@@ -387,20 +388,37 @@
 
 #pragma mark request  post
 
-- (void)postContentWithImg {
-    
-    NSMutableString *nmStr = [[NSMutableString alloc] init];
-    
-    [_contentTV.attributedText enumerateAttributesInRange:NSMakeRange(0, _contentTV.attributedText.length) options:0 usingBlock:^(NSDictionary<NSString *,id> * _Nonnull attrs, NSRange range, BOOL * _Nonnull stop) {
-        EmotionAttachment *attach = attrs[@"NSAttachment"];
-        if ([attach isKindOfClass:[EmotionAttachment class]]) {
-            [nmStr appendString:attach.chs];
-        } else {
-            [nmStr appendString:[_contentTV.text substringWithRange:range]];
+//编码后上传，进度显示在 HUD 上；同一张图片之前传过时直接复用结果
+- (void)uploadImage:(UIImage *)image {
+    MBProgressHUD *hud = [MBProgressHUD showHUDAddedTo:self.view animated:YES];
+    hud.mode = MBProgressHUDModeDeterminate;
+    hud.labelText = @"正在上传图片";
+    
+    __weak typeof(self) weakSelf = self;
+    [[UploadImageEncoder sharedUploadImageEncoder] encodeImages:@[image] maxPixel:kUploadImagePostMaxPixel quality:0.7 completion:^(NSArray<UploadImageFile *> *files) {
+        if (files == nil || weakSelf == nil) {
+            [hud hide:YES];
+            return;
         }
+        weakSelf.imageUploader.progressBlock = ^(NSUInteger index, float progress) {
+            hud.progress = progress;
+        };
+        [weakSelf.imageUploader uploadFiles:files completion:^(NSArray<NSDictionary *> *responses, NSError *error) {
+            [hud hide:YES];
+            if (responses == nil) {
+                UIAlertView *alert = [[UIAlertView alloc] initWithTitle:@"提示" message:@"图片上传失败，请重试" delegate:nil cancelButtonTitle:@"确定" otherButtonTitles: nil];
+                [alert show];
+                return;
+            }
+            weakSelf.imageResponse = responses.firstObject;
+            [weakSelf postContentWithImg];
+        }];
     }];
+}
+
+- (void)postContentWithImg {
     
-    self.postFeedAPI.c = nmStr;
+    self.postFeedAPI.c = [[EmotionManager sharedEmotionManager] plainStringFromAttributedString:_contentTV.attributedText];
     
     if (self.imageView.image != nil) {
         self.postFeedAPI.imgs = @[self.imageResponse];
@@ -414,20 +432,8 @@
     if (tt.length < 5) {
         return @"";
     }
-    NSMutableAttributedString *nmAttrS = [[NSMutableAttributedString alloc] initWithAttributedString:tt];
-    NSMutableString *nmTt = [NSMutableString string];
-    NSAttributedString *subStr = [nmAttrS attributedSubstringFromRange:NSMakeRange(0, 5)];
-    
-    [subStr enumerateAttributesInRange:NSMakeRange(0, subStr.length) options:0 usingBlock:^(NSDictionary<NSString *,id> * _Nonnull attrs, NSRange range, BOOL * _Nonnull stop) {
-        EmotionAttachment *attach = attrs[@"NSAttachment"];
-        if ([attach isKindOfClass:[EmotionAttachment class]]) {
-            [nmTt appendString:attach.chs];
-        } else {
-            [nmTt appendString:[_contentTV.text substringWithRange:range]];
-        }
-    }];
-    
-    return nmTt;
+    NSAttributedString *subStr = [tt attributedSubstringFromRange:NSMakeRange(0, 5)];
+    return [[EmotionManager sharedEmotionManager] plainStringFromAttributedString:subStr];
 }
 
 - (void)requestFailed:(APIBaseRequest *)request {
@@ -438,12 +444,6 @@
 - (void)requestFinished:(APIBaseRequest *)request {
     NSLog(@"%@",request.responseJSONObject);
 
-    if (request == _postFeedPicAPI) {
-        self.imageResponse = request.responseJSONObject;
-        [self postContentWithImg];
-        return;
-    }
-    
     [self.view endEditing:YES];
     [self dismissViewControllerAnimated:YES completion:^{
         [UserInfoInstance sharedUserInfoInstance].postSecretImage = nil;
@@ -526,14 +526,11 @@
     return _input_view;
 }
 
-- (PostFeedPicAPI *)postFeedPicAPI {
-    if (_postFeedPicAPI == nil) {
-        _postFeedPicAPI = [PostFeedPicAPI new];
-        _postFeedPicAPI.animatingView = self.view;
-        _postFeedPicAPI.animatingText = @"数据提交中";
-        _postFeedPicAPI.delegate = self;
+- (PostImageUploader *)imageUploader {
+    if (_imageUploader == nil) {
+        _imageUploader = [PostImageUploader new];
     }
-    return _postFeedPicAPI;
+    return _imageUploader;
 }
 
 - (PostFeedAPI *)postFeedAPI {
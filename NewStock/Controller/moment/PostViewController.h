@@ -8,13 +8,13 @@
 
 #import "BaseViewController.h"
 #import "PostFeedAPI.h"
-#import "PostFeedPicAPI.h"
+#import "PostImageUploader.h"
 #import "GCPlaceholderTextView.h"
 
 @interface PostViewController : BaseViewController<UIActionSheetDelegate,UITextViewDelegate,UIGestureRecognizerDelegate>
 {
     PostFeedAPI *_postFeedAPI;
-    PostFeedPicAPI *_postFeedPicAPI;
+    PostImageUploader *_imageUploader;
     
     GCPlaceholderTextView *_titleTV;
     GCPlaceholderTextView *_contentTV;
@@ -10,6 +10,7 @@
 #import <SDWebImageDownloader.h>
 #import "AppDelegate.h"
 #import "NewMomentViewController.h"
+#import "MBProgressHUD.h"
 
 #define color_noSelected [UIColor colorWithRed:243/255.0 green:243/255.0 blue:243/255.0 alpha:1]
 #define color_selected [UIColor colorWithRed:53/255.0 green:142/255.0 blue:231/255.0 alpha:1]
@@ -41,6 +42,10 @@
 
 @property (nonatomic) UIButton *img_btn; //全局 imgbtn
 
+@property (nonatomic) NSArray<UploadImageFile *> *upload_files; //编码好的待上传图片
+
+@property (nonatomic) MBProgressHUD *uploadHUD; //图片上传进度
+
 //@property (nonatomic, assign) NSInteger totalImgLength; //保存所有图片大小和
 
 @end
@@ -256,9 +261,7 @@
     
     _ams = @"N";
     
-    _postFeedPicAPI = [PostFeedPicAPI new];
-    _postFeedPicAPI.animatingView = _mainView;
-    _postFeedPicAPI.animatingText = @"数据提交中";
+    _imageUploader = [PostImageUploader new];
     
     _postFeedAPI = [[PostFeedAPI alloc] init];
     _postFeedAPI.animatingView = _mainView;
@@ -288,15 +291,13 @@
     }
     
     if ([SystemUtil isSignIn] && !_isPosting) {
-        _postFeedPicAPI.delegate = self;
-        _postFeedPicAPI.imageArray = self.image_array;
         _isPosting = YES;
         if (self.image_array.count) {
             [self isOutTenM:^(BOOL b) {
                 if (b) {
                     return;
                 }else {
-                    [_postFeedPicAPI start];
+                    [self uploadImages];
                 }
             }];
         }else {
@@ -331,26 +332,40 @@
     }];
 }
 
-- (void)requestFinished:(APIBaseRequest *)request {
-    
-    NSLog(@"succeed:%@",request.responseJSONObject);
-    
-    if ([request.responseJSONObject isKindOfClass:[NSArray class]]) {
-        NSInteger index = 0;
-        for (NSDictionary *dict in request.responseJSONObject) {
-            UIImage *image = self.image_array[index];
-            NSString *str = [NSString stringWithFormat:@"<img src=\"%@\" alt=\"\" width=\"%lf\" height=\"%lf\" />",dict[@"origin"],image.size.width,image.size.height];
-            [self.imageUrl_array addObject:str];
-            index ++;
-        }
-    }else {
-        NSDictionary *dict = request.responseJSONObject;
-        if ([dict.allKeys containsObject:@"origin"]) {
-            UIImage *image = self.image_array[0];
-            NSString *str = [NSString stringWithFormat:@"<img src=\"%@\" alt=\"\" width=\"%lf\" height=\"%lf\" />",dict[@"origin"],image.size.width,image.size.height];
-            [self.imageUrl_array addObject:str];
+//逐张并发上传，失败的单张重传，进度显示在 HUD 上
+- (void)uploadImages {
+    self.uploadHUD = [MBProgressHUD showHUDAddedTo:_mainView animated:YES];
+    self.uploadHUD.mode = MBProgressHUDModeDeterminate;
+    self.uploadHUD.labelText = [NSString stringWithFormat:@"正在上传图片 0/%zd", self.upload_files.count];
+    
+    __weak typeof(self) weakSelf = self;
+    __weak PostImageUploader *uploader = _imageUploader;
+    _imageUploader.progressBlock = ^(NSUInteger index, float progress) {
+        weakSelf.uploadHUD.progress = uploader.progress;
+        weakSelf.uploadHUD.labelText = [NSString stringWithFormat:@"正在上传图片 %zd/%zd", uploader.finishedCount, weakSelf.upload_files.count];
+    };
+    [_imageUploader uploadFiles:self.upload_files completion:^(NSArray<NSDictionary *> *responses, NSError *error) {
+        [weakSelf.uploadHUD hide:YES];
+        weakSelf.uploadHUD = nil;
+        if (responses == nil) {
+            UIAlertView *alert = [[UIAlertView alloc] initWithTitle:@"提示" message:@"图片上传失败，请重试" delegate:nil cancelButtonTitle:@"确定" otherButtonTitles: nil];
+            [alert show];
+            weakSelf.isPosting = NO;
+            weakSelf.isSaveContent = NO;
+            return;
         }
-    }
+        [weakSelf didUploadImages:responses];
+    }];
+}
+
+- (void)didUploadImages:(NSArray<NSDictionary *> *)responses {
+    
+    self.upload_files = nil;
+    [responses enumerateObjectsUsingBlock:^(NSDictionary *dict, NSUInteger index, BOOL *stop) {
+        UIImage *image = self.image_array[index];
+        NSString *str = [NSString stringWithFormat:@"<img src=\"%@\" alt=\"\" width=\"%lf\" height=\"%lf\" />",dict[@"origin"],image.size.width,image.size.height];
+        [self.imageUrl_array addObject:str];
+    }];
     
     if (_isSaveContent) {
         
@@ -369,10 +384,12 @@
         return;
     }
     
-    if (self.imageUrl_array.count && _isSaveContent == NO) {
-        [self postContestAndImages:YES];
-        return;
-    }
+    [self postContestAndImages:YES];
+}
+
+- (void)requestFinished:(APIBaseRequest *)request {
+    
+    NSLog(@"succeed:%@",request.responseJSONObject);
     
 //    UIAlertView *alertView = [[UIAlertView alloc] initWithTitle:@"提示" message:@"提交成功！" delegate:self cancelButtonTitle:@"确定" otherButtonTitles:nil];
 //    alertView.tag = 1001;
@@ -544,10 +561,8 @@
                         if (b) {
                             return ;
                         }else {
-                            _postFeedPicAPI.delegate = self;
-                            _postFeedPicAPI.imageArray = self.image_array;
                             _isSaveContent = YES;
-                            [_postFeedPicAPI start];
+                            [self uploadImages];
                         }
                     }];
 
@@ -783,26 +798,27 @@
     return imageText;
 }
 
+//在后台把图片编码成待上传的文件，总大小检查和上传用同一份编码
 - (void)isOutTenM:(void(^)(BOOL))block {
     
-    __block NSInteger totalLength = 0;
-    dispatch_async(dispatch_get_global_queue(0, 0), ^{
-        
-        for (UIImage *img in self.image_array) {
-            totalLength += UIImageJPEGRepresentation(img, 0.7).length;
+    [[UploadImageEncoder sharedUploadImageEncoder] encodeImages:self.image_array maxPixel:kUploadImagePostMaxPixel quality:0.7 completion:^(NSArray<UploadImageFile *> *files) {
+        NSString *message = nil;
+        if (files == nil) {
+            message = @"图片处理失败";
+        } else if (([UploadImageEncoder totalLengthOfFiles:files] / 1024 / 1024) > 10) {
+            message = @"图片总大小不能超过10M";
         }
-        dispatch_async(dispatch_get_main_queue(), ^{
-            if ((totalLength / 1024 / 1024) > 10) {
-                UIAlertView *alert = [[UIAlertView alloc] initWithTitle:@"提示" message:@"图片总大小不能超过10M" delegate:nil cancelButtonTitle:@"确定" otherButtonTitles: nil];
-                [alert show];
-                _isPosting = NO;
-                block(YES);
-            }else {
-                block(NO);
-            }
-        });
-
-    });
+        if (message) {
+            UIAlertView *alert = [[UIAlertView alloc] initWithTitle:@"提示" message:message delegate:nil cancelButtonTitle:@"确定" otherButtonTitles: nil];
+            [alert show];
+            self.upload_files = nil;
+            _isPosting = NO;
+            block(YES);
+        }else {
+            self.upload_files = files;
+            block(NO);
+        }
+    }];
 
 }
 
@@ -30,4 +30,7 @@
 @property (nonatomic, strong) NSString * fallCount;
 @property (nonatomic, strong) NSString * keepCount;
 
+//市场+代码，列表 diff 时用来认出同一只股票
+- (NSString *)stockIdentifier;
+
 @end
@@ -31,4 +31,8 @@
              };
 }
 
+- (NSString *)stockIdentifier {
+    return [NSString stringWithFormat:@"%@.%@", _marketCd ?: @"", _symbol ?: @""];
+}
+
 @end
@@ -0,0 +1,71 @@
+//
+//  FeedListLayout.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <YYText/YYText.h>
+@class FeedListModel;
+
+//正文股票高亮 YYTextHighlight.userInfo 中的 StockCodeInfo
+extern NSString * const FeedListLayoutStockKey;
+
+typedef NS_ENUM(NSInteger, FeedListLayoutStyle) {
+    FeedListLayoutStyleTalk = 0,    //论股堂 MomentFeedListCell
+    FeedListLayoutStyleSecret,      //秘密 MomentSecretTableViewCell
+};
+
+/**
+ *  帖子列表一行的排版结果
+ *
+ *  文字排版、图片尺寸和行高一次算好，缓存在 FeedListModel.layout 上，
+ *  heightForRow 和 cell 赋值都只读这里的结果，不再在主线程排版。
+ *  只读，可以在任意线程创建。
+ */
+@interface FeedListLayout : NSObject
+
+@property (nonatomic, assign, readonly) FeedListLayoutStyle style;
+
+/**
+ *  排版时的 cell 宽度
+ */
+@property (nonatomic, assign, readonly) CGFloat width;
+
+/**
+ *  标题，只有论股堂有；标题为空时为 nil，高度为 0
+ */
+@property (nonatomic, strong, readonly) YYTextLayout *titleLayout;
+@property (nonatomic, assign, readonly) CGFloat titleHeight;
+
+/**
+ *  正文，码表中的股票名称、代码已加高亮，点击由 cell 的 highlightTapAction 处理
+ */
+@property (nonatomic, strong, readonly) YYTextLayout *contentLayout;
+@property (nonatomic, assign, readonly) CGFloat contentHeight;
+
+/**
+ *  配图地址，没有配图为 nil
+ */
+@property (nonatomic, copy, readonly) NSString *imageURL;
+@property (nonatomic, assign, readonly) CGSize imageSize;
+
+/**
+ *  行高
+ */
+@property (nonatomic, assign, readonly) CGFloat height;
+
+//样式、宽度一致且排版后码表没有更新
+- (BOOL)matchesStyle:(FeedListLayoutStyle)style width:(CGFloat)width;
+
++ (instancetype)layoutWithModel:(FeedListModel *)model style:(FeedListLayoutStyle)style width:(CGFloat)width;
+
+//取 model 上缓存的排版，样式或宽度不一致时在当前线程重排并缓存；只在主线程调用
++ (instancetype)layoutForModel:(FeedListModel *)model style:(FeedListLayoutStyle)style width:(CGFloat)width;
+
+//在后台排版整页数据，完成后在主线程写入各 model.layout 再回调
++ (void)layoutModels:(NSArray<FeedListModel *> *)models style:(FeedListLayoutStyle)style width:(CGFloat)width completion:(dispatch_block_t)completion;
+
+@end
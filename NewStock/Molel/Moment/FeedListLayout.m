@@ -0,0 +1,251 @@
+//
+//  FeedListLayout.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "FeedListLayout.h"
+#import "FeedListModel.h"
+#import "EmotionManager.h"
+#import "Defination.h"
+#import "StockMentionMatcher.h"
+
+NSString * const FeedListLayoutStockKey = @"stock";
+
+@interface FeedListLayout ()
+
+@property (nonatomic, assign, readwrite) FeedListLayoutStyle style;
+@property (nonatomic, assign, readwrite) CGFloat width;
+@property (nonatomic, strong, readwrite) YYTextLayout *titleLayout;
+@property (nonatomic, assign, readwrite) CGFloat titleHeight;
+@property (nonatomic, strong, readwrite) YYTextLayout *contentLayout;
+@property (nonatomic, assign, readwrite) CGFloat contentHeight;
+@property (nonatomic, copy, readwrite) NSString *imageURL;
+@property (nonatomic, assign, readwrite) CGSize imageSize;
+@property (nonatomic, assign, readwrite) CGFloat height;
+
+//排版时的 StockMentionMatcher.generation
+@property (nonatomic, assign) NSUInteger stockGeneration;
+
+@end
+
+@implementation FeedListLayout
+
++ (dispatch_queue_t)private_layoutQueue {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        //串行，先到的页先排完
+        queue = dispatch_queue_create("com.newstock.feedlayout", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
+}
+
++ (instancetype)layoutWithModel:(FeedListModel *)model style:(FeedListLayoutStyle)style width:(CGFloat)width {
+    if (model == nil) {
+        return nil;
+    }
+    FeedListLayout *layout = [FeedListLayout new];
+    layout.style = style;
+    layout.width = width;
+    layout.stockGeneration = [StockMentionMatcher sharedStockMentionMatcher].generation;
+    if (style == FeedListLayoutStyleTalk) {
+        [layout private_layoutTalkWithModel:model];
+    } else {
+        [layout private_layoutSecretWithModel:model];
+    }
+    return layout;
+}
+
++ (instancetype)layoutForModel:(FeedListModel *)model style:(FeedListLayoutStyle)style width:(CGFloat)width {
+    if (![model.layout matchesStyle:style width:width]) {
+        model.layout = [self layoutWithModel:model style:style width:width];
+    }
+    return model.layout;
+}
+
++ (void)layoutModels:(NSArray<FeedListModel *> *)models style:(FeedListLayoutStyle)style width:(CGFloat)width completion:(dispatch_block_t)completion {
+    NSArray *pending = [models copy];
+    dispatch_async([self private_layoutQueue], ^{
+        NSMutableArray *layouts = [NSMutableArray arrayWithCapacity:pending.count];
+        for (FeedListModel *model in pending) {
+            [layouts addObject:[self layoutWithModel:model style:style width:width] ?: [NSNull null]];
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [pending enumerateObjectsUsingBlock:^(FeedListModel *model, NSUInteger idx, BOOL *stop) {
+                if (layouts[idx] != [NSNull null]) {
+                    model.layout = layouts[idx];
+                }
+            }];
+            if (completion) {
+                completion();
+            }
+        });
+    });
+}
+
+- (BOOL)matchesStyle:(FeedListLayoutStyle)style width:(CGFloat)width {
+    return self.style == style && ABS(self.width - width) < 0.5
+        && self.stockGeneration == [StockMentionMatcher sharedStockMentionMatcher].generation;
+}
+
+#pragma mark 论股堂
+
+- (void)private_layoutTalkWithModel:(FeedListModel *)model {
+    CGFloat textWidth = self.width - 24 * kScale;
+
+    //正文里的 <img> 取第一张做配图，其余去掉
+    NSString *content = model.c ?: @"";
+    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:@"<img src=\"(.*?)\".*?/>" options:0 error:nil];
+    if (model.imgs.count) {
+        self.imageURL = model.imgs[0][@"origin"];
+    } else {
+        NSTextCheckingResult *res = [regex firstMatchInString:content options:0 range:NSMakeRange(0, content.length)];
+        if (res) {
+            self.imageURL = [content substringWithRange:[res rangeAtIndex:1]];
+        }
+    }
+    content = [regex stringByReplacingMatchesInString:content options:0 range:NSMakeRange(0, content.length) withTemplate:@""];
+
+    NSString *tt = [model.tt stringByReplacingOccurrencesOfString:@" " withString:@""];
+    tt = [tt stringByReplacingOccurrencesOfString:@"\n" withString:@""];
+    if (tt.length) {
+        UIFont *font = [UIFont boldSystemFontOfSize:18 * kScale];
+        NSMutableParagraphStyle *para = [[NSMutableParagraphStyle alloc] init];
+        CGFloat width = [model.tt boundingRectWithSize:CGSizeMake(MAXFLOAT, font.lineHeight) options:1 attributes:@{NSFontAttributeName : font} context:nil].size.width;
+        para.lineSpacing = width > textWidth ? 4 * kScale : 0;
+
+        NSMutableAttributedString *title = [[NSMutableAttributedString alloc] initWithString:model.tt attributes:@{NSFontAttributeName : font, NSForegroundColorAttributeName : kUIColorFromRGB(0x333333), NSParagraphStyleAttributeName : para}];
+        //1 精 2 热 3 热+精
+        NSInteger tag = model.tag.integerValue;
+        if (tag == 2 || tag == 3) {
+            [title appendAttributedString:[FeedListLayout private_tagAttachmentNamed:@"ic_forum_hot" font:font]];
+        }
+        if (tag == 1 || tag == 3) {
+            [title appendAttributedString:[FeedListLayout private_tagAttachmentNamed:@"ic_forum_jing" font:font]];
+        }
+
+        YYTextContainer *container = [YYTextContainer containerWithSize:CGSizeMake(textWidth, CGFLOAT_MAX)];
+        container.maximumNumberOfRows = 2;
+        container.truncationType = YYTextTruncationTypeEnd;
+        self.titleLayout = [YYTextLayout layoutWithContainer:container text:title];
+        self.titleHeight = self.titleLayout.textBoundingSize.height;
+    }
+
+    if (content.length > 80) {
+        content = [content substringToIndex:80];
+    }
+    if (content.length) {
+        UIFont *font = [UIFont systemFontOfSize:15 * kScale];
+        NSMutableAttributedString *text = [[NSMutableAttributedString alloc] initWithString:content attributes:@{NSFontAttributeName : font, NSForegroundColorAttributeName : kUIColorFromRGB(0x808080)}];
+        [FeedListLayout private_highlightStocksInText:text plainString:content];
+
+        YYTextContainer *container = [YYTextContainer containerWithSize:CGSizeMake(textWidth, CGFLOAT_MAX)];
+        container.maximumNumberOfRows = 3;
+        YYTextLinePositionSimpleModifier *modifier = [YYTextLinePositionSimpleModifier new];
+        modifier.fixedLineHeight = font.lineHeight + 2;
+        container.linePositionModifier = modifier;
+        self.contentLayout = [YYTextLayout layoutWithContainer:container text:text];
+        self.contentHeight = self.contentLayout.textBoundingSize.height;
+    }
+
+    //与 MomentFeedListCell 的约束一致：分隔 10，头像 12+36，标题 20，正文 12，配图 18+175+10 或 18，阅读数，底部 12
+    CGFloat height = (10 + 12 + 36 + 20) * kScale + self.titleHeight;
+    height += (self.titleLayout ? 12 * kScale : 0) + self.contentHeight;
+    if (self.imageURL.length) {
+        self.imageSize = CGSizeMake(textWidth, 175 * kScale);
+        height += (18 + 175 + 10) * kScale;
+    } else {
+        height += 18 * kScale;
+    }
+    height += [UIFont systemFontOfSize:12 * kScale].lineHeight + 12 * kScale;
+    self.height = ceil(height);
+}
+
++ (NSAttributedString *)private_tagAttachmentNamed:(NSString *)name font:(UIFont *)font {
+    NSMutableAttributedString *attr = [[NSMutableAttributedString alloc] initWithString:@" " attributes:@{NSFontAttributeName : font}];
+    UIImage *image = [UIImage imageNamed:name];
+    if (image) {
+        [attr appendAttributedString:[NSAttributedString yy_attachmentStringWithContent:image contentMode:UIViewContentModeScaleAspectFit attachmentSize:CGSizeMake(16 * kScale, 16 * kScale) alignToFont:font alignment:YYTextVerticalAlignmentCenter]];
+    }
+    return attr;
+}
+
+#pragma mark 秘密
+
+- (void)private_layoutSecretWithModel:(FeedListModel *)model {
+    NSDictionary *img = model.imgs.firstObject;
+    if ([img isKindOfClass:[NSDictionary class]]) {
+        self.imageURL = img[@"origin"];
+    }
+    //话题卡片，整张图
+    if (model.ty.integerValue == 2) {
+        self.height = 198 * kScale;
+        return;
+    }
+
+    CGFloat textWidth = self.width - 24 * kScale;
+    NSString *content = model.c ?: @"";
+    if (content.length) {
+        //表情换成图片，高亮范围按替换后的文字算，一个表情占一个字符
+        NSMutableAttributedString *text = [[NSMutableAttributedString alloc] init];
+        NSMutableString *plain = [NSMutableString string];
+        [[EmotionManager sharedEmotionManager] enumerateString:content usingBlock:^(NSString *segment, UIImage *image) {
+            if (image == nil) {
+                [text appendAttributedString:[[NSAttributedString alloc] initWithString:segment]];
+                [plain appendString:segment];
+            } else {
+                [text appendAttributedString:[NSAttributedString yy_attachmentStringWithEmojiImage:image fontSize:17 * kScale]];
+                [plain appendString:@"好"];
+            }
+        }];
+
+        NSMutableParagraphStyle *para = [NSMutableParagraphStyle new];
+        para.lineSpacing = text.length > 19 ? 9 * kScale : 0;
+        [text addAttributes:@{
+                              NSParagraphStyleAttributeName : para,
+                              NSFontAttributeName : [UIFont systemFontOfSize:17 * kScale],
+                              NSForegroundColorAttributeName : kUIColorFromRGB(0x333333),
+                              } range:NSMakeRange(0, text.length)];
+        [FeedListLayout private_highlightStocksInText:text plainString:plain];
+
+        YYTextContainer *container = [YYTextContainer containerWithSize:CGSizeMake(textWidth, CGFLOAT_MAX)];
+        self.contentLayout = [YYTextLayout layoutWithContainer:container text:text];
+        self.contentHeight = self.contentLayout.textBoundingSize.height;
+    }
+
+    //没有正文时去掉正文与配图的间距
+    CGFloat height = 115 * kScale + (content.length ? self.contentHeight : -18 * kScale);
+    if (self.imageURL.length) {
+        //长边不超过 160，接口没给宽高时按 160 见方占位
+        CGFloat maxSide = 160 * kScale;
+        CGFloat width = [img[@"w"] floatValue];
+        CGFloat imageHeight = [img[@"h"] floatValue];
+        if (width <= 0 || imageHeight <= 0) {
+            width = imageHeight = maxSide;
+        } else if (MAX(width, imageHeight) > maxSide) {
+            CGFloat ratio = MAX(width, imageHeight) / maxSide;
+            width /= ratio;
+            imageHeight /= ratio;
+        }
+        self.imageSize = CGSizeMake(width, imageHeight);
+        height += imageHeight + 18 * kScale;
+    }
+    self.height = ceil(height);
+}
+
+#pragma mark 股票高亮
+
+//一次扫描找出码表里的全部股票，不再逐个匹配接口给的 sl
++ (void)private_highlightStocksInText:(NSMutableAttributedString *)text plainString:(NSString *)plain {
+    for (StockMention *mention in [[StockMentionMatcher sharedStockMentionMatcher] mentionsInString:plain]) {
+        if (NSMaxRange(mention.range) > text.length) {
+            continue;
+        }
+        [text yy_setTextHighlightRange:mention.range color:kUIColorFromRGB(0x358ee7) backgroundColor:nil userInfo:@{FeedListLayoutStockKey : mention.stock}];
+    }
+}
+
+@end
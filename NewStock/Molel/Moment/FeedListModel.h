@@ -8,6 +8,8 @@
 
 #import <Mantle/Mantle.h>
 #import <UIKit/UIKit.h>
+#import "StockCodesModel.h"
+@class FeedListLayout;
 
 
 @interface FeedListIconModel : MTLModel<MTLJSONSerializing>
@@ -50,6 +52,9 @@
 @property (nonatomic, copy) NSString *m;
 @property (nonatomic, copy) NSArray *c;
 
+//在 sl 中找同一只股票，没有时按码表的代码、名称新建；用于文字中匹配到的股票
++ (instancetype)modelWithStockCode:(StockCodeInfo *)stock inList:(NSArray<FeedListSLModel *> *)sl;
+
 @end
 
 @interface FeedListModel : MTLModel<MTLJSONSerializing>
@@ -75,10 +80,10 @@
 
 // add
 @property (nonatomic, assign) BOOL selected;
-@property (nonatomic, copy) NSString *imgStr;
-@property (nonatomic, copy) NSString *contentStr;
-@property (nonatomic, assign) CGFloat height;
-@property (nonatomic, strong) NSMutableAttributedString *saveAttr;
+@property (nonatomic, strong) FeedListLayout *layout;     //排版及行高，见 FeedListLayout
+
+//标题中的股票(StockMention)，码表不变时只算一次
+- (NSArray *)titleStockMentions;
 
 @end
 
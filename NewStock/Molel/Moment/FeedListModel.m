@@ -7,9 +7,15 @@
 //
 
 #import "FeedListModel.h"
+#import "StockMentionMatcher.h"
 
 
 @implementation FeedListModel
+{
+    //不声明为属性，不参与 Mantle 的比较和归档
+    NSArray *_titleMentions;
+    NSUInteger _titleMentionsGeneration;
+}
 
 + (NSDictionary *)JSONKeyPathsByPropertyKey {
     return @{
@@ -32,6 +38,23 @@
              };
 }
 
++ (MTLPropertyStorage)storageBehaviorForPropertyWithKey:(NSString *)propertyKey {
+    //排版结果不参与比较和归档
+    if ([propertyKey isEqualToString:@"layout"]) {
+        return MTLPropertyStorageNone;
+    }
+    return [super storageBehaviorForPropertyWithKey:propertyKey];
+}
+
+- (NSArray *)titleStockMentions {
+    NSUInteger generation = [StockMentionMatcher sharedStockMentionMatcher].generation;
+    if (_titleMentions == nil || _titleMentionsGeneration != generation) {
+        _titleMentions = [[StockMentionMatcher sharedStockMentionMatcher] mentionsInString:self.tt];
+        _titleMentionsGeneration = generation;
+    }
+    return _titleMentions;
+}
+
 + (NSValueTransformer *)slJSONTransformer {
     return [MTLValueTransformer transformerUsingForwardBlock:^id(id value, BOOL *success, NSError *__autoreleasing *error) {
         NSArray * jsonArray = value;
@@ -120,6 +143,24 @@
 
 @implementation FeedListSLModel
 
++ (instancetype)modelWithStockCode:(StockCodeInfo *)stock inList:(NSArray<FeedListSLModel *> *)sl {
+    if (stock == nil) {
+        return nil;
+    }
+    NSString *s = [NSString stringWithFormat:@"%@", stock.s];
+    for (FeedListSLModel *model in sl) {
+        if ([model.s isEqualToString:s] && [model.m intValue] == [stock.m intValue]) {
+            return model;
+        }
+    }
+    FeedListSLModel *model = [FeedListSLModel new];
+    model.t = [NSString stringWithFormat:@"%@", stock.t];
+    model.s = s;
+    model.m = [NSString stringWithFormat:@"%@", stock.m];
+    model.n = [NSString stringWithFormat:@"%@", stock.n];
+    return model;
+}
+
 + (NSDictionary *)JSONKeyPathsByPropertyKey {
     return @{
              @"t":@"t",
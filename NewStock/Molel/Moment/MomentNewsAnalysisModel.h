@@ -37,6 +37,9 @@
 @property (nonatomic, assign) CGFloat showHeight;
 @property (nonatomic, assign) CGFloat hideHeight;
 
+//标题、摘要(去掉 span 后)中的股票(StockMention)，按文字缓存，码表不变时只算一次
+- (NSArray *)stockMentionsInText:(NSString *)text;
+
 @end
 
 @interface MomentNewsAnalysisGroupModel : NSObject
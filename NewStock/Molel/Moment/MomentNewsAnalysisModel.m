@@ -7,8 +7,14 @@
 //
 
 #import "MomentNewsAnalysisModel.h"
+#import "StockMentionMatcher.h"
 
 @implementation MomentNewsAnalysisModel
+{
+    //不声明为属性，不参与 Mantle 的比较和归档
+    NSMutableDictionary<NSString *, NSArray *> *_stockMentions;
+    NSUInteger _stockMentionsGeneration;
+}
 
 + (NSDictionary *)JSONKeyPathsByPropertyKey {
     return @{
@@ -24,6 +30,23 @@
              };
 }
 
+- (NSArray *)stockMentionsInText:(NSString *)text {
+    if (text.length == 0) {
+        return @[];
+    }
+    StockMentionMatcher *matcher = [StockMentionMatcher sharedStockMentionMatcher];
+    if (_stockMentions == nil || _stockMentionsGeneration != matcher.generation) {
+        _stockMentions = [NSMutableDictionary dictionary];
+        _stockMentionsGeneration = matcher.generation;
+    }
+    NSArray *mentions = _stockMentions[text];
+    if (mentions == nil) {
+        mentions = [matcher mentionsInString:text];
+        _stockMentions[text] = mentions;
+    }
+    return mentions;
+}
+
 + (NSValueTransformer *)slJSONTransformer {
     return [MTLValueTransformer transformerUsingForwardBlock:^id(id value, BOOL *success, NSError *__autoreleasing *error) {
         NSArray * jsonArray = value;
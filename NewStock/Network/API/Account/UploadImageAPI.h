@@ -7,10 +7,12 @@
 //
 
 #import "APIRequest.h"
+#import "UploadImageEncoder.h"
 
 @interface UploadImageAPI : APIRequest
 
-@property (nonatomic, strong) UIImage *image;
+//由 UploadImageEncoder 编码好的头像
+@property (nonatomic, strong) UploadImageFile *imageFile;
 
 
 @end
@@ -24,11 +24,10 @@
 
 - (AFConstructingBlock)constructingBodyBlock {
     return ^(id<AFMultipartFormData> formData) {
-        NSData *data = UIImageJPEGRepresentation(self.image, 0.9);
         NSString *name = @"file";
         NSString *formKey = @"file";
         NSString *type = @"image/jpeg";
-        [formData appendPartWithFileData:data name:formKey fileName:name mimeType:type];
+        [formData appendPartWithFileURL:self.imageFile.fileURL name:formKey fileName:name mimeType:type error:nil];
     };
 }
 
@@ -7,10 +7,12 @@
 //
 
 #import "APIRequest.h"
+#import "UploadImageEncoder.h"
 
 @interface ShareAPI : APIRequest
 
-@property (nonatomic, strong) UIImage *file;
+//由 UploadImageEncoder 编码好的分享图片，为 nil 时不带图片
+@property (nonatomic, strong) UploadImageFile *file;
 
 @property (nonatomic, strong) NSString *img;
 
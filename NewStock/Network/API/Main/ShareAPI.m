@@ -41,11 +41,13 @@
 
 - (AFConstructingBlock)constructingBodyBlock {
     return ^(id<AFMultipartFormData> formData) {
-        NSData *data = UIImageJPEGRepresentation(self.file, 0.9);
+        if (self.file == nil) {
+            return;
+        }
         NSString *name = @"file";
         NSString *formKey = @"file";
         NSString *type = @"image/jpeg";
-        [formData appendPartWithFileData:data name:formKey fileName:name mimeType:type];
+        [formData appendPartWithFileURL:self.file.fileURL name:formKey fileName:name mimeType:type error:nil];
     };
 }
 
@@ -15,4 +15,7 @@
                marketCd:(NSString *)marketCd
                chartTyp:(NSString *)chartTyp;
 - (void)setChartTyp:(NSString *)chartTyp;
+
+//大于 0 时只请求该时间(毫秒)及之后的 K 线，本地已有缓存时用
+@property (nonatomic, assign) long long sinceTime;
 @end
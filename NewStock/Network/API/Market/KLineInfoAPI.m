@@ -52,6 +52,9 @@
 }
 
 - (id)requestArgument {
+    if (_sinceTime > 0) {
+        return @{@"startTime" : @(_sinceTime)};
+    }
     return nil;
 }
 
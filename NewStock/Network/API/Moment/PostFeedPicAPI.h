@@ -7,11 +7,16 @@
 //
 
 #import "APIListRequest.h"
+#import "UploadImageEncoder.h"
 
 @interface PostFeedPicAPI : APIRequest
 
-@property (nonatomic) NSArray <UIImage *>*imageArray;
+//由 UploadImageEncoder 编码好的图片，上传时从文件读取
+@property (nonatomic) NSArray <UploadImageFile *>*imageFiles;
 
 @property (nonatomic, copy) NSString *ty;
 
+//上传进度，主线程回调
+@property (nonatomic, copy) AFUploadProgressBlock uploadProgressBlock;
+
 @end
@@ -20,26 +20,24 @@
 }
 
 - (NSString *)requestUrl {
-    return _imageArray.count > 1 ? API_UPLOAD_IMGS : API_UPLOAD_IMG;
+    return _imageFiles.count > 1 ? API_UPLOAD_IMGS : API_UPLOAD_IMG;
 }
 
 - (AFConstructingBlock)constructingBodyBlock {
     return ^(id<AFMultipartFormData> formData) {
         
-        if (_imageArray.count == 1) {
-            NSData *data = UIImageJPEGRepresentation(self.imageArray.firstObject, 0.9);
+        if (_imageFiles.count == 1) {
             NSString *name = @"file";
             NSString *formKey = @"file";
             NSString *type = @"image/jpeg";
-            [formData appendPartWithFileData:data name:formKey fileName:name mimeType:type];
+            [formData appendPartWithFileURL:self.imageFiles.firstObject.fileURL name:formKey fileName:name mimeType:type error:nil];
         }else {
         
-            for (int i = 0; i < _imageArray.count; i ++) {
-                NSData *data = UIImageJPEGRepresentation(self.imageArray[i], 0.9);
+            for (int i = 0; i < _imageFiles.count; i ++) {
                 NSString *name = @"files";
                 NSString *formKey = @"files";
                 NSString *type = @"image/jpeg";
-                [formData appendPartWithFileData:data name:formKey fileName:name mimeType:type];
+                [formData appendPartWithFileURL:self.imageFiles[i].fileURL name:formKey fileName:name mimeType:type error:nil];
             }
 
         }
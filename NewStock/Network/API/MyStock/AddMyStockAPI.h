@@ -7,9 +7,12 @@
 //
 
 #import "APIRequest.h"
+#import "StockCodesModel.h"
 
 @interface AddMyStockAPI : APIRequest
 
+@property (nonatomic, strong) NSArray <StockCodeInfo *>*modelArray;
+
 @property (nonatomic, copy) NSString *t;
 @property (nonatomic, copy) NSString *s;
 @property (nonatomic, copy) NSString *m;
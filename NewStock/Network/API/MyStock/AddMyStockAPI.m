@@ -25,9 +25,21 @@
 }
 
 - (id)requestArgument {
-    NSDictionary *dict = [NSDictionary dictionaryWithObjectsAndKeys:self.t,@"t",self.s,@"s",self.m,@"m", nil];
-    NSArray *arr = [NSArray arrayWithObject:dict];
-    return  arr;
+    
+    if (self.modelArray.count) {
+        NSMutableArray *nmArr = [NSMutableArray array];
+        
+        for (StockCodeInfo *model in self.modelArray) {
+            NSDictionary *dict = [NSDictionary dictionaryWithObjectsAndKeys:model.t,@"t",model.s,@"s",model.m,@"m", nil];
+            [nmArr addObject:dict];
+        }
+        
+        return  nmArr.copy;
+    }else {
+        NSDictionary *dict = [NSDictionary dictionaryWithObjectsAndKeys:self.t,@"t",self.s,@"s",self.m,@"m", nil];
+        NSArray *arr = [NSArray arrayWithObject:dict];
+        return  arr;
+    }
 }
 
 - (id)jsonValidator {
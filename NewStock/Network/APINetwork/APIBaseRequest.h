@@ -30,6 +30,7 @@ typedef NS_ENUM(NSInteger , APIRequestPriority) {
 
 typedef void (^AFConstructingBlock)(id<AFMultipartFormData> formData);
 typedef void (^AFDownloadProgressBlock)(AFDownloadRequestOperation *operation, NSInteger bytesRead, long long totalBytesRead, long long totalBytesExpected, long long totalBytesReadForFile, long long totalBytesExpectedToReadForFile);
+typedef void (^AFUploadProgressBlock)(NSUInteger bytesWritten, long long totalBytesWritten, long long totalBytesExpectedToWrite);
 
 @class APIBaseRequest;
 
@@ -173,4 +174,7 @@ typedef void(^APIRequestCompletionBlock)(__kindof APIBaseRequest *request);
 /// 当需要断点续传时，获得下载进度的回调
 - (AFDownloadProgressBlock)resumableDownloadProgressBlock;
 
+/// 带文件的POST获得上传进度的回调，在主线程调用
+- (AFUploadProgressBlock)uploadProgressBlock;
+
 @end
@@ -92,6 +92,10 @@
     return nil;
 }
 
+- (AFUploadProgressBlock)uploadProgressBlock {
+    return nil;
+}
+
 /// append self to request queue
 - (void)start {
     [self toggleAccessoriesWillStartCallBack];
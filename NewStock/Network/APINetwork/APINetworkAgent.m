@@ -66,6 +66,13 @@
 }
 
 - (void)addRequest:(APIBaseRequest *)request {
+    //操作先入队后登记，回调在主线程查登记表，后台线程发起的请求转到主线程，避免回调先于登记
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self addRequest:request];
+        });
+        return;
+    }
     APIRequestMethod method = [request requestMethod];
     NSString *url = [self buildRequestUrl:request];
     id param = request.requestArgument;
@@ -160,6 +167,7 @@
                     } failure:^(AFHTTPRequestOperation *operation, NSError *error) {
                         [self handleRequestResult:operation];
                     }];
+                    [operation setUploadProgressBlock:request.uploadProgressBlock];
                     request.requestOperation = operation;
                     [_manager.operationQueue addOperation:operation];
                 }
@@ -206,7 +214,10 @@
 }
 
 - (void)cancelAllRequests {
-    NSDictionary *copyRecord = [_requestsRecord copy];
+    NSDictionary *copyRecord = nil;
+    @synchronized(self) {
+        copyRecord = [_requestsRecord copy];
+    }
     for (NSString *key in copyRecord) {
         APIBaseRequest *request = copyRecord[key];
         [request stop];
@@ -228,7 +239,10 @@
 
 - (void)handleRequestResult:(AFHTTPRequestOperation *)operation {
     NSString *key = [self requestHashKey:operation];
-    APIBaseRequest *request = _requestsRecord[key];
+    APIBaseRequest *request = nil;
+    @synchronized(self) {
+        request = _requestsRecord[key];
+    }
     APILog(@"Finished Request: %@", NSStringFromClass([request class]));
     if (request) {
         BOOL succeed = [self checkResult:request];
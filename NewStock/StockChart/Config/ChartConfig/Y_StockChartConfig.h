@@ -0,0 +1,75 @@
+//
+//  Y_StockChartConfig.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import "Y_StockChartConstant.h"
+
+/**
+ *  图表配置
+ *
+ *  每个 Y_StockChartView 持有一份，沿视图树传给各子视图，不同图表的缩放、均线类型互不影响。
+ *  不可变：修改时用 configWith... 生成新的配置再赋给图表。
+ */
+@interface Y_StockChartConfig : NSObject <NSCopying>
+
+/**
+ *  K线图的宽度，默认5
+ */
+@property (nonatomic, assign, readonly) CGFloat kLineWidth;
+
+/**
+ *  K线图的间隔，默认1
+ */
+@property (nonatomic, assign, readonly) CGFloat kLineGap;
+
+/**
+ *  T线图的宽度，默认1
+ */
+@property (nonatomic, assign, readonly) CGFloat tLineWidth;
+
+/**
+ *  T线图的间隔，默认0
+ */
+@property (nonatomic, assign, readonly) CGFloat tLineGap;
+
+/**
+ *  MainView的高度占比,默认为0.68
+ */
+@property (nonatomic, assign, readonly) CGFloat mainViewRatio;
+
+/**
+ *  VolumeView的高度占比,默认为0.3
+ */
+@property (nonatomic, assign, readonly) CGFloat volumeViewRatio;
+
+/**
+ *  5档的宽度占比,默认为0.33
+ */
+@property (nonatomic, assign, readonly) CGFloat fifthPosViewRatio;
+
+/**
+ *  5档的宽度,默认为115
+ */
+@property (nonatomic, assign, readonly) CGFloat fifthPosViewWidth;
+
+/**
+ *  均线类型：Y_StockChartTargetLineStatusMA 或 Y_StockChartTargetLineStatusEMA
+ */
+@property (nonatomic, assign, readonly) Y_StockChartTargetLineStatus averageLineStatus;
+
++ (instancetype)defaultConfig;
+
+//宽度限制在 Y_StockChartKLineMinWidth ~ Y_StockChartKLineMaxWidth
+- (instancetype)configWithKLineWidth:(CGFloat)kLineWidth;
+- (instancetype)configWithTLineWidth:(CGFloat)tLineWidth;
+
+- (instancetype)configWithMainViewRatio:(CGFloat)mainViewRatio volumeViewRatio:(CGFloat)volumeViewRatio;
+- (instancetype)configWithFifthPosViewWidth:(CGFloat)fifthPosViewWidth;
+- (instancetype)configWithAverageLineStatus:(Y_StockChartTargetLineStatus)averageLineStatus;
+
+@end
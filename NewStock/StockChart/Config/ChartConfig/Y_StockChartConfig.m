@@ -0,0 +1,121 @@
+//
+//  Y_StockChartConfig.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "Y_StockChartConfig.h"
+
+@interface Y_StockChartConfig ()
+
+@property (nonatomic, assign, readwrite) CGFloat kLineWidth;
+@property (nonatomic, assign, readwrite) CGFloat kLineGap;
+@property (nonatomic, assign, readwrite) CGFloat tLineWidth;
+@property (nonatomic, assign, readwrite) CGFloat tLineGap;
+@property (nonatomic, assign, readwrite) CGFloat mainViewRatio;
+@property (nonatomic, assign, readwrite) CGFloat volumeViewRatio;
+@property (nonatomic, assign, readwrite) CGFloat fifthPosViewRatio;
+@property (nonatomic, assign, readwrite) CGFloat fifthPosViewWidth;
+@property (nonatomic, assign, readwrite) Y_StockChartTargetLineStatus averageLineStatus;
+
+@end
+
+@implementation Y_StockChartConfig
+
+static CGFloat Y_StockChartClampLineWidth(CGFloat width) {
+    if (width > Y_StockChartKLineMaxWidth) {
+        return Y_StockChartKLineMaxWidth;
+    } else if (width < Y_StockChartKLineMinWidth) {
+        return Y_StockChartKLineMinWidth;
+    }
+    return width;
+}
+
++ (instancetype)defaultConfig {
+    static Y_StockChartConfig *config;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        config = [[Y_StockChartConfig alloc] init];
+        config.kLineWidth = 5;
+        config.kLineGap = 1;
+        config.tLineWidth = 1;
+        config.tLineGap = 0;
+        config.mainViewRatio = 0.68;
+        config.volumeViewRatio = 0.30;
+        config.fifthPosViewRatio = 0.33;
+        config.fifthPosViewWidth = 115;
+        config.averageLineStatus = Y_StockChartTargetLineStatusMA;
+    });
+    return config;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    //不可变，直接共用
+    return self;
+}
+
+- (Y_StockChartConfig *)mutableClone {
+    Y_StockChartConfig *config = [[Y_StockChartConfig alloc] init];
+    config.kLineWidth = _kLineWidth;
+    config.kLineGap = _kLineGap;
+    config.tLineWidth = _tLineWidth;
+    config.tLineGap = _tLineGap;
+    config.mainViewRatio = _mainViewRatio;
+    config.volumeViewRatio = _volumeViewRatio;
+    config.fifthPosViewRatio = _fifthPosViewRatio;
+    config.fifthPosViewWidth = _fifthPosViewWidth;
+    config.averageLineStatus = _averageLineStatus;
+    return config;
+}
+
+- (instancetype)configWithKLineWidth:(CGFloat)kLineWidth {
+    kLineWidth = Y_StockChartClampLineWidth(kLineWidth);
+    if (kLineWidth == _kLineWidth) {
+        return self;
+    }
+    Y_StockChartConfig *config = [self mutableClone];
+    config.kLineWidth = kLineWidth;
+    return config;
+}
+
+- (instancetype)configWithTLineWidth:(CGFloat)tLineWidth {
+    tLineWidth = Y_StockChartClampLineWidth(tLineWidth);
+    if (tLineWidth == _tLineWidth) {
+        return self;
+    }
+    Y_StockChartConfig *config = [self mutableClone];
+    config.tLineWidth = tLineWidth;
+    return config;
+}
+
+- (instancetype)configWithMainViewRatio:(CGFloat)mainViewRatio volumeViewRatio:(CGFloat)volumeViewRatio {
+    if (mainViewRatio == _mainViewRatio && volumeViewRatio == _volumeViewRatio) {
+        return self;
+    }
+    Y_StockChartConfig *config = [self mutableClone];
+    config.mainViewRatio = mainViewRatio;
+    config.volumeViewRatio = volumeViewRatio;
+    return config;
+}
+
+- (instancetype)configWithFifthPosViewWidth:(CGFloat)fifthPosViewWidth {
+    if (fifthPosViewWidth == _fifthPosViewWidth) {
+        return self;
+    }
+    Y_StockChartConfig *config = [self mutableClone];
+    config.fifthPosViewWidth = fifthPosViewWidth;
+    return config;
+}
+
+- (instancetype)configWithAverageLineStatus:(Y_StockChartTargetLineStatus)averageLineStatus {
+    if (averageLineStatus == _averageLineStatus) {
+        return self;
+    }
+    Y_StockChartConfig *config = [self mutableClone];
+    config.averageLineStatus = averageLineStatus;
+    return config;
+}
+
+@end
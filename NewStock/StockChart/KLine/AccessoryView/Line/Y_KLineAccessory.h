@@ -8,7 +8,7 @@
 
 #import <Foundation/Foundation.h>
 #import "Y_KLineVolumePositionModel.h"
-#import "Y_KLineModel.h"
+#import "Y_StockChartConfig.h"
 @interface Y_KLineAccessory : NSObject
 
 /**
@@ -17,14 +17,14 @@
 @property (nonatomic, strong) Y_KLineVolumePositionModel *positionModel;
 
 /**
- *  k线model
+ *  柱的值，大于 0 为涨色
  */
-@property (nonatomic, strong) Y_KLineModel *kLineModel;
+@property (nonatomic, assign) CGFloat value;
 
 /**
- *  线颜色
+ *  图表配置
  */
-@property (nonatomic, strong) UIColor *lineColor;
+@property (nonatomic, strong) Y_StockChartConfig *config;
 
 /**
  *  根据context初始化均线画笔
@@ -32,7 +32,7 @@
 - (instancetype)initWithContext:(CGContextRef)context;
 
 /**
- *  绘制成交量
+ *  绘制柱
  */
 - (void)draw;
 @end
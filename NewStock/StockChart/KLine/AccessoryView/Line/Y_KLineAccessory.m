@@ -7,7 +7,6 @@
 //
 
 #import "Y_KLineAccessory.h"
-#import "Y_StockChartGlobalVariable.h"
 #import "UIColor+Y_StockChart.h"
 @interface Y_KLineAccessory()
 
@@ -28,16 +27,16 @@
 }
 
 - (void)draw {
-    if(!self.kLineModel || !self.positionModel || !self.context || !self.lineColor) {
+    if(!self.positionModel || !self.context) {
         return;
     }
     CGContextRef context = self.context;
     CGContextSetStrokeColorWithColor(context, [UIColor decreaseColor].CGColor);
-    CGContextSetLineWidth(context, [Y_StockChartGlobalVariable kLineWidth]);
+    CGContextSetLineWidth(context, self.config.kLineWidth);
     
     CGPoint solidPoints[] = {self.positionModel.StartPoint, self.positionModel.EndPoint};
     
-    if(self.kLineModel.MACD.floatValue > 0)
+    if(self.value > 0)
     {
         CGContextSetStrokeColorWithColor(context, [UIColor increaseColor].CGColor);
     }
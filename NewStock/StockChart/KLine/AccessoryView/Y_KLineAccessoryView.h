@@ -8,6 +8,8 @@
 
 #import <UIKit/UIKit.h>
 #import "Y_StockChartConstant.h"
+#import "Y_StockChartConfig.h"
+@class Y_KLineIndicator;
 @protocol Y_KLineAccessoryViewDelegate <NSObject>
 
 @optional
@@ -42,9 +44,14 @@
 @property (nonatomic, weak) id<Y_KLineAccessoryViewDelegate> delegate;
 
 /**
- *  Accessory指标种类
+ *  图表配置
  */
-@property (nonatomic, assign) Y_StockChartTargetLineStatus targetLineStatus;
+@property (nonatomic, strong) Y_StockChartConfig *config;
+
+/**
+ *  副图指标，按注册表声明的输出列和画法绘制
+ */
+@property (nonatomic, strong) Y_KLineIndicator *indicator;
 
 /**
  *  绘制
@@ -9,6 +9,7 @@
 #import <UIKit/UIKit.h>
 #import "Y_StockChartConstant.h"
 @class Y_KLineModel;
+@class Y_KLineIndicator;
 @interface Y_AccessoryMAView : UIView
 
 +(instancetype)view;
@@ -16,8 +17,8 @@
 -(void)maProfileWithModel:(Y_KLineModel *)model;
 
 /**
- *  Accessory指标种类
+ *  副图指标，显示其标题和各输出列的值
  */
-@property (nonatomic, assign) Y_StockChartTargetLineStatus targetLineStatus;
+@property (nonatomic, strong) Y_KLineIndicator *indicator;
 
 @end
@@ -10,16 +10,17 @@
 #import "Masonry.h"
 #import "UIColor+Y_StockChart.h"
 #import "Y_KLineModel.h"
+#import "Y_KLineGroupModel.h"
+#import "Y_KLineIndicator.h"
 
 @interface Y_AccessoryMAView()
 
 @property (strong, nonatomic) UILabel *accessoryDescLabel;
 
-@property (strong, nonatomic) UILabel *DIFLabel;
-
-@property (strong, nonatomic) UILabel *DEALabel;
-
-@property (strong, nonatomic) UILabel *MACDLabel;
+/**
+ *  各输出列的数值，个数随指标变化
+ */
+@property (strong, nonatomic) NSMutableArray<UILabel *> *valueLabels;
 
 @end
 @implementation Y_AccessoryMAView
@@ -28,43 +29,14 @@
 {
     self = [super init];
     if (self) {
-        _DIFLabel = [self private_createLabel];
-        _DEALabel = [self private_createLabel];
-        _MACDLabel = [self private_createLabel];
         _accessoryDescLabel = [self private_createLabel];
-        
-        
-        
-        _DIFLabel.textColor = [UIColor ma7Color];
-        _DEALabel.textColor = [UIColor ma30Color];
-        _MACDLabel.textColor = [UIColor ma26Color];//[UIColor colorWithRGBHex:0xffffff];
+        _valueLabels = @[].mutableCopy;
 
-        
         [_accessoryDescLabel mas_makeConstraints:^(MASConstraintMaker *make) {
             make.left.equalTo(self.mas_left);
             make.top.equalTo(self.mas_top);
             make.bottom.equalTo(self.mas_bottom);
         }];
-        
-        
-        [_DIFLabel mas_makeConstraints:^(MASConstraintMaker *make) {
-            make.left.equalTo(_accessoryDescLabel.mas_right);
-            make.top.equalTo(self.mas_top);
-            make.bottom.equalTo(self.mas_bottom);
-            
-        }];
-        
-        [_DEALabel mas_makeConstraints:^(MASConstraintMaker *make) {
-            make.left.equalTo(_DIFLabel.mas_right);
-            make.top.equalTo(self.mas_top);
-            make.bottom.equalTo(self.mas_bottom);
-        }];
-        
-        [_MACDLabel mas_makeConstraints:^(MASConstraintMaker *make) {
-            make.left.equalTo(_DEALabel.mas_right);
-            make.top.equalTo(self.mas_top);
-            make.bottom.equalTo(self.mas_bottom);
-        }];
     }
     return self;
 }
@@ -72,35 +44,43 @@
 + (instancetype)view
 {
     Y_AccessoryMAView *MAView = [[Y_AccessoryMAView alloc]init];
-    
+
     return MAView;
 }
-- (void)maProfileWithModel:(Y_KLineModel *)model
+
+- (void)setIndicator:(Y_KLineIndicator *)indicator
 {
-    if(self.targetLineStatus == Y_StockChartTargetLineStatusMACD)
-    {
-        _accessoryDescLabel.text = @" MACD(12,26,9)";
-        _DIFLabel.text = [NSString stringWithFormat:@"  DIF：%.4f ",model.DIF.floatValue];
-        _DEALabel.text = [NSString stringWithFormat:@"  DEA：%.4f",model.DEA.floatValue];
-        _MACDLabel.text = [NSString stringWithFormat:@"  MACD：%.4f",model.MACD.floatValue];
-    } else if (self.targetLineStatus == Y_StockChartTargetLineStatusKDJ) {
-        _accessoryDescLabel.text = @" KDJ(9,3,3)";
-        _DIFLabel.text = [NSString stringWithFormat:@"  K：%.8f ",model.KDJ_K.floatValue];
-        _DEALabel.text = [NSString stringWithFormat:@"  D：%.8f",model.KDJ_D.floatValue];
-        _MACDLabel.text = [NSString stringWithFormat:@"  J：%.8f",model.KDJ_J.floatValue];
-    } else if (self.targetLineStatus == Y_StockChartTargetLineStatusRSI) {
-        _accessoryDescLabel.text = @" RSI(6,12,24)";
-        _DIFLabel.text = [NSString stringWithFormat:@"  RSI6：%.8f ",model.RSI_6.floatValue];
-        _DEALabel.text = [NSString stringWithFormat:@"  RSI12：%.8f",model.RSI_12.floatValue];
-        _MACDLabel.text = [NSString stringWithFormat:@"  RSI24：%.8f",model.RSI_24.floatValue];
-    } else if (self.targetLineStatus == Y_StockChartTargetLineStatusBOLL) {
-        _accessoryDescLabel.text = @" BOLL(20)";
-        _DIFLabel.text = [NSString stringWithFormat:@"  UPPER：%.4f ",model.BOLL_UPPER.floatValue];
-        _DEALabel.text = [NSString stringWithFormat:@"  MID：%.4f",model.BOLL_MID.floatValue];
-        _MACDLabel.text = [NSString stringWithFormat:@"  LOWER：%.4f",model.BOLL_DOWN.floatValue];
+    if ([_indicator isEqual:indicator]) {
+        return;
     }
+    _indicator = indicator;
 
+    //按输出列数重建数值 label，颜色顺序与副图的线一致
+    [_valueLabels makeObjectsPerformSelector:@selector(removeFromSuperview)];
+    [_valueLabels removeAllObjects];
+    NSArray *colors = @[[UIColor ma7Color], [UIColor ma30Color], [UIColor ma26Color], [UIColor ma12Color]];
+    UIView *leftView = _accessoryDescLabel;
+    for (NSUInteger i = 0; i < indicator.outputNames.count; i++) {
+        UILabel *label = [self private_createLabel];
+        label.textColor = i < colors.count ? colors[i] : [UIColor mainTextColor];
+        [label mas_makeConstraints:^(MASConstraintMaker *make) {
+            make.left.equalTo(leftView.mas_right);
+            make.top.equalTo(self.mas_top);
+            make.bottom.equalTo(self.mas_bottom);
+        }];
+        [_valueLabels addObject:label];
+        leftView = label;
+    }
+    _accessoryDescLabel.text = indicator ? [NSString stringWithFormat:@" %@", indicator.title] : nil;
+}
 
+- (void)maProfileWithModel:(Y_KLineModel *)model
+{
+    Y_KLineIndicatorSeries *series = [model.ParentGroupModel seriesForIndicator:self.indicator];
+    [self.indicator.outputNames enumerateObjectsUsingBlock:^(NSString * _Nonnull name, NSUInteger idx, BOOL * _Nonnull stop) {
+        NSNumber *value = [series numberAtIndex:model.Index output:idx];
+        self.valueLabels[idx].text = [NSString stringWithFormat:@"  %@：%.4f", name, value.floatValue];
+    }];
 }
 - (UILabel *)private_createLabel
 {
@@ -204,9 +204,9 @@
     _lowLabel.text = [NSString stringWithFormat:@"%.2f",model.Low.floatValue];
     _closeLabel.text = [NSString stringWithFormat:@"%.2f",model.Close.floatValue];
  
-    _MA7Label.text = [NSString stringWithFormat:@" MA5:%.2f ",model.MA7.floatValue];
-    _MA12Label.text = [NSString stringWithFormat:@" 10:%.2f ",model.MA12.floatValue];//MA
-    _MA26Label.text = [NSString stringWithFormat:@" 20:%.2f ",model.MA26.floatValue];//MA
+    _MA7Label.text = [NSString stringWithFormat:@" MA5:%.2f ",model.MA5.floatValue];
+    _MA12Label.text = [NSString stringWithFormat:@" 10:%.2f ",model.MA10.floatValue];//MA
+    _MA26Label.text = [NSString stringWithFormat:@" 20:%.2f ",model.MA20.floatValue];//MA
     _MA30Label.text = [NSString stringWithFormat:@" 30:%.2f",model.MA30.floatValue];//MA
 }
 - (UILabel *)private_createLabel
@@ -9,6 +9,7 @@
 #import <Foundation/Foundation.h>
 #import "Y_KLinePositionModel.h"
 #import "Y_KLineModel.h"
+#import "Y_StockChartConfig.h"
 /**
  *  K线的线
  */
@@ -29,6 +30,11 @@
  */
 @property (nonatomic, assign) CGFloat maxY;
 
+/**
+ *  图表配置
+ */
+@property (nonatomic, strong) Y_StockChartConfig *config;
+
 /**
  *  根据context初始化
  */
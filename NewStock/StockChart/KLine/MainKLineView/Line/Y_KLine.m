@@ -8,7 +8,6 @@
 
 #import "Y_KLine.h"
 #import "UIColor+Y_StockChart.h"
-#import "Y_StockChartGlobalVariable.h"
 #import "Y_StockChartConstant.h"
 @interface Y_KLine()
 
@@ -54,7 +53,7 @@
     CGContextSetStrokeColorWithColor(context, strokeColor.CGColor);
     
     //画中间较宽的开收盘线段-实体线
-    CGContextSetLineWidth(context, [Y_StockChartGlobalVariable kLineWidth]);
+    CGContextSetLineWidth(context, self.config.kLineWidth);
     const CGPoint solidPoints[] = {self.kLinePositionModel.OpenPoint, self.kLinePositionModel.ClosePoint};
     //画线
     CGContextStrokeLineSegments(context, solidPoints, 2);
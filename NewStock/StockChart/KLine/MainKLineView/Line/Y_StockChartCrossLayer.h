@@ -0,0 +1,24 @@
+//
+//  Y_StockChartCrossLayer.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+/**
+ *  长按的十字线
+ *
+ *  两条细线直接用 CALayer，移动时关闭隐式动画，不走 Auto Layout。
+ *  铺满 superlayer，横线与之同宽。
+ */
+@interface Y_StockChartCrossLayer : CALayer
+
+//十字线交点，竖线从顶部画 verticalHeight 高
+- (void)showAtPoint:(CGPoint)point verticalHeight:(CGFloat)verticalHeight;
+
+- (void)hide;
+
+@end
@@ -0,0 +1,56 @@
+//
+//  Y_StockChartCrossLayer.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "Y_StockChartCrossLayer.h"
+#import "UIColor+Y_StockChart.h"
+#import "Y_StockChartConstant.h"
+
+@interface Y_StockChartCrossLayer ()
+
+@property (nonatomic, strong) CALayer *verticalLayer;
+@property (nonatomic, strong) CALayer *horizontalLayer;
+
+@end
+
+@implementation Y_StockChartCrossLayer
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        self.hidden = YES;
+        _verticalLayer = [self private_createLineLayer];
+        _horizontalLayer = [self private_createLineLayer];
+    }
+    return self;
+}
+
+- (void)showAtPoint:(CGPoint)point verticalHeight:(CGFloat)verticalHeight {
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    self.frame = self.superlayer.bounds;
+    self.verticalLayer.frame = CGRectMake(point.x, 0, Y_StockChartLongPressVerticalViewWidth, verticalHeight);
+    self.horizontalLayer.frame = CGRectMake(0, point.y, CGRectGetWidth(self.bounds), Y_StockChartLongPressVerticalViewWidth);
+    self.hidden = NO;
+    [CATransaction commit];
+}
+
+- (void)hide {
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    self.hidden = YES;
+    [CATransaction commit];
+}
+
+- (CALayer *)private_createLineLayer {
+    CALayer *layer = [CALayer layer];
+    layer.backgroundColor = [UIColor longPressLineColor].CGColor;
+    [self addSublayer:layer];
+    return layer;
+}
+
+@end
@@ -6,6 +6,7 @@
 #import "Y_KLinePositionModel.h"
 #import "Y_KLineModel.h"
 #import "Y_StockChartConstant.h"
+#import "Y_StockChartConfig.h"
 @protocol TimeLineMainViewDelegate <NSObject>
 
 @optional
@@ -66,6 +67,11 @@
  */
 @property (nonatomic, weak) id<TimeLineMainViewDelegate> delegate;
 
+/**
+ *  图表配置
+ */
+@property (nonatomic, strong) Y_StockChartConfig *config;
+
 /**
  *  是否为图表类型
  */
@@ -103,14 +109,20 @@
 - (void)updateMainViewWidth;
 
 /**
- *  长按的时候根据原始的x位置获得精确的x的位置
+ *  长按位置对应的 K 线在 needDrawKLineModels 中的下标，按 K 线间距直接换算，超出两端时取最近的一根；没有 K 线时为 NSNotFound
+ *  与上一次长按的不是同一根时才通知 delegate 更新跟随信息
+ */
+- (NSInteger)longPressIndexWithOriginXPosition:(CGFloat)originXPosition;
+
+/**
+ *  第 index 根 K 线上十字线的交点，MainView 坐标
  */
-- (CGFloat)getExactXPositionWithOriginXPosition:(CGFloat)originXPosition;
+- (CGPoint)crossPointAtIndex:(NSInteger)index;
 
 /**
- *  长按的时候根据原始的y位置获得精确的y的位置
+ *  长按结束，下次长按重新通知 delegate
  */
-- (CGFloat)getExactYPositionWithOriginYPosition:(CGFloat)originXPosition;
+- (void)endLongPress;
 
 /**
  *  移除所有的监听事件
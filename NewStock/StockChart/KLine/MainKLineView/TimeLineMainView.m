@@ -8,7 +8,6 @@
 #import "Y_KLine.h"
 #import "Y_MALine.h"
 #import "Y_KLinePositionModel.h"
-#import "Y_StockChartGlobalVariable.h"
 #import "Masonry.h"
 #import "Defination.h"
 @interface TimeLineMainView()
@@ -39,6 +38,11 @@
  */
 @property (nonatomic, assign) CGFloat oldScale;
 
+/**
+ *  长按中的 K 线下标，没有长按时为 NSNotFound
+ */
+@property (nonatomic, assign) NSInteger longPressIndex;
+
 /**
  *  均线位置数组
  */
@@ -65,6 +69,7 @@
     if (self) {
         self.needDrawKLineModels = @[].mutableCopy;
         self.needDrawKLinePositionModels = @[].mutableCopy;
+        self.longPressIndex = NSNotFound;
         self.AverPositions = @[].mutableCopy;
         self.MA7Positions = @[].mutableCopy;
         self.MA30Positions = @[].mutableCopy;
@@ -113,7 +118,7 @@
         CGContextSetLineWidth(context, 0.3);
         CGContextSetStrokeColorWithColor(context, [UIColor dividingColor].CGColor);//线框颜色
         
-        CGFloat lineWidth = [Y_StockChartGlobalVariable tLineWidth];
+        CGFloat lineWidth = self.config.tLineWidth;
 
         CGContextMoveToPoint(context, self.frame.size.width/2-lineWidth, 0);
         CGContextAddLineToPoint(context, self.frame.size.width/2-lineWidth, Y_StockChartKLineMainViewMaxY);
@@ -148,7 +153,7 @@
         CGContextSetLineWidth(context, 0.3);
         CGContextSetStrokeColorWithColor(context, [UIColor dividingColor].CGColor);//线框颜色
         
-        CGFloat lineWidth = [Y_StockChartGlobalVariable tLineWidth];
+        CGFloat lineWidth = self.config.tLineWidth;
 
         CGContextMoveToPoint(context, self.frame.size.width/5-lineWidth, 0);
         CGContextAddLineToPoint(context, self.frame.size.width/5-lineWidth, Y_StockChartKLineMainViewMaxY);
@@ -196,6 +201,7 @@
     if(self.MainViewType == Y_StockChartcenterViewTypeKline)
     {
         Y_KLine *kLine = [[Y_KLine alloc]initWithContext:context];
+        kLine.config = self.config;
         kLine.maxY = Y_StockChartKLineMainViewMaxY;
 
         [self.needDrawKLinePositionModels enumerateObjectsUsingBlock:^(Y_KLinePositionModel * _Nonnull kLinePositionModel, NSUInteger idx, BOOL * _Nonnull stop) {
@@ -214,7 +220,7 @@
         }];
         MALine.MAPositions = positions;
         MALine.MAType = -1;
-        CGFloat maxY = self.parentScrollView.frame.size.height * [Y_StockChartGlobalVariable kLineMainViewRadio] - 12;
+        CGFloat maxY = self.parentScrollView.frame.size.height * self.config.mainViewRatio - 12;
         [MALine drawMiniWithOriginalY:maxY];
 //
         [self.needDrawKLinePositionModels enumerateObjectsUsingBlock:^(Y_KLinePositionModel * _Nonnull positionModel, NSUInteger idx, BOOL * _Nonnull stop) {
@@ -299,6 +305,8 @@
     if(self.kLineModels) {
         NSAssert(self.kLineModels, @"kLineModels不能为空");
         
+        //重新取了需要画的 K 线，长按下标要重新对应
+        self.longPressIndex = NSNotFound;
         //提取需要的kLineModel
         [self private_extractNeedDrawModels];
         //转换model为坐标model
@@ -319,8 +327,8 @@
 - (void)updateMainViewWidth
 {
     //根据stockModels的个数和间隔和K线的宽度计算出self的宽度，并设置contentsize
-    //CGFloat kLineViewWidth = self.kLineModels.count * [Y_StockChartGlobalVariable tLineWidth] + (self.kLineModels.count + 1) * [Y_StockChartGlobalVariable tLineGap] + 10;
-    CGFloat kLineViewWidth = self.kLineModels.count * [Y_StockChartGlobalVariable tLineWidth] + (self.kLineModels.count + 1) * [Y_StockChartGlobalVariable tLineGap];
+    //CGFloat kLineViewWidth = self.kLineModels.count * self.config.tLineWidth + (self.kLineModels.count + 1) * self.config.tLineGap + 10;
+    CGFloat kLineViewWidth = self.kLineModels.count * self.config.tLineWidth + (self.kLineModels.count + 1) * self.config.tLineGap;
     
     if(kLineViewWidth < self.parentScrollView.bounds.size.width) {
         kLineViewWidth = self.parentScrollView.bounds.size.width;
@@ -349,75 +357,40 @@
 //    }
 }
 
-/**
- *  长按的时候根据原始的x位置获得精确的x的位置
- */
-- (CGFloat)getExactXPositionWithOriginXPosition:(CGFloat)originXPosition
+#pragma mark 长按
+- (NSInteger)longPressIndexWithOriginXPosition:(CGFloat)originXPosition
 {
-    CGFloat xPositoinInMainView = originXPosition;
-    NSInteger startIndex = (NSInteger)((xPositoinInMainView - self.startXPosition) / ([Y_StockChartGlobalVariable tLineGap] + [Y_StockChartGlobalVariable tLineWidth]));
     NSInteger arrCount = self.needDrawKLinePositionModels.count;
-    for (NSInteger index = startIndex > 0 ? startIndex - 1 : 0; index < arrCount; ++index) {
-        Y_KLinePositionModel *kLinePositionModel = self.needDrawKLinePositionModels[index];
-        
-        CGFloat minX = kLinePositionModel.HighPoint.x - ([Y_StockChartGlobalVariable tLineGap] + [Y_StockChartGlobalVariable tLineWidth]/2);
-        CGFloat maxX = kLinePositionModel.HighPoint.x + ([Y_StockChartGlobalVariable tLineGap] + [Y_StockChartGlobalVariable tLineWidth]/2);
-        
-        if(xPositoinInMainView > minX && xPositoinInMainView < maxX)
-        {
-            if(self.delegate && [self.delegate respondsToSelector:@selector(kLineMainViewLongPressKLinePositionModel:kLineModel:)])
-            {
-                [self.delegate kLineMainViewLongPressKLinePositionModel:self.needDrawKLinePositionModels[index] kLineModel:self.needDrawKLineModels[index]];
-            }
-            return kLinePositionModel.HighPoint.x;
-        }
-
+    if(arrCount == 0)
+    {
+        return NSNotFound;
     }
-    if (startIndex>arrCount)
+    //第 i 根的 x 为第一根的 x + i * 间距
+    Y_KLinePositionModel *firstPositionModel = self.needDrawKLinePositionModels.firstObject;
+    CGFloat pitch = self.config.tLineGap + self.config.tLineWidth;
+    NSInteger index = (NSInteger)lround((originXPosition - firstPositionModel.HighPoint.x) / pitch);
+    index = MIN(MAX(index, 0), arrCount - 1);
+
+    if(index != self.longPressIndex)
     {
-        Y_KLinePositionModel *kLinePositionModel = self.needDrawKLinePositionModels[arrCount-1];
-        
+        self.longPressIndex = index;
         if(self.delegate && [self.delegate respondsToSelector:@selector(kLineMainViewLongPressKLinePositionModel:kLineModel:)])
         {
-            [self.delegate kLineMainViewLongPressKLinePositionModel:self.needDrawKLinePositionModels[arrCount-1] kLineModel:self.needDrawKLineModels[arrCount-1]];
+            [self.delegate kLineMainViewLongPressKLinePositionModel:self.needDrawKLinePositionModels[index] kLineModel:self.needDrawKLineModels[index]];
         }
-        
-        return kLinePositionModel.HighPoint.x;
-
     }
-    return 0.f;
+    return index;
 }
 
-/**
- *  长按的时候根据原始的y位置获得精确的y的位置
- */
-- (CGFloat)getExactYPositionWithOriginYPosition:(CGFloat)originXPosition
+- (CGPoint)crossPointAtIndex:(NSInteger)index
 {
-    CGFloat xPositoinInMainView = originXPosition;
-    NSInteger startIndex = (NSInteger)((xPositoinInMainView - self.startXPosition) / ([Y_StockChartGlobalVariable tLineGap] + [Y_StockChartGlobalVariable tLineWidth]));
-    NSInteger arrCount = self.needDrawKLinePositionModels.count;
-    for (NSInteger index = startIndex > 0 ? startIndex - 1 : 0; index < arrCount; ++index) {
-        Y_KLinePositionModel *kLinePositionModel = self.needDrawKLinePositionModels[index];
-        
-        CGFloat minX = kLinePositionModel.HighPoint.x - ([Y_StockChartGlobalVariable tLineGap] + [Y_StockChartGlobalVariable tLineWidth]/2);
-        CGFloat maxX = kLinePositionModel.HighPoint.x + ([Y_StockChartGlobalVariable tLineGap] + [Y_StockChartGlobalVariable tLineWidth]/2);
-        
-        if(xPositoinInMainView > minX && xPositoinInMainView < maxX)
-        {
-            if(self.delegate && [self.delegate respondsToSelector:@selector(kLineMainViewLongPressKLinePositionModel:kLineModel:)])
-            {
-                //[self.delegate kLineMainViewLongPressKLinePositionModel:self.needDrawKLinePositionModels[index] kLineModel:self.needDrawKLineModels[index]];
-            }
-            return kLinePositionModel.HighPoint.y;
-        }
-        
-    }
-    if (startIndex>arrCount)
-    {
-        Y_KLinePositionModel *kLinePositionModel = self.needDrawKLinePositionModels[arrCount-1];
-        return kLinePositionModel.HighPoint.y;
-    }
-    return 0.f;
+    Y_KLinePositionModel *kLinePositionModel = self.needDrawKLinePositionModels[index];
+    return CGPointMake(kLinePositionModel.HighPoint.x, kLinePositionModel.HighPoint.y);
+}
+
+- (void)endLongPress
+{
+    self.longPressIndex = NSNotFound;
 }
 
 #pragma mark 私有方法
@@ -439,10 +412,11 @@
         itemWidth = scrollViewWidth/250;
         //itemWidth = scrollViewWidth/([self.kLineModels count]+1);
     }
-    [Y_StockChartGlobalVariable settLineWith:itemWidth];
+    //分时线宽由宽度决定，TimeLineView 据此同步成交量图
+    self.config = [self.config configWithTLineWidth:itemWidth];
     
-    CGFloat lineGap = [Y_StockChartGlobalVariable tLineGap];
-    CGFloat lineWidth = [Y_StockChartGlobalVariable tLineWidth];
+    CGFloat lineGap = self.config.tLineGap;
+    CGFloat lineWidth = self.config.tLineWidth;
     NSInteger needDrawKLineCount = 1+(scrollViewWidth - lineGap)/(lineGap+lineWidth);
     
     //起始位置
@@ -509,22 +483,22 @@
             minAssert = kLineModel.Low.floatValue;
         }
         /*
-        if(kLineModel.MA7)
+        if([kLineModel MA5WithConfig:self.config])
         {
-            if (minAssert > kLineModel.MA7.floatValue) {
-                minAssert = kLineModel.MA7.floatValue;
+            if (minAssert > [kLineModel MA5WithConfig:self.config].floatValue) {
+                minAssert = [kLineModel MA5WithConfig:self.config].floatValue;
             }
-            if (maxAssert < kLineModel.MA7.floatValue) {
-                maxAssert = kLineModel.MA7.floatValue;
+            if (maxAssert < [kLineModel MA5WithConfig:self.config].floatValue) {
+                maxAssert = [kLineModel MA5WithConfig:self.config].floatValue;
             }
         }
-        if(kLineModel.MA30)
+        if([kLineModel MA30WithConfig:self.config])
         {
-            if (minAssert > kLineModel.MA30.floatValue) {
-                minAssert = kLineModel.MA30.floatValue;
+            if (minAssert > [kLineModel MA30WithConfig:self.config].floatValue) {
+                minAssert = [kLineModel MA30WithConfig:self.config].floatValue;
             }
-            if (maxAssert < kLineModel.MA30.floatValue) {
-                maxAssert = kLineModel.MA30.floatValue;
+            if (maxAssert < [kLineModel MA30WithConfig:self.config].floatValue) {
+                maxAssert = [kLineModel MA30WithConfig:self.config].floatValue;
             }
         }
         if(kLineModel.AverPrice)
@@ -569,7 +543,7 @@
     
     
     CGFloat minY = Y_StockChartKLineMainViewMinY;
-    CGFloat maxY = self.parentScrollView.frame.size.height * [Y_StockChartGlobalVariable kLineMainViewRadio] - 15;
+    CGFloat maxY = self.parentScrollView.frame.size.height * self.config.mainViewRatio - 15;
 //    CGFloat rectWidth = self.frame.size.width;
     
     CGFloat unitValue = (maxAssert - minAssert)/(maxY - minY);
@@ -594,8 +568,8 @@
         //K线坐标转换
         Y_KLineModel *kLineModel = kLineModels[idx];
         
-        //CGFloat xPosition = self.startXPosition + idx * ([Y_StockChartGlobalVariable tLineWidth] + [Y_StockChartGlobalVariable tLineGap]);
-        CGFloat xPosition = self.startXPosition + idx * ([Y_StockChartGlobalVariable tLineWidth] + [Y_StockChartGlobalVariable tLineGap]);
+        //CGFloat xPosition = self.startXPosition + idx * (self.config.tLineWidth + self.config.tLineGap);
+        CGFloat xPosition = self.startXPosition + idx * (self.config.tLineWidth + self.config.tLineGap);
         CGPoint openPoint = CGPointMake(xPosition, ABS(maxY - (kLineModel.Open.floatValue - minAssert)/unitValue));
         CGFloat closePointY = ABS(maxY - (kLineModel.Close.floatValue - minAssert)/unitValue);
         if(ABS(closePointY - openPoint.y) < Y_StockChartKLineMinWidth)
@@ -644,17 +618,17 @@
         CGFloat averY = maxY;
         if(unitValue > 0.0000001)
         {
-            if(kLineModel.MA7)
+            if([kLineModel MA5WithConfig:self.config])
             {
-                ma7Y = maxY - (kLineModel.MA7.floatValue - minAssert)/unitValue;
+                ma7Y = maxY - ([kLineModel MA5WithConfig:self.config].floatValue - minAssert)/unitValue;
             }
 
         }
         if(unitValue > 0.0000001)
         {
-            if(kLineModel.MA30)
+            if([kLineModel MA30WithConfig:self.config])
             {
-                ma30Y = maxY - (kLineModel.MA30.floatValue - minAssert)/unitValue;
+                ma30Y = maxY - ([kLineModel MA30WithConfig:self.config].floatValue - minAssert)/unitValue;
             }
         }
         if(unitValue > 0.0000001)
@@ -671,11 +645,11 @@
         CGPoint ma30Point = CGPointMake(xPosition, ma30Y);
         CGPoint averPoint = CGPointMake(xPosition, averY);
         
-        if(kLineModel.MA7)
+        if([kLineModel MA5WithConfig:self.config])
         {
             [self.MA7Positions addObject: [NSValue valueWithCGPoint: ma7Point]];
         }
-        if(kLineModel.MA30)
+        if([kLineModel MA30WithConfig:self.config])
         {
             [self.MA30Positions addObject: [NSValue valueWithCGPoint: ma30Point]];
         }
@@ -711,14 +685,14 @@ static char *observerContext = NULL;
 - (NSInteger)startXPosition
 {
     NSInteger leftArrCount = self.needDrawStartIndex;
-    CGFloat startXPosition = (leftArrCount + 1) * [Y_StockChartGlobalVariable tLineGap] + leftArrCount * [Y_StockChartGlobalVariable tLineWidth] + [Y_StockChartGlobalVariable tLineWidth]/2;
+    CGFloat startXPosition = (leftArrCount + 1) * self.config.tLineGap + leftArrCount * self.config.tLineWidth + self.config.tLineWidth/2;
     return startXPosition;
 }
 
 - (NSInteger)needDrawStartIndex
 {
     CGFloat scrollViewOffsetX = self.parentScrollView.contentOffset.x < 0 ? 0 : self.parentScrollView.contentOffset.x;
-    NSUInteger leftArrCount = ABS(scrollViewOffsetX - [Y_StockChartGlobalVariable tLineGap]) / ([Y_StockChartGlobalVariable tLineGap] + [Y_StockChartGlobalVariable tLineWidth]);
+    NSUInteger leftArrCount = ABS(scrollViewOffsetX - self.config.tLineGap) / (self.config.tLineGap + self.config.tLineWidth);
     _needDrawStartIndex = leftArrCount;
     return _needDrawStartIndex;
 }
@@ -747,7 +721,7 @@ static char *observerContext = NULL;
     if([keyPath isEqualToString:Y_StockChartContentOffsetKey])
     {
         CGFloat difValue = ABS(self.parentScrollView.contentOffset.x - self.oldContentOffsetX);
-        if(difValue >= [Y_StockChartGlobalVariable tLineGap] + [Y_StockChartGlobalVariable tLineWidth])
+        if(difValue >= self.config.tLineGap + self.config.tLineWidth)
         {
             self.oldContentOffsetX = self.parentScrollView.contentOffset.x;
             [self drawMainView];
@@ -12,7 +12,6 @@
 #import "Y_KLine.h"
 #import "Y_MALine.h"
 #import "Y_KLinePositionModel.h"
-#import "Y_StockChartGlobalVariable.h"
 #import "Masonry.h"
 #import "Defination.h"
 
@@ -44,19 +43,30 @@
  */
 @property (nonatomic, assign) CGFloat oldScale;
 
+/**
+ *  长按中的 K 线下标，没有长按时为 NSNotFound
+ */
+@property (nonatomic, assign) NSInteger longPressIndex;
+
 /**
  *  均线位置数组
  */
 @property (nonatomic, strong) NSMutableArray *AverPositions;
 
 /**
- *  MA7位置数组
+ *  MA5位置数组
  */
-@property (nonatomic, strong) NSMutableArray *MA7Positions;
+@property (nonatomic, strong) NSMutableArray *MA5Positions;
 
-@property (nonatomic, strong) NSMutableArray *MA12Positions;
+/**
+ *  MA10位置数组
+ */
+@property (nonatomic, strong) NSMutableArray *MA10Positions;
 
-@property (nonatomic, strong) NSMutableArray *MA26Positions;
+/**
+ *  MA20位置数组
+ */
+@property (nonatomic, strong) NSMutableArray *MA20Positions;
 
 
 /**
@@ -74,10 +84,11 @@
     if (self) {
         self.needDrawKLineModels = @[].mutableCopy;
         self.needDrawKLinePositionModels = @[].mutableCopy;
+        self.longPressIndex = NSNotFound;
         self.AverPositions = @[].mutableCopy;
-        self.MA7Positions = @[].mutableCopy;
-        self.MA12Positions = @[].mutableCopy;
-        self.MA26Positions = @[].mutableCopy;
+        self.MA5Positions = @[].mutableCopy;
+        self.MA10Positions = @[].mutableCopy;
+        self.MA20Positions = @[].mutableCopy;
         self.MA30Positions = @[].mutableCopy;
         _needDrawStartIndex = 0;
         self.oldContentOffsetX = 0;
@@ -146,6 +157,7 @@
     if(self.MainViewType == Y_StockChartcenterViewTypeKline)
     {
         Y_KLine *kLine = [[Y_KLine alloc]initWithContext:context];
+        kLine.config = self.config;
         kLine.maxY = Y_StockChartKLineMainViewMaxY;
 
         __block CGPoint lastDrawDatePoint = CGPointZero;
@@ -238,7 +250,7 @@
         }];
         MALine.MAPositions = positions;
         MALine.MAType = -1;
-        CGFloat maxY = self.parentScrollView.frame.size.height * [Y_StockChartGlobalVariable kLineMainViewRadio] - 12;
+        CGFloat maxY = self.parentScrollView.frame.size.height * self.config.mainViewRatio - 12;
         [MALine drawMiniWithOriginalY:maxY];
 //        
         [self.needDrawKLinePositionModels enumerateObjectsUsingBlock:^(Y_KLinePositionModel * _Nonnull positionModel, NSUInteger idx, BOOL * _Nonnull stop) {
@@ -262,7 +274,7 @@
         }];
         
         
-        //画MA7线
+        //画均价线
         MALine.MAType = Y_AverType;
         MALine.MAPositions = self.AverPositions;
         [MALine draw];
@@ -271,17 +283,19 @@
     if(self.targetLineStatus != Y_StockChartTargetLineStatusCloseMA) {
         
 
-        //画MA7线
+        //画MA5线，Y_MA7Type 等只是颜色槽位
         MALine.MAType = Y_MA7Type;
-        MALine.MAPositions = self.MA7Positions;
+        MALine.MAPositions = self.MA5Positions;
         [MALine draw];
         
+        //画MA10线
         MALine.MAType = Y_MA12Type;
-        MALine.MAPositions = self.MA12Positions;
+        MALine.MAPositions = self.MA10Positions;
         [MALine draw];
 
+        //画MA20线
         MALine.MAType = Y_MA26Type;
-        MALine.MAPositions = self.MA26Positions;
+        MALine.MAPositions = self.MA20Positions;
         [MALine draw];
 
         //画MA30线
@@ -317,6 +331,8 @@
     {
         NSAssert(self.kLineModels, @"kLineModels不能为空");
         
+        //重新取了需要画的 K 线，长按下标要重新对应
+        self.longPressIndex = NSNotFound;
         //提取需要的kLineModel
         [self private_extractNeedDrawModels];
         //转换model为坐标model
@@ -334,8 +350,8 @@
 - (void)updateMainViewWidth
 {
     //根据stockModels的个数和间隔和K线的宽度计算出self的宽度，并设置contentsize
-    //CGFloat kLineViewWidth = self.kLineModels.count * [Y_StockChartGlobalVariable kLineWidth] + (self.kLineModels.count + 1) * [Y_StockChartGlobalVariable kLineGap] + 10;
-    CGFloat kLineViewWidth = self.kLineModels.count * [Y_StockChartGlobalVariable kLineWidth] + (self.kLineModels.count + 1) * [Y_StockChartGlobalVariable kLineGap];
+    //CGFloat kLineViewWidth = self.kLineModels.count * self.config.kLineWidth + (self.kLineModels.count + 1) * self.config.kLineGap + 10;
+    CGFloat kLineViewWidth = self.kLineModels.count * self.config.kLineWidth + (self.kLineModels.count + 1) * self.config.kLineGap;
     
     float scale = 0.0;
     if(self.parentScrollView.contentSize.width>0)scale = kLineViewWidth /self.parentScrollView.contentSize.width;
@@ -379,7 +395,7 @@
     
     
     
-//    CGFloat offsetX = _needDrawStartIndex * [Y_StockChartGlobalVariable kLineWidth] + (self.kLineModels.count + 1) * [Y_StockChartGlobalVariable kLineGap];// + 10;
+//    CGFloat offsetX = _needDrawStartIndex * self.config.kLineWidth + (self.kLineModels.count + 1) * self.config.kLineGap;// + 10;
 //    
 //    CGFloat offset = offsetX - self.parentScrollView.frame.size.width;
 //    
@@ -395,79 +411,41 @@
 
 }
 
-/**
- *  长按的时候根据原始的x位置获得精确的x的位置
- */
-- (CGFloat)getExactXPositionWithOriginXPosition:(CGFloat)originXPosition
+#pragma mark 长按
+- (NSInteger)longPressIndexWithOriginXPosition:(CGFloat)originXPosition
 {
-    CGFloat xPositoinInMainView = originXPosition;
-    NSInteger startIndex = (NSInteger)((xPositoinInMainView - self.startXPosition) / ([Y_StockChartGlobalVariable kLineGap] + [Y_StockChartGlobalVariable kLineWidth]));
     NSInteger arrCount = self.needDrawKLinePositionModels.count;
-    for (NSInteger index = startIndex > 0 ? startIndex - 1 : 0; index < arrCount; ++index) {
-        Y_KLinePositionModel *kLinePositionModel = self.needDrawKLinePositionModels[index];
-        
-        CGFloat minX = kLinePositionModel.HighPoint.x - ([Y_StockChartGlobalVariable kLineGap] + [Y_StockChartGlobalVariable kLineWidth]/2);
-        CGFloat maxX = kLinePositionModel.HighPoint.x + ([Y_StockChartGlobalVariable kLineGap] + [Y_StockChartGlobalVariable kLineWidth]/2);
-        
-        if(xPositoinInMainView > minX && xPositoinInMainView < maxX)
-        {
-            if(self.delegate && [self.delegate respondsToSelector:@selector(kLineMainViewLongPressKLinePositionModel:kLineModel:)])
-            {
-                [self.delegate kLineMainViewLongPressKLinePositionModel:self.needDrawKLinePositionModels[index] kLineModel:self.needDrawKLineModels[index]];
-            }
-            return kLinePositionModel.HighPoint.x;
-        }
-        
-
+    if(arrCount == 0)
+    {
+        return NSNotFound;
     }
-    if (startIndex>arrCount)
+    //第 i 根的 x 为第一根的 x + i * 间距
+    Y_KLinePositionModel *firstPositionModel = self.needDrawKLinePositionModels.firstObject;
+    CGFloat pitch = self.config.kLineGap + self.config.kLineWidth;
+    NSInteger index = (NSInteger)lround((originXPosition - firstPositionModel.HighPoint.x) / pitch);
+    index = MIN(MAX(index, 0), arrCount - 1);
+
+    if(index != self.longPressIndex)
     {
-        Y_KLinePositionModel *kLinePositionModel = self.needDrawKLinePositionModels[arrCount-1];
-        
+        self.longPressIndex = index;
         if(self.delegate && [self.delegate respondsToSelector:@selector(kLineMainViewLongPressKLinePositionModel:kLineModel:)])
         {
-            [self.delegate kLineMainViewLongPressKLinePositionModel:self.needDrawKLinePositionModels[arrCount-1] kLineModel:self.needDrawKLineModels[arrCount-1]];
+            [self.delegate kLineMainViewLongPressKLinePositionModel:self.needDrawKLinePositionModels[index] kLineModel:self.needDrawKLineModels[index]];
         }
-        
-        return kLinePositionModel.HighPoint.x;
     }
-    return 0.f;
+    return index;
 }
 
-/**
- *  长按的时候根据原始的y位置获得精确的y的位置
- */
-- (CGFloat)getExactYPositionWithOriginYPosition:(CGFloat)originXPosition
+- (CGPoint)crossPointAtIndex:(NSInteger)index
 {
-    CGFloat xPositoinInMainView = originXPosition;
-    NSInteger startIndex = (NSInteger)((xPositoinInMainView - self.startXPosition) / ([Y_StockChartGlobalVariable kLineGap] + [Y_StockChartGlobalVariable kLineWidth]));
-    NSInteger arrCount = self.needDrawKLinePositionModels.count;
-    for (NSInteger index = startIndex > 0 ? startIndex - 1 : 0; index < arrCount; ++index) {
-        Y_KLinePositionModel *kLinePositionModel = self.needDrawKLinePositionModels[index];
-        
-        CGFloat minX = kLinePositionModel.HighPoint.x - ([Y_StockChartGlobalVariable kLineGap] + [Y_StockChartGlobalVariable kLineWidth]/2);
-        CGFloat maxX = kLinePositionModel.HighPoint.x + ([Y_StockChartGlobalVariable kLineGap] + [Y_StockChartGlobalVariable kLineWidth]/2);
-        
-        if(xPositoinInMainView > minX && xPositoinInMainView < maxX)
-        {
-            if(self.delegate && [self.delegate respondsToSelector:@selector(kLineMainViewLongPressKLinePositionModel:kLineModel:)])
-            {
-                //[self.delegate kLineMainViewLongPressKLinePositionModel:self.needDrawKLinePositionModels[index] kLineModel:self.needDrawKLineModels[index]];
-            }
-            //return kLinePositionModel.HighPoint.y;
-            return kLinePositionModel.ClosePoint.y;
-        }
-        
-    }
-    if (startIndex>arrCount)
-    {
-        Y_KLinePositionModel *kLinePositionModel = self.needDrawKLinePositionModels[arrCount-1];
-        //return kLinePositionModel.HighPoint.y;
-        return kLinePositionModel.ClosePoint.y;
-    }
-    return 0.f;
+    Y_KLinePositionModel *kLinePositionModel = self.needDrawKLinePositionModels[index];
+    return CGPointMake(kLinePositionModel.HighPoint.x, kLinePositionModel.ClosePoint.y);
 }
 
+- (void)endLongPress
+{
+    self.longPressIndex = NSNotFound;
+}
 
 #pragma mark 私有方法
 //提取需要绘制的数组
@@ -479,8 +457,8 @@
     CGFloat scrollViewWidth = self.parentScrollView.frame.size.width;
     
     
-    CGFloat lineGap = [Y_StockChartGlobalVariable kLineGap];
-    CGFloat lineWidth = [Y_StockChartGlobalVariable kLineWidth];
+    CGFloat lineGap = self.config.kLineGap;
+    CGFloat lineWidth = self.config.kLineWidth;
     NSInteger needDrawKLineCount = 1+(scrollViewWidth - lineGap)/(lineGap+lineWidth);//+1
     
     //起始位置
@@ -548,22 +526,22 @@
         {
             minAssert = kLineModel.Low.floatValue;
         }
-//        if(kLineModel.MA7)
+//        if([kLineModel MA5WithConfig:self.config])
 //        {
-//            if (minAssert > kLineModel.MA7.floatValue) {
-//                minAssert = kLineModel.MA7.floatValue;
+//            if (minAssert > [kLineModel MA5WithConfig:self.config].floatValue) {
+//                minAssert = [kLineModel MA5WithConfig:self.config].floatValue;
 //            }
-//            if (maxAssert < kLineModel.MA7.floatValue) {
-//                maxAssert = kLineModel.MA7.floatValue;
+//            if (maxAssert < [kLineModel MA5WithConfig:self.config].floatValue) {
+//                maxAssert = [kLineModel MA5WithConfig:self.config].floatValue;
 //            }
 //        }
-//        if(kLineModel.MA30)
+//        if([kLineModel MA30WithConfig:self.config])
 //        {
-//            if (minAssert > kLineModel.MA30.floatValue) {
-//                minAssert = kLineModel.MA30.floatValue;
+//            if (minAssert > [kLineModel MA30WithConfig:self.config].floatValue) {
+//                minAssert = [kLineModel MA30WithConfig:self.config].floatValue;
 //            }
-//            if (maxAssert < kLineModel.MA30.floatValue) {
-//                maxAssert = kLineModel.MA30.floatValue;
+//            if (maxAssert < [kLineModel MA30WithConfig:self.config].floatValue) {
+//                maxAssert = [kLineModel MA30WithConfig:self.config].floatValue;
 //            }
 //        }
 //        if(kLineModel.AverPrice)
@@ -600,7 +578,7 @@
     
     
     CGFloat minY = Y_StockChartKLineMainViewMinY;
-    CGFloat maxY = self.parentScrollView.frame.size.height * [Y_StockChartGlobalVariable kLineMainViewRadio] - 15;
+    CGFloat maxY = self.parentScrollView.frame.size.height * self.config.mainViewRatio - 15;
 //    CGFloat rectWidth = self.frame.size.width;
     
     CGFloat unitValue = (maxAssert - minAssert)/(maxY - minY);
@@ -612,9 +590,9 @@
     
     [self.needDrawKLinePositionModels removeAllObjects];
     [self.AverPositions removeAllObjects];
-    [self.MA7Positions removeAllObjects];
-    [self.MA12Positions removeAllObjects];
-    [self.MA26Positions removeAllObjects];
+    [self.MA5Positions removeAllObjects];
+    [self.MA10Positions removeAllObjects];
+    [self.MA20Positions removeAllObjects];
     [self.MA30Positions removeAllObjects];
     
     NSInteger kLineModelsCount = kLineModels.count;
@@ -627,8 +605,8 @@
         //K线坐标转换
         Y_KLineModel *kLineModel = kLineModels[idx];
         
-        //CGFloat xPosition = self.startXPosition + idx * ([Y_StockChartGlobalVariable kLineWidth] + [Y_StockChartGlobalVariable kLineGap]);
-        CGFloat xPosition = self.startXPosition + idx * ([Y_StockChartGlobalVariable kLineWidth] + [Y_StockChartGlobalVariable kLineGap]);
+        //CGFloat xPosition = self.startXPosition + idx * (self.config.kLineWidth + self.config.kLineGap);
+        CGFloat xPosition = self.startXPosition + idx * (self.config.kLineWidth + self.config.kLineGap);
         CGPoint openPoint = CGPointMake(xPosition, ABS(maxY - (kLineModel.Open.floatValue - minAssert)/unitValue));
         CGFloat closePointY = ABS(maxY - (kLineModel.Close.floatValue - minAssert)/unitValue);
         if(ABS(closePointY - openPoint.y) < Y_StockChartKLineMinWidth)
@@ -672,40 +650,40 @@
          
         
         //MA坐标转换
-        CGFloat ma7Y = maxY;
-        CGFloat ma12Y = maxY;
-        CGFloat ma26Y = maxY;
+        CGFloat ma5Y = maxY;
+        CGFloat ma10Y = maxY;
+        CGFloat ma20Y = maxY;
         CGFloat ma30Y = maxY;
         CGFloat averY = maxY;
         if(unitValue > 0.0000001)
         {
-            if(kLineModel.MA7)
+            if([kLineModel MA5WithConfig:self.config])
             {
-                ma7Y = maxY - (kLineModel.MA7.floatValue - minAssert)/unitValue;
+                ma5Y = maxY - ([kLineModel MA5WithConfig:self.config].floatValue - minAssert)/unitValue;
             }
 
         }
         if(unitValue > 0.0000001)
         {
-            if(kLineModel.MA12)
+            if(kLineModel.MA10)
             {
-                ma12Y = maxY - (kLineModel.MA12.floatValue - minAssert)/unitValue;
+                ma10Y = maxY - (kLineModel.MA10.floatValue - minAssert)/unitValue;
             }
             
         }
         if(unitValue > 0.0000001)
         {
-            if(kLineModel.MA26)
+            if(kLineModel.MA20)
             {
-                ma26Y = maxY - (kLineModel.MA26.floatValue - minAssert)/unitValue;
+                ma20Y = maxY - (kLineModel.MA20.floatValue - minAssert)/unitValue;
             }
             
         }
         if(unitValue > 0.0000001)
         {
-            if(kLineModel.MA30)
+            if([kLineModel MA30WithConfig:self.config])
             {
-                ma30Y = maxY - (kLineModel.MA30.floatValue - minAssert)/unitValue;
+                ma30Y = maxY - ([kLineModel MA30WithConfig:self.config].floatValue - minAssert)/unitValue;
             }
         }
         if(unitValue > 0.0000001)
@@ -716,27 +694,27 @@
             }
         }
         
-        NSAssert(!isnan(ma7Y) && !isnan(ma30Y)&&!isnan(averY), @"出现NAN值");
+        NSAssert(!isnan(ma5Y) && !isnan(ma30Y)&&!isnan(averY), @"出现NAN值");
         
-        CGPoint ma7Point = CGPointMake(xPosition, ma7Y);
-        CGPoint ma12Point = CGPointMake(xPosition, ma12Y);
-        CGPoint ma26Point = CGPointMake(xPosition, ma26Y);
+        CGPoint ma5Point = CGPointMake(xPosition, ma5Y);
+        CGPoint ma10Point = CGPointMake(xPosition, ma10Y);
+        CGPoint ma20Point = CGPointMake(xPosition, ma20Y);
         CGPoint ma30Point = CGPointMake(xPosition, ma30Y);
         CGPoint averPoint = CGPointMake(xPosition, averY);
         
-        if(kLineModel.MA7)
+        if([kLineModel MA5WithConfig:self.config])
         {
-            [self.MA7Positions addObject: [NSValue valueWithCGPoint: ma7Point]];
+            [self.MA5Positions addObject: [NSValue valueWithCGPoint: ma5Point]];
         }
-        if(kLineModel.MA12)
+        if(kLineModel.MA10)
         {
-            [self.MA12Positions addObject: [NSValue valueWithCGPoint: ma12Point]];
+            [self.MA10Positions addObject: [NSValue valueWithCGPoint: ma10Point]];
         }
-        if(kLineModel.MA26)
+        if(kLineModel.MA20)
         {
-            [self.MA26Positions addObject: [NSValue valueWithCGPoint: ma26Point]];
+            [self.MA20Positions addObject: [NSValue valueWithCGPoint: ma20Point]];
         }
-        if(kLineModel.MA30)
+        if([kLineModel MA30WithConfig:self.config])
         {
             [self.MA30Positions addObject: [NSValue valueWithCGPoint: ma30Point]];
         }
@@ -772,7 +750,7 @@ static char *observerContext = NULL;
 - (NSInteger)startXPosition
 {
     NSInteger leftArrCount = self.needDrawStartIndex;
-    CGFloat startXPosition = (leftArrCount + 1) * [Y_StockChartGlobalVariable kLineGap] + leftArrCount * [Y_StockChartGlobalVariable kLineWidth] + [Y_StockChartGlobalVariable kLineWidth]/2;
+    CGFloat startXPosition = (leftArrCount + 1) * self.config.kLineGap + leftArrCount * self.config.kLineWidth + self.config.kLineWidth/2;
     return startXPosition;
 }
 
@@ -784,7 +762,7 @@ static char *observerContext = NULL;
         CGFloat scrollViewOffsetX = self.parentScrollView.contentOffset.x < 0 ? 0 : self.parentScrollView.contentOffset.x;
         
 
-        NSUInteger leftArrCount = ABS(scrollViewOffsetX - [Y_StockChartGlobalVariable kLineGap]) / ([Y_StockChartGlobalVariable kLineGap] + [Y_StockChartGlobalVariable kLineWidth]);
+        NSUInteger leftArrCount = ABS(scrollViewOffsetX - self.config.kLineGap) / (self.config.kLineGap + self.config.kLineWidth);
         _needDrawStartIndex = leftArrCount;
         return _needDrawStartIndex;
 
@@ -794,8 +772,8 @@ static char *observerContext = NULL;
 //        CGPoint p1 = [pinch locationOfTouch:0 inView:self.scrollView];
 //        CGPoint p2 = [pinch locationOfTouch:1 inView:self.scrollView];
 //        CGPoint centerPoint = CGPointMake((p1.x+p2.x)/2, (p1.y+p2.y)/2);
-//        NSUInteger oldLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - [Y_StockChartGlobalVariable kLineGap]) / ([Y_StockChartGlobalVariable kLineGap] + oldKLineWidth);
-//        NSUInteger newLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - [Y_StockChartGlobalVariable kLineGap]) / ([Y_StockChartGlobalVariable kLineGap] + [Y_StockChartGlobalVariable kLineWidth]);
+//        NSUInteger oldLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - self.config.kLineGap) / (self.config.kLineGap + oldKLineWidth);
+//        NSUInteger newLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - self.config.kLineGap) / (self.config.kLineGap + self.config.kLineWidth);
 //        
 //        NSLog(@"----centerPoint x:%lf y:%lf",centerPoint.x, centerPoint.y);
 //        NSLog(@"----self.scrollView.contentOffset.x:%lf",self.scrollView.contentOffset.x);
@@ -831,7 +809,7 @@ static char *observerContext = NULL;
     if([keyPath isEqualToString:Y_StockChartContentOffsetKey])
     {
         CGFloat difValue = ABS(self.parentScrollView.contentOffset.x - self.oldContentOffsetX);
-        if(difValue >= [Y_StockChartGlobalVariable kLineGap] + [Y_StockChartGlobalVariable kLineWidth])
+        if(difValue >= self.config.kLineGap + self.config.kLineWidth)
         {
             self.oldContentOffsetX = self.parentScrollView.contentOffset.x;
             [self drawMainView];
@@ -0,0 +1,23 @@
+//
+//  Y_KLineCoreBridge.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  kline_core 与接口数据之间的转换
+ *
+ *  指标(含主图和成交量的均线)见 Y_KLineIndicator，由 Y_KLineGroupModel 按需计算。
+ */
+@interface Y_KLineCoreBridge : NSObject
+
+//接口 chartInfLst 字典与 kline_bar 互转，data 内为连续的 kline_bar
+//均价按成交量加权换算成成交额，缺失的开高低取收盘价
++ (NSMutableData *)barDataWithDictionaries:(NSArray<NSDictionary *> *)arr;
++ (NSArray<NSDictionary *> *)dictionariesWithBarData:(NSData *)data;
+
+@end
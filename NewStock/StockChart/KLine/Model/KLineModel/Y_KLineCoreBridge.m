@@ -0,0 +1,60 @@
+//
+//  Y_KLineCoreBridge.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "Y_KLineCoreBridge.h"
+#import "kline_core.h"
+
+static double KLineDouble(id value, double fallback) {
+    return [value isKindOfClass:[NSNumber class]] ? [value doubleValue] : fallback;
+}
+
+@implementation Y_KLineCoreBridge
+
++ (NSMutableData *)barDataWithDictionaries:(NSArray<NSDictionary *> *)arr {
+    NSMutableData *data = [NSMutableData dataWithLength:arr.count * sizeof(kline_bar)];
+    kline_bar *bars = data.mutableBytes;
+    for (NSUInteger i = 0; i < arr.count; i++) {
+        NSDictionary *dic = arr[i];
+        kline_bar *bar = &bars[i];
+        bar->time = [[dic objectForKey:@"createChartTime"] longLongValue];
+        bar->close = KLineDouble([dic objectForKey:@"close"], 0);
+        bar->open = KLineDouble([dic objectForKey:@"open"], bar->close);
+        bar->high = KLineDouble([dic objectForKey:@"high"], bar->close);
+        bar->low = KLineDouble([dic objectForKey:@"low"], bar->close);
+        bar->volume = KLineDouble([dic objectForKey:@"volume"], 0);
+        bar->average_price = KLineDouble([dic objectForKey:@"averagePrice"], NAN);
+        bar->prev_close = KLineDouble([dic objectForKey:@"prevClose"], NAN);
+    }
+    return data;
+}
+
++ (NSArray<NSDictionary *> *)dictionariesWithBarData:(NSData *)data {
+    const kline_bar *bars = data.bytes;
+    NSUInteger n = data.length / sizeof(kline_bar);
+    NSMutableArray *result = [NSMutableArray arrayWithCapacity:n];
+    for (NSUInteger i = 0; i < n; i++) {
+        const kline_bar *bar = &bars[i];
+        NSMutableDictionary *dic = [NSMutableDictionary dictionaryWithCapacity:8];
+        dic[@"createChartTime"] = @(bar->time);
+        dic[@"open"] = @(bar->open);
+        dic[@"high"] = @(bar->high);
+        dic[@"low"] = @(bar->low);
+        dic[@"close"] = @(bar->close);
+        dic[@"volume"] = @(bar->volume);
+        if (!kline_is_missing(bar->average_price)) {
+            dic[@"averagePrice"] = @(bar->average_price);
+        }
+        if (!kline_is_missing(bar->prev_close)) {
+            dic[@"prevClose"] = @(bar->prev_close);
+        }
+        [result addObject:dic];
+    }
+    return result;
+}
+
+@end
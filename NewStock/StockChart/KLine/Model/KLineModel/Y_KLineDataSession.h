@@ -0,0 +1,49 @@
+//
+//  Y_KLineDataSession.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+@class Y_KLineGroupModel;
+
+//chartTyp 有新数据，在主线程回调
+typedef void (^Y_KLineDataSessionUpdateBlock)(NSString *chartTyp, Y_KLineGroupModel *groupModel);
+
+/**
+ *  一只股票/指数的 K 线数据
+ *
+ *  保存各周期算好指标的 Y_KLineGroupModel，供同一只股票的详情页、横屏页共用，
+ *  横竖屏切换不用重新请求和计算。按股票共享、引用计数：页面 acquire 后持有，dealloc 时 relinquish，
+ *  没有页面使用时释放。
+ *  加载顺序：内存 -> 本地聚合 -> 磁盘缓存 -> 增量请求；同一周期的请求进行中时不重复发起。
+ */
+@interface Y_KLineDataSession : NSObject
+
+@property (nonatomic, copy, readonly) NSString *symbolTyp;
+@property (nonatomic, copy, readonly) NSString *symbol;
+@property (nonatomic, copy, readonly) NSString *marketCd;
+
++ (instancetype)acquireSessionWithSymbolTyp:(NSString *)symbolTyp
+                                     symbol:(NSString *)symbol
+                                   marketCd:(NSString *)marketCd;
+- (void)relinquish;
+
+//内存中 chartTyp 的数据；没有时尝试用已加载的周期本地聚合，仍没有返回 nil
+- (Y_KLineGroupModel *)groupModelForChartType:(NSString *)chartTyp;
+
+//加载/刷新 chartTyp，没有任何数据时在 animatingView 上显示加载中；completion 在请求结束后回调
+- (void)loadChartType:(NSString *)chartTyp
+        animatingView:(UIView *)animatingView
+           completion:(void (^)(BOOL success))completion;
+
+//指标参数修改后丢掉各周期里该指标的缓存，下次取用时按新参数计算
+- (void)removeIndicatorSeriesNamed:(NSString *)name;
+
+//observer 释放后自动移除，block 中不要强引用 observer
+- (void)addObserver:(id)observer usingBlock:(Y_KLineDataSessionUpdateBlock)block;
+- (void)removeObserver:(id)observer;
+
+@end
@@ -0,0 +1,223 @@
+//
+//  Y_KLineDataSession.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "Y_KLineDataSession.h"
+#import "Y_KLineGroupModel.h"
+#import "Y_KLineDiskCache.h"
+#import "KLineInfoAPI.h"
+#import "APIBaseRequest+AnimatingAccessory.h"
+
+//正在使用的会话，key 为 symbolTyp_marketCd_symbol
+static NSMutableDictionary<NSString *, Y_KLineDataSession *> *activeSessions;
+
+@interface Y_KLineDataSession ()
+{
+    NSInteger _refCount;
+    NSMutableDictionary<NSString *, Y_KLineGroupModel *> *_groups;
+    NSMutableDictionary<NSString *, NSMutableArray *> *_pendingCompletions;
+    NSMutableDictionary<NSString *, KLineInfoAPI *> *_requests;
+    NSMapTable<id, Y_KLineDataSessionUpdateBlock> *_observers;
+}
+@property (nonatomic, copy, readwrite) NSString *symbolTyp;
+@property (nonatomic, copy, readwrite) NSString *symbol;
+@property (nonatomic, copy, readwrite) NSString *marketCd;
+@end
+
+@implementation Y_KLineDataSession
+
++ (NSString *)keyWithSymbolTyp:(NSString *)symbolTyp symbol:(NSString *)symbol marketCd:(NSString *)marketCd {
+    return [NSString stringWithFormat:@"%@_%@_%@", symbolTyp, marketCd, symbol];
+}
+
++ (instancetype)acquireSessionWithSymbolTyp:(NSString *)symbolTyp
+                                     symbol:(NSString *)symbol
+                                   marketCd:(NSString *)marketCd {
+    NSAssert([NSThread isMainThread], @"chart data session must be used on main thread");
+    if (!activeSessions) {
+        activeSessions = [NSMutableDictionary dictionary];
+    }
+    NSString *key = [self keyWithSymbolTyp:symbolTyp symbol:symbol marketCd:marketCd];
+    Y_KLineDataSession *session = activeSessions[key];
+    if (!session) {
+        session = [[Y_KLineDataSession alloc] init];
+        session.symbolTyp = symbolTyp;
+        session.symbol = symbol;
+        session.marketCd = marketCd;
+        activeSessions[key] = session;
+    }
+    session->_refCount++;
+    return session;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _groups = [NSMutableDictionary dictionary];
+        _pendingCompletions = [NSMutableDictionary dictionary];
+        _requests = [NSMutableDictionary dictionary];
+        _observers = [NSMapTable weakToStrongObjectsMapTable];
+    }
+    return self;
+}
+
+- (void)relinquish {
+    NSAssert([NSThread isMainThread], @"chart data session must be used on main thread");
+    if (_refCount <= 0) {
+        return;
+    }
+    if (--_refCount > 0) {
+        return;
+    }
+
+    [activeSessions removeObjectForKey:[Y_KLineDataSession keyWithSymbolTyp:_symbolTyp symbol:_symbol marketCd:_marketCd]];
+    for (KLineInfoAPI *request in _requests.allValues) {
+        [request stop];
+    }
+    for (NSString *chartTyp in _pendingCompletions.allKeys) {
+        [self finishChartType:chartTyp success:NO];
+    }
+    [_requests removeAllObjects];
+}
+
+#pragma mark data
+
+- (Y_KLineGroupModel *)groupModelForChartType:(NSString *)chartTyp {
+    if (chartTyp == nil) {
+        return nil;
+    }
+    Y_KLineGroupModel *groupModel = _groups[chartTyp];
+    if (!groupModel && _groups.count > 0) {
+        //先用已加载的周期本地聚合显示，服务端数据回来后替换
+        groupModel = [Y_KLineGroupModel objectDerivedForChartType:chartTyp fromGroups:_groups.allValues];
+        if (groupModel) {
+            _groups[chartTyp] = groupModel;
+        }
+    }
+    return groupModel;
+}
+
+- (void)loadChartType:(NSString *)chartTyp
+        animatingView:(UIView *)animatingView
+           completion:(void (^)(BOOL success))completion {
+    NSAssert([NSThread isMainThread], @"chart data session must be used on main thread");
+    if (chartTyp == nil) {
+        if (completion) completion(NO);
+        return;
+    }
+
+    //同一周期正在加载，等这次的结果
+    NSMutableArray *completions = _pendingCompletions[chartTyp];
+    if (completions) {
+        if (completion) [completions addObject:[completion copy]];
+        return;
+    }
+    completions = [NSMutableArray array];
+    if (completion) [completions addObject:[completion copy]];
+    _pendingCompletions[chartTyp] = completions;
+
+    Y_KLineGroupModel *current = _groups[chartTyp];
+    if (current && !current.isDerived) {
+        [self requestChartType:chartTyp animatingView:animatingView];
+        return;
+    }
+
+    //先显示磁盘缓存，再只请求缓存之后的数据；股票信息不全时不走缓存
+    NSString *cacheKey = [Y_KLineDiskCache keyWithSymbolTyp:_symbolTyp symbol:_symbol marketCd:_marketCd chartTyp:chartTyp];
+    if (!cacheKey) {
+        [self requestChartType:chartTyp animatingView:animatingView];
+        return;
+    }
+    [[Y_KLineDiskCache sharedY_KLineDiskCache] loadBarsForKey:cacheKey completion:^(NSArray<NSDictionary *> *bars) {
+        if (!_pendingCompletions[chartTyp]) {
+            return;
+        }
+        Y_KLineGroupModel *shown = _groups[chartTyp];
+        if (bars && (!shown || shown.isDerived)) {
+            [self updateChartType:chartTyp groupModel:[Y_KLineGroupModel objectWithArray:bars chartType:chartTyp]];
+        }
+        [self requestChartType:chartTyp animatingView:animatingView];
+    }];
+}
+
+- (void)requestChartType:(NSString *)chartTyp animatingView:(UIView *)animatingView {
+    KLineInfoAPI *api = [[KLineInfoAPI alloc] initWithSymbolTyp:_symbolTyp symbol:_symbol marketCd:_marketCd chartTyp:chartTyp];
+    api.ignoreCache = YES;
+
+    Y_KLineGroupModel *current = _groups[chartTyp];
+    NSString *cacheKey = [Y_KLineDiskCache keyWithSymbolTyp:_symbolTyp symbol:_symbol marketCd:_marketCd chartTyp:chartTyp];
+    //没有缓存时增量的结果无处合并，整段请求
+    long long sinceTime = cacheKey ? [Y_KLineDiskCache sinceTimeForGroup:current chartType:chartTyp] : 0;
+    api.sinceTime = sinceTime;
+
+    if (!current) {
+        api.animatingView = animatingView;
+        api.animatingText = @"数据加载中...";
+    }
+    _requests[chartTyp] = api;
+
+    [api startWithCompletionBlockWithSuccess:^(APIBaseRequest *request) {
+        NSArray *bars = request.responseJSONObject[@"chartInfLst"];
+        [[Y_KLineDiskCache sharedY_KLineDiskCache] saveBars:bars forKey:cacheKey incremental:(sinceTime > 0) completion:^(NSArray<NSDictionary *> *merged) {
+            if (_requests[chartTyp] != api) {
+                return;
+            }
+            [self updateChartType:chartTyp groupModel:[Y_KLineGroupModel objectWithArray:merged chartType:chartTyp]];
+            [self finishChartType:chartTyp success:YES];
+        }];
+    } failure:^(APIBaseRequest *request) {
+        DLog(@"kline: request %@ %@ chartTyp=%@ failed: %@", _marketCd, _symbol, chartTyp, request.requestOperationError);
+        if (_requests[chartTyp] == api) {
+            [self finishChartType:chartTyp success:NO];
+        }
+    }];
+}
+
+- (void)updateChartType:(NSString *)chartTyp groupModel:(Y_KLineGroupModel *)groupModel {
+    if (!groupModel) {
+        return;
+    }
+    //已显示过的指标只补算变化的 K 线
+    [groupModel inheritIndicatorsFromGroup:_groups[chartTyp]];
+    _groups[chartTyp] = groupModel;
+
+    for (id observer in [[_observers keyEnumerator] allObjects]) {
+        Y_KLineDataSessionUpdateBlock block = [_observers objectForKey:observer];
+        if (block) block(chartTyp, groupModel);
+    }
+}
+
+- (void)finishChartType:(NSString *)chartTyp success:(BOOL)success {
+    [_requests removeObjectForKey:chartTyp];
+    NSArray *completions = _pendingCompletions[chartTyp];
+    [_pendingCompletions removeObjectForKey:chartTyp];
+    for (void (^completion)(BOOL) in completions) {
+        completion(success);
+    }
+}
+
+- (void)removeIndicatorSeriesNamed:(NSString *)name {
+    for (Y_KLineGroupModel *groupModel in [_groups allValues]) {
+        [groupModel removeSeriesForIndicatorName:name];
+    }
+}
+
+#pragma mark observer
+
+- (void)addObserver:(id)observer usingBlock:(Y_KLineDataSessionUpdateBlock)block {
+    if (observer && block) {
+        [_observers setObject:[block copy] forKey:observer];
+    }
+}
+
+- (void)removeObserver:(id)observer {
+    if (observer) {
+        [_observers removeObjectForKey:observer];
+    }
+}
+
+@end
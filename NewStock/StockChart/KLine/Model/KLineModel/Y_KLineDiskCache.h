@@ -0,0 +1,43 @@
+//
+//  Y_KLineDiskCache.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ARCSingletonTemplate.h"
+@class Y_KLineGroupModel;
+
+/**
+ *  K 线磁盘缓存(kline_core kline_store)
+ *
+ *  按股票+周期保存接口返回的 K 线，再次打开时先显示缓存，只请求最后一根之后的数据。
+ *  新数据以段的形式追加，段数多了自动合并，总大小超过上限按最近使用淘汰。
+ *  读写都在串行队列上，回调在主线程。
+ */
+@interface Y_KLineDiskCache : NSObject
+
+SYNTHESIZE_SINGLETON_FOR_HEADER(Y_KLineDiskCache)
+
+//任一项为空时返回 nil，调用方不缓存；key 为 nil 时读取得到 nil，保存原样返回
++ (NSString *)keyWithSymbolTyp:(NSString *)symbolTyp
+                        symbol:(NSString *)symbol
+                      marketCd:(NSString *)marketCd
+                      chartTyp:(NSString *)chartTyp;
+
+//增量请求的起始时间，group 为空、本地聚合的或不支持增量的周期返回 0
++ (long long)sinceTimeForGroup:(Y_KLineGroupModel *)group chartType:(NSString *)chartTyp;
++ (long long)sinceTimeForBars:(NSArray<NSDictionary *> *)bars chartType:(NSString *)chartTyp;
+
+//读取缓存的 K 线(chartInfLst 格式)，没有时为 nil
+- (void)loadBarsForKey:(NSString *)key completion:(void (^)(NSArray<NSDictionary *> *bars))completion;
+
+//保存接口返回的数据，incremental 为 YES 时与已有数据合并，返回完整的序列
+- (void)saveBars:(NSArray<NSDictionary *> *)bars
+          forKey:(NSString *)key
+     incremental:(BOOL)incremental
+      completion:(void (^)(NSArray<NSDictionary *> *bars))completion;
+
+@end
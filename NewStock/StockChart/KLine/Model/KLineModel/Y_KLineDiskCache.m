@@ -0,0 +1,159 @@
+//
+//  Y_KLineDiskCache.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "Y_KLineDiskCache.h"
+#import "Y_KLineGroupModel.h"
+#import "Y_KLineCoreBridge.h"
+#import "kline_core.h"
+
+//所有 K 线缓存文件的总大小上限
+static const size_t kKLineDiskCacheCapacity = 20 * 1024 * 1024;
+
+//缓存 key 的一项，nil、NSNull 和空串都算缺失
+static NSString *KLineKeyComponent(id value) {
+    if ([value isKindOfClass:[NSNumber class]]) {
+        value = [value stringValue];
+    }
+    return [value isKindOfClass:[NSString class]] && [value length] > 0 ? value : nil;
+}
+
+@interface Y_KLineDiskCache ()
+{
+    kline_store *_store;
+    dispatch_queue_t _ioQueue;
+}
+@end
+
+@implementation Y_KLineDiskCache
+SYNTHESIZE_SINGLETON_FOR_CLASS(Y_KLineDiskCache)
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _ioQueue = dispatch_queue_create("com.newstock.klinecache", DISPATCH_QUEUE_SERIAL);
+
+        NSString *pathOfCaches = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+        NSString *dir = [pathOfCaches stringByAppendingPathComponent:@"kline"];
+        [[NSFileManager defaultManager] createDirectoryAtPath:dir withIntermediateDirectories:YES attributes:nil error:nil];
+        _store = kline_store_open([dir fileSystemRepresentation], kKLineDiskCacheCapacity);
+        if (!_store) {
+            DLog(@"kline cache: cannot open %@", dir);
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    kline_store_close(_store);
+}
+
++ (NSString *)keyWithSymbolTyp:(NSString *)symbolTyp
+                        symbol:(NSString *)symbol
+                      marketCd:(NSString *)marketCd
+                      chartTyp:(NSString *)chartTyp {
+    NSString *typ = KLineKeyComponent(symbolTyp);
+    NSString *market = KLineKeyComponent(marketCd);
+    NSString *code = KLineKeyComponent(symbol);
+    NSString *chart = KLineKeyComponent(chartTyp);
+    if (!(typ && market && code && chart)) {
+        return nil;
+    }
+    return [NSString stringWithFormat:@"%@_%@_%@_%@", typ, market, code, chart];
+}
+
++ (long long)sinceTimeForGroup:(Y_KLineGroupModel *)group chartType:(NSString *)chartTyp {
+    if (group == nil || group.isDerived) {
+        return 0;
+    }
+    return [self sinceTimeForBars:group.sourceArray chartType:chartTyp];
+}
+
++ (long long)sinceTimeForBars:(NSArray<NSDictionary *> *)bars chartType:(NSString *)chartTyp {
+    if ([bars count] == 0) {
+        return 0;
+    }
+    //五日是滚动的五个交易日，分时和 Tick 只有当天，都整段请求
+    switch ([chartTyp integerValue]) {
+        case 4: case 6: case 8: case 9:
+        case 10: case 11: case 12: case 14: case 15:
+            return [[[bars lastObject] objectForKey:@"createChartTime"] longLongValue];
+        default:
+            return 0;
+    }
+}
+
+#pragma mark io
+
+//在 _ioQueue 上调用
+- (NSArray<NSDictionary *> *)readBarsForKey:(NSString *)key {
+    kline_bar *bars = NULL;
+    size_t count = 0;
+    int rc = kline_store_read(_store, [key UTF8String], &bars, &count);
+    if (rc != KLINE_OK) {
+        if (rc != KLINE_ENOENT) {
+            DLog(@"kline cache: read %@ failed (%d)", key, rc);
+        }
+        return nil;
+    }
+    NSData *data = [NSData dataWithBytesNoCopy:bars length:count * sizeof(kline_bar) freeWhenDone:YES];
+    return [Y_KLineCoreBridge dictionariesWithBarData:data];
+}
+
+- (void)loadBarsForKey:(NSString *)key completion:(void (^)(NSArray<NSDictionary *> *bars))completion {
+    dispatch_async(_ioQueue, ^{
+        NSArray *bars = _store && key ? [self readBarsForKey:key] : nil;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (completion) completion(bars);
+        });
+    });
+}
+
+- (void)saveBars:(NSArray<NSDictionary *> *)bars
+          forKey:(NSString *)key
+     incremental:(BOOL)incremental
+      completion:(void (^)(NSArray<NSDictionary *> *bars))completion {
+    NSArray *arr = [bars isKindOfClass:[NSArray class]] ? bars : @[];
+    dispatch_async(_ioQueue, ^{
+        NSArray *result = arr;
+        if (!_store || !key) {
+            //没有缓存可用，原样返回
+        } else if (arr.count == 0) {
+            //请求失败或返回空时不能覆盖已有的缓存，增量时没有新K线就用缓存
+            if (incremental) {
+                result = [self readBarsForKey:key] ?: arr;
+            }
+        } else {
+            NSData *data = [Y_KLineCoreBridge barDataWithDictionaries:arr];
+            const char *k = [key UTF8String];
+            kline_store_info info;
+            int rc = KLINE_OK;
+            if (!incremental || kline_store_stat(_store, k, &info) != KLINE_OK) {
+                rc = kline_store_write(_store, k, data.bytes, arr.count);
+            } else {
+                rc = kline_store_append(_store, k, data.bytes, arr.count);
+                result = [self readBarsForKey:key] ?: arr;
+
+                //保持接口原有的根数，最早的滚出去
+                NSUInteger window = MAX(info.count, arr.count);
+                if (result.count > window) {
+                    result = [result subarrayWithRange:NSMakeRange(result.count - window, window)];
+                    NSData *trimmed = [Y_KLineCoreBridge barDataWithDictionaries:result];
+                    rc = kline_store_write(_store, k, trimmed.bytes, result.count);
+                }
+            }
+            if (rc != KLINE_OK) {
+                DLog(@"kline cache: write %@ failed (%d)", key, rc);
+            }
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (completion) completion(result);
+        });
+    });
+}
+
+@end
@@ -9,15 +9,39 @@
 #import <Foundation/Foundation.h>
 #import <math.h>
 @class Y_KLineModel;
+@class Y_KLineIndicator;
+@class Y_KLineIndicatorSeries;
 
 @interface Y_KLineGroupModel : NSObject
 
 
 @property (nonatomic, copy) NSArray<Y_KLineModel *> *models;
 
+//接口原始数据(chartInfLst)及其周期，供本地聚合其他周期
+@property (nonatomic, copy) NSArray *sourceArray;
+@property (nonatomic, copy) NSString *sourceChartType;
+
+//由其他周期本地聚合得到，等服务端数据回来后替换
+@property (nonatomic, assign) BOOL isDerived;
+
 //初始化Model
 + (instancetype) objectWithArray:(NSArray *)arr;
 + (instancetype) objectWith5MinArray:(NSArray *)arr;
+
+//arr 为 chartTyp 周期的接口数据；五日(13)的 1 分钟 K 聚合成 5 分钟
++ (instancetype) objectWithArray:(NSArray *)arr chartType:(NSString *)chartTyp;
+
+//从已加载的周期中挑可聚合、时间跨度最长的一组推导 chartTyp，没有返回 nil
++ (instancetype) objectDerivedForChartType:(NSString *)chartTyp fromGroups:(NSArray<Y_KLineGroupModel *> *)groups;
+
+//指标(含主图均线)，第一次取某个指标(含参数)时才算整组并缓存，下标与 models 一致；在主线程调用
+- (Y_KLineIndicatorSeries *)seriesForIndicator:(Y_KLineIndicator *)indicator;
+
+//刷新数据时沿用 group 已取用过的指标：与 group 相同的前缀直接复制，只补算之后变化和新增的 K 线；在主线程调用
+- (void)inheritIndicatorsFromGroup:(Y_KLineGroupModel *)group;
+
+//丢掉名为 name 的指标各组参数的缓存，改参数后调用；在主线程调用
+- (void)removeSeriesForIndicatorName:(NSString *)name;
 @end
 
 //初始化第一个Model
@@ -8,6 +8,16 @@
 
 #import "Y_KLineGroupModel.h"
 #import "Y_KLineModel.h"
+#import "Y_KLinePeriodResampler.h"
+#import "Y_KLineIndicator.h"
+
+@interface Y_KLineGroupModel ()
+{
+    //key 为 indicator.title
+    NSMutableDictionary<NSString *, Y_KLineIndicatorSeries *> *_indicatorSeries;
+}
+@end
+
 @implementation Y_KLineGroupModel
 + (instancetype) objectWithArray:(NSArray *)arr {
     
@@ -25,6 +35,7 @@
         model.PreviousKlineModel = preModel;
         [model initWithDictionary:valueDic];
         model.ParentGroupModel = groupModel;
+        model.Index = mutableArr.count;
         
         [mutableArr addObject:model];
         
@@ -32,74 +43,119 @@
     }
     
     groupModel.models = mutableArr;
-    
-    
-    //初始化第一个Model的数据
-    Y_KLineModel *firstModel = mutableArr[0];
-    [firstModel initFirstModel];
-    
-    //初始化其他Model的数据
-    [mutableArr enumerateObjectsUsingBlock:^(Y_KLineModel *model, NSUInteger idx, BOOL * _Nonnull stop) {
-        [model initData];
-    }];
 
+    //指标在画图第一次取用时再算，见 seriesForIndicator:
     return groupModel;
 }
 
 + (instancetype) objectWith5MinArray:(NSArray *)arr
 {
-    
+    return [self objectWithArray:arr chartType:@"13"];
+}
+
++ (instancetype) objectWithArray:(NSArray *)arr chartType:(NSString *)chartTyp
+{
     if([arr count] == 0)return nil;
     NSAssert([arr isKindOfClass:[NSArray class]], @"arr不是一个数组");
-    
-    Y_KLineGroupModel *groupModel = [Y_KLineGroupModel new];
-    NSMutableArray *mutableArr = @[].mutableCopy;
-    __block Y_KLineModel *preModel = [[Y_KLineModel alloc]init];
-    
-    //设置数据
-    //for (NSDictionary *valueDic in arr)
-    
-    long five_min = 5*60*1000;//5分钟
 
-    for (int i = 0; i < [arr count]; i ++)
+    NSString *sourceChartType = chartTyp;
+    NSArray *bars = arr;
+    if ([chartTyp isEqualToString:@"13"])
     {
-        NSDictionary *valueDic = [arr objectAtIndex:i];
-        
-        long longDate = [[valueDic objectForKey:@"createChartTime"] longValue];
-
-//        double doubleDate = [[valueDic objectForKey:@"createChartTime"] doubleValue]/1000;
-//        NSDate *date = [NSDate dateWithTimeIntervalSince1970:doubleDate];
-//        NSDateFormatter *formatter = [NSDateFormatter new];
-//        formatter.dateFormat = @"mm";
-//        NSString *dateStr = [formatter stringFromDate:date];
-        //if([dateStr intValue]%5)
-        
-        if ((longDate % five_min) == 0)
+        //五日返回 1 分钟 K，按交易时段聚合成 5 分钟，开盘集合竞价并入第一根
+        sourceChartType = @"2";
+        bars = [Y_KLinePeriodResampler resampleBars:arr toChartType:chartTyp];
+    }
+
+    Y_KLineGroupModel *groupModel = [self objectWithArray:bars];
+    groupModel.sourceArray = arr;
+    groupModel.sourceChartType = sourceChartType;
+    return groupModel;
+}
+
++ (instancetype) objectDerivedForChartType:(NSString *)chartTyp fromGroups:(NSArray<Y_KLineGroupModel *> *)groups
+{
+    Y_KLineGroupModel *source = nil;
+    long long sourceSpan = -1;
+    for (Y_KLineGroupModel *group in groups)
+    {
+        //只从服务端数据聚合，避免误差累积
+        if (group.isDerived || [group.sourceArray count] == 0) continue;
+        if (![Y_KLinePeriodResampler canResampleChartType:chartTyp fromChartType:group.sourceChartType]) continue;
+
+        long long first = [[[group.sourceArray firstObject] objectForKey:@"createChartTime"] longLongValue];
+        long long last = [[[group.sourceArray lastObject] objectForKey:@"createChartTime"] longLongValue];
+        if (last - first > sourceSpan)
         {
-            Y_KLineModel *model = [Y_KLineModel new];
-            model.PreviousKlineModel = preModel;
-            [model initWithDictionary:valueDic];
-            model.ParentGroupModel = groupModel;
-            
-            [mutableArr addObject:model];
-            
-            preModel = model;
+            sourceSpan = last - first;
+            source = group;
         }
-       
     }
-    
-    groupModel.models = mutableArr;
-    
-    
-    //初始化第一个Model的数据
-    Y_KLineModel *firstModel = mutableArr[0];
-    [firstModel initFirstModel];
-    
-    //初始化其他Model的数据
-    [mutableArr enumerateObjectsUsingBlock:^(Y_KLineModel *model, NSUInteger idx, BOOL * _Nonnull stop) {
-        [model initData];
-    }];
-    
+    if (!source) return nil;
+
+    NSArray *bars = [Y_KLinePeriodResampler resampleBars:source.sourceArray toChartType:chartTyp];
+    Y_KLineGroupModel *groupModel = [self objectWithArray:bars];
+    groupModel.isDerived = YES;
     return groupModel;
 }
+
+- (Y_KLineIndicatorSeries *)seriesForIndicator:(Y_KLineIndicator *)indicator
+{
+    if (!indicator) return nil;
+    NSAssert([NSThread isMainThread], @"指标缓存只在主线程访问");
+
+    Y_KLineIndicatorSeries *series = _indicatorSeries[indicator.title];
+    if (!series)
+    {
+        series = [Y_KLineIndicatorSeries seriesWithIndicator:indicator models:self.models];
+        if (!series) return nil;
+        if (!_indicatorSeries) _indicatorSeries = [NSMutableDictionary dictionary];
+        _indicatorSeries[indicator.title] = series;
+    }
+    return series;
+}
+
+- (void)inheritIndicatorsFromGroup:(Y_KLineGroupModel *)group
+{
+    if (!group || group == self || group->_indicatorSeries.count == 0) return;
+    NSAssert([NSThread isMainThread], @"指标缓存只在主线程访问");
+
+    NSUInteger from = [self private_commonPrefixWithModels:group.models];
+    if (!_indicatorSeries) _indicatorSeries = [NSMutableDictionary dictionary];
+    [group->_indicatorSeries enumerateKeysAndObjectsUsingBlock:^(NSString *title, Y_KLineIndicatorSeries *series, BOOL *stop) {
+        if (_indicatorSeries[title]) return;
+        Y_KLineIndicatorSeries *updated = [series seriesWithModels:self.models from:from];
+        if (updated) _indicatorSeries[title] = updated;
+    }];
+}
+
+- (void)removeSeriesForIndicatorName:(NSString *)name
+{
+    NSAssert([NSThread isMainThread], @"指标缓存只在主线程访问");
+    for (NSString *title in [_indicatorSeries allKeys]) {
+        if ([_indicatorSeries[title].indicator.name isEqualToString:name]) {
+            [_indicatorSeries removeObjectForKey:title];
+        }
+    }
+}
+
+//与 models 开头相同的根数，只比较指标用到的高低收量和昨收
+- (NSUInteger)private_commonPrefixWithModels:(NSArray<Y_KLineModel *> *)models
+{
+    NSUInteger count = MIN(models.count, self.models.count);
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        Y_KLineModel *a = self.models[i];
+        Y_KLineModel *b = models[i];
+        if (a.Volume != b.Volume ||
+            ![a.Close isEqual:b.Close] ||
+            !(a.High == b.High || [a.High isEqual:b.High]) ||
+            !(a.Low == b.Low || [a.Low isEqual:b.Low]) ||
+            !(a.PreClose == b.PreClose || [a.PreClose isEqual:b.PreClose]))
+        {
+            return i;
+        }
+    }
+    return count;
+}
 @end
@@ -0,0 +1,97 @@
+//
+//  Y_KLineIndicator.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+@class Y_KLineModel;
+
+typedef NS_ENUM(NSInteger, Y_KLineIndicatorStyle) {
+    Y_KLineIndicatorStyleLine = 0,  //折线
+    Y_KLineIndicatorStyleBar,       //以 0 为基线的柱，如 MACD
+};
+
+/**
+ *  指标及其参数
+ *
+ *  对应 kline_core 注册表中的一项(kline_indicator_find)，参数、输出列、画法都由注册表声明，
+ *  副图按声明绘制，新增指标只需在 kline_indicator.c 中写计算函数并注册。
+ *  不可变：改参数用 indicatorWithParams: 生成新的指标。
+ */
+@interface Y_KLineIndicator : NSObject <NSCopying>
+
+/**
+ *  名称，如 MACD
+ */
+@property (nonatomic, copy, readonly) NSString *name;
+
+/**
+ *  参数值及参数名，如 12,26,9 和 SHORT,LONG,MID
+ */
+@property (nonatomic, copy, readonly) NSArray<NSNumber *> *params;
+@property (nonatomic, copy, readonly) NSArray<NSString *> *paramNames;
+@property (nonatomic, copy, readonly) NSArray<NSNumber *> *defaultParams;
+
+/**
+ *  注册表声明的参数范围(含两端)，及参数是否只能取整数
+ */
+@property (nonatomic, copy, readonly) NSArray<NSNumber *> *minParams;
+@property (nonatomic, copy, readonly) NSArray<NSNumber *> *maxParams;
+- (BOOL)isIntegralParamAtIndex:(NSUInteger)index;
+
+/**
+ *  带参数的标题，如 MACD(12,26,9)；同名同参数的指标 title 相同
+ */
+@property (nonatomic, copy, readonly) NSString *title;
+
+/**
+ *  输出列名，如 DIF、DEA、MACD 或 RSI6、RSI12、RSI24
+ */
+@property (nonatomic, copy, readonly) NSArray<NSString *> *outputNames;
+
+/**
+ *  与价格同一坐标，副图同时画 K 线，如 BOLL
+ */
+@property (nonatomic, assign, readonly) BOOL drawsPrice;
+
+- (Y_KLineIndicatorStyle)styleForOutputAtIndex:(NSUInteger)index;
+
+//副图菜单的全部指标，按菜单顺序，参数取用户设置；主图、成交量图的均线(MA、EMA、VMA、VEMA)不在其中
++ (NSArray<Y_KLineIndicator *> *)registeredIndicators;
+
+//参数取用户设置，没有设置时取默认值；没有注册返回 nil
++ (instancetype)indicatorWithName:(NSString *)name;
+
+//参数个数不对或超出注册表声明的范围返回 nil
+- (instancetype)indicatorWithParams:(NSArray<NSNumber *> *)params;
+
+//保存为用户设置，之后 indicatorWithName: 都取这组参数
+- (void)saveAsPreferred;
+
+@end
+
+/**
+ *  一组 K 线上某个指标的计算结果
+ *
+ *  由 Y_KLineGroupModel -seriesForIndicator: 在第一次取用时创建和缓存，下标与 models 一致；
+ *  数据刷新后按 -seriesWithModels:from: 只补算变化的部分。
+ */
+@interface Y_KLineIndicatorSeries : NSObject
+
+@property (nonatomic, strong, readonly) Y_KLineIndicator *indicator;
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+//models 按时间升序
++ (instancetype)seriesWithIndicator:(Y_KLineIndicator *)indicator models:(NSArray<Y_KLineModel *> *)models;
+
+//新数据 models 的前 from 根与原来相同：复制前 from 根的结果，只算之后变化和新增的 K 线
+- (instancetype)seriesWithModels:(NSArray<Y_KLineModel *> *)models from:(NSUInteger)from;
+
+//数据不足一个周期时为 NAN / nil
+- (double)valueAtIndex:(NSUInteger)index output:(NSUInteger)output;
+- (NSNumber *)numberAtIndex:(NSUInteger)index output:(NSUInteger)output;
+
+@end
@@ -0,0 +1,313 @@
+//
+//  Y_KLineIndicator.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "Y_KLineIndicator.h"
+#import "Y_KLineModel.h"
+#import "kline_core.h"
+#import "SystemUtil.h"
+
+//用户设置的参数存在 CacheStore，key 为前缀加指标名，值为逗号分隔的参数，如 "12,26,9"
+static NSString * const Y_KLineIndicatorParamsKey = @"Y_KLineIndicatorParams_";
+
+@interface Y_KLineIndicator ()
+{
+    const kline_indicator *_descriptor;
+}
+@property (nonatomic, copy, readwrite) NSArray<NSNumber *> *params;
+@property (nonatomic, copy, readwrite) NSString *title;
+@property (nonatomic, copy, readwrite) NSArray<NSString *> *outputNames;
+- (const kline_indicator *)descriptor;
+@end
+
+@implementation Y_KLineIndicator
+
++ (NSArray<Y_KLineIndicator *> *)registeredIndicators {
+    NSMutableArray *indicators = [NSMutableArray array];
+    for (size_t i = 0; i < kline_indicator_count(); i++) {
+        //主图、成交量图的均线不进副图菜单
+        if (kline_indicator_at(i)->flags & KLINE_INDICATOR_MAIN_CHART) {
+            continue;
+        }
+        Y_KLineIndicator *indicator = [self indicatorWithName:@(kline_indicator_at(i)->name)];
+        if (indicator) {
+            [indicators addObject:indicator];
+        }
+    }
+    return indicators;
+}
+
++ (instancetype)indicatorWithName:(NSString *)name {
+    const kline_indicator *descriptor = kline_indicator_find(name.UTF8String);
+    if (!descriptor) {
+        return nil;
+    }
+    Y_KLineIndicator *indicator = [[Y_KLineIndicator alloc] initWithDescriptor:descriptor params:nil];
+    NSArray *saved = [self private_paramsFromString:[SystemUtil getCache:[Y_KLineIndicatorParamsKey stringByAppendingString:name]]];
+    if (saved) {
+        //参数范围改过时忽略旧的设置
+        return [indicator indicatorWithParams:saved] ?: indicator;
+    }
+    return indicator;
+}
+
+//解析失败返回 nil
++ (NSArray<NSNumber *> *)private_paramsFromString:(NSString *)string {
+    if (string.length == 0) {
+        return nil;
+    }
+    NSMutableArray *params = [NSMutableArray array];
+    for (NSString *component in [string componentsSeparatedByString:@","]) {
+        NSScanner *scanner = [NSScanner scannerWithString:component];
+        double value;
+        if (![scanner scanDouble:&value] || !scanner.isAtEnd) {
+            return nil;
+        }
+        [params addObject:@(value)];
+    }
+    return params;
+}
+
+- (instancetype)initWithDescriptor:(const kline_indicator *)descriptor params:(NSArray<NSNumber *> *)params {
+    self = [super init];
+    if (self) {
+        _descriptor = descriptor;
+        _params = [params copy] ?: [self defaultParams];
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    //不可变，直接共用
+    return self;
+}
+
+- (BOOL)isEqual:(id)object {
+    if (![object isKindOfClass:[Y_KLineIndicator class]]) {
+        return NO;
+    }
+    return [self.title isEqualToString:[object title]];
+}
+
+- (NSUInteger)hash {
+    return self.title.hash;
+}
+
+- (instancetype)indicatorWithParams:(NSArray<NSNumber *> *)params {
+    if (params.count != _descriptor->param_count) {
+        return nil;
+    }
+    for (NSUInteger p = 0; p < params.count; p++) {
+        const kline_param *param = &_descriptor->params[p];
+        if (![params[p] isKindOfClass:[NSNumber class]]) {
+            return nil;
+        }
+        double value = [params[p] doubleValue];
+        if (!(value >= param->min && value <= param->max) || (param->integral && value != floor(value))) {
+            return nil;
+        }
+    }
+    if ([params isEqualToArray:_params]) {
+        return self;
+    }
+    return [[Y_KLineIndicator alloc] initWithDescriptor:_descriptor params:params];
+}
+
+- (void)saveAsPreferred {
+    [SystemUtil putCache:[Y_KLineIndicatorParamsKey stringByAppendingString:self.name]
+                   value:[self.params componentsJoinedByString:@","]];
+}
+
+#pragma mark 注册表声明
+
+- (const kline_indicator *)descriptor {
+    return _descriptor;
+}
+
+- (NSString *)name {
+    return @(_descriptor->name);
+}
+
+- (NSArray<NSString *> *)paramNames {
+    NSMutableArray *names = [NSMutableArray array];
+    for (size_t p = 0; p < _descriptor->param_count; p++) {
+        [names addObject:@(_descriptor->params[p].name)];
+    }
+    return names;
+}
+
+- (NSArray<NSNumber *> *)defaultParams {
+    NSMutableArray *values = [NSMutableArray array];
+    for (size_t p = 0; p < _descriptor->param_count; p++) {
+        [values addObject:@(_descriptor->params[p].value)];
+    }
+    return values;
+}
+
+- (NSArray<NSNumber *> *)minParams {
+    NSMutableArray *values = [NSMutableArray array];
+    for (size_t p = 0; p < _descriptor->param_count; p++) {
+        [values addObject:@(_descriptor->params[p].min)];
+    }
+    return values;
+}
+
+- (NSArray<NSNumber *> *)maxParams {
+    NSMutableArray *values = [NSMutableArray array];
+    for (size_t p = 0; p < _descriptor->param_count; p++) {
+        [values addObject:@(_descriptor->params[p].max)];
+    }
+    return values;
+}
+
+- (BOOL)isIntegralParamAtIndex:(NSUInteger)index {
+    return index < _descriptor->param_count && _descriptor->params[index].integral;
+}
+
+- (NSString *)title {
+    if (!_title) {
+        NSMutableArray *values = [NSMutableArray array];
+        for (NSNumber *param in _params) {
+            [values addObject:[NSString stringWithFormat:@"%g", param.doubleValue]];
+        }
+        _title = [NSString stringWithFormat:@"%@(%@)", self.name, [values componentsJoinedByString:@","]];
+    }
+    return _title;
+}
+
+- (NSArray<NSString *> *)outputNames {
+    if (!_outputNames) {
+        NSMutableArray *names = [NSMutableArray array];
+        for (size_t i = 0; i < _descriptor->output_count; i++) {
+            const kline_output *output = &_descriptor->outputs[i];
+            NSString *name = @(output->name);
+            if (output->suffix_param > 0 && output->suffix_param <= (int)_params.count) {
+                name = [name stringByAppendingFormat:@"%g", _params[output->suffix_param - 1].doubleValue];
+            }
+            [names addObject:name];
+        }
+        _outputNames = names;
+    }
+    return _outputNames;
+}
+
+- (BOOL)drawsPrice {
+    return (_descriptor->flags & KLINE_INDICATOR_PRICE_OVERLAY) != 0;
+}
+
+- (Y_KLineIndicatorStyle)styleForOutputAtIndex:(NSUInteger)index {
+    if (index < _descriptor->output_count && _descriptor->outputs[index].style == KLINE_STYLE_BAR) {
+        return Y_KLineIndicatorStyleBar;
+    }
+    return Y_KLineIndicatorStyleLine;
+}
+
+@end
+
+#pragma mark -
+
+@interface Y_KLineIndicatorSeries ()
+{
+    //column_count 列，每列 count 个，前 output_count 列为输出
+    NSMutableData *_columns;
+}
+@property (nonatomic, strong, readwrite) Y_KLineIndicator *indicator;
+@property (nonatomic, assign, readwrite) NSUInteger count;
+@end
+
+@implementation Y_KLineIndicatorSeries
+
+static double Y_KLineIndicatorDouble(NSNumber *value, double fallback) {
+    return [value isKindOfClass:[NSNumber class]] ? value.doubleValue : fallback;
+}
+
++ (instancetype)seriesWithIndicator:(Y_KLineIndicator *)indicator models:(NSArray<Y_KLineModel *> *)models {
+    return [self private_seriesWithIndicator:indicator models:models previous:nil from:0];
+}
+
+- (instancetype)seriesWithModels:(NSArray<Y_KLineModel *> *)models from:(NSUInteger)from {
+    return [Y_KLineIndicatorSeries private_seriesWithIndicator:self.indicator models:models previous:self from:MIN(from, MIN(_count, models.count))];
+}
+
+//[0, from) 从 previous 复制，只算 [from, count)
++ (instancetype)private_seriesWithIndicator:(Y_KLineIndicator *)indicator models:(NSArray<Y_KLineModel *> *)models previous:(Y_KLineIndicatorSeries *)previous from:(NSUInteger)from {
+    if (!indicator) {
+        return nil;
+    }
+    const kline_indicator *descriptor = [indicator descriptor];
+    size_t n = models.count;
+
+    Y_KLineIndicatorSeries *series = [Y_KLineIndicatorSeries new];
+    series.indicator = indicator;
+    series.count = n;
+    series->_columns = [NSMutableData dataWithLength:descriptor->column_count * n * sizeof(double)];
+
+    double *columns[KLINE_INDICATOR_MAX_COLUMNS];
+    double *base = series->_columns.mutableBytes;
+    for (size_t c = 0; c < descriptor->column_count; c++) {
+        columns[c] = base + c * n;
+        if (from > 0) {
+            const double *old = previous->_columns.bytes;
+            memcpy(columns[c], old + c * previous->_count, from * sizeof(double));
+        }
+    }
+
+    //只取指标声明要用的输入列，如均线只取收盘价或成交量；按 KLINE_INPUT_* 的位序为高 低 收 量 昨收
+    double *input[5] = {NULL};
+    NSUInteger inputCount = 0;
+    for (NSUInteger k = 0; k < 5; k++) {
+        inputCount += (descriptor->inputs >> k) & 1;
+    }
+    NSMutableData *inputData = [NSMutableData dataWithLength:inputCount * n * sizeof(double)];
+    double *next = inputData.mutableBytes;
+    for (NSUInteger k = 0; k < 5; k++) {
+        if (descriptor->inputs & (1u << k)) {
+            input[k] = next;
+            next += n;
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        Y_KLineModel *model = models[i];
+        double close = Y_KLineIndicatorDouble(model.Close, 0);
+        if (input[0]) input[0][i] = Y_KLineIndicatorDouble(model.High, close);
+        if (input[1]) input[1][i] = Y_KLineIndicatorDouble(model.Low, close);
+        if (input[2]) input[2][i] = close;
+        if (input[3]) input[3][i] = model.Volume;
+        if (input[4]) {
+            //接口没有给昨收时用上一根收盘价
+            double pc = Y_KLineIndicatorDouble(model.PreClose, 0);
+            input[4][i] = pc > 0 ? pc : NAN;
+        }
+    }
+    kline_inputs inputs = {input[0], input[1], input[2], input[3], input[4], n};
+
+    double params[KLINE_INDICATOR_MAX_PARAMS];
+    for (NSUInteger p = 0; p < indicator.params.count && p < KLINE_INDICATOR_MAX_PARAMS; p++) {
+        params[p] = indicator.params[p].doubleValue;
+    }
+
+    if (kline_indicator_update(descriptor, &inputs, from, params, columns) != KLINE_OK) {
+        NSAssert(NO, @"指标计算失败：%@", indicator.title);
+        return nil;
+    }
+    return series;
+}
+
+- (double)valueAtIndex:(NSUInteger)index output:(NSUInteger)output {
+    if (index >= _count || output >= self.indicator.outputNames.count) {
+        return NAN;
+    }
+    const double *base = _columns.bytes;
+    return base[output * _count + index];
+}
+
+- (NSNumber *)numberAtIndex:(NSUInteger)index output:(NSUInteger)output {
+    double value = [self valueAtIndex:index output:output];
+    return kline_is_missing(value) ? nil : @(value);
+}
+
+@end
@@ -0,0 +1,27 @@
+//
+//  Y_KLinePeriodResampler.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  本地周期聚合(kline_core kline_resample)
+ *
+ *  用已加载的较细周期 K 线推导较粗周期，切换周期时可以先显示、不用等网络：
+ *  1 分钟 -> 5/15/30/60 分钟；日 K -> 周/月/季/年 K；月 K -> 季/年 K。
+ *  五日(13)接口返回的是 1 分钟 K，显示前也用这里聚合成 5 分钟。
+ *  分钟 K 按 A 股交易时段切分。chartTyp 与 KLineInfoAPI 一致。
+ */
+@interface Y_KLinePeriodResampler : NSObject
+
+//source 周期的 K 线能否聚合出 chartTyp
++ (BOOL)canResampleChartType:(NSString *)chartTyp fromChartType:(NSString *)source;
+
+//bars 为接口 chartInfLst 格式、按时间升序，返回同格式的 chartTyp 周期 K 线；不支持的周期返回 nil
++ (NSArray<NSDictionary *> *)resampleBars:(NSArray<NSDictionary *> *)bars toChartType:(NSString *)chartTyp;
+
+@end
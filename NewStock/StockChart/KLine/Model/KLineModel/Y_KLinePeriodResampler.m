@@ -0,0 +1,102 @@
+//
+//  Y_KLinePeriodResampler.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "Y_KLinePeriodResampler.h"
+#import "Y_KLineCoreBridge.h"
+#import "kline_core.h"
+
+//北京时间
+static const int kKLineUTCOffsetMinutes = 8 * 60;
+
+//周期粒度，分钟 K 用分钟数，日及以上用负数区分
+typedef NS_ENUM(NSInteger, KLINE_GRANULARITY) {
+    KLINE_GRANULARITY_NONE = 0,
+    KLINE_GRANULARITY_DAY = -1,
+    KLINE_GRANULARITY_WEEK = -2,
+    KLINE_GRANULARITY_MONTH = -3,
+    KLINE_GRANULARITY_QUARTER = -4,
+    KLINE_GRANULARITY_YEAR = -5,
+};
+
+static NSInteger KLineGranularity(NSString *chartTyp) {
+    switch ([chartTyp integerValue]) {
+        case 2:  return 1;
+        case 4:  return 5;
+        case 6:  return 15;
+        case 8:  return 30;
+        case 9:  return 60;
+        case 13: return 5;  //五日分时按 5 分钟显示
+        case 10: return KLINE_GRANULARITY_DAY;
+        case 11: return KLINE_GRANULARITY_WEEK;
+        case 12: return KLINE_GRANULARITY_MONTH;
+        case 14: return KLINE_GRANULARITY_QUARTER;
+        case 15: return KLINE_GRANULARITY_YEAR;
+        default: return KLINE_GRANULARITY_NONE;
+    }
+}
+
+@implementation Y_KLinePeriodResampler
+
++ (BOOL)canResampleChartType:(NSString *)chartTyp fromChartType:(NSString *)source {
+    NSInteger target = KLineGranularity(chartTyp);
+    NSInteger from = KLineGranularity(source);
+    if (target == KLINE_GRANULARITY_NONE || from == KLINE_GRANULARITY_NONE) {
+        return NO;
+    }
+    //五日需要五天的 1 分钟数据，只有接口的 13 本身有
+    if ([chartTyp integerValue] == 13) {
+        return NO;
+    }
+    if (target > 0 && from > 0) {
+        return target > from && target % from == 0;
+    }
+    if (target > 0 || from > 0) {
+        return NO;
+    }
+    //周跨月，不能再聚合成月/季/年
+    if (from == KLINE_GRANULARITY_WEEK) {
+        return NO;
+    }
+    return target < from;
+}
+
++ (NSArray<NSDictionary *> *)resampleBars:(NSArray<NSDictionary *> *)bars toChartType:(NSString *)chartTyp {
+    NSInteger granularity = KLineGranularity(chartTyp);
+    kline_period period = {0};
+    period.utc_offset_minutes = kKLineUTCOffsetMinutes;
+    switch (granularity) {
+        case KLINE_GRANULARITY_NONE:
+        case KLINE_GRANULARITY_DAY:
+            return nil;
+        case KLINE_GRANULARITY_WEEK:
+            period.unit = KLINE_PERIOD_WEEK;
+            break;
+        case KLINE_GRANULARITY_MONTH:
+            period.unit = KLINE_PERIOD_MONTH;
+            break;
+        case KLINE_GRANULARITY_QUARTER:
+            period.unit = KLINE_PERIOD_QUARTER;
+            break;
+        case KLINE_GRANULARITY_YEAR:
+            period.unit = KLINE_PERIOD_YEAR;
+            break;
+        default:
+            period.unit = KLINE_PERIOD_MINUTE;
+            period.minutes = (int)granularity;
+            period.sessions = kline_a_share_sessions;
+            period.session_count = 2;
+            break;
+    }
+
+    NSMutableData *data = [Y_KLineCoreBridge barDataWithDictionaries:bars];
+    size_t n = kline_resample(data.mutableBytes, bars.count, &period, data.mutableBytes);
+    data.length = n * sizeof(kline_bar);
+    return [Y_KLineCoreBridge dictionariesWithBarData:data];
+}
+
+@end
@@ -6,6 +6,7 @@
 #import <UIKit/UIKit.h>
 #import "Y_KLineModel.h"
 #import "Y_StockChartConstant.h"
+#import "Y_StockChartConfig.h"
 @interface TimeLineView : UIView
 
 /**
@@ -18,6 +19,11 @@
  */
 @property (nonatomic, assign) CGFloat volumeViewRatio;
 
+/**
+ *  图表配置
+ */
+@property (nonatomic, strong) Y_StockChartConfig *config;
+
 /**
  *  数据
  */
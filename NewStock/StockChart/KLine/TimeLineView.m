@@ -5,13 +5,13 @@
 #import "TimeLineView.h"
 #import "TimeLineMainView.h"
 #import "Y_TLineFollowView.h"
+#import "Y_StockChartCrossLayer.h"
 
 #import "Y_VolumeMAView.h"
 #import "Masonry.h"
 #import "UIColor+Y_StockChart.h"
 #import <QuartzCore/QuartzCore.h>
 
-#import "Y_StockChartGlobalVariable.h"
 #import "Y_KLineVolumeView.h"
 #import "Y_StockChartRightYView.h"
 
@@ -49,6 +49,11 @@
  */
 @property (nonatomic, assign) CGFloat oldExactOffset;
 
+/**
+ *  上次缩放手势的scale
+ */
+@property (nonatomic, assign) CGFloat oldPinchScale;
+
 
 //跟随数据View
 @property (nonatomic, strong) Y_TLineFollowView *tLineFollowView;
@@ -61,10 +66,9 @@
 
 
 /**
- *  长按后显示的View
+ *  长按后显示的十字线
  */
-@property (nonatomic, strong) UIView *verticalView;
-@property (nonatomic, strong) UIView *horizontalView;
+@property (nonatomic, strong) Y_StockChartCrossLayer *crossLayer;
 
 
 @property (nonatomic, strong) MASConstraint *kLineMainViewHeightConstraint;
@@ -83,8 +87,10 @@
 - (instancetype)initWithFrame:(CGRect)frame {
     self = [super initWithFrame:frame];
     if(self) {
-        self.mainViewRatio = [Y_StockChartGlobalVariable kLineMainViewRadio];
-        self.volumeViewRatio = [Y_StockChartGlobalVariable kLineVolumeViewRadio];
+        _config = [Y_StockChartConfig defaultConfig];
+        self.mainViewRatio = _config.mainViewRatio;
+        self.volumeViewRatio = _config.volumeViewRatio;
+        self.oldPinchScale = 1.0f;
         
     }
     return self;
@@ -163,6 +169,7 @@
 - (TimeLineMainView *)kLineMainView {
     if (!_kLineMainView && self) {
         _kLineMainView = [TimeLineMainView new];
+        _kLineMainView.config = self.config;
 //        _kLineMainView.layer.borderWidth = 0.5;
 //        _kLineMainView.layer.borderColor = [[UIColor boarderColor] CGColor];
         
@@ -189,6 +196,7 @@
     if(!_kLineVolumeView && self)
     {
         _kLineVolumeView = [Y_KLineVolumeView new];
+        _kLineVolumeView.config = self.config;
         _kLineVolumeView.layer.borderWidth = 0.5;
         _kLineVolumeView.layer.borderColor = [kUIColorFromRGB(0xd3d3d3) CGColor];
         _kLineVolumeView.chartType = Y_StockChartcenterViewTypeTimeLine;
@@ -260,6 +268,12 @@
 }
 
 #pragma mark - set方法
+- (void)setConfig:(Y_StockChartConfig *)config {
+    _config = config;
+    _kLineMainView.config = config;
+    _kLineVolumeView.config = config;
+}
+
 - (void)setTimeLineType:(Y_StockTimeLineType)timeLineType {
     _timeLineType = timeLineType;
     _kLineMainView.timeLineType = timeLineType;
@@ -284,7 +298,7 @@
     
     [self private_drawKLineMainView];
     //设置contentOffset
-//    CGFloat kLineViewWidth = self.kLineModels.count * [Y_StockChartGlobalVariable tLineWidth] + (self.kLineModels.count + 1) * [Y_StockChartGlobalVariable tLineGap];
+//    CGFloat kLineViewWidth = self.kLineModels.count * self.config.tLineWidth + (self.kLineModels.count + 1) * self.config.tLineGap;
     //CGFloat offset = kLineViewWidth - self.scrollView.frame.size.width;
 //    if (offset > 0)
 //    {
@@ -309,15 +323,14 @@
 #pragma mark - event事件处理方法
 #pragma mark 缩放执行方法
 - (void)event_pichMethod:(UIPinchGestureRecognizer *)pinch {
-    static CGFloat oldScale = 1.0f;
-    CGFloat difValue = pinch.scale - oldScale;
+    CGFloat difValue = pinch.scale - self.oldPinchScale;
     if(ABS(difValue) > Y_StockChartScaleBound) {
-        CGFloat oldtLineWidth = [Y_StockChartGlobalVariable tLineWidth];
+        CGFloat oldtLineWidth = self.config.tLineWidth;
 
         NSInteger oldNeedDrawStartIndex = self.kLineMainView.needDrawStartIndex;
         NSLog(@"原来的index%ld",(long)self.kLineMainView.needDrawStartIndex);
-        [Y_StockChartGlobalVariable settLineWith:oldtLineWidth * (difValue > 0 ? (1 + Y_StockChartScaleFactor) : (1 - Y_StockChartScaleFactor))];
-        oldScale = pinch.scale;
+        self.config = [self.config configWithTLineWidth:oldtLineWidth * (difValue > 0 ? (1 + Y_StockChartScaleFactor) : (1 - Y_StockChartScaleFactor))];
+        self.oldPinchScale = pinch.scale;
         //更新MainView的宽度
         [self.kLineMainView updateMainViewWidth];
         
@@ -325,8 +338,8 @@
             CGPoint p1 = [pinch locationOfTouch:0 inView:self.scrollView];
             CGPoint p2 = [pinch locationOfTouch:1 inView:self.scrollView];
             CGPoint centerPoint = CGPointMake((p1.x+p2.x)/2, (p1.y+p2.y)/2);
-            NSUInteger oldLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - [Y_StockChartGlobalVariable tLineGap]) / ([Y_StockChartGlobalVariable tLineGap] + oldtLineWidth);
-            NSUInteger newLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - [Y_StockChartGlobalVariable tLineGap]) / ([Y_StockChartGlobalVariable tLineGap] + [Y_StockChartGlobalVariable tLineWidth]);
+            NSUInteger oldLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - self.config.tLineGap) / (self.config.tLineGap + oldtLineWidth);
+            NSUInteger newLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - self.config.tLineGap) / (self.config.tLineGap + self.config.tLineWidth);
             
             self.kLineMainView.pinchStartIndex = oldNeedDrawStartIndex + oldLeftArrCount - newLeftArrCount;
             //            self.kLineMainView.pinchPoint = centerPoint;
@@ -335,82 +348,43 @@
         [self.kLineMainView drawMainView];
     }
 }
+
+- (Y_StockChartCrossLayer *)crossLayer {
+    if(!_crossLayer)
+    {
+        _crossLayer = [Y_StockChartCrossLayer layer];
+        //盖在 scrollView 上、跟随 View 下
+        [self.layer insertSublayer:_crossLayer above:self.scrollView.layer];
+    }
+    return _crossLayer;
+}
+
 #pragma mark 长按手势执行方法
 - (void)event_longPressMethod:(UILongPressGestureRecognizer *)longPress {
-    static CGFloat oldPositionX = 0;
     if(UIGestureRecognizerStateChanged == longPress.state || UIGestureRecognizerStateBegan == longPress.state)
     {
-        CGPoint location = [longPress locationInView:self.scrollView];
-        if(ABS(oldPositionX - location.x) < ([Y_StockChartGlobalVariable tLineWidth] + [Y_StockChartGlobalVariable tLineGap])/2)
-        {
-            return;
-        }
-        
+        CGPoint location = [longPress locationInView:self.kLineMainView];
+
         //暂停滑动
         //self.scrollView.scrollEnabled = NO;
-        oldPositionX = location.x;
-        
-        //初始化竖线
-        if(!self.verticalView)
-        {
-            self.verticalView = [UIView new];
-            self.verticalView.clipsToBounds = YES;
-            [self.scrollView addSubview:self.verticalView];
-            self.verticalView.backgroundColor = [UIColor longPressLineColor];
-            [self.verticalView mas_makeConstraints:^(MASConstraintMaker *make) {
-                make.top.equalTo(self).offset(0);
-                make.width.equalTo(@(Y_StockChartLongPressVerticalViewWidth));
-                make.height.equalTo(self.scrollView.mas_height);
-                make.left.equalTo(@(-10));
-            }];
-        }
-        if(!self.horizontalView)
+        //按 K 线间距换算长按的是哪一根，换了一根才通知跟随 View
+        NSInteger index = [self.kLineMainView longPressIndexWithOriginXPosition:location.x];
+        if(index == NSNotFound)
         {
-            self.horizontalView = [UIView new];
-            self.horizontalView.clipsToBounds = YES;
-            [self.scrollView addSubview:self.horizontalView];
-            self.horizontalView.backgroundColor = [UIColor longPressLineColor];
-            [self.horizontalView mas_makeConstraints:^(MASConstraintMaker *make) {
-                make.top.equalTo(self).offset(-10);
-                make.width.equalTo(self.scrollView.mas_width);
-                make.height.equalTo(@(Y_StockChartLongPressVerticalViewWidth));
-                make.left.equalTo(@(0));
-            }];
+            return;
         }
-        
-        //更新竖线位置
-        CGFloat rightXPosition = [self.kLineMainView getExactXPositionWithOriginXPosition:location.x];
-        [self.verticalView mas_updateConstraints:^(MASConstraintMaker *make) {
-            make.left.equalTo(@(rightXPosition));
-        }];
-        [self.verticalView layoutIfNeeded];
-        self.verticalView.hidden = NO;
-        
-        
-        //更新横线位置
-        CGFloat rightYPosition = [self.kLineMainView getExactYPositionWithOriginYPosition:location.x];
-        [self.horizontalView mas_updateConstraints:^(MASConstraintMaker *make) {
-            make.top.equalTo(self).offset(rightYPosition);
-        }];
-        [self.horizontalView layoutIfNeeded];
-        self.horizontalView.hidden = NO;
+
+        //更新十字线位置
+        CGPoint crossPoint = [self.kLineMainView convertPoint:[self.kLineMainView crossPointAtIndex:index] toView:self];
+        [self.crossLayer showAtPoint:crossPoint verticalHeight:CGRectGetHeight(self.scrollView.frame)];
     }
-    
+
     if(longPress.state == UIGestureRecognizerStateEnded)
     {
-        //取消竖线
-        if(self.verticalView)
-        {
-            self.verticalView.hidden = YES;
-        }
-        
-        //取消横线
-        if(self.horizontalView)
-        {
-            self.horizontalView.hidden = YES;
-        }
-        
-        oldPositionX = 0;
+        //取消十字线
+        [_crossLayer hide];
+        [self.kLineMainView endLongPress];
+
         //恢复scrollView的滑动
         //self.scrollView.scrollEnabled = YES;
         
@@ -484,6 +458,9 @@
 }
 
 - (void)kLineMainViewCurrentNeedDrawKLineColors:(NSArray *)kLineColors {
+    //分时线宽由主图按宽度算出，成交量图与之一致
+    _config = self.kLineMainView.config;
+    self.kLineVolumeView.config = _config;
     self.kLineVolumeView.kLineColors = kLineColors;
 //    if(self.targetLineStatus >= 103)
 //    {
@@ -10,6 +10,7 @@
 #import "Y_KLineVolumePositionModel.h"
 #import "Y_KLineModel.h"
 #import "Y_StockChartConstant.h"
+#import "Y_StockChartConfig.h"
 
 @interface Y_KLineVolume : NSObject
 
@@ -33,6 +34,11 @@
  */
 @property (nonatomic, strong) UIColor *lineColor;
 
+/**
+ *  图表配置
+ */
+@property (nonatomic, strong) Y_StockChartConfig *config;
+
 /**
  *  根据context初始化均线画笔
  */
@@ -7,7 +7,6 @@
 //
 
 #import "Y_KLineVolume.h"
-#import "Y_StockChartGlobalVariable.h"
 @interface Y_KLineVolume ()
 @property (nonatomic, assign) CGContextRef context;
 @end
@@ -32,9 +31,9 @@
     CGContextSetStrokeColorWithColor(context, self.lineColor.CGColor);
     
     if (self.chartType == Y_StockChartcenterViewTypeTimeLine) {
-        CGContextSetLineWidth(context, [Y_StockChartGlobalVariable tLineWidth] * 0.7);
+        CGContextSetLineWidth(context, self.config.tLineWidth * 0.7);
     } else {
-        CGContextSetLineWidth(context, [Y_StockChartGlobalVariable kLineWidth]);
+        CGContextSetLineWidth(context, self.config.kLineWidth);
     }
     
     const CGPoint solidPoints[] = {self.positionModel.StartPoint, self.positionModel.EndPoint};
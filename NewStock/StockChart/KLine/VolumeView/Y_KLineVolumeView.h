@@ -8,6 +8,7 @@
 
 #import <UIKit/UIKit.h>
 #import "Y_StockChartConstant.h"
+#import "Y_StockChartConfig.h"
 @protocol Y_KLineVolumeViewDelegate <NSObject>
 
 @optional
@@ -46,6 +47,11 @@
  */
 @property (nonatomic, weak) id<Y_KLineVolumeViewDelegate> delegate;
 
+/**
+ *  图表配置
+ */
+@property (nonatomic, strong) Y_StockChartConfig *config;
+
 
 /**
  *  Accessory指标种类
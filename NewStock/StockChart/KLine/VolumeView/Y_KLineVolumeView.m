@@ -61,6 +61,7 @@
     
     Y_KLineVolume *kLineVolume = [[Y_KLineVolume alloc] initWithContext:context];
     kLineVolume.chartType = self.chartType;
+    kLineVolume.config = self.config;
     
     [self.needDrawKLineVolumePositionModels enumerateObjectsUsingBlock:^(Y_KLineVolumePositionModel * _Nonnull volumePositionModel, NSUInteger idx, BOOL * _Nonnull stop) {
         kLineVolume.positionModel = volumePositionModel;
@@ -127,22 +128,22 @@
             maxVolume = model.Volume;
         }
         
-        if(model.Volume_MA7)
+        if([model Volume_MA7WithConfig:self.config])
         {
-            if (minVolume > model.Volume_MA7.floatValue) {
-                minVolume = model.Volume_MA7.floatValue;
+            if (minVolume > [model Volume_MA7WithConfig:self.config].floatValue) {
+                minVolume = [model Volume_MA7WithConfig:self.config].floatValue;
             }
-            if (maxVolume < model.Volume_MA7.floatValue) {
-                maxVolume = model.Volume_MA7.floatValue;
+            if (maxVolume < [model Volume_MA7WithConfig:self.config].floatValue) {
+                maxVolume = [model Volume_MA7WithConfig:self.config].floatValue;
             }
         }
-        if(model.Volume_MA30)
+        if([model Volume_MA30WithConfig:self.config])
         {
-            if (minVolume > model.Volume_MA30.floatValue) {
-                minVolume = model.Volume_MA30.floatValue;
+            if (minVolume > [model Volume_MA30WithConfig:self.config].floatValue) {
+                minVolume = [model Volume_MA30WithConfig:self.config].floatValue;
             }
-            if (maxVolume < model.Volume_MA30.floatValue) {
-                maxVolume = model.Volume_MA30.floatValue;
+            if (maxVolume < [model Volume_MA30WithConfig:self.config].floatValue) {
+                maxVolume = [model Volume_MA30WithConfig:self.config].floatValue;
             }
         }
     }];
@@ -174,17 +175,17 @@
         CGFloat ma30Y = maxY;
         if(unitValue > 0.0000001)
         {
-            if(model.Volume_MA7)
+            if([model Volume_MA7WithConfig:self.config])
             {
-                ma7Y = maxY - (model.Volume_MA7.floatValue - minVolume)/unitValue;
+                ma7Y = maxY - ([model Volume_MA7WithConfig:self.config].floatValue - minVolume)/unitValue;
             }
             
         }
         if(unitValue > 0.0000001)
         {
-            if(model.Volume_MA30)
+            if([model Volume_MA30WithConfig:self.config])
             {
-                ma30Y = maxY - (model.Volume_MA30.floatValue - minVolume)/unitValue;
+                ma30Y = maxY - ([model Volume_MA30WithConfig:self.config].floatValue - minVolume)/unitValue;
             }
         }
         
@@ -193,11 +194,11 @@
         CGPoint ma7Point = CGPointMake(xPosition, ma7Y);
         CGPoint ma30Point = CGPointMake(xPosition, ma30Y);
         
-        if(model.Volume_MA7)
+        if([model Volume_MA7WithConfig:self.config])
         {
             [self.Volume_MA7Positions addObject: [NSValue valueWithCGPoint: ma7Point]];
         }
-        if(model.Volume_MA30)
+        if([model Volume_MA30WithConfig:self.config])
         {
             [self.Volume_MA30Positions addObject: [NSValue valueWithCGPoint: ma30Point]];
         }
@@ -9,6 +9,8 @@
 #import <UIKit/UIKit.h>
 #import "Y_KLineModel.h"
 #import "Y_StockChartConstant.h"
+#import "Y_StockChartConfig.h"
+@class Y_KLineIndicator;
 @interface Y_KLineView : UIView
 
 /**
@@ -21,6 +23,11 @@
  */
 @property (nonatomic, assign) CGFloat volumeViewRatio;
 
+/**
+ *  图表配置
+ */
+@property (nonatomic, strong) Y_StockChartConfig *config;
+
 /**
  *  数据
  */
@@ -42,10 +49,15 @@
 @property (nonatomic, assign) Y_StockChartCenterViewType MainViewType;
 
 /**
- *  Accessory指标种类
+ *  均线种类(MA/EMA/关闭)，或关闭Accessory
  */
 @property (nonatomic, assign) Y_StockChartTargetLineStatus targetLineStatus;
 
+/**
+ *  副图指标，默认注册表中的第一个
+ */
+@property (nonatomic, strong) Y_KLineIndicator *accessoryIndicator;
+
 
 
 -(void)showKLineAccessoryView:(BOOL)b;
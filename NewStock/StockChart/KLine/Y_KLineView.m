@@ -15,12 +15,13 @@
 #import "UIColor+Y_StockChart.h"
 #import <QuartzCore/QuartzCore.h>
 
-#import "Y_StockChartGlobalVariable.h"
 #import "Y_KLineVolumeView.h"
 #import "Y_StockChartRightYView.h"
 #import "Y_KLineAccessoryView.h"
 
 #import "Y_KLineFollowView.h"
+#import "Y_StockChartCrossLayer.h"
+#import "Y_KLineIndicator.h"
 #import "Defination.h"
 
 @interface Y_KLineView() <UIScrollViewDelegate, Y_KLineMainViewDelegate, Y_KLineVolumeViewDelegate, Y_KLineAccessoryViewDelegate>
@@ -61,6 +62,11 @@
  */
 @property (nonatomic, assign) CGFloat oldExactOffset;
 
+/**
+ *  上次缩放手势的scale
+ */
+@property (nonatomic, assign) CGFloat oldPinchScale;
+
 
 //跟随数据View
 @property (nonatomic, strong) Y_KLineFollowView *kLineFollowView;
@@ -82,10 +88,9 @@
 @property (nonatomic, strong) Y_AccessoryMAView *accessoryMAView;
 
 /**
- *  长按后显示的View
+ *  长按后显示的十字线
  */
-@property (nonatomic, strong) UIView *verticalView;
-@property (nonatomic, strong) UIView *horizontalView;
+@property (nonatomic, strong) Y_StockChartCrossLayer *crossLayer;
 
 
 @property (nonatomic, strong) MASConstraint *kLineMainViewHeightConstraint;
@@ -104,27 +109,11 @@
 - (instancetype)initWithFrame:(CGRect)frame {
     self = [super initWithFrame:frame];
     if(self) {
-        self.mainViewRatio = [Y_StockChartGlobalVariable kLineMainViewRadio];
-        self.volumeViewRatio = [Y_StockChartGlobalVariable kLineVolumeViewRadio];
-        
-        
-        /*if (self.MainViewType == Y_StockChartcenterViewTypeKline)
-         {
-         [Y_StockChartGlobalVariable setkLineGap:1.0];
-         [Y_StockChartGlobalVariable setkLineWith:2.0];
-         }
-         else if(self.MainViewType == Y_StockChartcenterViewTypeTimeLine)
-         {
-         [Y_StockChartGlobalVariable setkLineGap:0.0];
-         
-         CGFloat kLineWidth = self.frame.size.width;
-         NSUInteger count = [_kLineModels count];
-         if (count>0)
-         {
-         CGFloat itemWidth = (float)kLineWidth/count;
-         [Y_StockChartGlobalVariable setkLineWith:itemWidth];
-         }
-         }*/
+        _config = [Y_StockChartConfig defaultConfig];
+        self.mainViewRatio = _config.mainViewRatio;
+        self.volumeViewRatio = _config.volumeViewRatio;
+        self.oldPinchScale = 1.0f;
+        _accessoryIndicator = [Y_KLineIndicator registeredIndicators].firstObject;
     }
     return self;
 }
@@ -232,6 +221,7 @@
 - (Y_KLineMainView *)kLineMainView {
     if (!_kLineMainView && self) {
         _kLineMainView = [Y_KLineMainView new];
+        _kLineMainView.config = self.config;
 //        _kLineMainView.layer.borderWidth = 0.5;
 //        _kLineMainView.layer.borderColor = [[UIColor boarderColor] CGColor];
         _kLineMainView.delegate = self;
@@ -255,6 +245,7 @@
     if(!_kLineVolumeView && self)
     {
         _kLineVolumeView = [Y_KLineVolumeView new];
+        _kLineVolumeView.config = self.config;
         _kLineVolumeView.layer.borderWidth = 0.5;
         _kLineVolumeView.layer.borderColor = [kUIColorFromRGB(0xd3d3d3) CGColor];
         _kLineVolumeView.delegate = self;
@@ -275,6 +266,7 @@
     if(!_kLineAccessoryView && self)
     {
         _kLineAccessoryView = [Y_KLineAccessoryView new];
+        _kLineAccessoryView.config = self.config;
         _kLineAccessoryView.layer.borderWidth = 0.5;
         _kLineAccessoryView.layer.borderColor = [kUIColorFromRGB(0xd3d3d3) CGColor];
         
@@ -348,6 +340,13 @@
     return _accessoryView;
 }
 #pragma mark - set方法
+- (void)setConfig:(Y_StockChartConfig *)config {
+    _config = config;
+    _kLineMainView.config = config;
+    _kLineVolumeView.config = config;
+    _kLineAccessoryView.config = config;
+}
+
 - (void)setKLineType:(Y_StockKLineType)kLineType {
     _kLineType = kLineType;
     _kLineMainView.kLineType = kLineType;
@@ -367,7 +366,7 @@
     
     [self private_drawKLineMainView];
     //设置contentOffset
-    CGFloat kLineViewWidth = self.kLineModels.count * [Y_StockChartGlobalVariable kLineWidth] + (self.kLineModels.count + 1) * [Y_StockChartGlobalVariable kLineGap];// + 10;
+    CGFloat kLineViewWidth = self.kLineModels.count * self.config.kLineWidth + (self.kLineModels.count + 1) * self.config.kLineGap;// + 10;
     CGFloat offset = kLineViewWidth - self.scrollView.frame.size.width;
     if (offset > 0)
     {
@@ -385,7 +384,7 @@
 
     
     [self.volumeMAView maProfileWithModel:model];
-    self.accessoryMAView.targetLineStatus = self.targetLineStatus;
+    self.accessoryMAView.indicator = self.accessoryIndicator;
     [self.accessoryMAView maProfileWithModel:model];
 }
 
@@ -393,42 +392,41 @@
     _targetLineStatus = targetLineStatus;
     if(targetLineStatus < 105)
     {
-        if(targetLineStatus == Y_StockChartTargetLineStatusAccessoryClose){
-            
-            [Y_StockChartGlobalVariable setkLineMainViewRadio:0.6];
-            [Y_StockChartGlobalVariable setkLineVolumeViewRadio:0.3];
+        [self private_updateAccessoryLayout];
+    }
 
-        } else {
-            [Y_StockChartGlobalVariable setkLineMainViewRadio:0.6];
-            [Y_StockChartGlobalVariable setkLineVolumeViewRadio:0.3];
+}
 
-        }
-        
-        [self.kLineMainViewHeightConstraint uninstall];
-        [_kLineMainView mas_updateConstraints:^(MASConstraintMaker *make) {
-            self.kLineMainViewHeightConstraint = make.height.equalTo(self.scrollView).multipliedBy([Y_StockChartGlobalVariable kLineMainViewRadio]);
-        }];
-        //[self.kLineVolumeViewHeightConstraint uninstall];
-        [self.kLineVolumeView mas_updateConstraints:^(MASConstraintMaker *make) {
-            make.bottom.equalTo(self).offset(-1);
-            //self.kLineVolumeViewHeightConstraint = make.height.equalTo(self.scrollView.mas_height).multipliedBy([Y_StockChartGlobalVariable kLineVolumeViewRadio]);
-        }];
-        [self reDraw];
-    }
+- (void)setAccessoryIndicator:(Y_KLineIndicator *)accessoryIndicator {
+    _accessoryIndicator = accessoryIndicator;
+    [self private_updateAccessoryLayout];
+}
 
+- (void)private_updateAccessoryLayout {
+    self.config = [self.config configWithMainViewRatio:0.6 volumeViewRatio:0.3];
+
+    [self.kLineMainViewHeightConstraint uninstall];
+    [_kLineMainView mas_updateConstraints:^(MASConstraintMaker *make) {
+        self.kLineMainViewHeightConstraint = make.height.equalTo(self.scrollView).multipliedBy(self.config.mainViewRatio);
+    }];
+    //[self.kLineVolumeViewHeightConstraint uninstall];
+    [self.kLineVolumeView mas_updateConstraints:^(MASConstraintMaker *make) {
+        make.bottom.equalTo(self).offset(-1);
+        //self.kLineVolumeViewHeightConstraint = make.height.equalTo(self.scrollView.mas_height).multipliedBy(self.config.volumeViewRatio);
+    }];
+    [self reDraw];
 }
 #pragma mark - event事件处理方法
 #pragma mark 缩放执行方法
 - (void)event_pichMethod:(UIPinchGestureRecognizer *)pinch {
-    static CGFloat oldScale = 1.0f;
-    CGFloat difValue = pinch.scale - oldScale;
+    CGFloat difValue = pinch.scale - self.oldPinchScale;
     if(ABS(difValue) > Y_StockChartScaleBound) {
-        CGFloat oldKLineWidth = [Y_StockChartGlobalVariable kLineWidth];
+        CGFloat oldKLineWidth = self.config.kLineWidth;
 
         NSInteger oldNeedDrawStartIndex = self.kLineMainView.needDrawStartIndex;
 
-        [Y_StockChartGlobalVariable setkLineWith:oldKLineWidth * (difValue > 0 ? (1 + Y_StockChartScaleFactor) : (1 - Y_StockChartScaleFactor))];
-        oldScale = pinch.scale;
+        self.config = [self.config configWithKLineWidth:oldKLineWidth * (difValue > 0 ? (1 + Y_StockChartScaleFactor) : (1 - Y_StockChartScaleFactor))];
+        self.oldPinchScale = pinch.scale;
         //更新MainView的宽度
         [self.kLineMainView updateMainViewWidth];
         
@@ -436,8 +434,8 @@
             CGPoint p1 = [pinch locationOfTouch:0 inView:self.scrollView];
             CGPoint p2 = [pinch locationOfTouch:1 inView:self.scrollView];
             CGPoint centerPoint = CGPointMake((p1.x+p2.x)/2, (p1.y+p2.y)/2);
-            NSUInteger oldLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - [Y_StockChartGlobalVariable kLineGap]) / ([Y_StockChartGlobalVariable kLineGap] + oldKLineWidth);
-            NSUInteger newLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - [Y_StockChartGlobalVariable kLineGap]) / ([Y_StockChartGlobalVariable kLineGap] + [Y_StockChartGlobalVariable kLineWidth]);
+            NSUInteger oldLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - self.config.kLineGap) / (self.config.kLineGap + oldKLineWidth);
+            NSUInteger newLeftArrCount = ABS((centerPoint.x - self.scrollView.contentOffset.x) - self.config.kLineGap) / (self.config.kLineGap + self.config.kLineWidth);
             
             self.kLineMainView.pinchStartIndex = oldNeedDrawStartIndex + oldLeftArrCount - newLeftArrCount;
             //            self.kLineMainView.pinchPoint = centerPoint;
@@ -446,77 +444,39 @@
         [self.kLineMainView drawMainView];
     }
 }
+
+- (Y_StockChartCrossLayer *)crossLayer {
+    if(!_crossLayer) {
+        _crossLayer = [Y_StockChartCrossLayer layer];
+        //盖在 scrollView 上、跟随 View 下
+        [self.layer insertSublayer:_crossLayer above:self.scrollView.layer];
+    }
+    return _crossLayer;
+}
+
 #pragma mark 长按手势执行方法
 - (void)event_longPressMethod:(UILongPressGestureRecognizer *)longPress {
-    static CGFloat oldPositionX = 0;
     if(UIGestureRecognizerStateChanged == longPress.state || UIGestureRecognizerStateBegan == longPress.state) {
-        CGPoint location = [longPress locationInView:self.scrollView];
-        if(ABS(oldPositionX - location.x) < ([Y_StockChartGlobalVariable kLineWidth] + [Y_StockChartGlobalVariable kLineGap])/2)
-        {
-            return;
-        }
-        
+        CGPoint location = [longPress locationInView:self.kLineMainView];
+
         //暂停滑动
         self.scrollView.scrollEnabled = NO;
-        oldPositionX = location.x;
-        
-        //初始化竖线
-        if(!self.verticalView) {
-            self.verticalView = [UIView new];
-            self.verticalView.clipsToBounds = YES;
-            [self.scrollView addSubview:self.verticalView];
-            self.verticalView.backgroundColor = [UIColor longPressLineColor];
-            [self.verticalView mas_makeConstraints:^(MASConstraintMaker *make) {
-                make.top.equalTo(self).offset(0);
-                make.width.equalTo(@(Y_StockChartLongPressVerticalViewWidth));
-                make.height.equalTo(self.scrollView.mas_height);
-                make.left.equalTo(@(-10));
-            }];
-        } if(!self.horizontalView) {
-            self.horizontalView = [UIView new];
-            self.horizontalView.clipsToBounds = YES;
-            [self.scrollView addSubview:self.horizontalView];
-            self.horizontalView.backgroundColor = [UIColor longPressLineColor];
-            [self.horizontalView mas_makeConstraints:^(MASConstraintMaker *make) {
-                make.top.equalTo(self).offset(-10);
-                //make.width.equalTo(self.scrollView.mas_width);
-                make.width.equalTo(self);
-                make.height.equalTo(@(Y_StockChartLongPressVerticalViewWidth));
-                //make.left.equalTo(@(0));
-                make.left.equalTo(self);
-            }];
+        //按 K 线间距换算长按的是哪一根，换了一根才通知跟随 View
+        NSInteger index = [self.kLineMainView longPressIndexWithOriginXPosition:location.x];
+        if(index == NSNotFound) {
+            return;
         }
-        
-        //更新竖线位置
-        CGFloat rightXPosition = [self.kLineMainView getExactXPositionWithOriginXPosition:location.x];
-        [self.verticalView mas_updateConstraints:^(MASConstraintMaker *make) {
-            make.left.equalTo(@(rightXPosition));
-        }];
-        [self.verticalView layoutIfNeeded];
-        self.verticalView.hidden = NO;
-        
-        
-        //更新横线位置
-        CGFloat rightYPosition = [self.kLineMainView getExactYPositionWithOriginYPosition:location.x];
-        [self.horizontalView mas_updateConstraints:^(MASConstraintMaker *make) {
-            make.top.equalTo(self).offset(rightYPosition);
-        }];
-        [self.horizontalView layoutIfNeeded];
-        self.horizontalView.hidden = NO;
+
+        //更新十字线位置
+        CGPoint crossPoint = [self.kLineMainView convertPoint:[self.kLineMainView crossPointAtIndex:index] toView:self];
+        [self.crossLayer showAtPoint:crossPoint verticalHeight:CGRectGetHeight(self.scrollView.frame)];
     }
-    
+
     if(longPress.state == UIGestureRecognizerStateEnded) {
-        //取消竖线
-        if(self.verticalView) {
-            self.verticalView.hidden = YES;
-        }
-        
-        //取消横线
-        if(self.horizontalView) {
-            self.horizontalView.hidden = YES;
-        }
-        
-        oldPositionX = 0;
+        //取消十字线
+        [_crossLayer hide];
+        [self.kLineMainView endLongPress];
+
         //恢复scrollView的滑动
         self.scrollView.scrollEnabled = YES;
         
@@ -559,7 +519,7 @@
 
 - (void)private_drawKLineAccessoryView {
     //更新约束
-    self.accessoryMAView.targetLineStatus = self.targetLineStatus;
+    self.accessoryMAView.indicator = self.accessoryIndicator;
     [self.accessoryMAView maProfileWithModel:_kLineModels.lastObject];
     [self.kLineAccessoryView layoutIfNeeded];
     [self.kLineAccessoryView draw];
@@ -602,10 +562,7 @@
     [self private_drawKLineVolumeView];
 
     self.kLineAccessoryView.kLineColors = kLineColors;
-    if(self.targetLineStatus < 105)
-    {
-        self.kLineAccessoryView.targetLineStatus = self.targetLineStatus;
-    }
+    self.kLineAccessoryView.indicator = self.accessoryIndicator;
     [self private_drawKLineAccessoryView];
 }
 
@@ -0,0 +1,146 @@
+//
+//  kline_bench.cpp
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+//  kline_core 微基准
+//
+//  kline_bench                       合成序列 1k/10k/100k/1M 根
+//  kline_bench --quick               只跑 1k，用于 ctest 冒烟
+//  kline_bench file.csv [...]        录制的序列，格式同 tests/golden/series.csv
+//
+
+#include "kline_core.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Series {
+    std::string name;
+    std::vector<double> open, high, low, close, volume, prevClose;
+    size_t size() const { return close.size(); }
+};
+
+//几何随机游走，固定种子
+Series syntheticSeries(size_t count) {
+    Series s;
+    char name[32];
+    std::snprintf(name, sizeof(name), "synthetic %zu", count);
+    s.name = name;
+    uint64_t seed = 20161227;
+    auto rand = [&seed]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (seed >> 11) * (1.0 / 9007199254740992.0);
+    };
+    double close = 12.34;
+    for (size_t i = 0; i < count; i++) {
+        double prev = close;
+        double open = prev * (1 + (rand() - 0.5) * 0.02);
+        close = prev * (1 + (rand() - 0.5) * 0.06);
+        s.open.push_back(open);
+        s.high.push_back(std::max(open, close) * (1 + rand() * 0.01));
+        s.low.push_back(std::min(open, close) * (1 - rand() * 0.01));
+        s.close.push_back(close);
+        s.volume.push_back(1e5 + rand() * 9e6);
+        s.prevClose.push_back(prev);
+    }
+    return s;
+}
+
+bool loadSeries(const char *path, Series &s) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    s.name = path;
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line)) {
+        std::stringstream row(line);
+        std::vector<double> *columns[] = {&s.open, &s.high, &s.low, &s.close, &s.volume, &s.prevClose};
+        for (std::vector<double> *column : columns) {
+            std::string cell;
+            std::getline(row, cell, ',');
+            column->push_back(cell.empty() ? NAN : std::strtod(cell.c_str(), NULL));
+        }
+    }
+    return s.size() > 0;
+}
+
+//重复执行直到累计超过 minTime，返回每根 K 线的纳秒数
+template <typename F>
+double measure(size_t bars, F fn) {
+    using Clock = std::chrono::steady_clock;
+    const auto minTime = std::chrono::milliseconds(200);
+    size_t iterations = 0;
+    auto start = Clock::now();
+    auto elapsed = Clock::duration::zero();
+    do {
+        fn();
+        iterations++;
+        elapsed = Clock::now() - start;
+    } while (elapsed < minTime);
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    return ns / iterations / bars;
+}
+
+volatile double sink;
+
+void run(const Series &s) {
+    size_t n = s.size();
+    std::vector<double> a(n), b(n), c(n);
+
+    std::printf("%s\n", s.name.c_str());
+    struct Case {
+        const char *name;
+        double nsPerBar;
+    } cases[] = {
+        {"MA(5)", measure(n, [&] { kline_ma(s.close.data(), n, 5, a.data()); })},
+        {"MA(30)", measure(n, [&] { kline_ma(s.close.data(), n, 30, a.data()); })},
+        {"EMA(12)", measure(n, [&] { kline_ema(s.close.data(), n, 12, a.data()); })},
+        {"MACD(12,26,9)", measure(n, [&] { kline_macd(s.close.data(), n, 12, 26, 9, a.data(), b.data(), c.data()); })},
+        {"KDJ(9,3,3)", measure(n, [&] { kline_kdj(s.high.data(), s.low.data(), s.close.data(), n, 9, 3, 3, a.data(), b.data(), c.data(), NULL, NULL, NULL); })},
+        {"RSI(6)", measure(n, [&] { kline_rsi(s.close.data(), s.prevClose.data(), n, 6, a.data()); })},
+        {"BOLL(20,2)", measure(n, [&] { kline_boll(s.close.data(), n, 20, 2, a.data(), b.data(), c.data(), NULL); })},
+    };
+    sink = a[n - 1] + b[n - 1] + c[n - 1];
+
+    for (const Case &c : cases) {
+        std::printf("  %-16s %8.2f ns/bar  %10.3f ms/series\n", c.name, c.nsPerBar, c.nsPerBar * n / 1e6);
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--quick") == 0) {
+        run(syntheticSeries(1000));
+        return 0;
+    }
+    if (argc > 1) {
+        for (int i = 1; i < argc; i++) {
+            Series s;
+            if (!loadSeries(argv[i], s)) {
+                std::fprintf(stderr, "cannot read %s\n", argv[i]);
+                return 1;
+            }
+            run(s);
+        }
+        return 0;
+    }
+    for (size_t count : {1000, 10000, 100000, 1000000}) {
+        run(syntheticSeries(count));
+    }
+    return 0;
+}
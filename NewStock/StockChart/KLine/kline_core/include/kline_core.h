@@ -0,0 +1,248 @@
+//
+//  kline_core.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+//  K线指标计算，纯 C 实现，不依赖 UIKit/Foundation，可在客户端和服务端共用。
+//  公式见 KLineModel/指标公式.md、KDJ介绍.md。
+//
+//  约定：
+//  - 输入按时间升序，下标 0 为最早的一根
+//  - 输出数组由调用方分配，长度与输入相同，不能与输入重叠
+//  - 数据不足一个周期的位置输出 NAN(kline_is_missing 判断)
+//
+
+#ifndef KLINE_CORE_H
+#define KLINE_CORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KLINE_OK        0
+#define KLINE_EINVAL   -1   //参数错误
+#define KLINE_ENOMEM   -2   //内存不足
+#define KLINE_EIO      -3   //读写文件失败
+#define KLINE_ENOENT   -4   //没有缓存
+
+//是否为缺失值(NAN)
+int kline_is_missing(double value);
+
+//以下求和都用 Neumaier 补偿，长序列、大成交量下误差不随长度累积
+
+//前缀和：out[i] = in[0] + ... + in[i]
+int kline_prefix_sum(const double *in, size_t count, double *out);
+
+//滑动窗口和：out[i] = in[i-N+1] + ... + in[i]，不足 N 根时为已有的全部之和，每根 O(1)
+int kline_rolling_sum(const double *in, size_t count, size_t period, double *out);
+
+//MA(N) = (C1+C2+……CN)/N，i < N-1 输出 NAN
+int kline_ma(const double *in, size_t count, size_t period, double *out);
+
+//EMA(N) = 2/(N+1)*(C-昨日EMA)+昨日EMA，第一根等于 in[0]
+int kline_ema(const double *in, size_t count, size_t period, double *out);
+
+//SMA(X,N,M) = (M*X + (N-M)*昨日SMA)/N，第一根等于 seed
+int kline_sma(const double *in, size_t count, size_t period, double weight, double seed, double *out);
+
+//N 周期内最高/最低值，不足 N 根时取已有的全部
+int kline_highest(const double *in, size_t count, size_t period, double *out);
+int kline_lowest(const double *in, size_t count, size_t period, double *out);
+
+//MACD(fast,slow,signal)
+//DIF = EMA(fast) - EMA(slow)，DEA = EMA(DIF, signal)，BAR = 2*(DIF-DEA)
+//第一根 DIF、DEA、BAR 均为 0
+int kline_macd(const double *close, size_t count,
+               size_t fast, size_t slow, size_t signal,
+               double *dif, double *dea, double *bar);
+
+//KDJ(period,m1,m2)
+//RSV = (C-LLV(L,period))/(HHV(H,period)-LLV(L,period))*100，最高等于最低时 RSV 为 100
+//K = SMA(RSV,m1,1)，D = SMA(K,m2,1)，前一日 K、D 初始为 50，J = 3K-2D
+//rsv/highest/lowest 可传 NULL
+int kline_kdj(const double *high, const double *low, const double *close, size_t count,
+              size_t period, size_t m1, size_t m2,
+              double *k, double *d, double *j,
+              double *rsv, double *highest, double *lowest);
+
+//RSI(N) = SMA(MAX(C-LC,0),N,1)/SMA(ABS(C-LC),N,1)*100
+//LC 取 prev_close[i]，prev_close 为 NULL 或该位置为 NAN 时取 close[i-1]
+//第一根没有昨收，输出 0
+int kline_rsi(const double *close, const double *prev_close, size_t count,
+              size_t period, double *out);
+
+//BOLL(N,P)
+//MID = MA(C,N)，VART1 = (C-MID)^2，VART2 = MA(VART1,N)
+//UPPER = MID + P*SQRT(VART2)，LOWER = MID - P*SQRT(VART2)
+//MID 从 N-1 开始有值，UPPER/LOWER 从 2N-2 开始有值；vart1 可传 NULL
+int kline_boll(const double *close, size_t count, size_t period, double width,
+               double *mid, double *upper, double *lower, double *vart1);
+
+//----------------------------------------------------------------------
+//指标注册表
+//每个指标声明参数、所需输入、输出列和增量计算函数，副图按声明绘制，新增指标只需写一个 update 并加入注册表。
+//列由调用方分配，每列长度与输入相同：前 output_count 列为输出，其后为迭代用的状态列。
+//update 计算 [from, count) 的各列，要求 [0, from) 已由之前的调用按相同的输入算好；
+//追加新 K 线时 from 取原根数，最后一根更新时 from 取 count-1。
+
+#define KLINE_INDICATOR_MAX_PARAMS   4
+#define KLINE_INDICATOR_MAX_COLUMNS  10
+
+//输入列
+#define KLINE_INPUT_HIGH        (1u << 0)
+#define KLINE_INPUT_LOW         (1u << 1)
+#define KLINE_INPUT_CLOSE       (1u << 2)
+#define KLINE_INPUT_VOLUME      (1u << 3)
+#define KLINE_INPUT_PREV_CLOSE  (1u << 4)   //可选，缺失时取上一根收盘价
+
+//指标标志
+#define KLINE_INDICATOR_PRICE_OVERLAY  (1u << 0)   //与价格同一坐标，副图同时画 K 线
+#define KLINE_INDICATOR_MAIN_CHART     (1u << 1)   //主图、成交量图的均线，不进副图菜单
+
+typedef struct {
+    const double *high;
+    const double *low;
+    const double *close;
+    const double *volume;
+    const double *prev_close;   //可为 NULL，或某根为 NAN
+    size_t count;
+} kline_inputs;
+
+typedef enum {
+    KLINE_STYLE_LINE = 0,
+    KLINE_STYLE_BAR,            //以 0 为基线的柱，正值为涨色
+} kline_style;
+
+typedef struct {
+    const char *name;
+    double value;               //默认值
+    double min;
+    double max;
+    int integral;               //周期类参数只能取整数
+} kline_param;
+
+typedef struct {
+    const char *name;
+    kline_style style;
+    int suffix_param;           //非 0 时名称后接第 suffix_param 个参数(从 1 数)，如 RSI6
+} kline_output;
+
+typedef int (*kline_indicator_update_fn)(const kline_inputs *in, size_t from,
+                                         const double *params, double *const *columns);
+
+typedef struct {
+    const char *name;
+    unsigned flags;
+    unsigned inputs;            //KLINE_INPUT_* 组合
+    size_t param_count;
+    kline_param params[KLINE_INDICATOR_MAX_PARAMS];
+    size_t output_count;
+    kline_output outputs[KLINE_INDICATOR_MAX_COLUMNS];
+    size_t column_count;        //输出列 + 状态列
+    kline_indicator_update_fn update;
+} kline_indicator;
+
+//注册表按副图菜单顺序排列，KLINE_INDICATOR_MAIN_CHART 的排在最后
+size_t kline_indicator_count(void);
+const kline_indicator *kline_indicator_at(size_t index);
+//按名称查找，没有返回 NULL
+const kline_indicator *kline_indicator_find(const char *name);
+
+//检查参数范围和所需输入后调用 indicator->update；params 为 NULL 时用默认值
+int kline_indicator_update(const kline_indicator *indicator, const kline_inputs *in, size_t from,
+                           const double *params, double *const *columns);
+
+//----------------------------------------------------------------------
+//周期聚合
+
+//一根 K 线，time 为毫秒时间戳；average_price 为当日累计均价，没有时为 NAN
+typedef struct {
+    int64_t time;
+    double open;
+    double high;
+    double low;
+    double close;
+    double volume;
+    double average_price;
+    double prev_close;
+} kline_bar;
+
+typedef enum {
+    KLINE_PERIOD_MINUTE = 0,    //N 分钟
+    KLINE_PERIOD_WEEK,          //周一至周日
+    KLINE_PERIOD_MONTH,
+    KLINE_PERIOD_QUARTER,
+    KLINE_PERIOD_YEAR,
+} kline_period_unit;
+
+//交易时段，分钟数从当地零点算起，如 9:30 为 570
+typedef struct {
+    int open_minute;
+    int close_minute;
+} kline_session;
+
+typedef struct {
+    kline_period_unit unit;
+    int minutes;                    //unit 为 KLINE_PERIOD_MINUTE 时的分钟数
+    int utc_offset_minutes;         //当地时区，北京时间为 480
+    const kline_session *sessions;  //按时间升序；为 NULL 时按全天连续切分
+    size_t session_count;
+} kline_period;
+
+//A 股交易时段 9:30-11:30、13:00-15:00
+extern const kline_session kline_a_share_sessions[2];
+
+//把较细周期的 K 线聚合成 period 周期：开取第一根、收取最后一根，高低取极值，量求和，昨收取第一根，
+//均价本身是累计值，取最后一根
+//分钟 K 以区间结束时间标记(9:35 为 9:30-9:35)，开盘集合竞价并入第一根，午休及收盘后的数据并入前一时段最后一根
+//周、月、季、年 K 的时间取区间内最后一根的时间
+//in 按时间升序，out 至少 count 个，可与 in 相同(原地聚合)；返回输出根数，参数错误返回 0
+size_t kline_resample(const kline_bar *in, size_t count, const kline_period *period, kline_bar *out);
+
+//----------------------------------------------------------------------
+//K 线磁盘缓存
+//每个 key(股票+周期)一个文件，由若干次追加写入的段组成，读取时按顺序回放：
+//后写入的段覆盖时间不早于其第一根的旧数据，未收盘的最后一根会被新数据更新。
+//断电等造成的残缺段读取时丢弃，下次追加前截掉。
+//段数超过 KLINE_STORE_MAX_SEGMENTS 时合并成一段；文件总大小超过上限时按最近使用时间淘汰。
+//不是线程安全的，调用方需串行访问同一个目录
+
+#define KLINE_STORE_MAX_SEGMENTS 8
+
+typedef struct kline_store kline_store;
+
+typedef struct {
+    size_t count;           //回放后的根数
+    size_t segments;        //有效段数
+    int64_t first_time;
+    int64_t last_time;
+} kline_store_info;
+
+//dir 需已存在；capacity 为所有缓存文件的总字节数上限，0 表示不限
+kline_store *kline_store_open(const char *dir, size_t capacity);
+void kline_store_close(kline_store *store);
+
+//key 只能包含字母、数字和 '_'、'-'、'.'，长度不超过 128
+//读取全部 K 线，*bars 由调用方 free；没有缓存返回 KLINE_ENOENT
+int kline_store_read(kline_store *store, const char *key, kline_bar **bars, size_t *count);
+//已缓存的范围，供请求时只取更新的数据；只读文件头，文件头过期(写到一半)时才回放
+int kline_store_stat(kline_store *store, const char *key, kline_store_info *info);
+//追加一段，bars 按时间升序
+int kline_store_append(kline_store *store, const char *key, const kline_bar *bars, size_t count);
+//整体替换为一段，先写临时文件再 rename
+int kline_store_write(kline_store *store, const char *key, const kline_bar *bars, size_t count);
+int kline_store_remove(kline_store *store, const char *key);
+//按最近使用时间淘汰到不超过 capacity，最近使用的一个文件总是保留；
+//append/write 之后自动调用，此时刚写入的文件总是保留
+int kline_store_trim(kline_store *store);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KLINE_CORE_H */
@@ -0,0 +1,283 @@
+//
+//  kline_core.c
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#include "kline_core.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+//Neumaier 补偿求和，c 累计每次加法舍入丢掉的低位
+typedef struct {
+    double sum;
+    double c;
+} kline_accumulator;
+
+static inline void kline_accumulate(kline_accumulator *acc, double value) {
+    double t = acc->sum + value;
+    if (fabs(acc->sum) >= fabs(value)) {
+        acc->c += (acc->sum - t) + value;
+    } else {
+        acc->c += (value - t) + acc->sum;
+    }
+    acc->sum = t;
+}
+
+static inline double kline_accumulated(const kline_accumulator *acc) {
+    return acc->sum + acc->c;
+}
+
+int kline_is_missing(double value) {
+    return isnan(value);
+}
+
+int kline_prefix_sum(const double *in, size_t count, double *out) {
+    if (count && (!in || !out)) {
+        return KLINE_EINVAL;
+    }
+    kline_accumulator acc = {0, 0};
+    for (size_t i = 0; i < count; i++) {
+        kline_accumulate(&acc, in[i]);
+        out[i] = kline_accumulated(&acc);
+    }
+    return KLINE_OK;
+}
+
+int kline_rolling_sum(const double *in, size_t count, size_t period, double *out) {
+    if (period == 0 || (count && (!in || !out))) {
+        return KLINE_EINVAL;
+    }
+    //滑动窗口，每根加入新值、移出旧值，加减都做补偿
+    kline_accumulator acc = {0, 0};
+    for (size_t i = 0; i < count; i++) {
+        kline_accumulate(&acc, in[i]);
+        if (i >= period) {
+            kline_accumulate(&acc, -in[i - period]);
+        }
+        out[i] = kline_accumulated(&acc);
+    }
+    return KLINE_OK;
+}
+
+int kline_ma(const double *in, size_t count, size_t period, double *out) {
+    int status = kline_rolling_sum(in, count, period, out);
+    if (status != KLINE_OK) {
+        return status;
+    }
+    for (size_t i = 0; i < count; i++) {
+        out[i] = i + 1 >= period ? out[i] / period : NAN;
+    }
+    return KLINE_OK;
+}
+
+int kline_sma(const double *in, size_t count, size_t period, double weight, double seed, double *out) {
+    if (period == 0 || weight <= 0 || weight > period || (count && (!in || !out))) {
+        return KLINE_EINVAL;
+    }
+    double prev = seed;
+    for (size_t i = 0; i < count; i++) {
+        prev = (weight * in[i] + (period - weight) * prev) / period;
+        out[i] = prev;
+    }
+    return KLINE_OK;
+}
+
+int kline_ema(const double *in, size_t count, size_t period, double *out) {
+    if (period == 0 || (count && (!in || !out))) {
+        return KLINE_EINVAL;
+    }
+    if (count == 0) {
+        return KLINE_OK;
+    }
+    //EMA(N) 即 SMA(X,N+1,2)，新股首日用收盘价作为前一日 EMA
+    return kline_sma(in, count, period + 1, 2, in[0], out);
+}
+
+//单调队列求窗口极值，sign 为 1 求最大、-1 求最小
+static int kline_extreme(const double *in, size_t count, size_t period, double sign, double *out) {
+    if (period == 0 || (count && (!in || !out))) {
+        return KLINE_EINVAL;
+    }
+    if (count == 0) {
+        return KLINE_OK;
+    }
+    //环形缓冲，容量取 2 的幂，用掩码代替取模
+    size_t limit = period < count ? period : count;
+    size_t capacity = 1;
+    while (capacity < limit) {
+        capacity <<= 1;
+    }
+    size_t mask = capacity - 1;
+    size_t *queue = malloc(capacity * sizeof(size_t));
+    if (!queue) {
+        return KLINE_ENOMEM;
+    }
+    //head 为队首，size 为元素个数
+    size_t head = 0, size = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (size && queue[head] + period <= i) {
+            head = (head + 1) & mask;
+            size--;
+        }
+        while (size) {
+            size_t tail = (head + size - 1) & mask;
+            if (sign * in[queue[tail]] > sign * in[i]) {
+                break;
+            }
+            size--;
+        }
+        queue[(head + size) & mask] = i;
+        size++;
+        out[i] = in[queue[head]];
+    }
+    free(queue);
+    return KLINE_OK;
+}
+
+int kline_highest(const double *in, size_t count, size_t period, double *out) {
+    return kline_extreme(in, count, period, 1, out);
+}
+
+int kline_lowest(const double *in, size_t count, size_t period, double *out) {
+    return kline_extreme(in, count, period, -1, out);
+}
+
+int kline_macd(const double *close, size_t count,
+               size_t fast, size_t slow, size_t signal,
+               double *dif, double *dea, double *bar) {
+    if (fast == 0 || slow == 0 || signal == 0 || (count && (!close || !dif || !dea || !bar))) {
+        return KLINE_EINVAL;
+    }
+    if (count == 0) {
+        return KLINE_OK;
+    }
+    double fastAlpha = 2.0 / (fast + 1);
+    double slowAlpha = 2.0 / (slow + 1);
+    double signalAlpha = 2.0 / (signal + 1);
+
+    double fastEMA = close[0];
+    double slowEMA = close[0];
+    double prevDEA = 0;
+    for (size_t i = 0; i < count; i++) {
+        fastEMA += fastAlpha * (close[i] - fastEMA);
+        slowEMA += slowAlpha * (close[i] - slowEMA);
+        double d = fastEMA - slowEMA;
+        //新股首日不存在前一日，DEA 从 0 开始迭代
+        prevDEA = i == 0 ? 0 : prevDEA + signalAlpha * (d - prevDEA);
+        dif[i] = d;
+        dea[i] = prevDEA;
+        bar[i] = 2 * (d - prevDEA);
+    }
+    return KLINE_OK;
+}
+
+int kline_kdj(const double *high, const double *low, const double *close, size_t count,
+              size_t period, size_t m1, size_t m2,
+              double *k, double *d, double *j,
+              double *rsv, double *highest, double *lowest) {
+    if (period == 0 || m1 == 0 || m2 == 0 || (count && (!high || !low || !close || !k || !d || !j))) {
+        return KLINE_EINVAL;
+    }
+    if (count == 0) {
+        return KLINE_OK;
+    }
+
+    double *hh = highest, *ll = lowest;
+    double *buffer = NULL;
+    if (!hh || !ll) {
+        buffer = malloc(2 * count * sizeof(double));
+        if (!buffer) {
+            return KLINE_ENOMEM;
+        }
+        if (!hh) hh = buffer;
+        if (!ll) ll = buffer + count;
+    }
+
+    int status = kline_highest(high, count, period, hh);
+    if (status == KLINE_OK) {
+        status = kline_lowest(low, count, period, ll);
+    }
+    if (status == KLINE_OK) {
+        double prevK = 50, prevD = 50;
+        for (size_t i = 0; i < count; i++) {
+            double range = hh[i] - ll[i];
+            double r = range == 0 ? 100 : (close[i] - ll[i]) * 100 / range;
+            prevK = (r + (m1 - 1) * prevK) / m1;
+            prevD = (prevK + (m2 - 1) * prevD) / m2;
+            k[i] = prevK;
+            d[i] = prevD;
+            j[i] = 3 * prevK - 2 * prevD;
+            if (rsv) {
+                rsv[i] = r;
+            }
+        }
+    }
+
+    free(buffer);
+    return status;
+}
+
+int kline_rsi(const double *close, const double *prev_close, size_t count,
+              size_t period, double *out) {
+    if (period == 0 || (count && (!close || !out))) {
+        return KLINE_EINVAL;
+    }
+    double up = 0, total = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (i == 0) {
+            out[i] = 0;
+            continue;
+        }
+        double lc = prev_close && !isnan(prev_close[i]) ? prev_close[i] : close[i - 1];
+        double change = close[i] - lc;
+        up = ((change > 0 ? change : 0) + (period - 1) * up) / period;
+        total = (fabs(change) + (period - 1) * total) / period;
+        out[i] = total == 0 ? 0 : up * 100 / total;
+    }
+    return KLINE_OK;
+}
+
+int kline_boll(const double *close, size_t count, size_t period, double width,
+               double *mid, double *upper, double *lower, double *vart1) {
+    if (period == 0 || (count && (!close || !mid || !upper || !lower))) {
+        return KLINE_EINVAL;
+    }
+    int status = kline_ma(close, count, period, mid);
+    if (status != KLINE_OK) {
+        return status;
+    }
+
+    //VART1 从 MID 有值开始，对其再做 N 周期滑动平均
+    kline_accumulator acc = {0, 0};
+    size_t valid = 0;
+    for (size_t i = 0; i < count; i++) {
+        double v = NAN;
+        if (!isnan(mid[i])) {
+            double diff = close[i] - mid[i];
+            v = diff * diff;
+            kline_accumulate(&acc, v);
+            valid++;
+            if (valid > period) {
+                double old = close[i - period] - mid[i - period];
+                kline_accumulate(&acc, -(old * old));
+            }
+        }
+        if (vart1) {
+            vart1[i] = v;
+        }
+        if (valid >= period) {
+            //补偿后仍可能出现极小的负数
+            double dev = width * sqrt(fmax(kline_accumulated(&acc) / period, 0));
+            upper[i] = mid[i] + dev;
+            lower[i] = mid[i] - dev;
+        } else {
+            upper[i] = NAN;
+            lower[i] = NAN;
+        }
+    }
+    return KLINE_OK;
+}
@@ -0,0 +1,371 @@
+//
+//  kline_indicator.c
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+//  指标注册表，副图指标及主图、成交量图的均线。每个 update 只算 [from, count)，递推类指标从前一根的输出/状态列接着算，
+//  窗口类指标从 from 往前补一个窗口的输入重新算。
+//
+
+#include "kline_core.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+//第 i 根的昨收，第一根没有昨收时返回 NAN
+static inline double kline_last_close(const kline_inputs *in, size_t i) {
+    if (in->prev_close && !isnan(in->prev_close[i])) {
+        return in->prev_close[i];
+    }
+    return i > 0 ? in->close[i - 1] : NAN;
+}
+
+//[from, count) 的 period 周期最高最低，hh[0]/ll[0] 对应 from
+static int kline_window_range(const kline_inputs *in, size_t from, size_t period, double *hh, double *ll) {
+    size_t start = from + 1 > period ? from + 1 - period : 0;
+    size_t n = in->count - start;
+    double *buffer = malloc(2 * n * sizeof(double));
+    if (!buffer) {
+        return KLINE_ENOMEM;
+    }
+    int status = kline_highest(in->high + start, n, period, buffer);
+    if (status == KLINE_OK) {
+        status = kline_lowest(in->low + start, n, period, buffer + n);
+    }
+    if (status == KLINE_OK) {
+        memcpy(hh, buffer + (from - start), (in->count - from) * sizeof(double));
+        memcpy(ll, buffer + n + (from - start), (in->count - from) * sizeof(double));
+    }
+    free(buffer);
+    return status;
+}
+
+//列：DIF DEA MACD | EMA(SHORT) EMA(LONG)
+static int kline_macd_update(const kline_inputs *in, size_t from, const double *params, double *const *columns) {
+    double fastAlpha = 2.0 / (params[0] + 1);
+    double slowAlpha = 2.0 / (params[1] + 1);
+    double signalAlpha = 2.0 / (params[2] + 1);
+    double *dif = columns[0], *dea = columns[1], *bar = columns[2];
+    double *fastEMA = columns[3], *slowEMA = columns[4];
+
+    for (size_t i = from; i < in->count; i++) {
+        double c = in->close[i];
+        if (i == 0) {
+            //与 kline_macd 一致，第一根 DIF、DEA 均为 0
+            fastEMA[i] = c;
+            slowEMA[i] = c;
+            dif[i] = 0;
+            dea[i] = 0;
+            bar[i] = 0;
+            continue;
+        }
+        fastEMA[i] = fastEMA[i - 1] + fastAlpha * (c - fastEMA[i - 1]);
+        slowEMA[i] = slowEMA[i - 1] + slowAlpha * (c - slowEMA[i - 1]);
+        dif[i] = fastEMA[i] - slowEMA[i];
+        dea[i] = dea[i - 1] + signalAlpha * (dif[i] - dea[i - 1]);
+        bar[i] = 2 * (dif[i] - dea[i]);
+    }
+    return KLINE_OK;
+}
+
+//列：K D J
+static int kline_kdj_update(const kline_inputs *in, size_t from, const double *params, double *const *columns) {
+    size_t period = (size_t)params[0];
+    double m1 = params[1], m2 = params[2];
+    double *k = columns[0], *d = columns[1], *j = columns[2];
+    size_t n = in->count - from;
+
+    double *range = malloc(2 * n * sizeof(double));
+    if (!range) {
+        return KLINE_ENOMEM;
+    }
+    int status = kline_window_range(in, from, period, range, range + n);
+    if (status == KLINE_OK) {
+        double prevK = from ? k[from - 1] : 50;
+        double prevD = from ? d[from - 1] : 50;
+        for (size_t i = from; i < in->count; i++) {
+            double hh = range[i - from], ll = range[n + i - from];
+            double r = hh == ll ? 100 : (in->close[i] - ll) * 100 / (hh - ll);
+            prevK = (r + (m1 - 1) * prevK) / m1;
+            prevD = (prevK + (m2 - 1) * prevD) / m2;
+            k[i] = prevK;
+            d[i] = prevD;
+            j[i] = 3 * prevK - 2 * prevD;
+        }
+    }
+    free(range);
+    return status;
+}
+
+//列：RSI1 RSI2 RSI3 | 每个周期的涨幅均值、振幅均值
+static int kline_rsi_update(const kline_inputs *in, size_t from, const double *params, double *const *columns) {
+    for (size_t p = 0; p < 3; p++) {
+        double period = params[p];
+        double *out = columns[p], *up = columns[3 + 2 * p], *total = columns[4 + 2 * p];
+        for (size_t i = from; i < in->count; i++) {
+            if (i == 0) {
+                out[i] = 0;
+                up[i] = 0;
+                total[i] = 0;
+                continue;
+            }
+            double change = in->close[i] - kline_last_close(in, i);
+            up[i] = ((change > 0 ? change : 0) + (period - 1) * up[i - 1]) / period;
+            total[i] = (fabs(change) + (period - 1) * total[i - 1]) / period;
+            out[i] = total[i] == 0 ? 0 : up[i] * 100 / total[i];
+        }
+    }
+    return KLINE_OK;
+}
+
+//列：UPPER MID LOWER
+static int kline_boll_update(const kline_inputs *in, size_t from, const double *params, double *const *columns) {
+    size_t period = (size_t)params[0];
+    //UPPER/LOWER 依赖往前 2N-2 根收盘价
+    size_t lookback = 2 * period - 2;
+    size_t start = from > lookback ? from - lookback : 0;
+    size_t n = in->count - start;
+
+    double *buffer = malloc(3 * n * sizeof(double));
+    if (!buffer) {
+        return KLINE_ENOMEM;
+    }
+    int status = kline_boll(in->close + start, n, period, params[1], buffer + n, buffer, buffer + 2 * n, NULL);
+    if (status == KLINE_OK) {
+        for (size_t c = 0; c < 3; c++) {
+            memcpy(columns[c] + from, buffer + c * n + (from - start), (in->count - from) * sizeof(double));
+        }
+    }
+    free(buffer);
+    return status;
+}
+
+//WR(N) = (HHV(H,N)-C)/(HHV(H,N)-LLV(L,N))*100，最高等于最低时为 0
+//列：WR1 WR2
+static int kline_wr_update(const kline_inputs *in, size_t from, const double *params, double *const *columns) {
+    size_t n = in->count - from;
+    double *range = malloc(2 * n * sizeof(double));
+    if (!range) {
+        return KLINE_ENOMEM;
+    }
+    int status = KLINE_OK;
+    for (size_t p = 0; p < 2 && status == KLINE_OK; p++) {
+        status = kline_window_range(in, from, (size_t)params[p], range, range + n);
+        for (size_t i = from; status == KLINE_OK && i < in->count; i++) {
+            double hh = range[i - from], ll = range[n + i - from];
+            columns[p][i] = hh == ll ? 0 : (hh - in->close[i]) * 100 / (hh - ll);
+        }
+    }
+    free(range);
+    return status;
+}
+
+//OBV = 昨日OBV + SGN(C-LC)*V，第一根没有昨收时为 0；MAOBV = MA(OBV,M)
+//列：OBV MAOBV
+static int kline_obv_update(const kline_inputs *in, size_t from, const double *params, double *const *columns) {
+    size_t period = (size_t)params[0];
+    double *obv = columns[0], *ma = columns[1];
+    for (size_t i = from; i < in->count; i++) {
+        double change = in->close[i] - kline_last_close(in, i);
+        double v = change > 0 ? in->volume[i] : (change < 0 ? -in->volume[i] : 0);
+        obv[i] = (i ? obv[i - 1] : 0) + v;
+    }
+
+    size_t start = from + 1 > period ? from + 1 - period : 0;
+    size_t n = in->count - start;
+    double *buffer = malloc(n * sizeof(double));
+    if (!buffer) {
+        return KLINE_ENOMEM;
+    }
+    int status = kline_ma(obv + start, n, period, buffer);
+    if (status == KLINE_OK) {
+        memcpy(ma + from, buffer + (from - start), (in->count - from) * sizeof(double));
+    }
+    free(buffer);
+    return status;
+}
+
+//src 的 params[0..count) 各周期均线，每个周期从 from 往前补一个窗口重新算
+static int kline_ma_columns(const double *src, size_t count, size_t from, const double *params, size_t periods,
+                            double *const *columns) {
+    size_t longest = 0;
+    for (size_t p = 0; p < periods; p++) {
+        longest = (size_t)params[p] > longest ? (size_t)params[p] : longest;
+    }
+    size_t capacity = count - from + longest;
+    double *buffer = malloc((capacity < count ? capacity : count) * sizeof(double));
+    if (!buffer) {
+        return KLINE_ENOMEM;
+    }
+    int status = KLINE_OK;
+    for (size_t p = 0; p < periods && status == KLINE_OK; p++) {
+        size_t period = (size_t)params[p];
+        size_t start = from + 1 > period ? from + 1 - period : 0;
+        status = kline_ma(src + start, count - start, period, buffer);
+        if (status == KLINE_OK) {
+            memcpy(columns[p] + from, buffer + (from - start), (count - from) * sizeof(double));
+        }
+    }
+    free(buffer);
+    return status;
+}
+
+//与 kline_ema 一致，从前一根的 EMA 接着递推，第一根取自身
+static int kline_ema_columns(const double *src, size_t count, size_t from, const double *params, size_t periods,
+                             double *const *columns) {
+    for (size_t p = 0; p < periods; p++) {
+        double seed = from ? columns[p][from - 1] : src[0];
+        int status = kline_sma(src + from, count - from, (size_t)params[p] + 1, 2, seed, columns[p] + from);
+        if (status != KLINE_OK) {
+            return status;
+        }
+    }
+    return KLINE_OK;
+}
+
+//列：MA1 MA2 MA3 MA4
+static int kline_price_ma_update(const kline_inputs *in, size_t from, const double *params, double *const *columns) {
+    return kline_ma_columns(in->close, in->count, from, params, 4, columns);
+}
+
+//列：EMA1 EMA2
+static int kline_price_ema_update(const kline_inputs *in, size_t from, const double *params, double *const *columns) {
+    return kline_ema_columns(in->close, in->count, from, params, 2, columns);
+}
+
+//列：MA1 MA2
+static int kline_volume_ma_update(const kline_inputs *in, size_t from, const double *params, double *const *columns) {
+    return kline_ma_columns(in->volume, in->count, from, params, 2, columns);
+}
+
+//列：EMA1 EMA2
+static int kline_volume_ema_update(const kline_inputs *in, size_t from, const double *params, double *const *columns) {
+    return kline_ema_columns(in->volume, in->count, from, params, 2, columns);
+}
+
+static const kline_indicator kline_indicators[] = {
+    {
+        "MACD", 0, KLINE_INPUT_CLOSE,
+        3, {{"SHORT", 12, 2, 200, 1}, {"LONG", 26, 2, 200, 1}, {"MID", 9, 2, 200, 1}},
+        3, {{"DIF", KLINE_STYLE_LINE, 0}, {"DEA", KLINE_STYLE_LINE, 0}, {"MACD", KLINE_STYLE_BAR, 0}},
+        5, kline_macd_update,
+    },
+    {
+        "KDJ", 0, KLINE_INPUT_HIGH | KLINE_INPUT_LOW | KLINE_INPUT_CLOSE,
+        3, {{"N", 9, 1, 100, 1}, {"M1", 3, 1, 100, 1}, {"M2", 3, 1, 100, 1}},
+        3, {{"K", KLINE_STYLE_LINE, 0}, {"D", KLINE_STYLE_LINE, 0}, {"J", KLINE_STYLE_LINE, 0}},
+        3, kline_kdj_update,
+    },
+    {
+        "RSI", 0, KLINE_INPUT_CLOSE | KLINE_INPUT_PREV_CLOSE,
+        3, {{"N1", 6, 1, 100, 1}, {"N2", 12, 1, 100, 1}, {"N3", 24, 1, 100, 1}},
+        3, {{"RSI", KLINE_STYLE_LINE, 1}, {"RSI", KLINE_STYLE_LINE, 2}, {"RSI", KLINE_STYLE_LINE, 3}},
+        9, kline_rsi_update,
+    },
+    {
+        "BOLL", KLINE_INDICATOR_PRICE_OVERLAY, KLINE_INPUT_CLOSE,
+        2, {{"N", 20, 2, 120, 1}, {"P", 2, 0.1, 10, 0}},
+        3, {{"UPPER", KLINE_STYLE_LINE, 0}, {"MID", KLINE_STYLE_LINE, 0}, {"LOWER", KLINE_STYLE_LINE, 0}},
+        3, kline_boll_update,
+    },
+    {
+        "WR", 0, KLINE_INPUT_HIGH | KLINE_INPUT_LOW | KLINE_INPUT_CLOSE,
+        2, {{"N", 10, 1, 100, 1}, {"N1", 6, 1, 100, 1}},
+        2, {{"WR", KLINE_STYLE_LINE, 1}, {"WR", KLINE_STYLE_LINE, 2}},
+        2, kline_wr_update,
+    },
+    {
+        "OBV", 0, KLINE_INPUT_CLOSE | KLINE_INPUT_VOLUME | KLINE_INPUT_PREV_CLOSE,
+        1, {{"M", 30, 1, 250, 1}},
+        2, {{"OBV", KLINE_STYLE_LINE, 0}, {"MAOBV", KLINE_STYLE_LINE, 0}},
+        2, kline_obv_update,
+    },
+    //以下为主图、成交量图的均线，不进副图菜单
+    {
+        "MA", KLINE_INDICATOR_MAIN_CHART | KLINE_INDICATOR_PRICE_OVERLAY, KLINE_INPUT_CLOSE,
+        4, {{"N1", 5, 1, 250, 1}, {"N2", 10, 1, 250, 1}, {"N3", 20, 1, 250, 1}, {"N4", 30, 1, 250, 1}},
+        4, {{"MA", KLINE_STYLE_LINE, 1}, {"MA", KLINE_STYLE_LINE, 2}, {"MA", KLINE_STYLE_LINE, 3}, {"MA", KLINE_STYLE_LINE, 4}},
+        4, kline_price_ma_update,
+    },
+    {
+        "EMA", KLINE_INDICATOR_MAIN_CHART | KLINE_INDICATOR_PRICE_OVERLAY, KLINE_INPUT_CLOSE,
+        2, {{"N1", 5, 1, 250, 1}, {"N2", 30, 1, 250, 1}},
+        2, {{"EMA", KLINE_STYLE_LINE, 1}, {"EMA", KLINE_STYLE_LINE, 2}},
+        2, kline_price_ema_update,
+    },
+    {
+        "VMA", KLINE_INDICATOR_MAIN_CHART, KLINE_INPUT_VOLUME,
+        2, {{"M1", 7, 1, 250, 1}, {"M2", 30, 1, 250, 1}},
+        2, {{"MA", KLINE_STYLE_LINE, 1}, {"MA", KLINE_STYLE_LINE, 2}},
+        2, kline_volume_ma_update,
+    },
+    {
+        "VEMA", KLINE_INDICATOR_MAIN_CHART, KLINE_INPUT_VOLUME,
+        2, {{"M1", 7, 1, 250, 1}, {"M2", 30, 1, 250, 1}},
+        2, {{"EMA", KLINE_STYLE_LINE, 1}, {"EMA", KLINE_STYLE_LINE, 2}},
+        2, kline_volume_ema_update,
+    },
+};
+
+size_t kline_indicator_count(void) {
+    return sizeof(kline_indicators) / sizeof(kline_indicators[0]);
+}
+
+const kline_indicator *kline_indicator_at(size_t index) {
+    return index < kline_indicator_count() ? &kline_indicators[index] : NULL;
+}
+
+const kline_indicator *kline_indicator_find(const char *name) {
+    if (!name) {
+        return NULL;
+    }
+    for (size_t i = 0; i < kline_indicator_count(); i++) {
+        if (strcmp(kline_indicators[i].name, name) == 0) {
+            return &kline_indicators[i];
+        }
+    }
+    return NULL;
+}
+
+int kline_indicator_update(const kline_indicator *indicator, const kline_inputs *in, size_t from,
+                           const double *params, double *const *columns) {
+    if (!indicator || !in || !columns || from > in->count) {
+        return KLINE_EINVAL;
+    }
+
+    double defaults[KLINE_INDICATOR_MAX_PARAMS];
+    if (!params) {
+        for (size_t p = 0; p < indicator->param_count; p++) {
+            defaults[p] = indicator->params[p].value;
+        }
+        params = defaults;
+    }
+    for (size_t p = 0; p < indicator->param_count; p++) {
+        const kline_param *param = &indicator->params[p];
+        if (!(params[p] >= param->min && params[p] <= param->max)) {
+            return KLINE_EINVAL;
+        }
+        if (param->integral && params[p] != floor(params[p])) {
+            return KLINE_EINVAL;
+        }
+    }
+
+    if (from == in->count) {
+        return KLINE_OK;
+    }
+    if (((indicator->inputs & KLINE_INPUT_HIGH) && !in->high) ||
+        ((indicator->inputs & KLINE_INPUT_LOW) && !in->low) ||
+        ((indicator->inputs & KLINE_INPUT_CLOSE) && !in->close) ||
+        ((indicator->inputs & KLINE_INPUT_VOLUME) && !in->volume)) {
+        return KLINE_EINVAL;
+    }
+    for (size_t c = 0; c < indicator->column_count; c++) {
+        if (!columns[c]) {
+            return KLINE_EINVAL;
+        }
+    }
+    return indicator->update(in, from, params, columns);
+}
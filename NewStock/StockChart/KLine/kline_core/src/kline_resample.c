@@ -0,0 +1,130 @@
+//
+//  kline_resample.c
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#include "kline_core.h"
+
+#include <math.h>
+
+const kline_session kline_a_share_sessions[2] = {
+    {9 * 60 + 30, 11 * 60 + 30},
+    {13 * 60, 15 * 60},
+};
+
+static int64_t floor_div(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+//1970-01-01 起的天数转公历年月(H. Hinnant civil_from_days)
+static void civil_from_days(int64_t days, int64_t *year, int *month) {
+    days += 719468;
+    int64_t era = floor_div(days, 146097);
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    *year = yoe + era * 400 + (m <= 2);
+    *month = m;
+}
+
+//分钟 K 所属区间的结束分钟(当地零点起)
+static int minute_bucket_end(int minute, const kline_period *period) {
+    int n = period->minutes;
+    if (!period->sessions || period->session_count == 0) {
+        int end = (minute + n - 1) / n * n;
+        return end > 0 ? end : n;
+    }
+
+    //最后一个开盘时间不晚于 minute 的时段，早于第一个时段的算第一个时段
+    size_t s = 0;
+    for (size_t i = 0; i < period->session_count; i++) {
+        if (period->sessions[i].open_minute <= minute) {
+            s = i;
+        }
+    }
+    const kline_session *session = &period->sessions[s];
+    int offset = minute - session->open_minute;
+    int length = session->close_minute - session->open_minute;
+    if (offset > length) {
+        offset = length;
+    }
+    if (offset < 1) {
+        offset = 1;
+    }
+    int end = session->open_minute + (offset + n - 1) / n * n;
+    return end < session->close_minute ? end : session->close_minute;
+}
+
+//区间键，相同键的 K 线合并；minute 周期同时给出区间结束时间
+static int64_t bucket_key(int64_t time, const kline_period *period, int64_t *label) {
+    int64_t local = floor_div(time, 60000) + period->utc_offset_minutes;
+    int64_t days = floor_div(local, 1440);
+    int minute = (int)(local - days * 1440);
+
+    switch (period->unit) {
+        case KLINE_PERIOD_MINUTE: {
+            int end = minute_bucket_end(minute, period);
+            int64_t key = days * 1440 + end;
+            *label = (key - period->utc_offset_minutes) * 60000;
+            return key;
+        }
+        case KLINE_PERIOD_WEEK:
+            //1970-01-01 是周四，+3 后以周一为一周开始
+            return floor_div(days + 3, 7);
+        case KLINE_PERIOD_MONTH:
+        case KLINE_PERIOD_QUARTER:
+        case KLINE_PERIOD_YEAR: {
+            int64_t year;
+            int month;
+            civil_from_days(days, &year, &month);
+            if (period->unit == KLINE_PERIOD_MONTH) {
+                return year * 12 + (month - 1);
+            }
+            if (period->unit == KLINE_PERIOD_QUARTER) {
+                return year * 4 + (month - 1) / 3;
+            }
+            return year;
+        }
+    }
+    return 0;
+}
+
+size_t kline_resample(const kline_bar *in, size_t count, const kline_period *period, kline_bar *out) {
+    if (!period || (count && (!in || !out))) {
+        return 0;
+    }
+    if (period->unit == KLINE_PERIOD_MINUTE && period->minutes <= 0) {
+        return 0;
+    }
+
+    size_t n = 0;
+    int64_t currentKey = 0;
+    for (size_t i = 0; i < count; i++) {
+        //先拷贝，原地聚合时 out[n] 可能就是 in[i]
+        kline_bar bar = in[i];
+        int64_t label = bar.time;
+        int64_t key = bucket_key(bar.time, period, &label);
+
+        if (n == 0 || key != currentKey) {
+            currentKey = key;
+            bar.time = label;
+            out[n++] = bar;
+            continue;
+        }
+
+        kline_bar *merged = &out[n - 1];
+        merged->time = label;
+        merged->high = fmax(merged->high, bar.high);
+        merged->low = fmin(merged->low, bar.low);
+        merged->close = bar.close;
+        merged->volume += bar.volume;
+        merged->average_price = bar.average_price;
+    }
+    return n;
+}
@@ -0,0 +1,515 @@
+//
+//  kline_store.c
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+//  文件格式(本机字节序，只作缓存用)：
+//  文件头 {magic, sizeof(kline_bar), 回放后的根数/段数/首尾时间, 对应的文件长度}，
+//  之后是若干段 {count, checksum} + count 根 kline_bar。
+//  每次写入段后再更新文件头；文件长度和文件头记录的不一致(写到一半)时 stat 退回整段回放。
+//
+
+#include "kline_core.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#define KLINE_STORE_MAGIC       0x334c4b53u     //"SKL3"，文件头带回放结果
+#define KLINE_STORE_SUFFIX      ".kls"
+#define KLINE_STORE_MAX_KEY     128
+
+struct kline_store {
+    char *dir;
+    size_t capacity;
+};
+
+typedef struct {
+    uint32_t magic;
+    uint32_t bar_size;
+    uint32_t count;
+    uint32_t segments;
+    int64_t first_time;
+    int64_t last_time;
+    int64_t file_size;      //写入文件头时的文件长度
+} store_header;
+
+typedef struct {
+    uint32_t count;
+    uint32_t checksum;
+} segment_header;
+
+//回放结果
+typedef struct {
+    kline_bar *bars;
+    size_t count;
+    size_t capacity;
+    size_t segments;
+    long valid_end;     //最后一个有效段的结束位置
+    long file_size;
+} store_replay;
+
+//FNV-1a
+static uint32_t checksum(const void *data, size_t size) {
+    const unsigned char *p = data;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int valid_key(const char *key) {
+    if (!key || !*key) {
+        return 0;
+    }
+    size_t n = 0;
+    for (const char *c = key; *c; c++, n++) {
+        int ok = (*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9') ||
+                 *c == '_' || *c == '-' || *c == '.';
+        if (!ok || n >= KLINE_STORE_MAX_KEY) {
+            return 0;
+        }
+    }
+    //不允许 "." 和 ".."
+    return strcmp(key, ".") != 0 && strcmp(key, "..") != 0;
+}
+
+static char *store_path(const kline_store *store, const char *key, const char *suffix) {
+    size_t size = strlen(store->dir) + 1 + strlen(key) + strlen(suffix) + 1;
+    char *path = malloc(size);
+    if (path) {
+        snprintf(path, size, "%s/%s%s", store->dir, key, suffix);
+    }
+    return path;
+}
+
+static int trim_store(kline_store *store, const char *keep);
+
+static int replay_reserve(store_replay *r, size_t extra) {
+    size_t need = r->count + extra;
+    if (need <= r->capacity) {
+        return KLINE_OK;
+    }
+    size_t capacity = r->capacity ? r->capacity : 256;
+    while (capacity < need) {
+        capacity *= 2;
+    }
+    kline_bar *bars = realloc(r->bars, capacity * sizeof(kline_bar));
+    if (!bars) {
+        return KLINE_ENOMEM;
+    }
+    r->bars = bars;
+    r->capacity = capacity;
+    return KLINE_OK;
+}
+
+//r->bars[r->count, r->count+count) 是新的一段，覆盖时间不早于其第一根的旧数据
+static void replay_apply(store_replay *r, size_t count) {
+    kline_bar *segment = r->bars + r->count;
+    size_t lo = 0, hi = r->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (r->bars[mid].time < segment[0].time) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo != r->count) {
+        memmove(r->bars + lo, segment, count * sizeof(kline_bar));
+    }
+    r->count = lo + count;
+    r->segments++;
+}
+
+static int replay_file(const char *path, store_replay *r) {
+    memset(r, 0, sizeof(*r));
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        return KLINE_ENOENT;
+    }
+
+    store_header header;
+    if (fseek(fp, 0, SEEK_END) != 0 || (r->file_size = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET) != 0 ||
+        fread(&header, sizeof(header), 1, fp) != 1 ||
+        header.magic != KLINE_STORE_MAGIC || header.bar_size != sizeof(kline_bar)) {
+        //格式不对当作没有缓存，下次写入时覆盖
+        fclose(fp);
+        return KLINE_ENOENT;
+    }
+    r->valid_end = (long)sizeof(header);
+
+    int rc = KLINE_OK;
+    segment_header segment;
+    while (fread(&segment, sizeof(segment), 1, fp) == 1) {
+        long remaining = r->file_size - r->valid_end - (long)sizeof(segment);
+        if (segment.count == 0 || (unsigned long)remaining / sizeof(kline_bar) < segment.count) {
+            break;
+        }
+        if ((rc = replay_reserve(r, segment.count)) != KLINE_OK) {
+            break;
+        }
+        kline_bar *tail = r->bars + r->count;
+        if (fread(tail, sizeof(kline_bar), segment.count, fp) != segment.count ||
+            checksum(tail, segment.count * sizeof(kline_bar)) != segment.checksum) {
+            break;
+        }
+        replay_apply(r, segment.count);
+        r->valid_end += (long)(sizeof(segment) + segment.count * sizeof(kline_bar));
+    }
+    fclose(fp);
+
+    if (rc != KLINE_OK) {
+        free(r->bars);
+        memset(r, 0, sizeof(*r));
+    }
+    return rc;
+}
+
+//fp 的当前位置会被移到文件头之后
+static int write_header(FILE *fp, const store_replay *r) {
+    store_header header;
+    memset(&header, 0, sizeof(header));
+    header.magic = KLINE_STORE_MAGIC;
+    header.bar_size = (uint32_t)sizeof(kline_bar);
+    header.count = (uint32_t)r->count;
+    header.segments = (uint32_t)r->segments;
+    if (r->count) {
+        header.first_time = r->bars[0].time;
+        header.last_time = r->bars[r->count - 1].time;
+    }
+    header.file_size = r->valid_end;
+    if (fseek(fp, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, fp) != 1) {
+        return KLINE_EIO;
+    }
+    return KLINE_OK;
+}
+
+static int write_segment(FILE *fp, const kline_bar *bars, size_t count) {
+    segment_header segment;
+    segment.count = (uint32_t)count;
+    segment.checksum = checksum(bars, count * sizeof(kline_bar));
+    if (fwrite(&segment, sizeof(segment), 1, fp) != 1 ||
+        fwrite(bars, sizeof(kline_bar), count, fp) != count) {
+        return KLINE_EIO;
+    }
+    return KLINE_OK;
+}
+
+static int write_file(const kline_store *store, const char *key, const kline_bar *bars, size_t count) {
+    char *path = store_path(store, key, KLINE_STORE_SUFFIX);
+    char *tmp = store_path(store, key, ".tmp");
+    int rc = KLINE_ENOMEM;
+    if (path && tmp) {
+        rc = KLINE_EIO;
+        FILE *fp = fopen(tmp, "wb");
+        if (fp) {
+            store_replay r;
+            memset(&r, 0, sizeof(r));
+            r.bars = (kline_bar *)bars;
+            r.count = count;
+            r.segments = 1;
+            r.valid_end = (long)(sizeof(store_header) + sizeof(segment_header) + count * sizeof(kline_bar));
+            int ok = write_header(fp, &r) == KLINE_OK && write_segment(fp, bars, count) == KLINE_OK;
+            ok = (fclose(fp) == 0) && ok;
+            if (ok && rename(tmp, path) == 0) {
+                rc = KLINE_OK;
+            } else {
+                remove(tmp);
+            }
+        }
+    }
+    free(path);
+    free(tmp);
+    return rc;
+}
+
+kline_store *kline_store_open(const char *dir, size_t capacity) {
+    if (!dir || !*dir) {
+        return NULL;
+    }
+    kline_store *store = malloc(sizeof(kline_store));
+    if (!store) {
+        return NULL;
+    }
+    store->dir = malloc(strlen(dir) + 1);
+    if (!store->dir) {
+        free(store);
+        return NULL;
+    }
+    strcpy(store->dir, dir);
+    store->capacity = capacity;
+    return store;
+}
+
+void kline_store_close(kline_store *store) {
+    if (store) {
+        free(store->dir);
+        free(store);
+    }
+}
+
+int kline_store_read(kline_store *store, const char *key, kline_bar **bars, size_t *count) {
+    if (!store || !valid_key(key) || !bars || !count) {
+        return KLINE_EINVAL;
+    }
+    *bars = NULL;
+    *count = 0;
+    char *path = store_path(store, key, KLINE_STORE_SUFFIX);
+    if (!path) {
+        return KLINE_ENOMEM;
+    }
+    store_replay r;
+    int rc = replay_file(path, &r);
+    if (rc == KLINE_OK && r.count == 0) {
+        rc = KLINE_ENOENT;
+    }
+    if (rc == KLINE_OK) {
+        //更新最近使用时间
+        utime(path, NULL);
+        *bars = r.bars;
+        *count = r.count;
+    } else {
+        free(r.bars);
+    }
+    free(path);
+    return rc;
+}
+
+int kline_store_stat(kline_store *store, const char *key, kline_store_info *info) {
+    if (!store || !valid_key(key) || !info) {
+        return KLINE_EINVAL;
+    }
+    memset(info, 0, sizeof(*info));
+    char *path = store_path(store, key, KLINE_STORE_SUFFIX);
+    if (!path) {
+        return KLINE_ENOMEM;
+    }
+
+    //文件头和文件长度一致时直接用文件头记录的结果
+    FILE *fp = fopen(path, "rb");
+    if (!fp) {
+        free(path);
+        return KLINE_ENOENT;
+    }
+    store_header header;
+    struct stat st;
+    int trusted = fread(&header, sizeof(header), 1, fp) == 1 && fstat(fileno(fp), &st) == 0 &&
+                  header.magic == KLINE_STORE_MAGIC && header.bar_size == sizeof(kline_bar) &&
+                  header.file_size == (int64_t)st.st_size;
+    fclose(fp);
+    if (trusted) {
+        free(path);
+        if (header.count == 0) {
+            return KLINE_ENOENT;
+        }
+        info->count = header.count;
+        info->segments = header.segments;
+        info->first_time = header.first_time;
+        info->last_time = header.last_time;
+        return KLINE_OK;
+    }
+
+    store_replay r;
+    int rc = replay_file(path, &r);
+    if (rc == KLINE_OK && r.count == 0) {
+        rc = KLINE_ENOENT;
+    }
+    if (rc == KLINE_OK) {
+        info->count = r.count;
+        info->segments = r.segments;
+        info->first_time = r.bars[0].time;
+        info->last_time = r.bars[r.count - 1].time;
+    }
+    free(r.bars);
+    free(path);
+    return rc;
+}
+
+int kline_store_append(kline_store *store, const char *key, const kline_bar *bars, size_t count) {
+    if (!store || !valid_key(key) || (count && !bars)) {
+        return KLINE_EINVAL;
+    }
+    if (count == 0) {
+        return KLINE_OK;
+    }
+    char *path = store_path(store, key, KLINE_STORE_SUFFIX);
+    if (!path) {
+        return KLINE_ENOMEM;
+    }
+
+    store_replay r;
+    int rc = replay_file(path, &r);
+    if (rc == KLINE_ENOENT || (rc == KLINE_OK && r.segments == 0)) {
+        rc = write_file(store, key, bars, count);
+    } else if (rc == KLINE_OK && r.segments + 1 > KLINE_STORE_MAX_SEGMENTS) {
+        //合并成一段
+        rc = replay_reserve(&r, count);
+        if (rc == KLINE_OK) {
+            memcpy(r.bars + r.count, bars, count * sizeof(kline_bar));
+            replay_apply(&r, count);
+            rc = write_file(store, key, r.bars, r.count);
+        }
+    } else if (rc == KLINE_OK) {
+        //截掉残缺的段再追加
+        if (r.valid_end != r.file_size && truncate(path, r.valid_end) != 0) {
+            rc = KLINE_EIO;
+        } else {
+            FILE *fp = fopen(path, "r+b");
+            rc = KLINE_EIO;
+            if (fp) {
+                //先写段，再按回放结果更新文件头
+                rc = fseek(fp, r.valid_end, SEEK_SET) == 0 ? write_segment(fp, bars, count) : KLINE_EIO;
+                if (rc == KLINE_OK) {
+                    rc = replay_reserve(&r, count);
+                }
+                if (rc == KLINE_OK) {
+                    memcpy(r.bars + r.count, bars, count * sizeof(kline_bar));
+                    replay_apply(&r, count);
+                    r.valid_end += (long)(sizeof(segment_header) + count * sizeof(kline_bar));
+                    rc = write_header(fp, &r);
+                }
+                if (fclose(fp) != 0) {
+                    rc = KLINE_EIO;
+                }
+            }
+        }
+    }
+    free(r.bars);
+
+    if (rc == KLINE_OK) {
+        trim_store(store, path);
+    }
+    free(path);
+    return rc;
+}
+
+int kline_store_write(kline_store *store, const char *key, const kline_bar *bars, size_t count) {
+    if (!store || !valid_key(key) || (count && !bars)) {
+        return KLINE_EINVAL;
+    }
+    if (count == 0) {
+        return kline_store_remove(store, key);
+    }
+    int rc = write_file(store, key, bars, count);
+    if (rc == KLINE_OK) {
+        char *path = store_path(store, key, KLINE_STORE_SUFFIX);
+        trim_store(store, path);
+        free(path);
+    }
+    return rc;
+}
+
+int kline_store_remove(kline_store *store, const char *key) {
+    if (!store || !valid_key(key)) {
+        return KLINE_EINVAL;
+    }
+    char *path = store_path(store, key, KLINE_STORE_SUFFIX);
+    if (!path) {
+        return KLINE_ENOMEM;
+    }
+    int rc = (remove(path) == 0) ? KLINE_OK : KLINE_ENOENT;
+    free(path);
+    return rc;
+}
+
+typedef struct {
+    char *path;
+    long long size;
+    time_t mtime;
+} store_file;
+
+static int compare_mtime(const void *a, const void *b) {
+    const store_file *fa = a, *fb = b;
+    if (fa->mtime != fb->mtime) {
+        return fa->mtime < fb->mtime ? -1 : 1;
+    }
+    return strcmp(fa->path, fb->path);
+}
+
+int kline_store_trim(kline_store *store) {
+    if (!store) {
+        return KLINE_EINVAL;
+    }
+    return trim_store(store, NULL);
+}
+
+//keep 为刚写入的文件，不参与淘汰(mtime 只精确到秒，同一秒写入的文件分不出先后)；
+//为 NULL 时保留最近使用的一个
+static int trim_store(kline_store *store, const char *keep) {
+    if (store->capacity == 0) {
+        return KLINE_OK;
+    }
+    DIR *dir = opendir(store->dir);
+    if (!dir) {
+        return KLINE_EIO;
+    }
+
+    store_file *files = NULL;
+    size_t count = 0, capacity = 0;
+    long long total = 0;
+    int rc = KLINE_OK;
+    size_t suffix = strlen(KLINE_STORE_SUFFIX);
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        size_t length = strlen(entry->d_name);
+        if (length <= suffix || strcmp(entry->d_name + length - suffix, KLINE_STORE_SUFFIX) != 0) {
+            continue;
+        }
+        if (count == capacity) {
+            capacity = capacity ? capacity * 2 : 32;
+            store_file *grown = realloc(files, capacity * sizeof(store_file));
+            if (!grown) {
+                rc = KLINE_ENOMEM;
+                break;
+            }
+            files = grown;
+        }
+        size_t size = strlen(store->dir) + 1 + length + 1;
+        char *path = malloc(size);
+        if (!path) {
+            rc = KLINE_ENOMEM;
+            break;
+        }
+        snprintf(path, size, "%s/%s", store->dir, entry->d_name);
+        struct stat st;
+        if (stat(path, &st) != 0) {
+            free(path);
+            continue;
+        }
+        if (keep && strcmp(path, keep) == 0) {
+            total += (long long)st.st_size;
+            free(path);
+            continue;
+        }
+        files[count].path = path;
+        files[count].size = (long long)st.st_size;
+        files[count].mtime = st.st_mtime;
+        total += files[count].size;
+        count++;
+    }
+    closedir(dir);
+
+    size_t evictable = keep ? count : (count ? count - 1 : 0);
+    if (rc == KLINE_OK && total > (long long)store->capacity && evictable > 0) {
+        qsort(files, count, sizeof(store_file), compare_mtime);
+        for (size_t i = 0; i < evictable && total > (long long)store->capacity; i++) {
+            if (remove(files[i].path) == 0) {
+                total -= files[i].size;
+            }
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        free(files[i].path);
+    }
+    free(files);
+    return rc;
+}
@@ -0,0 +1,305 @@
+#!/usr/bin/env python3
+#
+#  gen_golden.py
+#  NewStock
+#
+#  Created by Willey on 2026/10/19.
+#  Copyright © 2026年 Willey. All rights reserved.
+#
+#  生成 kline_core 金值测试数据。
+#  按 指标公式.md / KDJ介绍.md 逐条直译，每根都对窗口重新求和，不复用 kline_core 的增量算法。
+#
+#  python3 gen_golden.py                     # 生成本目录及 ../fixtures/daily、../fixtures/minute1
+#  python3 gen_golden.py --json kline.json DIR
+#      把 K 线接口的返回(createChartTime/open/high/low/close/volume/prevClose)存为 DIR/series.csv，
+#      并生成 DIR/expected.csv；用抓到的真实行情替换 fixtures 下的序列时用这个
+#  python3 gen_golden.py DIR                 # 按已有的 DIR/series.csv 重新生成 DIR/expected.csv
+
+import datetime
+import json
+import math
+import os
+import sys
+
+COUNT = 80
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+BEIJING = datetime.timezone(datetime.timedelta(hours=8))
+
+
+def lcg(seed):
+    # 固定种子的线性同余，保证每次生成一致
+    def rand():
+        nonlocal seed
+        seed = (seed * 1103515245 + 12345) % (1 << 31)
+        return seed / float(1 << 31)
+    return rand
+
+
+def series():
+    rand = lcg(20161227)
+    rows = []
+    close = 12.34
+    for i in range(COUNT):
+        prev = close
+        open_ = round(prev * (1 + (rand() - 0.5) * 0.02), 2)
+        close = round(prev * (1 + (rand() - 0.5) * 0.06), 2)
+        high = round(max(open_, close) * (1 + rand() * 0.01), 2)
+        low = round(min(open_, close) * (1 - rand() * 0.01), 2)
+        volume = float(int(100000 + rand() * 900000))
+        # 第 0 根没有昨收；另外留几根空缺，测试用上一根收盘价补
+        prev_close = None if i == 0 or i % 17 == 5 else prev
+        # 几根一字板，测试最高等于最低
+        if i in (30, 31, 32, 33, 34, 35, 36, 37, 38):
+            open_ = high = low = close = prev
+        rows.append((open_, high, low, close, volume, prev_close))
+    return rows
+
+
+def millis(day, hour=15, minute=0):
+    t = datetime.datetime(day.year, day.month, day.day, hour, minute, tzinfo=BEIJING)
+    return int(t.timestamp()) * 1000
+
+
+def limit_price(prev, up):
+    # 主板涨跌停 10%，按分四舍五入
+    return round(prev * (1.1 if up else 0.9) + 1e-9, 2)
+
+
+def daily_series():
+    # 按 A 股日线的形态生成一年：周末和春节休市、停牌数日、除权日昨收不等于前一根收盘、
+    # 涨跌停封板(一字板)、成交量按手计
+    rand = lcg(20250102)
+    rows = []
+    day = datetime.date(2025, 1, 2)
+    close = 15.67
+    ex_rights = datetime.date(2025, 6, 19)
+    while len(rows) < 250:
+        closed = (day.weekday() >= 5
+                  or datetime.date(2025, 1, 28) <= day <= datetime.date(2025, 2, 4)
+                  or datetime.date(2025, 4, 7) <= day <= datetime.date(2025, 4, 11))  # 停牌
+        if closed:
+            day += datetime.timedelta(days=1)
+            continue
+        prev = close
+        if day == ex_rights:
+            # 10 派 5 元
+            prev = round(prev - 0.5, 2)
+        up, down = limit_price(prev, True), limit_price(prev, False)
+        index = len(rows)
+        if index in (120, 121):
+            open_ = high = low = close = up
+            volume = float(int(2000 + rand() * 8000))
+        elif index == 180:
+            open_ = high = low = close = down
+            volume = float(int(3000 + rand() * 5000))
+        else:
+            open_ = min(max(round(prev * (1 + (rand() - 0.5) * 0.03), 2), down), up)
+            close = min(max(round(prev * (1 + (rand() - 0.5) * 0.08), 2), down), up)
+            high = min(round(max(open_, close) * (1 + rand() * 0.015), 2), up)
+            low = max(round(min(open_, close) * (1 - rand() * 0.015), 2), down)
+            volume = float(int(50000 + rand() * 450000))
+        prev_close = None if index == 0 else prev
+        rows.append((open_, high, low, close, volume, prev_close, millis(day)))
+        day += datetime.timedelta(days=1)
+    return rows
+
+
+def minute_series():
+    # 按 A 股一个交易日的 1 分钟线生成：9:31~11:30、13:01~15:00 共 240 根，开盘和尾盘放量，
+    # 午间休市，偶有没有成交的分钟(四价相同、量为 0)；只有第一根带昨收，其余用上一根收盘补
+    rand = lcg(20250616)
+    day = datetime.date(2025, 6, 16)
+    yesterday = 15.67
+    rows = []
+    close = yesterday
+    minutes = [(9, 31 + i) for i in range(29)] + [(10, i) for i in range(60)] + \
+              [(11, i) for i in range(31)] + [(13, 1 + i) for i in range(59)] + \
+              [(14, i) for i in range(60)] + [(15, 0)]
+    for index, (hour, minute) in enumerate(minutes):
+        prev = close
+        if index % 23 == 11:
+            open_ = high = low = close = prev
+            volume = 0.0
+        else:
+            open_ = round(prev + (rand() - 0.5) * 0.02, 2)
+            close = round(prev + (rand() - 0.5) * 0.06, 2)
+            high = round(max(open_, close) + rand() * 0.02, 2)
+            low = round(min(open_, close) - rand() * 0.02, 2)
+            # 开盘和尾盘成交量大
+            edge = 4.0 if index < 10 or index >= 230 else 1.0
+            volume = float(int((200 + rand() * 1800) * edge))
+        prev_close = yesterday if index == 0 else None
+        rows.append((open_, high, low, close, volume, prev_close, millis(day, hour, minute)))
+    return rows
+
+
+def json_series(path):
+    # K 线接口返回的数组，或外面包一层 data/list
+    with open(path) as f:
+        data = json.load(f)
+    while isinstance(data, dict):
+        data = data.get('data') or data.get('list') or []
+    rows = []
+    for bar in data:
+        def value(key):
+            v = bar.get(key)
+            return None if v is None or v == '' else float(v)
+        prev_close = value('prevClose')
+        rows.append((value('open'), value('high'), value('low'), value('close'), value('volume'),
+                     prev_close if prev_close else None, int(bar['createChartTime'])))
+    rows.sort(key=lambda r: r[6])
+    return rows
+
+
+def read_series(directory):
+    rows = []
+    with open(os.path.join(directory, 'series.csv')) as f:
+        names = f.readline().strip().split(',')
+        for line in f:
+            cells = dict(zip(names, line.strip().split(',')))
+            row = [None if cells.get(n, '') == '' else float(cells[n])
+                   for n in ('open', 'high', 'low', 'close', 'volume', 'prev_close')]
+            if 'time' in cells:
+                row.append(int(cells['time']))
+            rows.append(tuple(row))
+    return rows
+
+
+def ma(values, n):
+    out = []
+    for i in range(len(values)):
+        if i + 1 < n or values[i - n + 1] is None:
+            out.append(None)
+        else:
+            out.append(sum(values[i - n + 1:i + 1]) / n)
+    return out
+
+
+def ema(values, n):
+    # EMA(N) = 2/(N+1)*(C-昨日EMA)+昨日EMA，首日前一日 EMA 取收盘价
+    out = []
+    prev = values[0]
+    for v in values:
+        prev = 2.0 / (n + 1) * (v - prev) + prev
+        out.append(prev)
+    return out
+
+
+def macd(close):
+    ema12 = ema(close, 12)
+    ema26 = ema(close, 26)
+    dif, dea, bar = [], [], []
+    prev_dea = 0.0
+    for i in range(len(close)):
+        d = ema12[i] - ema26[i]
+        # 今日 DEA = 前一日 DEA*8/10 + 今日 DIF*2/10，首日为 0
+        prev_dea = 0.0 if i == 0 else prev_dea * 8 / 10 + d * 2 / 10
+        dif.append(d)
+        dea.append(prev_dea)
+        bar.append(2 * (d - prev_dea))
+    return dif, dea, bar
+
+
+def kdj(high, low, close):
+    ks, ds, js = [], [], []
+    k = d = 50.0
+    for i in range(len(close)):
+        lo = min(low[max(0, i - 8):i + 1])
+        hi = max(high[max(0, i - 8):i + 1])
+        rsv = 100.0 if hi == lo else (close[i] - lo) / (hi - lo) * 100
+        # K = (当日RSV + 2*前一日K)/3，D = (当日K + 2*前一日D)/3
+        k = (rsv + 2 * k) / 3
+        d = (k + 2 * d) / 3
+        ks.append(k)
+        ds.append(d)
+        js.append(3 * k - 2 * d)
+    return ks, ds, js
+
+
+def rsi(close, prev_close, n):
+    out = [0.0]
+    up = total = 0.0
+    for i in range(1, len(close)):
+        lc = prev_close[i] if prev_close[i] is not None else close[i - 1]
+        change = close[i] - lc
+        up = (max(change, 0) + (n - 1) * up) / n
+        total = (abs(change) + (n - 1) * total) / n
+        out.append(0.0 if total == 0 else up / total * 100)
+    return out
+
+
+def boll(close, n, p):
+    mid = ma(close, n)
+    vart1 = [None if m is None else (c - m) ** 2 for c, m in zip(close, mid)]
+    vart2 = ma(vart1, n)
+    upper = [None if v is None else m + p * math.sqrt(v) for m, v in zip(mid, vart2)]
+    lower = [None if v is None else m - p * math.sqrt(v) for m, v in zip(mid, vart2)]
+    return mid, upper, lower
+
+
+def fmt(v):
+    return '' if v is None else repr(v)
+
+
+def write_series(directory, rows):
+    os.makedirs(directory, exist_ok=True)
+    with open(os.path.join(directory, 'series.csv'), 'w') as f:
+        # time 为毫秒时间戳，放最后一列，kline_bench 按前 6 列读取
+        f.write('open,high,low,close,volume,prev_close' + (',time' if len(rows[0]) > 6 else '') + '\n')
+        for r in rows:
+            f.write(','.join(fmt(v) for v in r) + '\n')
+
+
+def write_expected(directory, rows):
+    high = [r[1] for r in rows]
+    low = [r[2] for r in rows]
+    close = [r[3] for r in rows]
+    volume = [r[4] for r in rows]
+    prev_close = [r[5] for r in rows]
+
+    columns = [
+        ('ma5', ma(close, 5)),
+        ('ma10', ma(close, 10)),
+        ('ma20', ma(close, 20)),
+        ('ma30', ma(close, 30)),
+        ('vol_ma7', ma(volume, 7)),
+        ('vol_ma30', ma(volume, 30)),
+        ('ema7', ema(close, 7)),
+        ('ema12', ema(close, 12)),
+        ('ema26', ema(close, 26)),
+        ('ema30', ema(close, 30)),
+    ]
+    columns += list(zip(('dif', 'dea', 'bar'), macd(close)))
+    columns += list(zip(('k', 'd', 'j'), kdj(high, low, close)))
+    columns += [('rsi6', rsi(close, prev_close, 6)),
+                ('rsi12', rsi(close, prev_close, 12)),
+                ('rsi24', rsi(close, prev_close, 24))]
+    columns += list(zip(('boll_mid', 'boll_upper', 'boll_lower'), boll(close, 20, 2)))
+
+    with open(os.path.join(directory, 'expected.csv'), 'w') as f:
+        f.write(','.join(name for name, _ in columns) + '\n')
+        for i in range(len(rows)):
+            f.write(','.join(fmt(values[i]) for _, values in columns) + '\n')
+
+
+def main(argv):
+    if len(argv) == 3 and argv[0] == '--json':
+        rows = json_series(argv[1])
+        write_series(argv[2], rows)
+        write_expected(argv[2], rows)
+    elif len(argv) == 1:
+        write_expected(argv[0], read_series(argv[0]))
+    elif not argv:
+        fixtures = os.path.join(HERE, '..', 'fixtures')
+        for directory, rows in ((HERE, series()),
+                                (os.path.join(fixtures, 'daily'), daily_series()),
+                                (os.path.join(fixtures, 'minute1'), minute_series())):
+            write_series(directory, rows)
+            write_expected(directory, rows)
+    else:
+        sys.exit('usage: gen_golden.py [--json kline.json DIR | DIR]')
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
@@ -0,0 +1,229 @@
+//
+//  kline_core_test.cpp
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+//  kline_core 金值测试：
+//  - 指标公式.md 中的 MACD 手算例子
+//  - golden/expected.csv，由 gen_golden.py 按文档公式逐条计算
+//  - fixtures/daily、fixtures/minute1：日线、1 分钟线形态的序列，金值同样由 gen_golden.py 计算
+//
+
+#include "kline_core.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+bool near(double actual, double expected, double tolerance) {
+    if (std::isnan(actual) || std::isnan(expected)) {
+        return std::isnan(actual) && std::isnan(expected);
+    }
+    return std::fabs(actual - expected) <= tolerance * std::fmax(1.0, std::fabs(expected));
+}
+
+#define CHECK_NEAR(actual, expected, tolerance) do { \
+    double a_ = (actual), e_ = (expected); \
+    if (!near(a_, e_, (tolerance))) { \
+        std::fprintf(stderr, "%s:%d: %s = %.10g, expected %.10g\n", __FILE__, __LINE__, #actual, a_, e_); \
+        failures++; \
+    } \
+} while (0)
+
+typedef std::map<std::string, std::vector<double> > Table;
+
+//读取 CSV，空单元格为 NAN
+Table readCSV(const std::string &path) {
+    Table table;
+    std::ifstream in(path.c_str());
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", path.c_str());
+        failures++;
+        return table;
+    }
+    std::string line;
+    std::getline(in, line);
+    std::vector<std::string> names;
+    std::stringstream header(line);
+    std::string name;
+    while (std::getline(header, name, ',')) {
+        names.push_back(name);
+    }
+    while (std::getline(in, line)) {
+        std::stringstream row(line);
+        for (size_t i = 0; i < names.size(); i++) {
+            std::string cell;
+            std::getline(row, cell, ',');
+            table[names[i]].push_back(cell.empty() ? NAN : std::strtod(cell.c_str(), NULL));
+        }
+    }
+    return table;
+}
+
+void checkSeries(const char *name, const std::vector<double> &actual, const std::vector<double> &expected) {
+    CHECK(actual.size() == expected.size());
+    for (size_t i = 0; i < actual.size() && i < expected.size(); i++) {
+        if (!near(actual[i], expected[i], 1e-9)) {
+            std::fprintf(stderr, "%s[%zu] = %.12g, expected %.12g\n", name, i, actual[i], expected[i]);
+            failures++;
+            return;
+        }
+    }
+}
+
+//指标公式.md：对理工检测、法因数控上市首日和第二日
+//文档计算过程保留 4 位小数，这里按 5e-4 比较
+void testMACDDocumentExamples() {
+    struct Example {
+        double close[2];
+        double ema12, ema26, dif, dea, bar;
+    } examples[] = {
+        {{55.01, 53.7}, 54.8085, 54.913, -0.1045, -0.0209, -0.1672},
+        {{12.34, 11.11}, 12.1508, 12.2489, -0.0981, -0.01962, -0.15696},
+    };
+    for (const Example &e : examples) {
+        double ema12[2], ema26[2], dif[2], dea[2], bar[2];
+        CHECK(kline_ema(e.close, 2, 12, ema12) == KLINE_OK);
+        CHECK(kline_ema(e.close, 2, 26, ema26) == KLINE_OK);
+        CHECK(kline_macd(e.close, 2, 12, 26, 9, dif, dea, bar) == KLINE_OK);
+
+        //新股上市首日 DIFF、DEA、MACD 都为 0
+        CHECK_NEAR(dif[0], 0, 0);
+        CHECK_NEAR(dea[0], 0, 0);
+        CHECK_NEAR(bar[0], 0, 0);
+
+        CHECK_NEAR(ema12[1], e.ema12, 5e-4);
+        CHECK_NEAR(ema26[1], e.ema26, 5e-4);
+        CHECK_NEAR(dif[1], e.dif, 5e-4);
+        CHECK_NEAR(dea[1], e.dea, 5e-4);
+        CHECK_NEAR(bar[1], e.bar, 5e-4);
+    }
+}
+
+//KDJ介绍.md：第一天前一日 K、D 为 50，RSV 取 9 日内最高最低
+void testKDJFirstDays() {
+    const double high[] = {10, 11, 12};
+    const double low[] = {8, 9, 10};
+    const double close[] = {9, 10.5, 12};
+    double k[3], d[3], j[3], rsv[3];
+    CHECK(kline_kdj(high, low, close, 3, 9, 3, 3, k, d, j, rsv, NULL, NULL) == KLINE_OK);
+
+    CHECK_NEAR(rsv[0], 50, 1e-12);
+    CHECK_NEAR(k[0], 50, 1e-12);
+    CHECK_NEAR(d[0], 50, 1e-12);
+    CHECK_NEAR(j[0], 50, 1e-12);
+
+    //RSV = (10.5-8)/(11-8)*100，K = (RSV+2*50)/3
+    CHECK_NEAR(rsv[1], 250.0 / 3, 1e-12);
+    CHECK_NEAR(k[1], (250.0 / 3 + 100) / 3, 1e-12);
+    CHECK_NEAR(d[1], (k[1] + 100) / 3, 1e-12);
+    CHECK_NEAR(j[1], 3 * k[1] - 2 * d[1], 1e-12);
+
+    CHECK_NEAR(rsv[2], 100, 1e-12);
+}
+
+void testMissingWarmup() {
+    const double close[] = {1, 2, 3, 4, 5};
+    double out[5];
+    CHECK(kline_ma(close, 5, 3, out) == KLINE_OK);
+    CHECK(kline_is_missing(out[0]));
+    CHECK(kline_is_missing(out[1]));
+    CHECK_NEAR(out[2], 2, 1e-12);
+    CHECK_NEAR(out[4], 4, 1e-12);
+
+    CHECK(kline_ma(close, 5, 0, out) == KLINE_EINVAL);
+    CHECK(kline_ma(NULL, 5, 3, out) == KLINE_EINVAL);
+    CHECK(kline_ma(NULL, 0, 3, NULL) == KLINE_OK);
+}
+
+void testGolden(const std::string &dir) {
+    Table input = readCSV(dir + "/series.csv");
+    Table expected = readCSV(dir + "/expected.csv");
+    const std::vector<double> &high = input["high"];
+    const std::vector<double> &low = input["low"];
+    const std::vector<double> &close = input["close"];
+    const std::vector<double> &volume = input["volume"];
+    const std::vector<double> &prevClose = input["prev_close"];
+    size_t n = close.size();
+    CHECK(n > 0);
+    if (n == 0) {
+        return;
+    }
+
+    std::vector<double> out(n), a(n), b(n), c(n);
+
+    const struct { const char *name; const std::vector<double> *in; size_t period; } mas[] = {
+        {"ma5", &close, 5}, {"ma10", &close, 10}, {"ma20", &close, 20}, {"ma30", &close, 30},
+        {"vol_ma7", &volume, 7}, {"vol_ma30", &volume, 30},
+    };
+    for (const auto &m : mas) {
+        CHECK(kline_ma(m.in->data(), n, m.period, out.data()) == KLINE_OK);
+        checkSeries(m.name, out, expected[m.name]);
+    }
+
+    const struct { const char *name; size_t period; } emas[] = {
+        {"ema7", 7}, {"ema12", 12}, {"ema26", 26}, {"ema30", 30},
+    };
+    for (const auto &m : emas) {
+        CHECK(kline_ema(close.data(), n, m.period, out.data()) == KLINE_OK);
+        checkSeries(m.name, out, expected[m.name]);
+    }
+
+    CHECK(kline_macd(close.data(), n, 12, 26, 9, a.data(), b.data(), c.data()) == KLINE_OK);
+    checkSeries("dif", a, expected["dif"]);
+    checkSeries("dea", b, expected["dea"]);
+    checkSeries("bar", c, expected["bar"]);
+
+    CHECK(kline_kdj(high.data(), low.data(), close.data(), n, 9, 3, 3, a.data(), b.data(), c.data(), NULL, NULL, NULL) == KLINE_OK);
+    checkSeries("k", a, expected["k"]);
+    checkSeries("d", b, expected["d"]);
+    checkSeries("j", c, expected["j"]);
+
+    const struct { const char *name; size_t period; } rsis[] = {
+        {"rsi6", 6}, {"rsi12", 12}, {"rsi24", 24},
+    };
+    for (const auto &m : rsis) {
+        CHECK(kline_rsi(close.data(), prevClose.data(), n, m.period, out.data()) == KLINE_OK);
+        checkSeries(m.name, out, expected[m.name]);
+    }
+
+    CHECK(kline_boll(close.data(), n, 20, 2, a.data(), b.data(), c.data(), NULL) == KLINE_OK);
+    checkSeries("boll_mid", a, expected["boll_mid"]);
+    checkSeries("boll_upper", b, expected["boll_upper"]);
+    checkSeries("boll_lower", c, expected["boll_lower"]);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::string dir = argc > 1 ? argv[1] : "golden";
+
+    testMACDDocumentExamples();
+    testKDJFirstDays();
+    testMissingWarmup();
+    testGolden(dir);
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("kline_core: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,344 @@
+//
+//  kline_indicator_test.cpp
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+//  指标注册表测试：注册的 MACD/KDJ/RSI/BOLL 及主图均线与原有函数结果一致；
+//  分段追加、更新最后一根的增量计算与一次算完的结果一致；参数和输入校验。
+//
+
+#include "kline_core.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+struct Random {
+    uint64_t state;
+    explicit Random(uint64_t seed) : state(seed) {}
+    double next() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (state >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+struct Bars {
+    std::vector<double> high, low, close, volume, prevClose;
+
+    kline_inputs inputs(size_t count) const {
+        kline_inputs in;
+        in.high = high.data();
+        in.low = low.data();
+        in.close = close.data();
+        in.volume = volume.data();
+        in.prev_close = prevClose.data();
+        in.count = count;
+        return in;
+    }
+};
+
+//随机游走，每 50 根一次停牌复牌(昨收与上一根收盘不同)，偶尔一字板
+Bars randomBars(Random &r, size_t n) {
+    Bars bars;
+    double price = 10;
+    for (size_t i = 0; i < n; i++) {
+        double lc = price;
+        if (i % 50 == 49) {
+            lc = price * (0.9 + 0.2 * r.next());
+        }
+        double close = lc * (0.95 + 0.1 * r.next());
+        bool limit = r.next() < 0.02;
+        bars.high.push_back(limit ? close : std::fmax(close, lc) * (1 + 0.02 * r.next()));
+        bars.low.push_back(limit ? close : std::fmin(close, lc) * (1 - 0.02 * r.next()));
+        bars.close.push_back(close);
+        bars.volume.push_back(std::floor(1e6 * r.next()));
+        bars.prevClose.push_back(i % 50 == 49 ? lc : NAN);
+        price = close;
+    }
+    return bars;
+}
+
+struct Columns {
+    std::vector<std::vector<double> > data;
+    std::vector<double *> pointers;
+
+    Columns(size_t columns, size_t count) : data(columns, std::vector<double>(count, -12345.0)) {
+        for (size_t c = 0; c < columns; c++) {
+            pointers.push_back(data[c].data());
+        }
+    }
+};
+
+bool same(double a, double b, double tolerance) {
+    if (kline_is_missing(a) || kline_is_missing(b)) {
+        return kline_is_missing(a) && kline_is_missing(b);
+    }
+    return std::fabs(a - b) <= tolerance * std::fmax(1.0, std::fmax(std::fabs(a), std::fabs(b)));
+}
+
+void checkColumn(const char *what, const double *actual, const double *expected, size_t count, double tolerance) {
+    for (size_t i = 0; i < count; i++) {
+        if (!same(actual[i], expected[i], tolerance)) {
+            std::fprintf(stderr, "%s[%zu] = %.17g, expected %.17g\n", what, i, actual[i], expected[i]);
+            failures++;
+            return;
+        }
+    }
+}
+
+//注册的指标与原有函数逐位一致(BOLL 只差补偿求和的起点)
+void testMatchesLegacy(const Bars &bars) {
+    size_t n = bars.close.size();
+    kline_inputs in = bars.inputs(n);
+
+    {
+        const kline_indicator *macd = kline_indicator_find("MACD");
+        Columns columns(macd->column_count, n);
+        CHECK(kline_indicator_update(macd, &in, 0, NULL, columns.pointers.data()) == KLINE_OK);
+        std::vector<double> dif(n), dea(n), bar(n);
+        kline_macd(bars.close.data(), n, 12, 26, 9, dif.data(), dea.data(), bar.data());
+        checkColumn("MACD.DIF", columns.pointers[0], dif.data(), n, 0);
+        checkColumn("MACD.DEA", columns.pointers[1], dea.data(), n, 0);
+        checkColumn("MACD.MACD", columns.pointers[2], bar.data(), n, 0);
+    }
+    {
+        const kline_indicator *kdj = kline_indicator_find("KDJ");
+        Columns columns(kdj->column_count, n);
+        CHECK(kline_indicator_update(kdj, &in, 0, NULL, columns.pointers.data()) == KLINE_OK);
+        std::vector<double> k(n), d(n), j(n);
+        kline_kdj(bars.high.data(), bars.low.data(), bars.close.data(), n, 9, 3, 3,
+                  k.data(), d.data(), j.data(), NULL, NULL, NULL);
+        checkColumn("KDJ.K", columns.pointers[0], k.data(), n, 0);
+        checkColumn("KDJ.D", columns.pointers[1], d.data(), n, 0);
+        checkColumn("KDJ.J", columns.pointers[2], j.data(), n, 0);
+    }
+    {
+        const kline_indicator *rsi = kline_indicator_find("RSI");
+        Columns columns(rsi->column_count, n);
+        double params[] = {6, 12, 24};
+        CHECK(kline_indicator_update(rsi, &in, 0, params, columns.pointers.data()) == KLINE_OK);
+        for (size_t p = 0; p < 3; p++) {
+            std::vector<double> out(n);
+            kline_rsi(bars.close.data(), bars.prevClose.data(), n, (size_t)params[p], out.data());
+            checkColumn("RSI", columns.pointers[p], out.data(), n, 0);
+        }
+    }
+    {
+        const kline_indicator *boll = kline_indicator_find("BOLL");
+        Columns columns(boll->column_count, n);
+        CHECK(kline_indicator_update(boll, &in, 0, NULL, columns.pointers.data()) == KLINE_OK);
+        std::vector<double> mid(n), upper(n), lower(n);
+        kline_boll(bars.close.data(), n, 20, 2, mid.data(), upper.data(), lower.data(), NULL);
+        checkColumn("BOLL.UPPER", columns.pointers[0], upper.data(), n, 0);
+        checkColumn("BOLL.MID", columns.pointers[1], mid.data(), n, 0);
+        checkColumn("BOLL.LOWER", columns.pointers[2], lower.data(), n, 0);
+    }
+}
+
+//WR、OBV 按定义逐根直接算
+void testNewIndicators(const Bars &bars) {
+    size_t n = bars.close.size();
+    kline_inputs in = bars.inputs(n);
+
+    const kline_indicator *wr = kline_indicator_find("WR");
+    Columns wrColumns(wr->column_count, n);
+    CHECK(kline_indicator_update(wr, &in, 0, NULL, wrColumns.pointers.data()) == KLINE_OK);
+    const size_t wrPeriods[] = {10, 6};
+    for (size_t p = 0; p < 2; p++) {
+        std::vector<double> expected(n);
+        for (size_t i = 0; i < n; i++) {
+            size_t begin = i + 1 >= wrPeriods[p] ? i + 1 - wrPeriods[p] : 0;
+            double hh = bars.high[begin], ll = bars.low[begin];
+            for (size_t k = begin; k <= i; k++) {
+                hh = std::fmax(hh, bars.high[k]);
+                ll = std::fmin(ll, bars.low[k]);
+            }
+            expected[i] = hh == ll ? 0 : (hh - bars.close[i]) * 100 / (hh - ll);
+        }
+        checkColumn("WR", wrColumns.pointers[p], expected.data(), n, 0);
+    }
+
+    const kline_indicator *obv = kline_indicator_find("OBV");
+    Columns obvColumns(obv->column_count, n);
+    CHECK(kline_indicator_update(obv, &in, 0, NULL, obvColumns.pointers.data()) == KLINE_OK);
+    std::vector<double> expected(n), ma(n);
+    double sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        double lc = !std::isnan(bars.prevClose[i]) ? bars.prevClose[i] : (i ? bars.close[i - 1] : bars.close[i]);
+        sum += bars.close[i] > lc ? bars.volume[i] : (bars.close[i] < lc ? -bars.volume[i] : 0);
+        expected[i] = sum;
+    }
+    kline_ma(expected.data(), n, 30, ma.data());
+    checkColumn("OBV.OBV", obvColumns.pointers[0], expected.data(), n, 0);
+    checkColumn("OBV.MAOBV", obvColumns.pointers[1], ma.data(), n, 1e-12);
+}
+
+//主图、成交量图的均线与 kline_ma / kline_ema 一致
+void testMainChart(const Bars &bars) {
+    size_t n = bars.close.size();
+    kline_inputs in = bars.inputs(n);
+    std::vector<double> expected(n);
+
+    const kline_indicator *ma = kline_indicator_find("MA");
+    Columns maColumns(ma->column_count, n);
+    CHECK(kline_indicator_update(ma, &in, 0, NULL, maColumns.pointers.data()) == KLINE_OK);
+    const size_t maPeriods[] = {5, 10, 20, 30};
+    for (size_t p = 0; p < 4; p++) {
+        kline_ma(bars.close.data(), n, maPeriods[p], expected.data());
+        checkColumn("MA", maColumns.pointers[p], expected.data(), n, 0);
+    }
+
+    const kline_indicator *ema = kline_indicator_find("EMA");
+    Columns emaColumns(ema->column_count, n);
+    CHECK(kline_indicator_update(ema, &in, 0, NULL, emaColumns.pointers.data()) == KLINE_OK);
+    kline_ema(bars.close.data(), n, 30, expected.data());
+    checkColumn("EMA30", emaColumns.pointers[1], expected.data(), n, 0);
+
+    const kline_indicator *vma = kline_indicator_find("VMA");
+    Columns vmaColumns(vma->column_count, n);
+    CHECK(kline_indicator_update(vma, &in, 0, NULL, vmaColumns.pointers.data()) == KLINE_OK);
+    kline_ma(bars.volume.data(), n, 7, expected.data());
+    checkColumn("VMA7", vmaColumns.pointers[0], expected.data(), n, 0);
+
+    const kline_indicator *vema = kline_indicator_find("VEMA");
+    Columns vemaColumns(vema->column_count, n);
+    CHECK(kline_indicator_update(vema, &in, 0, NULL, vemaColumns.pointers.data()) == KLINE_OK);
+    kline_ema(bars.volume.data(), n, 7, expected.data());
+    checkColumn("VEMA7", vemaColumns.pointers[0], expected.data(), n, 0);
+
+    //均线只需要各自的输入列
+    kline_inputs closeOnly = in;
+    closeOnly.high = closeOnly.low = closeOnly.volume = NULL;
+    CHECK(kline_indicator_update(ma, &closeOnly, 0, NULL, maColumns.pointers.data()) == KLINE_OK);
+    CHECK(kline_indicator_update(vma, &closeOnly, 0, NULL, vmaColumns.pointers.data()) == KLINE_EINVAL);
+
+    //主图均线排在副图指标之后
+    bool mainChart = false;
+    for (size_t i = 0; i < kline_indicator_count(); i++) {
+        bool flagged = (kline_indicator_at(i)->flags & KLINE_INDICATOR_MAIN_CHART) != 0;
+        CHECK(flagged || !mainChart);
+        mainChart = mainChart || flagged;
+    }
+    CHECK(mainChart);
+}
+
+//分段追加、每根都更新一次未收盘的最后一根，结果与一次算完一致
+void testIncremental(const kline_indicator *indicator, const Bars &bars, Random &r) {
+    size_t n = bars.close.size();
+    kline_inputs full = bars.inputs(n);
+    Columns expected(indicator->column_count, n);
+    CHECK(kline_indicator_update(indicator, &full, 0, NULL, expected.pointers.data()) == KLINE_OK);
+
+    Columns actual(indicator->column_count, n);
+    Bars live = bars;
+    size_t done = 0;
+    while (done < n) {
+        size_t step = 1 + (size_t)(r.next() * 40);
+        size_t count = done + step < n ? done + step : n;
+
+        //最后一根先以一个临时价格算一次，再用最终价格从 count-1 重算
+        live.close[count - 1] = bars.close[count - 1] * 1.01;
+        live.high[count - 1] = std::fmax(bars.high[count - 1], live.close[count - 1]);
+        kline_inputs partial = live.inputs(count);
+        CHECK(kline_indicator_update(indicator, &partial, done, NULL, actual.pointers.data()) == KLINE_OK);
+        live.close[count - 1] = bars.close[count - 1];
+        live.high[count - 1] = bars.high[count - 1];
+        CHECK(kline_indicator_update(indicator, &partial, count - 1, NULL, actual.pointers.data()) == KLINE_OK);
+        done = count;
+    }
+
+    char what[64];
+    for (size_t c = 0; c < indicator->output_count; c++) {
+        std::snprintf(what, sizeof(what), "%s incremental column %zu", indicator->name, c);
+        //窗口类指标从 from 往前补窗口重算，补偿求和的起点不同，只差舍入
+        checkColumn(what, actual.pointers[c], expected.pointers[c], n, 1e-12);
+    }
+}
+
+void testValidation(const Bars &bars) {
+    CHECK(kline_indicator_count() >= 6);
+    CHECK(kline_indicator_find("MACD") == kline_indicator_at(0));
+    CHECK(kline_indicator_find("DMI") == NULL);
+    CHECK(kline_indicator_find(NULL) == NULL);
+    CHECK(kline_indicator_at(kline_indicator_count()) == NULL);
+
+    for (size_t i = 0; i < kline_indicator_count(); i++) {
+        const kline_indicator *indicator = kline_indicator_at(i);
+        CHECK(indicator->output_count <= indicator->column_count);
+        CHECK(indicator->column_count <= KLINE_INDICATOR_MAX_COLUMNS);
+        CHECK(indicator->param_count <= KLINE_INDICATOR_MAX_PARAMS);
+        for (size_t p = 0; p < indicator->param_count; p++) {
+            const kline_param *param = &indicator->params[p];
+            CHECK(param->value >= param->min && param->value <= param->max);
+        }
+    }
+
+    const kline_indicator *macd = kline_indicator_find("MACD");
+    size_t n = bars.close.size();
+    kline_inputs in = bars.inputs(n);
+    Columns columns(macd->column_count, n);
+    double outOfRange[] = {12, 26, 0};
+    double fractional[] = {12, 26.5, 9};
+    CHECK(kline_indicator_update(macd, &in, 0, outOfRange, columns.pointers.data()) == KLINE_EINVAL);
+    CHECK(kline_indicator_update(macd, &in, 0, fractional, columns.pointers.data()) == KLINE_EINVAL);
+    CHECK(kline_indicator_update(macd, &in, n + 1, NULL, columns.pointers.data()) == KLINE_EINVAL);
+    CHECK(kline_indicator_update(macd, &in, n, NULL, columns.pointers.data()) == KLINE_OK);
+
+    //BOLL 宽度可以是小数
+    const kline_indicator *boll = kline_indicator_find("BOLL");
+    Columns bollColumns(boll->column_count, n);
+    double width[] = {20, 2.5};
+    CHECK(kline_indicator_update(boll, &in, 0, width, bollColumns.pointers.data()) == KLINE_OK);
+
+    //缺少所需输入
+    kline_inputs noHigh = in;
+    noHigh.high = NULL;
+    const kline_indicator *kdj = kline_indicator_find("KDJ");
+    Columns kdjColumns(kdj->column_count, n);
+    CHECK(kline_indicator_update(kdj, &noHigh, 0, NULL, kdjColumns.pointers.data()) == KLINE_EINVAL);
+    CHECK(kline_indicator_update(macd, &noHigh, 0, NULL, columns.pointers.data()) == KLINE_OK);
+
+    //昨收可选
+    kline_inputs noPrevClose = in;
+    noPrevClose.prev_close = NULL;
+    const kline_indicator *rsi = kline_indicator_find("RSI");
+    Columns rsiColumns(rsi->column_count, n);
+    CHECK(kline_indicator_update(rsi, &noPrevClose, 0, NULL, rsiColumns.pointers.data()) == KLINE_OK);
+}
+
+} // namespace
+
+int main() {
+    Random r(20161227);
+    Bars bars = randomBars(r, 2000);
+
+    testMatchesLegacy(bars);
+    testNewIndicators(bars);
+    testMainChart(bars);
+    for (size_t i = 0; i < kline_indicator_count(); i++) {
+        testIncremental(kline_indicator_at(i), bars, r);
+    }
+    testValidation(bars);
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("kline_indicator: all checks passed\n");
+    return 0;
+}
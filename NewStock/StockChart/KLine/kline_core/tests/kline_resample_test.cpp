@@ -0,0 +1,273 @@
+//
+//  kline_resample_test.cpp
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+//  周期聚合测试：A 股交易时段的分钟 K，以及周、月、季、年 K。
+//
+
+#include "kline_core.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+#define CHECK_EQ(actual, expected) do { \
+    long long a_ = (long long)(actual), e_ = (long long)(expected); \
+    if (a_ != e_) { \
+        std::fprintf(stderr, "%s:%d: %s = %lld, expected %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+        failures++; \
+    } \
+} while (0)
+
+const int kBeijing = 8 * 60;
+
+//北京时间转毫秒时间戳
+int64_t beijing(int year, int month, int day, int hour, int minute) {
+    //H. Hinnant days_from_civil
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yoe = year - era * 400;
+    int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int64_t days = era * 146097 + doe - 719468;
+    return ((days * 1440) + hour * 60 + minute - kBeijing) * 60000;
+}
+
+kline_bar bar(int64_t time, double open, double high, double low, double close, double volume) {
+    kline_bar b;
+    b.time = time;
+    b.open = open;
+    b.high = high;
+    b.low = low;
+    b.close = close;
+    b.volume = volume;
+    b.average_price = NAN;
+    b.prev_close = NAN;
+    return b;
+}
+
+//一天完整的 1 分钟 K：9:30 集合竞价 + 9:31-11:30 + 13:01-15:00
+std::vector<kline_bar> oneMinuteDay(int year, int month, int day) {
+    std::vector<kline_bar> bars;
+    double price = 10;
+    bars.push_back(bar(beijing(year, month, day, 9, 30), price, price, price, price, 1));
+    for (int m = 9 * 60 + 31; m <= 11 * 60 + 30; m++) {
+        price += 0.01;
+        bars.push_back(bar(beijing(year, month, day, m / 60, m % 60), price, price + 0.05, price - 0.05, price, 1));
+    }
+    for (int m = 13 * 60 + 1; m <= 15 * 60; m++) {
+        price -= 0.01;
+        bars.push_back(bar(beijing(year, month, day, m / 60, m % 60), price, price + 0.05, price - 0.05, price, 1));
+    }
+    //均价为当日累计
+    double sum = 0;
+    for (size_t i = 0; i < bars.size(); i++) {
+        sum += bars[i].close;
+        bars[i].average_price = sum / (i + 1);
+    }
+    return bars;
+}
+
+kline_period minutes(int n) {
+    kline_period p;
+    p.unit = KLINE_PERIOD_MINUTE;
+    p.minutes = n;
+    p.utc_offset_minutes = kBeijing;
+    p.sessions = kline_a_share_sessions;
+    p.session_count = 2;
+    return p;
+}
+
+kline_period calendar(kline_period_unit unit) {
+    kline_period p;
+    p.unit = unit;
+    p.minutes = 0;
+    p.utc_offset_minutes = kBeijing;
+    p.sessions = NULL;
+    p.session_count = 0;
+    return p;
+}
+
+void testMinuteBars() {
+    std::vector<kline_bar> in = oneMinuteDay(2016, 12, 27);
+    CHECK_EQ(in.size(), 241);
+
+    const struct { int minutes; size_t count; int firstHour, firstMinute; int lunchHour, lunchMinute; } cases[] = {
+        {5, 48, 9, 35, 11, 30},
+        {15, 16, 9, 45, 11, 30},
+        {30, 8, 10, 0, 11, 30},
+        {60, 4, 10, 30, 11, 30},
+    };
+    for (const auto &c : cases) {
+        std::vector<kline_bar> out(in.size());
+        kline_period p = minutes(c.minutes);
+        size_t n = kline_resample(in.data(), in.size(), &p, out.data());
+        CHECK_EQ(n, c.count);
+        if (n != c.count) {
+            continue;
+        }
+        CHECK_EQ(out[0].time, beijing(2016, 12, 27, c.firstHour, c.firstMinute));
+        CHECK_EQ(out[n / 2 - 1].time, beijing(2016, 12, 27, c.lunchHour, c.lunchMinute));
+        CHECK_EQ(out[n - 1].time, beijing(2016, 12, 27, 15, 0));
+
+        //成交量守恒，每根都是 c.minutes 根 1 分钟 K，第一根另加集合竞价
+        double volume = 0;
+        for (size_t i = 0; i < n; i++) {
+            volume += out[i].volume;
+        }
+        CHECK_EQ(volume, 241);
+        CHECK_EQ(out[0].volume, c.minutes + 1);
+        CHECK_EQ(out[1].volume, c.minutes);
+
+        //开取第一根，收取最后一根
+        CHECK(out[0].open == in[0].open);
+        CHECK(out[n - 1].close == in.back().close);
+        CHECK(out[n - 1].average_price == in.back().average_price);
+    }
+
+    //60 分钟：10:30、11:30、14:00、15:00
+    std::vector<kline_bar> out(in.size());
+    kline_period p = minutes(60);
+    size_t n = kline_resample(in.data(), in.size(), &p, out.data());
+    CHECK_EQ(n, 4);
+    CHECK_EQ(out[2].time, beijing(2016, 12, 27, 14, 0));
+    double high = 0, low = 1e9;
+    for (size_t i = 1; i <= 60; i++) {
+        high = std::fmax(high, in[i].high);
+        low = std::fmin(low, in[i].low);
+    }
+    low = std::fmin(low, in[0].low);
+    CHECK(out[0].high == high);
+    CHECK(out[0].low == low);
+}
+
+void testSessionEdges() {
+    //13:00 开盘集合竞价并入下午第一根；午休和收盘后的零星数据并入前一时段最后一根
+    kline_bar in[] = {
+        bar(beijing(2016, 12, 27, 11, 30), 1, 1, 1, 1, 1),
+        bar(beijing(2016, 12, 27, 12, 10), 1, 1, 1, 1, 1),
+        bar(beijing(2016, 12, 27, 13, 0), 1, 1, 1, 1, 1),
+        bar(beijing(2016, 12, 27, 13, 1), 1, 1, 1, 1, 1),
+        bar(beijing(2016, 12, 27, 15, 0), 1, 1, 1, 1, 1),
+        bar(beijing(2016, 12, 27, 15, 30), 1, 1, 1, 1, 1),
+    };
+    kline_bar out[6];
+    kline_period p = minutes(5);
+    size_t n = kline_resample(in, 6, &p, out);
+    CHECK_EQ(n, 3);
+    CHECK_EQ(out[0].time, beijing(2016, 12, 27, 11, 30));
+    CHECK_EQ(out[0].volume, 2);
+    CHECK_EQ(out[1].time, beijing(2016, 12, 27, 13, 5));
+    CHECK_EQ(out[1].volume, 2);
+    CHECK_EQ(out[2].time, beijing(2016, 12, 27, 15, 0));
+    CHECK_EQ(out[2].volume, 2);
+}
+
+void testCalendarBars() {
+    //2016-12-26(周一) 至 2017-01-06(周五)，日 K 时间为 15:00
+    std::vector<kline_bar> days;
+    const int dates[][3] = {
+        {2016, 12, 26}, {2016, 12, 27}, {2016, 12, 28}, {2016, 12, 29}, {2016, 12, 30},
+        {2017, 1, 3}, {2017, 1, 4}, {2017, 1, 5}, {2017, 1, 6},
+    };
+    double price = 10;
+    for (const auto &d : dates) {
+        kline_bar b = bar(beijing(d[0], d[1], d[2], 15, 0), price, price + 1, price - 1, price + 0.5, 100);
+        b.prev_close = price - 0.5;
+        days.push_back(b);
+        price += 1;
+    }
+
+    std::vector<kline_bar> out(days.size());
+    kline_period week = calendar(KLINE_PERIOD_WEEK);
+    size_t n = kline_resample(days.data(), days.size(), &week, out.data());
+    CHECK_EQ(n, 2);
+    CHECK_EQ(out[0].time, beijing(2016, 12, 30, 15, 0));
+    CHECK_EQ(out[0].volume, 500);
+    CHECK(out[0].open == 10);
+    CHECK(out[0].close == 14.5);
+    CHECK(out[0].high == 15);
+    CHECK(out[0].low == 9);
+    CHECK(out[0].prev_close == 9.5);
+    CHECK_EQ(out[1].time, beijing(2017, 1, 6, 15, 0));
+    CHECK_EQ(out[1].volume, 400);
+
+    kline_period month = calendar(KLINE_PERIOD_MONTH);
+    CHECK_EQ(kline_resample(days.data(), days.size(), &month, out.data()), 2);
+    kline_period quarter = calendar(KLINE_PERIOD_QUARTER);
+    CHECK_EQ(kline_resample(days.data(), days.size(), &quarter, out.data()), 2);
+    kline_period year = calendar(KLINE_PERIOD_YEAR);
+    CHECK_EQ(kline_resample(days.data(), days.size(), &year, out.data()), 2);
+
+    //一个季度内跨月
+    kline_bar q[] = {
+        bar(beijing(2017, 1, 3, 15, 0), 1, 1, 1, 1, 1),
+        bar(beijing(2017, 2, 3, 15, 0), 1, 1, 1, 1, 1),
+        bar(beijing(2017, 3, 31, 15, 0), 1, 1, 1, 1, 1),
+        bar(beijing(2017, 4, 5, 15, 0), 1, 1, 1, 1, 1),
+    };
+    kline_bar qo[4];
+    CHECK_EQ(kline_resample(q, 4, &quarter, qo), 2);
+    CHECK_EQ(qo[0].volume, 3);
+    CHECK_EQ(kline_resample(q, 4, &month, qo), 4);
+
+    //北京时间 1 月 1 日 0 点之后、UTC 仍在 12 月 31 日，算新年
+    kline_bar tz[] = {
+        bar(beijing(2016, 12, 31, 23, 0), 1, 1, 1, 1, 1),
+        bar(beijing(2017, 1, 1, 1, 0), 1, 1, 1, 1, 1),
+    };
+    kline_bar tzo[2];
+    CHECK_EQ(kline_resample(tz, 2, &year, tzo), 2);
+}
+
+void testInPlace() {
+    std::vector<kline_bar> bars = oneMinuteDay(2016, 12, 27);
+    std::vector<kline_bar> copy(bars.size());
+    kline_period p = minutes(15);
+    size_t expected = kline_resample(bars.data(), bars.size(), &p, copy.data());
+    size_t n = kline_resample(bars.data(), bars.size(), &p, bars.data());
+    CHECK_EQ(n, expected);
+    for (size_t i = 0; i < n && i < expected; i++) {
+        CHECK(bars[i].time == copy[i].time && bars[i].close == copy[i].close && bars[i].volume == copy[i].volume);
+    }
+}
+
+void testInvalid() {
+    kline_bar b = bar(0, 1, 1, 1, 1, 1);
+    kline_period p = minutes(0);
+    CHECK_EQ(kline_resample(&b, 1, &p, &b), 0);
+    CHECK_EQ(kline_resample(&b, 1, NULL, &b), 0);
+    p = minutes(5);
+    CHECK_EQ(kline_resample(NULL, 0, &p, NULL), 0);
+}
+
+} // namespace
+
+int main() {
+    testMinuteBars();
+    testSessionEdges();
+    testCalendarBars();
+    testInPlace();
+    testInvalid();
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("kline_resample: all checks passed\n");
+    return 0;
+}
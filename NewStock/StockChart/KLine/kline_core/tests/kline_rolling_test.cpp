@@ -0,0 +1,162 @@
+//
+//  kline_rolling_test.cpp
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+//  滑动窗口求和的性质测试：随机序列上与逐窗口重新求和的结果比较。
+//  覆盖长序列、大成交量、量级突变(大量级之后跟小量级)等容易累积误差的情况。
+//
+
+#include "kline_core.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+struct Random {
+    uint64_t state;
+    explicit Random(uint64_t seed) : state(seed) {}
+    double next() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (state >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+//参照值：每个窗口重新做一次补偿求和，累加用 long double
+long double windowSum(const std::vector<double> &in, size_t end, size_t period, long double *absSum) {
+    size_t begin = end + 1 >= period ? end + 1 - period : 0;
+    long double sum = 0, c = 0, abs = 0;
+    for (size_t i = begin; i <= end; i++) {
+        long double t = sum + in[i];
+        c += std::fabs(sum) >= std::fabs((long double)in[i]) ? (sum - t) + in[i] : (in[i] - t) + sum;
+        sum = t;
+        abs += std::fabs(in[i]);
+    }
+    *absSum = abs;
+    return sum + c;
+}
+
+//误差不超过窗口内绝对值之和的 tolerance 倍
+void checkSeries(const char *name, const std::vector<double> &in, size_t period, double tolerance) {
+    size_t n = in.size();
+    std::vector<double> rolling(n), ma(n), prefix(n);
+    if (kline_rolling_sum(in.data(), n, period, rolling.data()) != KLINE_OK
+        || kline_ma(in.data(), n, period, ma.data()) != KLINE_OK
+        || kline_prefix_sum(in.data(), n, prefix.data()) != KLINE_OK) {
+        std::fprintf(stderr, "%s: call failed\n", name);
+        failures++;
+        return;
+    }
+
+    double worst = 0;
+    for (size_t i = 0; i < n; i++) {
+        long double abs = 0;
+        long double expected = windowSum(in, i, period, &abs);
+        double error = (double)(std::fabs(rolling[i] - expected) / std::fmax((double)abs, 1e-300));
+        worst = std::fmax(worst, error);
+        if (error > tolerance) {
+            std::fprintf(stderr, "%s period %zu: sum[%zu] = %.17g, expected %.17Lg (relative error %g)\n",
+                         name, period, i, rolling[i], expected, error);
+            failures++;
+            return;
+        }
+        if (i + 1 >= period) {
+            double maError = std::fabs(ma[i] - (double)(expected / period)) / std::fmax((double)(abs / period), 1e-300);
+            if (maError > tolerance) {
+                std::fprintf(stderr, "%s period %zu: ma[%zu] = %.17g (relative error %g)\n", name, period, i, ma[i], maError);
+                failures++;
+                return;
+            }
+        } else if (!kline_is_missing(ma[i])) {
+            std::fprintf(stderr, "%s period %zu: ma[%zu] should be missing\n", name, period, i);
+            failures++;
+            return;
+        }
+    }
+
+    //前缀和只和全量参照比较最后一根，避免 O(n^2)
+    long double abs = 0;
+    long double total = windowSum(in, n - 1, n, &abs);
+    double prefixError = (double)(std::fabs(prefix[n - 1] - total) / std::fmax((double)abs, 1e-300));
+    if (prefixError > tolerance) {
+        std::fprintf(stderr, "%s: prefix sum relative error %g\n", name, prefixError);
+        failures++;
+    }
+    std::printf("  %-20s period %4zu  worst relative error %.3g\n", name, period, worst);
+}
+
+std::vector<double> prices(Random &r, size_t n) {
+    std::vector<double> v(n);
+    double p = 3000;
+    for (size_t i = 0; i < n; i++) {
+        p *= 1 + (r.next() - 0.5) * 0.04;
+        v[i] = std::round(p * 100) / 100;
+    }
+    return v;
+}
+
+std::vector<double> volumes(Random &r, size_t n) {
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; i++) {
+        v[i] = std::floor(1e8 + r.next() * 5e11);
+    }
+    return v;
+}
+
+//前一半是 1e12 级的量，后一半只有个位数
+std::vector<double> regimeChange(Random &r, size_t n) {
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; i++) {
+        v[i] = i < n / 2 ? 1e12 + r.next() * 1e12 : 1 + r.next() * 9;
+    }
+    return v;
+}
+
+//正负交替、量级随机，和接近 0
+std::vector<double> cancelling(Random &r, size_t n) {
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; i++) {
+        double magnitude = std::pow(10.0, r.next() * 16 - 4);
+        v[i] = (i % 2 ? -1 : 1) * magnitude;
+    }
+    return v;
+}
+
+} // namespace
+
+int main() {
+    Random r(20161227);
+    const size_t periods[] = {1, 5, 20, 30, 250};
+    //窗口求和后只剩一次舍入，1e-13 远大于双精度机器精度但远小于原 float 前缀和的误差
+    const double tolerance = 1e-13;
+
+    struct Case {
+        const char *name;
+        std::vector<double> series;
+    } cases[] = {
+        {"prices", prices(r, 50000)},
+        {"volumes", volumes(r, 50000)},
+        {"regime change", regimeChange(r, 20000)},
+        {"cancelling", cancelling(r, 20000)},
+    };
+
+    for (const Case &c : cases) {
+        for (size_t period : periods) {
+            checkSeries(c.name, c.series, period, tolerance);
+        }
+    }
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("kline_rolling: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,336 @@
+//
+//  kline_store_test.cpp
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+//  K 线磁盘缓存测试：追加回放、文件头计数、段合并、残缺段恢复、LRU 淘汰。
+//
+
+#include "kline_core.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+#define CHECK_EQ(actual, expected) do { \
+    long long a_ = (long long)(actual), e_ = (long long)(expected); \
+    if (a_ != e_) { \
+        std::fprintf(stderr, "%s:%d: %s = %lld, expected %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+        failures++; \
+    } \
+} while (0)
+
+std::string dir;
+
+std::string pathOf(const char *key) {
+    return dir + "/" + key + ".kls";
+}
+
+//time 从 1 开始的分钟序号，close 用来区分新旧数据
+std::vector<kline_bar> series(int64_t from, int64_t to, double close) {
+    std::vector<kline_bar> bars;
+    for (int64_t t = from; t <= to; t++) {
+        kline_bar b;
+        std::memset(&b, 0, sizeof(b));
+        b.time = t * 60000;
+        b.open = b.high = b.low = b.close = close;
+        b.volume = 1;
+        bars.push_back(b);
+    }
+    return bars;
+}
+
+std::vector<kline_bar> readAll(kline_store *store, const char *key, int *rc) {
+    kline_bar *bars = NULL;
+    size_t count = 0;
+    *rc = kline_store_read(store, key, &bars, &count);
+    std::vector<kline_bar> result(bars, bars + count);
+    std::free(bars);
+    return result;
+}
+
+void setMtime(const char *key, time_t t) {
+    struct utimbuf times = {t, t};
+    utime(pathOf(key).c_str(), &times);
+}
+
+bool exists(const char *key) {
+    struct stat st;
+    return stat(pathOf(key).c_str(), &st) == 0;
+}
+
+void testAppendReplay() {
+    kline_store *store = kline_store_open(dir.c_str(), 0);
+    const char *key = "3_600000_1_10";
+    int rc;
+
+    readAll(store, key, &rc);
+    CHECK_EQ(rc, KLINE_ENOENT);
+
+    std::vector<kline_bar> a = series(1, 100, 1);
+    CHECK_EQ(kline_store_append(store, key, a.data(), a.size()), KLINE_OK);
+
+    //最后一根未收盘，新数据从第 100 根开始
+    std::vector<kline_bar> b = series(100, 120, 2);
+    CHECK_EQ(kline_store_append(store, key, b.data(), b.size()), KLINE_OK);
+
+    kline_store_info info;
+    CHECK_EQ(kline_store_stat(store, key, &info), KLINE_OK);
+    CHECK_EQ(info.count, 120);
+    CHECK_EQ(info.segments, 2);
+    CHECK_EQ(info.first_time, 60000);
+    CHECK_EQ(info.last_time, 120 * 60000);
+
+    std::vector<kline_bar> all = readAll(store, key, &rc);
+    CHECK_EQ(rc, KLINE_OK);
+    CHECK_EQ(all.size(), 120);
+    if (all.size() == 120) {
+        CHECK(all[98].close == 1);
+        CHECK(all[99].close == 2);
+        CHECK(all[119].close == 2);
+        for (size_t i = 1; i < all.size(); i++) {
+            CHECK(all[i].time > all[i - 1].time);
+        }
+    }
+
+    //整体替换
+    std::vector<kline_bar> c = series(50, 60, 3);
+    CHECK_EQ(kline_store_write(store, key, c.data(), c.size()), KLINE_OK);
+    CHECK_EQ(kline_store_stat(store, key, &info), KLINE_OK);
+    CHECK_EQ(info.count, 11);
+    CHECK_EQ(info.segments, 1);
+
+    CHECK_EQ(kline_store_remove(store, key), KLINE_OK);
+    CHECK(!exists(key));
+    kline_store_close(store);
+}
+
+void testCompaction() {
+    kline_store *store = kline_store_open(dir.c_str(), 0);
+    const char *key = "compact";
+    for (int i = 0; i < KLINE_STORE_MAX_SEGMENTS * 2 + 1; i++) {
+        std::vector<kline_bar> bars = series(i * 10 + 1, i * 10 + 10, i);
+        CHECK_EQ(kline_store_append(store, key, bars.data(), bars.size()), KLINE_OK);
+    }
+    kline_store_info info;
+    CHECK_EQ(kline_store_stat(store, key, &info), KLINE_OK);
+    CHECK(info.segments <= KLINE_STORE_MAX_SEGMENTS);
+    CHECK_EQ(info.count, (KLINE_STORE_MAX_SEGMENTS * 2 + 1) * 10);
+
+    int rc;
+    std::vector<kline_bar> all = readAll(store, key, &rc);
+    for (size_t i = 0; i < all.size(); i++) {
+        CHECK_EQ(all[i].time, (int64_t)(i + 1) * 60000);
+        CHECK(all[i].close == (double)(i / 10));
+    }
+    kline_store_remove(store, key);
+    kline_store_close(store);
+}
+
+void testTornSegment() {
+    kline_store *store = kline_store_open(dir.c_str(), 0);
+    const char *key = "torn";
+    std::vector<kline_bar> a = series(1, 10, 1);
+    std::vector<kline_bar> b = series(11, 20, 2);
+    kline_store_append(store, key, a.data(), a.size());
+    kline_store_append(store, key, b.data(), b.size());
+
+    //第二段只写了一半
+    struct stat st;
+    stat(pathOf(key).c_str(), &st);
+    CHECK_EQ(truncate(pathOf(key).c_str(), st.st_size - 5 * (off_t)sizeof(kline_bar)), 0);
+
+    int rc;
+    std::vector<kline_bar> all = readAll(store, key, &rc);
+    CHECK_EQ(rc, KLINE_OK);
+    CHECK_EQ(all.size(), 10);
+
+    //残缺部分截掉后继续追加
+    std::vector<kline_bar> c = series(11, 15, 3);
+    CHECK_EQ(kline_store_append(store, key, c.data(), c.size()), KLINE_OK);
+    all = readAll(store, key, &rc);
+    CHECK_EQ(all.size(), 15);
+    if (all.size() == 15) {
+        CHECK(all[14].close == 3);
+    }
+
+    //校验和不对的段丢弃
+    stat(pathOf(key).c_str(), &st);
+    FILE *fp = std::fopen(pathOf(key).c_str(), "r+b");
+    std::fseek(fp, (long)st.st_size - 8, SEEK_SET);
+    std::fputc(0x7f, fp);
+    std::fclose(fp);
+    all = readAll(store, key, &rc);
+    CHECK_EQ(all.size(), 10);
+
+    //不是缓存文件当作没有
+    fp = std::fopen(pathOf(key).c_str(), "wb");
+    std::fputs("not a kline store", fp);
+    std::fclose(fp);
+    readAll(store, key, &rc);
+    CHECK_EQ(rc, KLINE_ENOENT);
+    CHECK_EQ(kline_store_append(store, key, a.data(), a.size()), KLINE_OK);
+    all = readAll(store, key, &rc);
+    CHECK_EQ(all.size(), 10);
+
+    kline_store_remove(store, key);
+    kline_store_close(store);
+}
+
+long long sizeOf(const char *key) {
+    struct stat st;
+    return stat(pathOf(key).c_str(), &st) == 0 ? (long long)st.st_size : -1;
+}
+
+void testHeaderStat() {
+    kline_store *store = kline_store_open(dir.c_str(), 0);
+    const char *key = "header";
+    std::vector<kline_bar> a = series(1, 10, 1);
+    std::vector<kline_bar> b = series(10, 15, 2);
+    kline_store_append(store, key, a.data(), a.size());
+    kline_store_append(store, key, b.data(), b.size());
+
+    //文件头记录的是回放后的结果，重叠的一根不重复计数
+    kline_store_info info;
+    CHECK_EQ(kline_store_stat(store, key, &info), KLINE_OK);
+    CHECK_EQ(info.count, 15);
+    CHECK_EQ(info.segments, 2);
+    CHECK_EQ(info.last_time, 15 * 60000);
+
+    //文件末尾多出半段，文件头过期，退回回放
+    long long size = sizeOf(key);
+    FILE *fp = std::fopen(pathOf(key).c_str(), "ab");
+    std::vector<kline_bar> c = series(16, 20, 3);
+    std::fwrite(c.data(), sizeof(kline_bar), 2, fp);
+    std::fclose(fp);
+    CHECK(sizeOf(key) > size);
+    CHECK_EQ(kline_store_stat(store, key, &info), KLINE_OK);
+    CHECK_EQ(info.count, 15);
+
+    //追加时截掉残缺部分，文件头重新一致
+    CHECK_EQ(kline_store_append(store, key, c.data(), c.size()), KLINE_OK);
+    CHECK_EQ(kline_store_stat(store, key, &info), KLINE_OK);
+    CHECK_EQ(info.count, 20);
+    CHECK_EQ(info.segments, 3);
+    CHECK_EQ(info.first_time, 60000);
+    CHECK_EQ(info.last_time, 20 * 60000);
+
+    kline_store_remove(store, key);
+    kline_store_close(store);
+}
+
+void testLRU() {
+    std::vector<kline_bar> bars = series(1, 100, 1);
+    kline_store *probe = kline_store_open(dir.c_str(), 0);
+    kline_store_write(probe, "lru_probe", bars.data(), bars.size());
+    long long fileSize = sizeOf("lru_probe");
+    kline_store_remove(probe, "lru_probe");
+    kline_store_close(probe);
+    kline_store *store = kline_store_open(dir.c_str(), (size_t)fileSize * 3);
+
+    const char *keys[] = {"lru_a", "lru_b", "lru_c"};
+    for (int i = 0; i < 3; i++) {
+        CHECK_EQ(kline_store_write(store, keys[i], bars.data(), bars.size()), KLINE_OK);
+        setMtime(keys[i], 1000000 + i * 10);
+    }
+
+    //读过的 a 变成最近使用
+    int rc;
+    readAll(store, "lru_a", &rc);
+    CHECK_EQ(rc, KLINE_OK);
+
+    CHECK_EQ(kline_store_write(store, "lru_d", bars.data(), bars.size()), KLINE_OK);
+    CHECK(exists("lru_a"));
+    CHECK(!exists("lru_b"));
+    CHECK(exists("lru_c"));
+    CHECK(exists("lru_d"));
+
+    for (const char *key : {"lru_a", "lru_b", "lru_c", "lru_d"}) {
+        kline_store_remove(store, key);
+    }
+    kline_store_close(store);
+}
+
+void testTrimKeepsWrittenKey() {
+    //刚写入的文件不看 mtime，总是保留(mtime 只精确到秒，同一秒写入的分不出先后)
+    std::vector<kline_bar> bars = series(1, 100, 1);
+    kline_store *store = kline_store_open(dir.c_str(), 0);
+    kline_store_write(store, "keep_b", bars.data(), bars.size());
+    long long fileSize = sizeOf("keep_b");
+    kline_store_close(store);
+    setMtime("keep_b", time(NULL) + 3600);
+
+    store = kline_store_open(dir.c_str(), (size_t)fileSize);
+    CHECK_EQ(kline_store_write(store, "keep_a", bars.data(), bars.size()), KLINE_OK);
+    CHECK(exists("keep_a"));
+    CHECK(!exists("keep_b"));
+
+    //只剩刚追加的文件时超出上限也保留
+    CHECK_EQ(kline_store_append(store, "keep_a", bars.data(), 1), KLINE_OK);
+    CHECK(exists("keep_a"));
+
+    kline_store_remove(store, "keep_a");
+    kline_store_close(store);
+}
+
+void testInvalid() {
+    kline_store *store = kline_store_open(dir.c_str(), 0);
+    kline_bar *bars = NULL;
+    size_t count = 0;
+    std::vector<kline_bar> a = series(1, 2, 1);
+    CHECK_EQ(kline_store_read(store, "../x", &bars, &count), KLINE_EINVAL);
+    CHECK_EQ(kline_store_read(store, "", &bars, &count), KLINE_EINVAL);
+    CHECK_EQ(kline_store_append(store, "a/b", a.data(), a.size()), KLINE_EINVAL);
+    CHECK_EQ(kline_store_append(store, "..", a.data(), a.size()), KLINE_EINVAL);
+    CHECK_EQ(kline_store_append(NULL, "a", a.data(), a.size()), KLINE_EINVAL);
+    CHECK_EQ(kline_store_append(store, "a", NULL, 1), KLINE_EINVAL);
+    CHECK(kline_store_open(NULL, 0) == NULL);
+    kline_store_close(store);
+}
+
+} // namespace
+
+int main() {
+    char tmpl[] = "/tmp/kline_store_XXXXXX";
+    if (!mkdtemp(tmpl)) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+    dir = tmpl;
+
+    testAppendReplay();
+    testCompaction();
+    testHeaderStat();
+    testTornSegment();
+    testLRU();
+    testTrimKeepsWrittenKey();
+    testInvalid();
+
+    rmdir(dir.c_str());
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("kline_store: all checks passed\n");
+    return 0;
+}
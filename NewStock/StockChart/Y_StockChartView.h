@@ -8,6 +8,7 @@
 
 #import <UIKit/UIKit.h>
 #import "Y_StockChartConstant.h"
+#import "Y_StockChartConfig.h"
 
 //种类
 typedef NS_ENUM(NSInteger, Y_KLineType) {
@@ -71,8 +72,14 @@ typedef NS_ENUM(NSInteger, Y_KLineType) {
  */
 @property (nonatomic, assign) Y_StockType currentStockType;
 
+/**
+ *  图表配置，默认 [Y_StockChartConfig defaultConfig]；缩放只影响本图表
+ */
+@property (nonatomic, strong) Y_StockChartConfig *config;
+
 - (void)reloadData;
 - (void)showKLineAccessoryView:(BOOL)b;
+//index 从 1 开始，对应 [Y_KLineIndicator registeredIndicators] 中的指标
 - (void)setAccessoryViewIndex:(NSInteger) index;
 
 @end
@@ -9,11 +9,11 @@
 #import "Y_StockChartView.h"
 #import "TimeLineView.h"
 #import "Y_KLineView.h"
+#import "Y_KLineIndicator.h"
 
 #import "Masonry.h"
 #import "Y_StockChartSegmentView.h"
 #import "HMSegmentedControl.h"
-#import "Y_StockChartGlobalVariable.h"
 #import <QuartzCore/QuartzCore.h>
 #import "UIColor+Y_StockChart.h"
 #import "MarketConfig.h"
@@ -55,6 +55,7 @@
 - (TimeLineView *)timeLineView {
     if(!_timeLineView) {
         _timeLineView = [TimeLineView new];
+        _timeLineView.config = self.config;
         _timeLineView.layer.borderWidth = 0.5;
         _timeLineView.layer.borderColor = SEP_BG_COLOR.CGColor;//[[UIColor boarderColor] CGColor];
         
@@ -65,8 +66,8 @@
                 //make.bottom.right.left.equalTo(self);
                 make.bottom.left.equalTo(self);
                 make.top.equalTo(self.segmentView.mas_bottom);
-                //make.width.mas_equalTo(self.segmentView.mas_width).multipliedBy(1-[Y_StockChartGlobalVariable fifthPosViewRadio]);
-                make.width.mas_equalTo(MAIN_SCREEN_WIDTH - [Y_StockChartGlobalVariable fifthPosViewWidth]);
+                //make.width.mas_equalTo(self.segmentView.mas_width).multipliedBy(1-self.config.fifthPosViewRatio);
+                make.width.mas_equalTo(MAIN_SCREEN_WIDTH - self.config.fifthPosViewWidth);
             }];
         } else {
             [_timeLineView mas_remakeConstraints:^(MASConstraintMaker *make) {
@@ -83,6 +84,7 @@
 - (Y_KLineView *)kLineView {
     if(!_kLineView) {
         _kLineView = [Y_KLineView new];
+        _kLineView.config = self.config;
         _kLineView.layer.borderWidth = 0.5;
         _kLineView.layer.borderColor = SEP_BG_COLOR.CGColor;//[[UIColor boarderColor] CGColor];
         [self addSubview:_kLineView];
@@ -147,24 +149,28 @@
     }
 }
 
+- (Y_StockChartConfig *)config {
+    if(!_config) {
+        _config = [Y_StockChartConfig defaultConfig];
+    }
+    return _config;
+}
+
+- (void)setConfig:(Y_StockChartConfig *)config {
+    _config = config;
+    _timeLineView.config = config;
+    _kLineView.config = config;
+}
+
 - (void)setCurrentStockType:(Y_StockType)currentStockType {
     _currentStockType = currentStockType;
     _timeLineView.currentStockType = currentStockType;
 }
 
 - (void)setAccessoryViewIndex:(NSInteger) index {
-    if (index == 1) {
-        NSLog(@"MACD");
-        _kLineView.targetLineStatus = Y_StockChartTargetLineStatusMACD;
-    } else if (index == 2) {
-        NSLog(@"KDJ");
-        _kLineView.targetLineStatus = Y_StockChartTargetLineStatusKDJ;
-    } else if (index == 3) {
-        NSLog(@"RSI");
-        _kLineView.targetLineStatus = Y_StockChartTargetLineStatusRSI;
-    } else if (index == 4) {
-        NSLog(@"BOLL");
-        _kLineView.targetLineStatus = Y_StockChartTargetLineStatusBOLL;
+    NSArray<Y_KLineIndicator *> *indicators = [Y_KLineIndicator registeredIndicators];
+    if (index >= 1 && index <= (NSInteger)indicators.count) {
+        _kLineView.accessoryIndicator = indicators[index - 1];
     }
     
 }
@@ -201,8 +207,8 @@
                 [_timeLineView mas_remakeConstraints:^(MASConstraintMaker *make) {
                     make.bottom.left.equalTo(self);
                     make.top.equalTo(self.segmentView.mas_bottom);
-                    //make.width.mas_equalTo(self.segmentView.mas_width).multipliedBy(1-[Y_StockChartGlobalVariable fifthPosViewRadio]);
-                    make.width.mas_equalTo(MAIN_SCREEN_WIDTH - [Y_StockChartGlobalVariable fifthPosViewWidth]);
+                    //make.width.mas_equalTo(self.segmentView.mas_width).multipliedBy(1-self.config.fifthPosViewRatio);
+                    make.width.mas_equalTo(MAIN_SCREEN_WIDTH - self.config.fifthPosViewWidth);
 
                 }];
                 [_timeLineView layoutIfNeeded];//
@@ -7,6 +7,7 @@
 //
 
 #import "EmotionButton.h"
+#import "EmotionManager.h"
 
 @implementation EmotionButton
 
@@ -15,10 +16,7 @@
     
     _model = model;
     
-    NSString *bundleStr = [[NSBundle mainBundle] pathForResource:@"Emoticons.bundle" ofType:nil];
-    NSBundle *bundle = [[NSBundle alloc] initWithPath:bundleStr];
-    NSString *imgPath = [NSString stringWithFormat:@"default/%@",model.png];
-    UIImage *image = [UIImage imageNamed:imgPath inBundle:bundle compatibleWithTraitCollection:nil];
+    UIImage *image = [[EmotionManager sharedEmotionManager] imageForEmotion:model];
     [self setImage:image forState:UIControlStateNormal];
     
     _attach = [[EmotionAttachment alloc] init];
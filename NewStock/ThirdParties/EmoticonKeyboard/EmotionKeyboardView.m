@@ -7,7 +7,7 @@
 //
 
 #import "EmotionKeyboardView.h"
-#import "EmotionModel.h"
+#import "EmotionManager.h"
 #import "EmotionCell.h"
 #import <Masonry.h>
 
@@ -33,6 +33,8 @@ static NSString *cellID = @"emotionCell";
 }
 
 - (void)setupUI {
+    //键盘弹出前先在后台把表情图片解码好
+    [[EmotionManager sharedEmotionManager] preloadImages];
     [self addSubview:self.collectionView];
     self.collectionView.frame = CGRectMake(0, 0, [UIScreen mainScreen].bounds.size.width, 190);
     
@@ -93,24 +95,11 @@ static NSString *cellID = @"emotionCell";
 
 - (NSArray *)emojiDataArray {
     if (_emojiDataArray == nil) {
-        NSString *path = [[NSBundle mainBundle] pathForResource:@"Emoticons.bundle" ofType:nil];
-        NSBundle *bundle = [[NSBundle alloc] initWithPath:path];
-        _emojiDataArray = [NSArray arrayWithContentsOfFile:[bundle pathForResource:@"default/EmoInfo.plist" ofType:nil]];
-        NSMutableArray *nmArr = [NSMutableArray array];
-        for (NSDictionary *dic in _emojiDataArray) {
-            EmotionModel *model = [EmotionModel new];
-            [model setValuesForKeysWithDictionary:dic];
-            [nmArr addObject:model];
-        }
-        _emojiDataArray = nmArr.copy;
+        NSArray *emotions = [EmotionManager sharedEmotionManager].emotions;
         NSMutableArray *nmSubArr = [NSMutableArray array];
-        for (int i = 0; i < 4; i ++) {
-            NSInteger loc = 27 * i;
-            NSInteger len = 27;
-            if (loc + len > 105) {
-                len = 105 - loc;
-            }
-            [nmSubArr addObject:[_emojiDataArray subarrayWithRange:NSMakeRange(loc, len)]];
+        for (NSInteger loc = 0; loc < emotions.count; loc += 27) {
+            NSInteger len = MIN(27, emotions.count - loc);
+            [nmSubArr addObject:[emotions subarrayWithRange:NSMakeRange(loc, len)]];
         }
         _emojiDataArray = nmSubArr.copy;
     }
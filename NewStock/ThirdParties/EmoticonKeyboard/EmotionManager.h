@@ -0,0 +1,49 @@
+//
+//  EmotionManager.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import "ARCSingletonTemplate.h"
+#import "EmotionModel.h"
+
+/**
+ *  表情表
+ *
+ *  Emoticons.bundle 只打开一次，[xxx] 按字典查找，图片第一次取用时解码并缓存，
+ *  帖子列表、表情键盘、发帖页共用。可在任意线程调用。
+ */
+@interface EmotionManager : NSObject
+
+SYNTHESIZE_SINGLETON_FOR_HEADER(EmotionManager)
+
+/**
+ *  全部表情，按键盘顺序
+ */
+@property (nonatomic, copy, readonly) NSArray<EmotionModel *> *emotions;
+
+/**
+ *  匹配 [xxx] 的正则，已编译好
+ */
+@property (nonatomic, strong, readonly) NSRegularExpression *regex;
+
+//不是表情返回 nil
+- (EmotionModel *)emotionForChs:(NSString *)chs;
+- (UIImage *)imageForChs:(NSString *)chs;
+
+//已解码的图片，同一个表情总是返回同一个 UIImage
+- (UIImage *)imageForEmotion:(EmotionModel *)emotion;
+
+//按顺序回调文字片段和表情，image 为 nil 时 segment 是文字；不认识的 [xxx] 当文字
+- (void)enumerateString:(NSString *)text usingBlock:(void (^)(NSString *segment, UIImage *image))block;
+
+//输入框内容转为发帖文字，表情附件换回 [xxx]
+- (NSString *)plainStringFromAttributedString:(NSAttributedString *)text;
+
+//在后台解码全部表情图片
+- (void)preloadImages;
+
+@end
@@ -0,0 +1,157 @@
+//
+//  EmotionManager.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "EmotionManager.h"
+#import "EmotionAttachment.h"
+
+//画到位图里，避免第一次显示时在主线程解码 PNG
+static UIImage *EmotionDecodedImage(UIImage *image) {
+    CGImageRef imageRef = image.CGImage;
+    if (imageRef == NULL) {
+        return image;
+    }
+    size_t width = CGImageGetWidth(imageRef);
+    size_t height = CGImageGetHeight(imageRef);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, 0, colorSpace, kCGBitmapByteOrder32Host | kCGImageAlphaPremultipliedFirst);
+    CGColorSpaceRelease(colorSpace);
+    if (context == NULL) {
+        return image;
+    }
+    CGContextDrawImage(context, CGRectMake(0, 0, width, height), imageRef);
+    CGImageRef decodedRef = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+    if (decodedRef == NULL) {
+        return image;
+    }
+    UIImage *decoded = [UIImage imageWithCGImage:decodedRef scale:image.scale orientation:image.imageOrientation];
+    CGImageRelease(decodedRef);
+    return decoded;
+}
+
+@interface EmotionManager ()
+
+@property (nonatomic, copy, readwrite) NSArray<EmotionModel *> *emotions;
+@property (nonatomic, strong, readwrite) NSRegularExpression *regex;
+
+@end
+
+@implementation EmotionManager
+{
+    NSBundle *_bundle;
+    NSDictionary<NSString *, EmotionModel *> *_emotionIndex;
+    //png -> 解码后的图片
+    NSMutableDictionary<NSString *, UIImage *> *_images;
+}
+SYNTHESIZE_SINGLETON_FOR_CLASS(EmotionManager)
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _bundle = [NSBundle bundleWithPath:[[NSBundle mainBundle] pathForResource:@"Emoticons.bundle" ofType:nil]];
+        _regex = [NSRegularExpression regularExpressionWithPattern:@"\\[.*?\\]" options:0 error:nil];
+        _images = [NSMutableDictionary dictionary];
+
+        NSArray *plist = [NSArray arrayWithContentsOfFile:[_bundle pathForResource:@"default/EmoInfo.plist" ofType:nil]];
+        NSMutableArray *emotions = [NSMutableArray arrayWithCapacity:plist.count];
+        NSMutableDictionary *index = [NSMutableDictionary dictionaryWithCapacity:plist.count];
+        for (NSDictionary *dic in plist) {
+            EmotionModel *model = [EmotionModel new];
+            [model setValuesForKeysWithDictionary:dic];
+            [emotions addObject:model];
+            //重复的 chs 取第一个，与原来线性查找一致
+            if (model.chs.length && index[model.chs] == nil) {
+                index[model.chs] = model;
+            }
+        }
+        _emotions = [emotions copy];
+        _emotionIndex = [index copy];
+    }
+    return self;
+}
+
+- (EmotionModel *)emotionForChs:(NSString *)chs {
+    return chs ? _emotionIndex[chs] : nil;
+}
+
+- (UIImage *)imageForChs:(NSString *)chs {
+    return [self imageForEmotion:[self emotionForChs:chs]];
+}
+
+- (UIImage *)imageForEmotion:(EmotionModel *)emotion {
+    NSString *png = emotion.png;
+    if (png.length == 0) {
+        return nil;
+    }
+    @synchronized (_images) {
+        UIImage *image = _images[png];
+        if (image) {
+            return image;
+        }
+    }
+    UIImage *image = [UIImage imageNamed:[NSString stringWithFormat:@"default/%@", png] inBundle:_bundle compatibleWithTraitCollection:nil];
+    if (image == nil) {
+        return nil;
+    }
+    image = EmotionDecodedImage(image);
+    @synchronized (_images) {
+        //并发解码同一张时保留先放进去的
+        UIImage *existing = _images[png];
+        if (existing) {
+            return existing;
+        }
+        _images[png] = image;
+    }
+    return image;
+}
+
+- (void)enumerateString:(NSString *)text usingBlock:(void (^)(NSString *, UIImage *))block {
+    if (text.length == 0 || block == nil) {
+        return;
+    }
+    __block NSUInteger index = 0;
+    [self.regex enumerateMatchesInString:text options:0 range:NSMakeRange(0, text.length) usingBlock:^(NSTextCheckingResult * _Nullable result, NSMatchingFlags flags, BOOL * _Nonnull stop) {
+        UIImage *image = [self imageForChs:[text substringWithRange:result.range]];
+        if (image == nil) {
+            return;
+        }
+        if (result.range.location > index) {
+            block([text substringWithRange:NSMakeRange(index, result.range.location - index)], nil);
+        }
+        block([text substringWithRange:result.range], image);
+        index = NSMaxRange(result.range);
+    }];
+    if (index < text.length) {
+        block([text substringFromIndex:index], nil);
+    }
+}
+
+- (NSString *)plainStringFromAttributedString:(NSAttributedString *)text {
+    NSMutableString *plain = [NSMutableString stringWithCapacity:text.length];
+    [text enumerateAttribute:NSAttachmentAttributeName inRange:NSMakeRange(0, text.length) options:0 usingBlock:^(id  _Nullable value, NSRange range, BOOL * _Nonnull stop) {
+        if ([value isKindOfClass:[EmotionAttachment class]]) {
+            [plain appendString:((EmotionAttachment *)value).chs ?: @""];
+        } else {
+            [plain appendString:[text.string substringWithRange:range]];
+        }
+    }];
+    return plain;
+}
+
+- (void)preloadImages {
+    NSArray *emotions = self.emotions;
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+        for (EmotionModel *emotion in emotions) {
+            @autoreleasepool {
+                [self imageForEmotion:emotion];
+            }
+        }
+    });
+}
+
+@end
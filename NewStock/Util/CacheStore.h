@@ -0,0 +1,37 @@
+//
+//  CacheStore.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ARCSingletonTemplate.h"
+
+/**
+ *  轻量键值缓存(SystemUtil getCache/putCache 的存储)
+ *
+ *  读写都在内存中完成，修改合并后异步写入 plist，进入后台时立即落盘。
+ *  本地没有的 key 会从 NSUserDefaults 导入一次，兼容旧版本数据。
+ *  数值类 getter 会缓存解析结果。
+ */
+@interface CacheStore : NSObject
+
+SYNTHESIZE_SINGLETON_FOR_HEADER(CacheStore)
+
+//不存在时返回 @""
+- (NSString *)stringForKey:(NSString *)key;
+- (float)floatForKey:(NSString *)key;
+- (long long)longLongForKey:(NSString *)key;
+- (BOOL)boolForKey:(NSString *)key;
+
+- (void)setString:(NSString *)value forKey:(NSString *)key;
+- (void)setFloat:(float)value forKey:(NSString *)key;
+- (void)setLongLong:(long long)value forKey:(NSString *)key;
+- (void)removeObjectForKey:(NSString *)key;
+
+//立即写入未落盘的修改
+- (void)synchronize;
+
+@end
@@ -0,0 +1,157 @@
+//
+//  CacheStore.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "CacheStore.h"
+#import <UIKit/UIKit.h>
+
+//合并写入的延迟
+static const NSTimeInterval kCacheStoreFlushDelay = 0.5;
+
+@interface CacheStore ()
+{
+    NSMutableDictionary<NSString *, NSString *> *_values;
+    NSMutableDictionary<NSString *, NSNumber *> *_numbers;
+    dispatch_queue_t _ioQueue;
+    BOOL _flushScheduled;
+}
+@end
+
+@implementation CacheStore
+SYNTHESIZE_SINGLETON_FOR_CLASS(CacheStore)
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _ioQueue = dispatch_queue_create("com.newstock.cachestore", DISPATCH_QUEUE_SERIAL);
+        _numbers = [NSMutableDictionary dictionary];
+
+        NSDictionary *dict = [NSDictionary dictionaryWithContentsOfFile:[self path]];
+        _values = [NSMutableDictionary dictionaryWithDictionary:dict];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(synchronize) name:UIApplicationDidEnterBackgroundNotification object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(synchronize) name:UIApplicationWillTerminateNotification object:nil];
+    }
+    return self;
+}
+
+- (NSString *)path {
+    NSString *pathOfLibrary = [NSSearchPathForDirectoriesInDomains(NSLibraryDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+    return [pathOfLibrary stringByAppendingPathComponent:@"cacheStore.plist"];
+}
+
+#pragma mark get
+
+- (NSString *)stringForKey:(NSString *)key {
+    if (key == nil) {
+        return @"";
+    }
+    @synchronized (self) {
+        NSString *v = _values[key];
+        if (v == nil) {
+            //旧版本存在 NSUserDefaults 中
+            id old = [[NSUserDefaults standardUserDefaults] objectForKey:key];
+            v = [old isKindOfClass:[NSString class]] ? old : @"";
+            _values[key] = v;
+            if ([v length]) {
+                [self setNeedsFlush];
+            }
+        }
+        return v;
+    }
+}
+
+- (NSNumber *)numberForKey:(NSString *)key {
+    @synchronized (self) {
+        NSNumber *number = _numbers[key];
+        if (number == nil) {
+            NSString *v = [self stringForKey:key];
+            number = [v rangeOfString:@"."].location == NSNotFound ? @([v longLongValue]) : @([v doubleValue]);
+            _numbers[key] = number;
+        }
+        return number;
+    }
+}
+
+- (float)floatForKey:(NSString *)key {
+    return [[self numberForKey:key] floatValue];
+}
+
+- (long long)longLongForKey:(NSString *)key {
+    return [[self numberForKey:key] longLongValue];
+}
+
+- (BOOL)boolForKey:(NSString *)key {
+    return [[self stringForKey:key] boolValue];
+}
+
+#pragma mark set
+
+- (void)setString:(NSString *)value forKey:(NSString *)key {
+    if (key == nil) {
+        return;
+    }
+    @synchronized (self) {
+        NSString *v = value ? [NSString stringWithFormat:@"%@", value] : @"";
+        if ([_values[key] isEqualToString:v]) {
+            return;
+        }
+        _values[key] = v;
+        [_numbers removeObjectForKey:key];
+        [self setNeedsFlush];
+    }
+}
+
+- (void)setFloat:(float)value forKey:(NSString *)key {
+    [self setString:[NSString stringWithFormat:@"%f", value] forKey:key];
+}
+
+- (void)setLongLong:(long long)value forKey:(NSString *)key {
+    [self setString:[NSString stringWithFormat:@"%lld", value] forKey:key];
+}
+
+//置空而不是删除，避免再次从 NSUserDefaults 导入旧值
+- (void)removeObjectForKey:(NSString *)key {
+    [self setString:@"" forKey:key];
+}
+
+- (void)synchronize {
+    dispatch_sync(_ioQueue, ^{
+        [self flush];
+    });
+}
+
+#pragma mark private
+
+//调用方需持有 self 锁
+- (void)setNeedsFlush {
+    if (_flushScheduled) {
+        return;
+    }
+    _flushScheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kCacheStoreFlushDelay * NSEC_PER_SEC)), _ioQueue, ^{
+        [self flush];
+    });
+}
+
+//在 _ioQueue 上执行
+- (void)flush {
+    NSDictionary *snapshot;
+    @synchronized (self) {
+        if (!_flushScheduled) {
+            return;
+        }
+        _flushScheduled = NO;
+        snapshot = [_values copy];
+    }
+
+    if (![snapshot writeToFile:[self path] atomically:YES]) {
+        NSLog(@"cache store write fail");
+    }
+}
+
+@end
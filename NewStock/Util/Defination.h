@@ -287,6 +287,12 @@ blue:((float)(rgbValue & 0xFF))/255.0 alpha:1.0]
 ///////////////////////////////////////////////////////
 //H5
 
+//H5 离线包清单，格式见 H5OfflinePackage.h
+#define H5_OFFLINE_MANIFEST @"jiabei/offline/manifest.json"
+
+//H5 离线包开关，后台上线清单接口和接口的跨域配置之前保持 0
+#define H5_OFFLINE_ENABLED 0
+
 //公告列表
 #define H5_STOCK_NEWS_LIST @"jiabei/HQ1002"
 
@@ -0,0 +1,70 @@
+//
+//  H5OfflinePackage.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ARCSingletonTemplate.h"
+
+//离线包下载自己的请求时打上，H5OfflineURLProtocol 不拦截
+static NSString * const H5OfflineBypassKey = @"H5OfflineBypassKey";
+
+/**
+ *  H5 静态资源离线包
+ *
+ *  清单接口：GET API_URL + H5_OFFLINE_MANIFEST，返回 200 和 JSON
+ *  {
+ *    "version": "20261019.1",
+ *    "files": {
+ *      "jiabei/HQ1002":    {"md5": "0cc175b9c0f1b6a831c399e269772661", "mime": "text/html"},
+ *      "jiabei/js/app.js": {"md5": "92eb5ffee6ae2fec3ad71c777531578f"}
+ *    }
+ *  }
+ *  - version：字符串或数字，和当前版本不同才下载；内容有变化就要换版本号
+ *  - files 的 key：相对 API_URL 的路径，和线上页面地址的 path 一致，不带 query；
+ *    开头的 "/" 会去掉，不能有空段、"." 和 ".."
+ *  - md5：文件内容的 32 位十六进制 md5，下载后校验，不一致整个版本不切换
+ *  - mime：可选，缺省按扩展名取，没有扩展名的是页面（text/html）
+ *  文件从 API_URL + 路径下载，不带登录 cookie。清单有一项不合法时整个清单丢弃。
+ *
+ *  文件按 md5 存放在 Library/h5_offline/objects 下，版本之间相同的文件不重复下载；
+ *  全部下载校验后，再按清单路径硬链接出 Library/h5_offline/site/<版本> 目录树，
+ *  没有扩展名的页面补上 .html。都成功才写入清单切换过去，中途失败继续用旧版本；
+ *  之后删掉新清单不再引用的文件和旧版本的目录树。
+ *
+ *  WKWebView 的请求不经过 NSURLProtocol，EmbedWebView 用 fileURLForURL: 从目录树整页加载，
+ *  页面引用的相对路径资源都是本地文件。本地页面的接口请求由 EmbedWebView 注入的脚本改发到
+ *  API_URL（window.H5_API_BASE），是跨域请求，后台接口需对 Origin: null 返回
+ *  Access-Control-Allow-Origin: null 和 Access-Control-Allow-Credentials: true。
+ *  UIWebView 和 NSURLConnection 的请求仍由 H5OfflineURLProtocol 按 dataForURL: 返回。
+ *
+ *  页面地址只有 query 里的 JSON 参数不同，查找时忽略 query；接口请求不在清单里，照常走网络。
+ *  H5_OFFLINE_ENABLED 为 0 时不读清单也不检查更新，所有查找都返回 nil。
+ */
+@interface H5OfflinePackage : NSObject
+
+SYNTHESIZE_SINGLETON_FOR_HEADER(H5OfflinePackage)
+
+//当前生效的版本，没有离线包时为 nil
+@property (nonatomic, copy, readonly) NSString *version;
+
+//后台检查清单，有新版本时下载切换；重复调用时只跑一次
+- (void)update;
+
+//url 是否在离线包里；可在任意线程调用
+- (BOOL)containsURL:(NSURL *)url;
+
+//url 对应的离线文件内容，不在离线包里返回 nil；可在任意线程调用
+- (NSData *)dataForURL:(NSURL *)url MIMEType:(NSString **)MIMEType;
+
+//页面在离线包里时返回目录树中的本地地址，带上 url 原来的 query 和 fragment，
+//readAccessURL 为当前版本目录树的根；不是页面或目录树还没建好时返回 nil
+- (NSURL *)fileURLForURL:(NSURL *)url readAccessURL:(NSURL **)readAccessURL;
+
+//当前版本目录树下的本地地址换回线上地址，.html 是落地时补的就去掉；不在目录树下返回 nil
+- (NSURL *)remoteURLForFileURL:(NSURL *)fileURL;
+
+@end
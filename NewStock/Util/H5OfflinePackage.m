@@ -0,0 +1,452 @@
+//
+//  H5OfflinePackage.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "H5OfflinePackage.h"
+#import <CommonCrypto/CommonDigest.h>
+#import "Defination.h"
+
+static NSString *H5OfflineDirectory(void) {
+    NSString *library = NSSearchPathForDirectoriesInDomains(NSLibraryDirectory, NSUserDomainMask, YES).firstObject;
+    return [library stringByAppendingPathComponent:@"h5_offline"];
+}
+
+static NSString *H5OfflineObjectsDirectory(void) {
+    return [H5OfflineDirectory() stringByAppendingPathComponent:@"objects"];
+}
+
+static NSString *H5OfflineSitesDirectory(void) {
+    return [H5OfflineDirectory() stringByAppendingPathComponent:@"site"];
+}
+
+static NSString *H5OfflineManifestPath(void) {
+    return [H5OfflineDirectory() stringByAppendingPathComponent:@"manifest.plist"];
+}
+
+static NSString *H5OfflineDigest(NSData *data) {
+    if (data == nil) {
+        return nil;
+    }
+    unsigned char result[CC_MD5_DIGEST_LENGTH];
+    CC_MD5(data.bytes, (CC_LONG)data.length, result);
+    NSMutableString *digest = [NSMutableString stringWithCapacity:CC_MD5_DIGEST_LENGTH * 2];
+    for (NSInteger i = 0; i < CC_MD5_DIGEST_LENGTH; i++) {
+        [digest appendFormat:@"%02x", result[i]];
+    }
+    return digest;
+}
+
+//md5 直接用作 objects 下的文件名，只接受 32 位十六进制，防止 "../" 之类的路径
+static BOOL H5OfflineIsDigest(NSString *md5) {
+    if (![md5 isKindOfClass:[NSString class]] || md5.length != CC_MD5_DIGEST_LENGTH * 2) {
+        return NO;
+    }
+    NSCharacterSet *hex = [NSCharacterSet characterSetWithCharactersInString:@"0123456789abcdefABCDEF"];
+    return [md5 rangeOfCharacterFromSet:hex.invertedSet].location == NSNotFound;
+}
+
+//版本号可能带 "/"，目录名用它的 md5
+static NSString *H5OfflineSiteDirectory(NSString *version) {
+    return [H5OfflineSitesDirectory() stringByAppendingPathComponent:H5OfflineDigest([version dataUsingEncoding:NSUTF8StringEncoding])];
+}
+
+//清单路径要落到目录树里，不能有空段、"." 和 ".."
+static BOOL H5OfflineIsRelativePath(NSString *path) {
+    if (![path isKindOfClass:[NSString class]] || path.length == 0) {
+        return NO;
+    }
+    for (NSString *component in [path componentsSeparatedByString:@"/"]) {
+        if (component.length == 0 || [component isEqualToString:@"."] || [component isEqualToString:@".."]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+static NSString *H5OfflineMIMEType(NSString *path) {
+    NSString *extension = path.pathExtension.lowercaseString;
+    if (extension.length == 0) {
+        return @"text/html";
+    }
+    NSDictionary *types = @{
+                            @"html" : @"text/html",
+                            @"htm"  : @"text/html",
+                            @"js"   : @"application/javascript",
+                            @"css"  : @"text/css",
+                            @"json" : @"application/json",
+                            @"png"  : @"image/png",
+                            @"jpg"  : @"image/jpeg",
+                            @"jpeg" : @"image/jpeg",
+                            @"gif"  : @"image/gif",
+                            @"svg"  : @"image/svg+xml",
+                            @"woff" : @"font/woff",
+                            @"ttf"  : @"font/ttf",
+                            };
+    return types[extension] ?: @"application/octet-stream";
+}
+
+static NSString *H5OfflineEntryMIMEType(NSString *path, NSDictionary *entry) {
+    return entry[@"mime"] ?: H5OfflineMIMEType(path);
+}
+
+//目录树中的相对路径；WKWebView 按扩展名判断本地文件的类型，没有扩展名的页面补上 .html
+static NSString *H5OfflineSitePath(NSString *path, NSDictionary *entry) {
+    if (path.pathExtension.length == 0 && [H5OfflineEntryMIMEType(path, entry) isEqualToString:@"text/html"]) {
+        return [path stringByAppendingPathExtension:@"html"];
+    }
+    return path;
+}
+
+@implementation H5OfflinePackage
+{
+    dispatch_queue_t _queue;
+    NSURLSession *_session;
+    NSURL *_baseURL;
+    //path -> {md5, mime}，切换版本时整体替换，读写都在 @synchronized(self) 里
+    NSDictionary<NSString *, NSDictionary *> *_files;
+    NSString *_version;
+    //只在 _queue 上访问
+    BOOL _updating;
+}
+SYNTHESIZE_SINGLETON_FOR_CLASS(H5OfflinePackage)
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("com.newstock.h5offline", DISPATCH_QUEUE_SERIAL);
+        _baseURL = [NSURL URLWithString:API_URL];
+
+        NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+        configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+        configuration.HTTPMaximumConnectionsPerHost = 4;
+        configuration.timeoutIntervalForRequest = 30;
+        _session = [NSURLSession sessionWithConfiguration:configuration];
+
+#if H5_OFFLINE_ENABLED
+        //本地清单也按下发时的规则再校验一次
+        NSDictionary *manifest = [self private_manifestFromJSON:[NSDictionary dictionaryWithContentsOfFile:H5OfflineManifestPath()]];
+        [self private_applyManifest:manifest];
+        //目录树被清掉时后台补建，建好之前页面走网络
+        if (manifest) {
+            dispatch_async(_queue, ^{
+                if (![[NSFileManager defaultManager] fileExistsAtPath:H5OfflineSiteDirectory(manifest[@"version"])]) {
+                    [self private_buildSiteForManifest:manifest];
+                }
+            });
+        }
+#endif
+    }
+    return self;
+}
+
+- (NSString *)version {
+    @synchronized (self) {
+        return _version;
+    }
+}
+
+- (void)update {
+#if H5_OFFLINE_ENABLED
+    dispatch_async(_queue, ^{
+        if (_updating) {
+            return;
+        }
+        _updating = YES;
+
+        NSURL *url = [NSURL URLWithString:[API_URL stringByAppendingString:H5_OFFLINE_MANIFEST]];
+        [[_session dataTaskWithRequest:[self private_requestWithURL:url] completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+            NSDictionary *manifest = nil;
+            if (data.length && [(NSHTTPURLResponse *)response statusCode] == 200) {
+                manifest = [self private_manifestFromJSON:[NSJSONSerialization JSONObjectWithData:data options:0 error:nil]];
+            }
+            dispatch_async(_queue, ^{
+                if (manifest == nil || [manifest[@"version"] isEqualToString:self.version]) {
+                    _updating = NO;
+                    return;
+                }
+                [self private_downloadManifest:manifest];
+            });
+        }] resume];
+    });
+#endif
+}
+
+- (BOOL)containsURL:(NSURL *)url {
+    return [self private_entryForURL:url path:NULL] != nil;
+}
+
+- (NSData *)dataForURL:(NSURL *)url MIMEType:(NSString **)MIMEType {
+    NSString *path = nil;
+    NSDictionary *entry = [self private_entryForURL:url path:&path];
+    if (entry == nil) {
+        return nil;
+    }
+    NSString *objectPath = [H5OfflineObjectsDirectory() stringByAppendingPathComponent:entry[@"md5"]];
+    NSData *data = [NSData dataWithContentsOfFile:objectPath options:NSDataReadingMappedIfSafe error:nil];
+    if (data && MIMEType) {
+        *MIMEType = H5OfflineEntryMIMEType(path, entry);
+    }
+    return data;
+}
+
+- (NSURL *)fileURLForURL:(NSURL *)url readAccessURL:(NSURL **)readAccessURL {
+    NSString *path = [self private_relativePathForURL:url];
+    if (path == nil) {
+        return nil;
+    }
+    NSDictionary *entry = nil;
+    NSString *version = nil;
+    @synchronized (self) {
+        entry = _files[path];
+        version = _version;
+    }
+    if (entry == nil || ![H5OfflineEntryMIMEType(path, entry) isEqualToString:@"text/html"]) {
+        return nil;
+    }
+
+    NSString *siteDirectory = H5OfflineSiteDirectory(version);
+    NSString *filePath = [siteDirectory stringByAppendingPathComponent:H5OfflineSitePath(path, entry)];
+    if (![[NSFileManager defaultManager] fileExistsAtPath:filePath]) {
+        return nil;
+    }
+    NSURLComponents *components = [NSURLComponents componentsWithURL:[NSURL fileURLWithPath:filePath] resolvingAgainstBaseURL:NO];
+    components.percentEncodedQuery = url.query;
+    components.percentEncodedFragment = url.fragment;
+    if (readAccessURL) {
+        *readAccessURL = [NSURL fileURLWithPath:siteDirectory isDirectory:YES];
+    }
+    return components.URL;
+}
+
+- (NSURL *)remoteURLForFileURL:(NSURL *)fileURL {
+    if (!fileURL.isFileURL) {
+        return nil;
+    }
+    NSDictionary *files = nil;
+    NSString *version = nil;
+    @synchronized (self) {
+        files = _files;
+        version = _version;
+    }
+    if (version == nil) {
+        return nil;
+    }
+
+    NSString *sitePath = [H5OfflineSiteDirectory(version) stringByAppendingString:@"/"];
+    NSString *path = fileURL.path;
+    if (![path hasPrefix:sitePath] || path.length == sitePath.length) {
+        return nil;
+    }
+    NSString *relativePath = [path substringFromIndex:sitePath.length];
+    NSString *pagePath = [relativePath stringByDeletingPathExtension];
+    if (files[relativePath] == nil && [relativePath.pathExtension isEqualToString:@"html"] && files[pagePath]) {
+        relativePath = pagePath;
+    }
+
+    NSURLComponents *components = [NSURLComponents componentsWithURL:_baseURL resolvingAgainstBaseURL:NO];
+    components.path = [NSString stringWithFormat:@"%@/%@", _baseURL.path, relativePath];
+    components.percentEncodedQuery = fileURL.query;
+    components.percentEncodedFragment = fileURL.fragment;
+    return components.URL;
+}
+
+#pragma mark private
+
+- (NSURLRequest *)private_requestWithURL:(NSURL *)url {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
+    [NSURLProtocol setProperty:@YES forKey:H5OfflineBypassKey inRequest:request];
+    return request;
+}
+
+- (NSDictionary *)private_entryForURL:(NSURL *)url path:(NSString **)outPath {
+    NSString *path = [self private_relativePathForURL:url];
+    if (path == nil) {
+        return nil;
+    }
+    if (outPath) {
+        *outPath = path;
+    }
+    @synchronized (self) {
+        return _files[path];
+    }
+}
+
+//API_URL 下的相对路径，不含 query
+- (NSString *)private_relativePathForURL:(NSURL *)url {
+    NSString *scheme = url.scheme.lowercaseString;
+    if (!([scheme isEqualToString:@"http"] || [scheme isEqualToString:@"https"])) {
+        return nil;
+    }
+    if (url.host == nil || [url.host caseInsensitiveCompare:_baseURL.host] != NSOrderedSame) {
+        return nil;
+    }
+    if (url.port != _baseURL.port && ![url.port isEqual:_baseURL.port]) {
+        return nil;
+    }
+    NSString *basePath = [_baseURL.path stringByAppendingString:@"/"];
+    NSString *path = url.path;
+    if (![path hasPrefix:basePath] || path.length == basePath.length) {
+        return nil;
+    }
+    return [path substringFromIndex:basePath.length];
+}
+
+//校验清单格式，转成可以直接写 plist 的字典；格式不对返回 nil
+- (NSDictionary *)private_manifestFromJSON:(id)json {
+    if (![json isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    id version = json[@"version"];
+    NSDictionary *files = json[@"files"];
+    if (!([version isKindOfClass:[NSString class]] || [version isKindOfClass:[NSNumber class]]) ||
+        ![files isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+
+    NSMutableDictionary *entries = [NSMutableDictionary dictionaryWithCapacity:files.count];
+    __block BOOL valid = YES;
+    [files enumerateKeysAndObjectsUsingBlock:^(NSString *path, NSDictionary *entry, BOOL *stop) {
+        NSString *md5 = [entry isKindOfClass:[NSDictionary class]] ? entry[@"md5"] : nil;
+        if ([path isKindOfClass:[NSString class]] && [path hasPrefix:@"/"]) {
+            path = [path substringFromIndex:1];
+        }
+        if (!H5OfflineIsRelativePath(path) || !H5OfflineIsDigest(md5)) {
+            valid = NO;
+            *stop = YES;
+            return;
+        }
+        NSMutableDictionary *item = [NSMutableDictionary dictionaryWithObject:md5.lowercaseString forKey:@"md5"];
+        if ([entry[@"mime"] isKindOfClass:[NSString class]]) {
+            item[@"mime"] = entry[@"mime"];
+        }
+        entries[path] = item;
+    }];
+    if (!valid) {
+        return nil;
+    }
+    return @{@"version" : [NSString stringWithFormat:@"%@", version], @"files" : entries};
+}
+
+- (void)private_applyManifest:(NSDictionary *)manifest {
+    NSDictionary *files = manifest[@"files"];
+    @synchronized (self) {
+        _version = [files isKindOfClass:[NSDictionary class]] ? manifest[@"version"] : nil;
+        _files = [files isKindOfClass:[NSDictionary class]] ? files : nil;
+    }
+}
+
+//在 _queue 上调用
+- (void)private_downloadManifest:(NSDictionary *)manifest {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    [fileManager createDirectoryAtPath:H5OfflineObjectsDirectory() withIntermediateDirectories:YES attributes:nil error:nil];
+
+    dispatch_group_t group = dispatch_group_create();
+    //只在 _queue 上读写
+    __block BOOL failed = NO;
+    [manifest[@"files"] enumerateKeysAndObjectsUsingBlock:^(NSString *path, NSDictionary *entry, BOOL *stop) {
+        NSString *md5 = entry[@"md5"];
+        NSString *objectPath = [H5OfflineObjectsDirectory() stringByAppendingPathComponent:md5];
+        //上个版本已经有的校验通过就不再下载，内容不对的删掉重下
+        if ([fileManager fileExistsAtPath:objectPath]) {
+            NSData *data = [NSData dataWithContentsOfFile:objectPath options:NSDataReadingMappedIfSafe error:nil];
+            if ([H5OfflineDigest(data) isEqualToString:md5]) {
+                return;
+            }
+            [fileManager removeItemAtPath:objectPath error:nil];
+        }
+        NSURL *url = [NSURL URLWithString:[API_URL stringByAppendingString:path]];
+        if (url == nil) {
+            failed = YES;
+            *stop = YES;
+            return;
+        }
+
+        dispatch_group_enter(group);
+        [[_session downloadTaskWithRequest:[self private_requestWithURL:url] completionHandler:^(NSURL *location, NSURLResponse *response, NSError *error) {
+            //location 只在回调里有效，这里就校验并移走
+            BOOL finished = NO;
+            if (location && [(NSHTTPURLResponse *)response statusCode] == 200) {
+                NSData *data = [NSData dataWithContentsOfURL:location options:NSDataReadingMappedIfSafe error:nil];
+                if ([H5OfflineDigest(data) isEqualToString:md5]) {
+                    NSFileManager *manager = [NSFileManager defaultManager];
+                    finished = [manager moveItemAtPath:location.path toPath:objectPath error:nil] || [manager fileExistsAtPath:objectPath];
+                }
+            }
+            dispatch_async(_queue, ^{
+                if (!finished) {
+                    failed = YES;
+                }
+                dispatch_group_leave(group);
+            });
+        }] resume];
+    }];
+
+    dispatch_group_notify(group, _queue, ^{
+        //全部到齐才切换，否则下次启动再试，已下好的文件留着复用
+        if (!failed && [self private_buildSiteForManifest:manifest] && [manifest writeToFile:H5OfflineManifestPath() atomically:YES]) {
+            [self private_applyManifest:manifest];
+            [self private_removeUnusedObjects];
+        }
+        _updating = NO;
+    });
+}
+
+//在 _queue 上调用；objects 里的文件按清单路径硬链接成目录树，先建在临时目录，完整了再挪过去
+- (BOOL)private_buildSiteForManifest:(NSDictionary *)manifest {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSString *siteDirectory = H5OfflineSiteDirectory(manifest[@"version"]);
+    NSString *buildDirectory = [siteDirectory stringByAppendingPathExtension:@"tmp"];
+    [fileManager removeItemAtPath:buildDirectory error:nil];
+
+    __block BOOL built = YES;
+    [manifest[@"files"] enumerateKeysAndObjectsUsingBlock:^(NSString *path, NSDictionary *entry, BOOL *stop) {
+        NSString *objectPath = [H5OfflineObjectsDirectory() stringByAppendingPathComponent:entry[@"md5"]];
+        NSString *filePath = [buildDirectory stringByAppendingPathComponent:H5OfflineSitePath(path, entry)];
+        [fileManager createDirectoryAtPath:[filePath stringByDeletingLastPathComponent] withIntermediateDirectories:YES attributes:nil error:nil];
+        //同一个卷上硬链接不多占空间，不行再复制
+        if (![fileManager linkItemAtPath:objectPath toPath:filePath error:nil] &&
+            ![fileManager copyItemAtPath:objectPath toPath:filePath error:nil]) {
+            built = NO;
+            *stop = YES;
+        }
+    }];
+
+    if (built) {
+        [fileManager removeItemAtPath:siteDirectory error:nil];
+        built = [fileManager moveItemAtPath:buildDirectory toPath:siteDirectory error:nil];
+    }
+    if (!built) {
+        [fileManager removeItemAtPath:buildDirectory error:nil];
+    }
+    return built;
+}
+
+//在 _queue 上调用
+- (void)private_removeUnusedObjects {
+    NSMutableSet *used = [NSMutableSet set];
+    @synchronized (self) {
+        for (NSDictionary *entry in _files.allValues) {
+            [used addObject:entry[@"md5"]];
+        }
+    }
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    for (NSString *name in [fileManager contentsOfDirectoryAtPath:H5OfflineObjectsDirectory() error:nil]) {
+        if (![used containsObject:name]) {
+            [fileManager removeItemAtPath:[H5OfflineObjectsDirectory() stringByAppendingPathComponent:name] error:nil];
+        }
+    }
+
+    //目录树里是硬链接，删掉旧版本不影响 objects
+    NSString *siteName = H5OfflineSiteDirectory(self.version).lastPathComponent;
+    for (NSString *name in [fileManager contentsOfDirectoryAtPath:H5OfflineSitesDirectory() error:nil]) {
+        if (![name isEqualToString:siteName]) {
+            [fileManager removeItemAtPath:[H5OfflineSitesDirectory() stringByAppendingPathComponent:name] error:nil];
+        }
+    }
+}
+
+@end
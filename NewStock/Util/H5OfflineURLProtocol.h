@@ -0,0 +1,17 @@
+//
+//  H5OfflineURLProtocol.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  UIWebView 页面的 GET 请求命中 H5OfflinePackage 时直接返回本地文件，没命中的交给后面的 protocol 走网络。
+ *  要在 CustomUrlProtocol 之后注册，后注册的先被询问。
+ */
+@interface H5OfflineURLProtocol : NSURLProtocol
+
+@end
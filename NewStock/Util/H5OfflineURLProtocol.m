@@ -0,0 +1,50 @@
+//
+//  H5OfflineURLProtocol.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "H5OfflineURLProtocol.h"
+#import "H5OfflinePackage.h"
+
+@implementation H5OfflineURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+    if ([NSURLProtocol propertyForKey:H5OfflineBypassKey inRequest:request]) {
+        return NO;
+    }
+    if (request.HTTPMethod.length && ![request.HTTPMethod isEqualToString:@"GET"]) {
+        return NO;
+    }
+    return [[H5OfflinePackage sharedH5OfflinePackage] containsURL:request.URL];
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+    return request;
+}
+
+- (void)startLoading {
+    NSString *MIMEType = nil;
+    NSData *data = [[H5OfflinePackage sharedH5OfflinePackage] dataForURL:self.request.URL MIMEType:&MIMEType];
+    if (data == nil) {
+        //canInit 之后刚好切换了版本
+        [self.client URLProtocol:self didFailWithError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorResourceUnavailable userInfo:nil]];
+        return;
+    }
+
+    NSString *contentType = [MIMEType hasPrefix:@"text/"] || [MIMEType isEqualToString:@"application/javascript"] ? [MIMEType stringByAppendingString:@"; charset=utf-8"] : MIMEType;
+    NSDictionary *headers = @{@"Content-Type" : contentType,
+                              @"Content-Length" : [NSString stringWithFormat:@"%lu", (unsigned long)data.length],
+                              @"Access-Control-Allow-Origin" : @"*"};
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL statusCode:200 HTTPVersion:@"HTTP/1.1" headerFields:headers];
+    [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    [self.client URLProtocol:self didLoadData:data];
+    [self.client URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading {
+}
+
+@end
@@ -0,0 +1,41 @@
+//
+//  ImagePipeline.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import "ARCSingletonTemplate.h"
+
+typedef void(^ImagePipelineCompletion)(UIImage *image, NSURL *url);
+
+/**
+ *  按显示尺寸取图
+ *
+ *  原图仍下载到 SDImageCache 的磁盘缓存（与 sd_setImageWithURL 共用），
+ *  在后台用 ImageIO 直接解码成显示尺寸的位图，不再把原图整张解码进内存。
+ *  内存缓存以 (URL, 像素尺寸) 为键，按位图字节数计成本，收到内存警告时清空。
+ */
+@interface ImagePipeline : NSObject
+
+SYNTHESIZE_SINGLETON_FOR_HEADER(ImagePipeline)
+
+/**
+ *  内存缓存上限(字节)，默认 30MB
+ */
+@property (nonatomic, assign) NSUInteger memoryCostLimit;
+
+//限制 SDImageCache 的内存缓存，启动时调用一次
++ (void)configureSharedImageCache;
+
+//size 为显示尺寸(pt)，按屏幕 scale 换算成像素
+- (UIImage *)cachedImageForURL:(NSURL *)url size:(CGSize)size;
+
+//内存缓存命中时同步回调；否则在后台读盘或下载、缩放，完成后在主线程回调，失败时 image 为 nil
+- (void)loadImageWithURL:(NSURL *)url size:(CGSize)size completion:(ImagePipelineCompletion)completion;
+
+- (void)clearMemory;
+
+@end
@@ -0,0 +1,195 @@
+//
+//  ImagePipeline.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "ImagePipeline.h"
+#import <ImageIO/ImageIO.h>
+#import <SDWebImage/SDImageCache.h>
+#import <SDWebImage/SDWebImageManager.h>
+#import <SDWebImage/SDWebImageDownloader.h>
+
+//缩放后位图的内存缓存上限(字节)
+static const NSUInteger kImagePipelineMemoryCost = 30 * 1024 * 1024;
+
+//SDImageCache 内存缓存上限，单位是像素数(宽x高x scale²)，约 32MB
+static const NSUInteger kSDImageCacheMaxPixels = 8 * 1024 * 1024;
+
+//从原图数据直接解码出长边不超过所需尺寸的位图，不会把原图整张解码
+static UIImage *ImagePipelineDownsample(NSData *data, CGSize pixelSize, CGFloat scale) {
+    CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef)data, (__bridge CFDictionaryRef)@{(id)kCGImageSourceShouldCache : @NO});
+    if (source == NULL) {
+        return nil;
+    }
+
+    //按 AspectFill 算，保证铺满显示区域；不放大
+    CGFloat maxPixel = MAX(pixelSize.width, pixelSize.height);
+    CFDictionaryRef properties = CGImageSourceCopyPropertiesAtIndex(source, 0, NULL);
+    if (properties) {
+        NSDictionary *dic = (__bridge NSDictionary *)properties;
+        CGFloat width = [dic[(id)kCGImagePropertyPixelWidth] doubleValue];
+        CGFloat height = [dic[(id)kCGImagePropertyPixelHeight] doubleValue];
+        //EXIF 方向 5~8 宽高互换
+        if ([dic[(id)kCGImagePropertyOrientation] integerValue] >= 5) {
+            CGFloat tmp = width;
+            width = height;
+            height = tmp;
+        }
+        if (width > 0 && height > 0) {
+            CGFloat factor = MIN(1, MAX(pixelSize.width / width, pixelSize.height / height));
+            maxPixel = ceil(MAX(width, height) * factor);
+        }
+        CFRelease(properties);
+    }
+
+    NSDictionary *options = @{
+                              (id)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+                              (id)kCGImageSourceCreateThumbnailWithTransform : @YES,
+                              (id)kCGImageSourceShouldCacheImmediately : @YES,
+                              (id)kCGImageSourceThumbnailMaxPixelSize : @(maxPixel),
+                              };
+    CGImageRef imageRef = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+    CFRelease(source);
+    if (imageRef == NULL) {
+        return nil;
+    }
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    return image;
+}
+
+@implementation ImagePipeline
+{
+    NSCache *_memoryCache;
+    SDWebImageDownloader *_downloader;
+    dispatch_queue_t _queue;
+    CGFloat _scale;
+    //key -> 等待中的回调，只在 _queue 上访问
+    NSMutableDictionary<NSString *, NSMutableArray<ImagePipelineCompletion> *> *_waiting;
+}
+SYNTHESIZE_SINGLETON_FOR_CLASS(ImagePipeline)
+
++ (void)configureSharedImageCache {
+    [SDImageCache sharedImageCache].maxMemoryCost = kSDImageCacheMaxPixels;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _memoryCache = [[NSCache alloc] init];
+        _memoryCache.name = @"com.newstock.imagepipeline";
+        _memoryCache.totalCostLimit = kImagePipelineMemoryCost;
+
+        //自己解码缩放，下载器不必再解一遍原图；后进先下，快速滑动时先出当前屏
+        _downloader = [[SDWebImageDownloader alloc] init];
+        _downloader.shouldDecompressImages = NO;
+        _downloader.executionOrder = SDWebImageDownloaderLIFOExecutionOrder;
+
+        _queue = dispatch_queue_create("com.newstock.imagepipeline", DISPATCH_QUEUE_SERIAL);
+        _scale = [UIScreen mainScreen].scale;
+        _waiting = [NSMutableDictionary dictionary];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(clearMemory) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    }
+    return self;
+}
+
+- (NSUInteger)memoryCostLimit {
+    return _memoryCache.totalCostLimit;
+}
+
+- (void)setMemoryCostLimit:(NSUInteger)memoryCostLimit {
+    _memoryCache.totalCostLimit = memoryCostLimit;
+}
+
+- (UIImage *)cachedImageForURL:(NSURL *)url size:(CGSize)size {
+    NSString *key = [self private_keyForURL:url size:size];
+    return key ? [_memoryCache objectForKey:key] : nil;
+}
+
+- (void)loadImageWithURL:(NSURL *)url size:(CGSize)size completion:(ImagePipelineCompletion)completion {
+    if (completion == nil) {
+        return;
+    }
+    NSString *key = [self private_keyForURL:url size:size];
+    if (key == nil) {
+        completion(nil, url);
+        return;
+    }
+    UIImage *image = [_memoryCache objectForKey:key];
+    if (image) {
+        completion(image, url);
+        return;
+    }
+
+    CGSize pixelSize = CGSizeMake(ceil(size.width * _scale), ceil(size.height * _scale));
+    dispatch_async(_queue, ^{
+        //同一张图同一尺寸只处理一次
+        NSMutableArray *waiting = _waiting[key];
+        if (waiting) {
+            [waiting addObject:[completion copy]];
+            return;
+        }
+        _waiting[key] = [NSMutableArray arrayWithObject:[completion copy]];
+
+        NSString *cacheKey = [[SDWebImageManager sharedManager] cacheKeyForURL:url];
+        NSString *path = [[SDImageCache sharedImageCache] defaultCachePathForKey:cacheKey];
+        NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+        if (data.length) {
+            [self private_finishKey:key url:url data:data pixelSize:pixelSize];
+            return;
+        }
+
+        [_downloader downloadImageWithURL:url options:0 progress:nil completed:^(UIImage *image, NSData *data, NSError *error, BOOL finished) {
+            if (!finished) {
+                return;
+            }
+            dispatch_async(_queue, ^{
+                if (data.length) {
+                    [[SDImageCache sharedImageCache] storeImageDataToDisk:data forKey:cacheKey];
+                }
+                [self private_finishKey:key url:url data:data pixelSize:pixelSize];
+            });
+        }];
+    });
+}
+
+- (void)clearMemory {
+    [_memoryCache removeAllObjects];
+}
+
+#pragma mark private
+
+- (NSString *)private_keyForURL:(NSURL *)url size:(CGSize)size {
+    if (url.absoluteString.length == 0 || size.width <= 0 || size.height <= 0) {
+        return nil;
+    }
+    return [NSString stringWithFormat:@"%@|%.0fx%.0f", url.absoluteString, ceil(size.width * _scale), ceil(size.height * _scale)];
+}
+
+//在 _queue 上调用
+- (void)private_finishKey:(NSString *)key url:(NSURL *)url data:(NSData *)data pixelSize:(CGSize)pixelSize {
+    UIImage *image = nil;
+    if (data.length) {
+        @autoreleasepool {
+            image = ImagePipelineDownsample(data, pixelSize, _scale);
+        }
+    }
+    if (image) {
+        NSUInteger cost = CGImageGetBytesPerRow(image.CGImage) * CGImageGetHeight(image.CGImage);
+        [_memoryCache setObject:image forKey:key cost:cost];
+    }
+
+    NSArray *completions = _waiting[key];
+    [_waiting removeObjectForKey:key];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        for (ImagePipelineCompletion completion in completions) {
+            completion(image, url);
+        }
+    });
+}
+
+@end
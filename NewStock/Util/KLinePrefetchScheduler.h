@@ -0,0 +1,36 @@
+//
+//  KLinePrefetchScheduler.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ARCSingletonTemplate.h"
+@class StockListModel;
+
+/**
+ *  K 线预取
+ *
+ *  当前图表加载完成、停留一会儿后，在后台以低优先级逐个请求：
+ *  当前股票最常用的其他周期，以及列表中相邻股票打开时的默认周期，结果写入 Y_KLineDiskCache。
+ *  WiFi 下预取较多，蜂窝网络只取一个周期，无网络不预取。
+ *  收到内存警告或进入后台时取消。
+ */
+@interface KLinePrefetchScheduler : NSObject
+
+SYNTHESIZE_SINGLETON_FOR_HEADER(KLinePrefetchScheduler)
+
+//用户切换到 chartTyp，累计次数决定预取顺序
+- (void)recordChartType:(NSString *)chartTyp;
+
+//chartTypes 为页面可切换的周期，第一个为打开时的默认周期；已在排队的同一股票不会重复安排
+- (void)scheduleForStock:(StockListModel *)stock
+               chartType:(NSString *)chartTyp
+              chartTypes:(NSArray<NSString *> *)chartTypes
+              neighbours:(NSArray<StockListModel *> *)neighbours;
+
+- (void)cancelAll;
+
+@end
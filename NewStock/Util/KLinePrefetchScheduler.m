@@ -0,0 +1,234 @@
+//
+//  KLinePrefetchScheduler.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "KLinePrefetchScheduler.h"
+#import <UIKit/UIKit.h>
+#import "StockListModel.h"
+#import "KLineInfoAPI.h"
+#import "Y_KLineDiskCache.h"
+#import "MarketConfig.h"
+#import "Reachability.h"
+#import "CacheStore.h"
+
+//图表加载完成后等待的时间，期间用户切走则不预取
+static const NSTimeInterval kPrefetchSettleDelay = 1.5;
+
+//同一份数据多久内不重复预取
+static const NSTimeInterval kPrefetchFreshInterval = 60;
+
+//各网络下预取的周期数、相邻股票数
+static const NSUInteger kPrefetchWiFiPeriods = 2;
+static const NSUInteger kPrefetchWiFiNeighbours = 4;
+static const NSUInteger kPrefetchWWANPeriods = 1;
+static const NSUInteger kPrefetchWWANNeighbours = 0;
+
+@interface KLinePrefetchTask : NSObject
+
+@property (nonatomic, copy) NSString *symbolTyp;
+@property (nonatomic, copy) NSString *symbol;
+@property (nonatomic, copy) NSString *marketCd;
+@property (nonatomic, copy) NSString *chartTyp;
+@property (nonatomic, copy, readonly) NSString *cacheKey;
+
+@end
+
+@implementation KLinePrefetchTask
+
++ (instancetype)taskWithStock:(StockListModel *)stock chartType:(NSString *)chartTyp {
+    KLinePrefetchTask *task = [[KLinePrefetchTask alloc] init];
+    task.symbolTyp = stock.symbolTyp;
+    task.symbol = stock.symbol;
+    task.marketCd = stock.marketCd;
+    task.chartTyp = chartTyp;
+    return task;
+}
+
+- (NSString *)cacheKey {
+    return [Y_KLineDiskCache keyWithSymbolTyp:_symbolTyp symbol:_symbol marketCd:_marketCd chartTyp:_chartTyp];
+}
+
+@end
+
+
+@interface KLinePrefetchScheduler ()
+{
+    NSMutableArray<KLinePrefetchTask *> *_tasks;
+    NSMutableDictionary<NSString *, NSDate *> *_fetchedAt;
+    NSString *_scheduledKey;
+    KLineInfoAPI *_request;
+    NSUInteger _generation;
+    BOOL _running;
+}
+@end
+
+@implementation KLinePrefetchScheduler
+SYNTHESIZE_SINGLETON_FOR_CLASS(KLinePrefetchScheduler)
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _tasks = [NSMutableArray array];
+        _fetchedAt = [NSMutableDictionary dictionary];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(didReceiveMemoryWarning) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(cancelAll) name:UIApplicationDidEnterBackgroundNotification object:nil];
+    }
+    return self;
+}
+
+- (NSString *)usageKeyForChartType:(NSString *)chartTyp {
+    return [NSString stringWithFormat:@"klinePeriodUsage_%@", chartTyp];
+}
+
+- (void)recordChartType:(NSString *)chartTyp {
+    if (chartTyp.length == 0) {
+        return;
+    }
+    NSString *key = [self usageKeyForChartType:chartTyp];
+    CacheStore *store = [CacheStore sharedCacheStore];
+    [store setLongLong:[store longLongForKey:key] + 1 forKey:key];
+}
+
+- (void)scheduleForStock:(StockListModel *)stock
+               chartType:(NSString *)chartTyp
+              chartTypes:(NSArray<NSString *> *)chartTypes
+              neighbours:(NSArray<StockListModel *> *)neighbours {
+    NSAssert([NSThread isMainThread], @"prefetch must be scheduled on main thread");
+    if (!(stock.symbolTyp && stock.symbol && stock.marketCd) || chartTypes.count == 0) {
+        return;
+    }
+
+    //同一页面的定时刷新不重复安排
+    NSString *scheduledKey = [Y_KLineDiskCache keyWithSymbolTyp:stock.symbolTyp symbol:stock.symbol marketCd:stock.marketCd chartTyp:chartTyp];
+    if ([scheduledKey isEqualToString:_scheduledKey]) {
+        return;
+    }
+    [self cancelAll];
+    _scheduledKey = scheduledKey;
+
+    NSUInteger periodCount, neighbourCount;
+    NetworkStatus status = [[Reachability reachabilityForInternetConnection] currentReachabilityStatus];
+    if (status == NotReachable) {
+        return;
+    } else if ([MarketConfig isWiFi]) {
+        periodCount = kPrefetchWiFiPeriods;
+        neighbourCount = kPrefetchWiFiNeighbours;
+    } else {
+        periodCount = kPrefetchWWANPeriods;
+        neighbourCount = kPrefetchWWANNeighbours;
+    }
+
+    //其他周期按使用次数排序，次数相同保持页面顺序
+    NSMutableArray *periods = [NSMutableArray array];
+    for (NSString *type in chartTypes) {
+        if (![type isEqualToString:chartTyp]) {
+            [periods addObject:type];
+        }
+    }
+    CacheStore *store = [CacheStore sharedCacheStore];
+    [periods sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(NSString *a, NSString *b) {
+        long long ua = [store longLongForKey:[self usageKeyForChartType:a]];
+        long long ub = [store longLongForKey:[self usageKeyForChartType:b]];
+        return ua == ub ? NSOrderedSame : (ua > ub ? NSOrderedAscending : NSOrderedDescending);
+    }];
+    for (NSUInteger i = 0; i < periods.count && i < periodCount; i++) {
+        [_tasks addObject:[KLinePrefetchTask taskWithStock:stock chartType:periods[i]]];
+    }
+
+    //相邻股票打开时的默认周期
+    NSUInteger added = 0;
+    for (StockListModel *neighbour in neighbours) {
+        if (added >= neighbourCount) {
+            break;
+        }
+        if (!(neighbour.symbolTyp && neighbour.symbol && neighbour.marketCd) || [neighbour.symbol isEqualToString:stock.symbol]) {
+            continue;
+        }
+        [_tasks addObject:[KLinePrefetchTask taskWithStock:neighbour chartType:chartTypes.firstObject]];
+        added++;
+    }
+
+    NSUInteger generation = _generation;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kPrefetchSettleDelay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        if (generation == _generation) {
+            [self runNext];
+        }
+    });
+}
+
+- (void)didReceiveMemoryWarning {
+    [self cancelAll];
+    [_fetchedAt removeAllObjects];
+}
+
+- (void)cancelAll {
+    _generation++;
+    [_tasks removeAllObjects];
+    [_request stop];
+    _request = nil;
+    _running = NO;
+}
+
+#pragma mark private
+
+- (void)runNext {
+    if (_running) {
+        return;
+    }
+    KLinePrefetchTask *task = nil;
+    while (_tasks.count && !task) {
+        KLinePrefetchTask *candidate = _tasks.firstObject;
+        [_tasks removeObjectAtIndex:0];
+        //key 不全的不能缓存，预取没有意义
+        if (!candidate.cacheKey) {
+            continue;
+        }
+        NSDate *fetchedAt = _fetchedAt[candidate.cacheKey];
+        if (!fetchedAt || -[fetchedAt timeIntervalSinceNow] > kPrefetchFreshInterval) {
+            task = candidate;
+        }
+    }
+    if (!task) {
+        return;
+    }
+
+    _running = YES;
+    NSUInteger generation = _generation;
+    NSString *cacheKey = task.cacheKey;
+    [[Y_KLineDiskCache sharedY_KLineDiskCache] loadBarsForKey:cacheKey completion:^(NSArray<NSDictionary *> *bars) {
+        if (generation != _generation) {
+            return;
+        }
+        long long sinceTime = [Y_KLineDiskCache sinceTimeForBars:bars chartType:task.chartTyp];
+
+        KLineInfoAPI *api = [[KLineInfoAPI alloc] initWithSymbolTyp:task.symbolTyp symbol:task.symbol marketCd:task.marketCd chartTyp:task.chartTyp];
+        api.ignoreCache = YES;
+        api.sinceTime = sinceTime;
+        api.requestPriority = APIRequestPriorityLow;
+        _request = api;
+
+        [api startWithCompletionBlockWithSuccess:^(APIBaseRequest *request) {
+            NSArray *response = request.responseJSONObject[@"chartInfLst"];
+            [[Y_KLineDiskCache sharedY_KLineDiskCache] saveBars:response forKey:cacheKey incremental:(sinceTime > 0) completion:^(NSArray<NSDictionary *> *merged) {
+                _fetchedAt[cacheKey] = [NSDate date];
+                if (generation == _generation) {
+                    _request = nil;
+                    _running = NO;
+                    [self runNext];
+                }
+            }];
+        } failure:^(APIBaseRequest *request) {
+            //网络不好时不再继续
+            if (generation == _generation) {
+                [self cancelAll];
+            }
+        }];
+    }];
+}
+
+@end
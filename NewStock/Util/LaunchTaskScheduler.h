@@ -0,0 +1,41 @@
+//
+//  LaunchTaskScheduler.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ARCSingletonTemplate.h"
+
+//启动任务执行阶段
+typedef NS_ENUM(NSInteger, LAUNCH_TASK_PHASE) {
+    LAUNCH_TASK_BLOCKING,           //首帧之前，同步执行
+    LAUNCH_TASK_AFTER_FIRST_FRAME,  //首帧提交之后
+    LAUNCH_TASK_IDLE                //主线程空闲时逐个执行
+};
+
+/**
+ *  冷启动任务调度
+ *
+ *  didFinishLaunching 中注册任务后调用 start。concurrent 的任务在后台并发执行，
+ *  其余在主线程按注册顺序执行。每个任务耗时(ms)记录在 taskCosts 中，
+ *  首个行情页面可交互时调用 markFirstScreenReady 输出整体启动耗时。
+ */
+@interface LaunchTaskScheduler : NSObject
+
+SYNTHESIZE_SINGLETON_FOR_HEADER(LaunchTaskScheduler)
+
+@property (nonatomic, strong, readonly) NSDictionary<NSString *, NSNumber *> *taskCosts;
+
+//进程创建到首屏可交互的耗时(ms)，未就绪时为 0
+@property (nonatomic, assign, readonly) double firstScreenCost;
+
+- (void)addTask:(NSString *)name phase:(LAUNCH_TASK_PHASE)phase concurrent:(BOOL)concurrent block:(dispatch_block_t)block;
+
+- (void)start;
+
+- (void)markFirstScreenReady;
+
+@end
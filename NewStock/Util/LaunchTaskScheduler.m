@@ -0,0 +1,201 @@
+//
+//  LaunchTaskScheduler.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "LaunchTaskScheduler.h"
+#import <QuartzCore/QuartzCore.h>
+#include <sys/sysctl.h>
+
+//排在 CoreAnimation 提交(2000000)之后，保证回调时首帧已提交
+static const CFIndex kLaunchObserverOrder = 0xFFFFFF;
+
+@interface LaunchTask : NSObject
+
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) BOOL concurrent;
+@property (nonatomic, copy) dispatch_block_t block;
+
+@end
+
+@implementation LaunchTask
+@end
+
+
+@interface LaunchTaskScheduler ()
+{
+    NSMutableArray<LaunchTask *> *_phaseTasks[3];
+    NSMutableDictionary<NSString *, NSNumber *> *_taskCosts;
+    dispatch_queue_t _concurrentQueue;
+    dispatch_group_t _concurrentGroup;
+    CFRunLoopObserverRef _idleObserver;
+    NSTimeInterval _processStartTime;
+    NSTimeInterval _launchStartTime;
+    BOOL _started;
+    BOOL _firstScreenReady;
+}
+@end
+
+@implementation LaunchTaskScheduler
+SYNTHESIZE_SINGLETON_FOR_CLASS(LaunchTaskScheduler)
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        for (int i = 0; i < 3; i++) {
+            _phaseTasks[i] = [NSMutableArray array];
+        }
+        _taskCosts = [NSMutableDictionary dictionary];
+        _concurrentQueue = dispatch_queue_create("com.newstock.launch", DISPATCH_QUEUE_CONCURRENT);
+        _concurrentGroup = dispatch_group_create();
+        _processStartTime = [self processStartTime];
+        _launchStartTime = [[NSDate date] timeIntervalSince1970];
+    }
+    return self;
+}
+
+- (NSTimeInterval)processStartTime {
+    struct kinfo_proc kp;
+    size_t len = sizeof(kp);
+    int mib[4] = {CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid()};
+    if (sysctl(mib, 4, &kp, &len, NULL, 0) != 0) {
+        return [[NSDate date] timeIntervalSince1970];
+    }
+    return kp.kp_proc.p_starttime.tv_sec + kp.kp_proc.p_starttime.tv_usec / 1000000.0;
+}
+
+- (NSDictionary<NSString *, NSNumber *> *)taskCosts {
+    @synchronized (self) {
+        return [_taskCosts copy];
+    }
+}
+
+- (void)addTask:(NSString *)name phase:(LAUNCH_TASK_PHASE)phase concurrent:(BOOL)concurrent block:(dispatch_block_t)block {
+    NSAssert([NSThread isMainThread], @"launch tasks must be added on main thread");
+    if (!block) {
+        return;
+    }
+
+    LaunchTask *task = [[LaunchTask alloc] init];
+    task.name = name;
+    task.concurrent = concurrent;
+    task.block = block;
+    [_phaseTasks[phase] addObject:task];
+}
+
+- (void)start {
+    if (_started) {
+        return;
+    }
+    _started = YES;
+
+    //首帧之前：后台任务先发出去，主线程任务同步执行，最后等后台任务结束
+    NSArray *blockingTasks = [self popTasksOfPhase:LAUNCH_TASK_BLOCKING];
+    dispatch_group_t blockingGroup = dispatch_group_create();
+    for (LaunchTask *task in blockingTasks) {
+        if (task.concurrent) {
+            dispatch_group_async(blockingGroup, _concurrentQueue, ^{
+                [self runTask:task];
+            });
+        }
+    }
+    for (LaunchTask *task in blockingTasks) {
+        if (!task.concurrent) {
+            [self runTask:task];
+        }
+    }
+    dispatch_group_wait(blockingGroup, DISPATCH_TIME_FOREVER);
+
+    //首帧提交之后
+    CFRunLoopObserverRef firstFrameObserver = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting, false, kLaunchObserverOrder, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+        DLog(@"launch: first frame committed %.1fms", [self msSince:_processStartTime]);
+        [self runPhase:LAUNCH_TASK_AFTER_FIRST_FRAME];
+        [self startIdleObserver];
+    });
+    CFRunLoopAddObserver(CFRunLoopGetMain(), firstFrameObserver, kCFRunLoopCommonModes);
+    CFRelease(firstFrameObserver);
+}
+
+- (void)markFirstScreenReady {
+    if (_firstScreenReady) {
+        return;
+    }
+    _firstScreenReady = YES;
+    _firstScreenCost = [self msSince:_processStartTime];
+
+    DLog(@"launch: first screen ready %.1fms (%.1fms after didFinishLaunching)", _firstScreenCost, [self msSince:_launchStartTime]);
+    DLog(@"launch: task costs %@", self.taskCosts);
+}
+
+#pragma mark private
+
+- (NSArray<LaunchTask *> *)popTasksOfPhase:(LAUNCH_TASK_PHASE)phase {
+    NSArray *tasks = [_phaseTasks[phase] copy];
+    [_phaseTasks[phase] removeAllObjects];
+    return tasks;
+}
+
+- (void)runPhase:(LAUNCH_TASK_PHASE)phase {
+    for (LaunchTask *task in [self popTasksOfPhase:phase]) {
+        [self dispatchTask:task];
+    }
+}
+
+- (void)dispatchTask:(LaunchTask *)task {
+    if (task.concurrent) {
+        dispatch_group_async(_concurrentGroup, _concurrentQueue, ^{
+            [self runTask:task];
+        });
+    } else {
+        [self runTask:task];
+    }
+}
+
+- (void)runTask:(LaunchTask *)task {
+    CFTimeInterval begin = CACurrentMediaTime();
+    task.block();
+    double cost = (CACurrentMediaTime() - begin) * 1000;
+
+    @synchronized (self) {
+        _taskCosts[task.name] = @(cost);
+    }
+    DLog(@"launch: %@ %.1fms%@", task.name, cost, [NSThread isMainThread] ? @"" : @" (bg)");
+}
+
+//每次主线程即将休眠时取出一个空闲任务执行，取完后移除
+- (void)startIdleObserver {
+    if (_idleObserver || _phaseTasks[LAUNCH_TASK_IDLE].count == 0) {
+        return;
+    }
+
+    _idleObserver = CFRunLoopObserverCreateWithHandler(kCFAllocatorDefault, kCFRunLoopBeforeWaiting, true, kLaunchObserverOrder, ^(CFRunLoopObserverRef observer, CFRunLoopActivity activity) {
+        NSMutableArray *idleTasks = _phaseTasks[LAUNCH_TASK_IDLE];
+        if (idleTasks.count) {
+            LaunchTask *task = idleTasks.firstObject;
+            [idleTasks removeObjectAtIndex:0];
+            [self dispatchTask:task];
+        }
+        if (idleTasks.count == 0) {
+            [self stopIdleObserver];
+        }
+    });
+    //只在 default mode 下执行，滑动时(tracking mode)不打扰
+    CFRunLoopAddObserver(CFRunLoopGetMain(), _idleObserver, kCFRunLoopDefaultMode);
+}
+
+- (void)stopIdleObserver {
+    if (_idleObserver) {
+        CFRunLoopRemoveObserver(CFRunLoopGetMain(), _idleObserver, kCFRunLoopDefaultMode);
+        CFRelease(_idleObserver);
+        _idleObserver = NULL;
+    }
+}
+
+- (double)msSince:(NSTimeInterval)time {
+    return ([[NSDate date] timeIntervalSince1970] - time) * 1000;
+}
+
+@end
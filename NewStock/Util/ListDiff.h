@@ -0,0 +1,77 @@
+//
+//  ListDiff.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <UIKit/UIKit.h>
+
+typedef id<NSCopying>(^ListDiffIdentifierBlock)(id object);
+
+typedef void(^ListDiffReconfigureBlock)(UITableViewCell *cell, NSIndexPath *indexPath);
+
+/**
+ *  两次列表数据的差异
+ *
+ *  同一标识的元素视为同一行，内容用 isEqual: 比较（MTLModel 逐个属性比较）。
+ */
+@interface ListDiffResult : NSObject
+
+//删除的行，旧数组下标
+@property (nonatomic, strong, readonly) NSIndexSet *deletes;
+
+//新增的行，新数组下标
+@property (nonatomic, strong, readonly) NSIndexSet *inserts;
+
+//移动的行，旧数组下标 -> 新数组下标；只因前面有增删而整体平移的行不算移动
+@property (nonatomic, strong, readonly) NSDictionary<NSNumber *, NSNumber *> *moves;
+
+//标识不变、内容有变化的行，新数组下标
+@property (nonatomic, strong, readonly) NSIndexSet *updates;
+
+@property (nonatomic, assign, readonly) BOOL hasChanges;
+
+/**
+ *  把差异应用到 tableView
+ *
+ *  调用前数据源须已换成新数组。增删和移动放在一次 beginUpdates/endUpdates 里，
+ *  内容变化的行不 reload，只对其中可见的 cell 调 reconfigure 重新填数据。
+ *  tableView 不在屏幕上时直接 reloadData。
+ */
+- (void)applyToTableView:(UITableView *)tableView section:(NSInteger)section reconfigure:(ListDiffReconfigureBlock)reconfigure;
+
+@end
+
+/**
+ *  列表 diff
+ *
+ *  按标识配对，O(n) 得出增删和内容变化，移动取最长递增子序列之外的行，O(n log n)。
+ *  同一标识出现多次时只有第一个参与配对，其余按增删处理。
+ */
+@interface ListDiff : NSObject
+
++ (ListDiffResult *)diffFromArray:(NSArray *)oldArray toArray:(NSArray *)newArray identifier:(ListDiffIdentifierBlock)identifier;
+
+//逐位比较，返回内容不同的下标；用于行位置固定、只替换内容的列表
++ (NSIndexSet *)changedIndexesFromArray:(NSArray *)oldArray toArray:(NSArray *)newArray;
+
+@end
+
+/**
+ *  把一帧内的多次刷新请求合并成一次
+ *
+ *  setNeedsUpdate 后在下一次屏幕刷新时执行一次 block，期间重复调用不会多执行。只在主线程使用。
+ */
+@interface ListUpdateCoalescer : NSObject
+
+- (instancetype)initWithBlock:(dispatch_block_t)block;
+
+- (void)setNeedsUpdate;
+
+//取消还没执行的一次
+- (void)cancel;
+
+@end
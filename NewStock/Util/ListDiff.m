@@ -0,0 +1,215 @@
+//
+//  ListDiff.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "ListDiff.h"
+#import <QuartzCore/QuartzCore.h>
+
+@interface ListDiffResult ()
+
+@property (nonatomic, strong, readwrite) NSIndexSet *deletes;
+@property (nonatomic, strong, readwrite) NSIndexSet *inserts;
+@property (nonatomic, strong, readwrite) NSDictionary<NSNumber *, NSNumber *> *moves;
+@property (nonatomic, strong, readwrite) NSIndexSet *updates;
+@property (nonatomic, assign) NSUInteger oldCount;
+
+@end
+
+@implementation ListDiffResult
+
+- (BOOL)hasChanges {
+    return _deletes.count || _inserts.count || _moves.count || _updates.count;
+}
+
+- (void)applyToTableView:(UITableView *)tableView section:(NSInteger)section reconfigure:(ListDiffReconfigureBlock)reconfigure {
+    if (!self.hasChanges) {
+        return;
+    }
+    //不在屏幕上没有动画可做；tableView 记录的行数和旧数组对不上时批量更新会抛异常
+    if (tableView.window == nil || [tableView numberOfRowsInSection:section] != _oldCount) {
+        [tableView reloadData];
+        return;
+    }
+
+    if (_deletes.count || _inserts.count || _moves.count) {
+        [tableView beginUpdates];
+        [tableView deleteRowsAtIndexPaths:[self private_indexPaths:_deletes section:section] withRowAnimation:UITableViewRowAnimationFade];
+        [tableView insertRowsAtIndexPaths:[self private_indexPaths:_inserts section:section] withRowAnimation:UITableViewRowAnimationFade];
+        [_moves enumerateKeysAndObjectsUsingBlock:^(NSNumber *from, NSNumber *to, BOOL *stop) {
+            [tableView moveRowAtIndexPath:[NSIndexPath indexPathForRow:from.integerValue inSection:section]
+                              toIndexPath:[NSIndexPath indexPathForRow:to.integerValue inSection:section]];
+        }];
+        [tableView endUpdates];
+    }
+
+    //不可见的行等滚动出来时由 cellForRowAtIndexPath: 按新数据填
+    if (reconfigure) {
+        [_updates enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+            NSIndexPath *indexPath = [NSIndexPath indexPathForRow:idx inSection:section];
+            UITableViewCell *cell = [tableView cellForRowAtIndexPath:indexPath];
+            if (cell) {
+                reconfigure(cell, indexPath);
+            }
+        }];
+    }
+}
+
+- (NSArray<NSIndexPath *> *)private_indexPaths:(NSIndexSet *)indexes section:(NSInteger)section {
+    NSMutableArray *indexPaths = [NSMutableArray arrayWithCapacity:indexes.count];
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        [indexPaths addObject:[NSIndexPath indexPathForRow:idx inSection:section]];
+    }];
+    return indexPaths;
+}
+
+@end
+
+@implementation ListDiff
+
++ (ListDiffResult *)diffFromArray:(NSArray *)oldArray toArray:(NSArray *)newArray identifier:(ListDiffIdentifierBlock)identifier {
+    NSMutableIndexSet *deletes = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *inserts = [NSMutableIndexSet indexSet];
+    NSMutableIndexSet *updates = [NSMutableIndexSet indexSet];
+    NSMutableDictionary *moves = [NSMutableDictionary dictionary];
+
+    //标识 -> 旧下标，配对后移除，剩下的就是删除的
+    NSMutableDictionary *oldIndexes = [NSMutableDictionary dictionaryWithCapacity:oldArray.count];
+    for (NSUInteger i = 0; i < oldArray.count; i++) {
+        id<NSCopying> key = identifier(oldArray[i]);
+        if (key == nil || oldIndexes[key]) {
+            [deletes addIndex:i];
+            continue;
+        }
+        oldIndexes[key] = @(i);
+    }
+
+    //按新数组顺序排列的配对
+    NSUInteger capacity = MIN(oldArray.count, newArray.count);
+    NSMutableArray<NSNumber *> *matchedOld = [NSMutableArray arrayWithCapacity:capacity];
+    NSMutableArray<NSNumber *> *matchedNew = [NSMutableArray arrayWithCapacity:capacity];
+    for (NSUInteger j = 0; j < newArray.count; j++) {
+        id<NSCopying> key = identifier(newArray[j]);
+        NSNumber *i = key ? oldIndexes[key] : nil;
+        if (i == nil) {
+            [inserts addIndex:j];
+            continue;
+        }
+        [oldIndexes removeObjectForKey:key];
+        [matchedOld addObject:i];
+        [matchedNew addObject:@(j)];
+        if (![oldArray[i.unsignedIntegerValue] isEqual:newArray[j]]) {
+            [updates addIndex:j];
+        }
+    }
+    for (NSNumber *i in oldIndexes.allValues) {
+        [deletes addIndex:i.unsignedIntegerValue];
+    }
+
+    //旧下标的最长递增子序列保持相对顺序，不用动；其余的是移动
+    NSIndexSet *stable = [self private_longestIncreasingSubsequence:matchedOld];
+    for (NSUInteger k = 0; k < matchedOld.count; k++) {
+        if (![stable containsIndex:k]) {
+            moves[matchedOld[k]] = matchedNew[k];
+        }
+    }
+
+    ListDiffResult *result = [ListDiffResult new];
+    result.deletes = deletes;
+    result.inserts = inserts;
+    result.moves = moves;
+    result.updates = updates;
+    result.oldCount = oldArray.count;
+    return result;
+}
+
++ (NSIndexSet *)changedIndexesFromArray:(NSArray *)oldArray toArray:(NSArray *)newArray {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    NSUInteger count = MAX(oldArray.count, newArray.count);
+    for (NSUInteger i = 0; i < count; i++) {
+        if (i >= oldArray.count || i >= newArray.count || ![oldArray[i] isEqual:newArray[i]]) {
+            [indexes addIndex:i];
+        }
+    }
+    return indexes;
+}
+
+//返回构成最长递增子序列的位置
++ (NSIndexSet *)private_longestIncreasingSubsequence:(NSArray<NSNumber *> *)values {
+    NSUInteger count = values.count;
+    NSMutableIndexSet *result = [NSMutableIndexSet indexSet];
+    if (count == 0) {
+        return result;
+    }
+
+    //tails[l]：长度为 l+1 的递增子序列中结尾值最小的那个的位置
+    NSUInteger *tails = malloc(count * sizeof(NSUInteger));
+    NSUInteger *previous = malloc(count * sizeof(NSUInteger));
+    NSUInteger length = 0;
+    for (NSUInteger k = 0; k < count; k++) {
+        NSUInteger value = values[k].unsignedIntegerValue;
+        NSUInteger low = 0, high = length;
+        while (low < high) {
+            NSUInteger mid = (low + high) / 2;
+            if (values[tails[mid]].unsignedIntegerValue < value) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        previous[k] = low > 0 ? tails[low - 1] : NSNotFound;
+        tails[low] = k;
+        if (low == length) {
+            length++;
+        }
+    }
+
+    for (NSUInteger k = tails[length - 1]; k != NSNotFound; k = previous[k]) {
+        [result addIndex:k];
+    }
+    free(tails);
+    free(previous);
+    return result;
+}
+
+@end
+
+@implementation ListUpdateCoalescer
+{
+    dispatch_block_t _block;
+    CADisplayLink *_displayLink;
+}
+
+- (instancetype)initWithBlock:(dispatch_block_t)block {
+    self = [super init];
+    if (self) {
+        _block = [block copy];
+    }
+    return self;
+}
+
+- (void)setNeedsUpdate {
+    if (_displayLink) {
+        return;
+    }
+    //displayLink 持有 self，执行或取消后就释放，不会循环引用
+    _displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(private_displayLinkFired:)];
+    [_displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+- (void)cancel {
+    [_displayLink invalidate];
+    _displayLink = nil;
+}
+
+- (void)private_displayLinkFired:(CADisplayLink *)displayLink {
+    [self cancel];
+    if (_block) {
+        _block();
+    }
+}
+
+@end
@@ -64,4 +64,7 @@
 
 + (float)getAppRefreshTime;
 
+//当前是否 WiFi 网络
++ (BOOL)isWiFi;
+
 @end
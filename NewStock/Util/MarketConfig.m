@@ -10,6 +10,7 @@
 #import "SystemUtil.h"
 #import "Defination.h"
 #import "Reachability.h"
+#import "CacheStore.h"
 
 
 @implementation MarketConfig
@@ -34,7 +35,7 @@
 }
 
 + (float)getRefreshTime {
-    float marketRefreshTime = [[SystemUtil getCache:@"marketRefreshTime"] floatValue];
+    float marketRefreshTime = [[CacheStore sharedCacheStore] floatForKey:@"marketRefreshTime"];
 
     if (marketRefreshTime>0) {
         return marketRefreshTime;
@@ -44,20 +45,21 @@
 }
 
 + (void)setRefreshTime:(float)f {
-    [SystemUtil putCache:@"marketRefreshTime" value:[NSString stringWithFormat:@"%f",f]];
+    [[CacheStore sharedCacheStore] setFloat:f forKey:@"marketRefreshTime"];
 }
 
 + (float)getAppRefreshTime {
     //判断是否wifi环境
-    Reachability *reach = [Reachability reachabilityForInternetConnection];
-    
-    NetworkStatus status = [reach currentReachabilityStatus];
-    
-    if (status == ReachableViaWiFi) {
+    if ([MarketConfig isWiFi]) {
         return DEFAULT_WIFI_REFRESH_TIME;
     }else {
         return [MarketConfig getRefreshTime];
     }
 }
 
++ (BOOL)isWiFi {
+    Reachability *reach = [Reachability reachabilityForInternetConnection];
+    return [reach currentReachabilityStatus] == ReachableViaWiFi;
+}
+
 @end
@@ -10,11 +10,21 @@
 #import "ARCSingletonTemplate.h"
 #import "StockCodesModel.h"
 
+/**
+ *  自选股同步
+ *
+ *  本地修改先写入操作日志(按用户分别持久化)，短时间内的多次修改合并后
+ *  用一次 add/del 或 reset 请求提交，失败按指数退避重试，连续失败多次后
+ *  暂停到下次修改或回到前台；服务端 4xx 拒绝的操作直接丢弃。
+ *  拉取服务端列表时会叠加尚未提交的操作，不会覆盖本地修改。
+ *  切换账号时原账号未提交的操作留在它自己的日志里，不会提交到新账号。
+ */
 @interface MyStockInfoInstance : NSObject
 SYNTHESIZE_SINGLETON_FOR_HEADER(MyStockInfoInstance)
 
 @property (nonatomic, strong) NSMutableArray <StockCodeInfo *> *myStockListArray;
 
+//callBack 在主线程回调，返回与本地未提交修改合并后的列表；本地列表更新时返回 nil
 - (void)getAllMyStock:(void(^)(NSArray *))callBack ;
 
 - (void)deleteStockWiths:(NSString *)s t:(NSString *)t m:(NSString *)m ;
@@ -26,4 +36,8 @@ SYNTHESIZE_SINGLETON_FOR_HEADER(MyStockInfoInstance)
 
 - (void)deleteStockWithArr:(NSArray<StockCodeInfo *> *)array;
 
+//立即提交未同步的操作
+- (void)flushPendingOperations;
+- (NSUInteger)pendingOperationCount;
+
 @end
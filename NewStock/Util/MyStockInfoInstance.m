@@ -12,112 +12,390 @@
 #import "DelMyStockAPI.h"
 #import "ResetMyStockAPI.h"
 #import "StockCodesModel.h"
+#import "StockListStore.h"
+#import "SystemUtil.h"
+#import "Defination.h"
 
-@interface MyStockInfoInstance ()
+//操作类型
+typedef NS_ENUM(NSInteger, MY_STOCK_OP) {
+    MY_STOCK_OP_ADD,
+    MY_STOCK_OP_DEL,
+    MY_STOCK_OP_REORDER
+};
+
+//最后一次修改后等待合并的时间
+static const NSTimeInterval kMyStockSyncDelay = 1.0;
+//重试间隔上限
+static const NSTimeInterval kMyStockSyncMaxRetryDelay = 60.0;
+//连续失败次数上限，超过后不再自动重试，等下次修改或回到前台
+static const NSInteger kMyStockSyncMaxRetryCount = 8;
 
-@property (nonatomic, strong) GetMyStockAPI *getMyStockAPI;
-@property (nonatomic, strong) AddMyStockAPI *addMyStockAPI;
-@property (nonatomic, strong) DelMyStockAPI *delMyStockAPI;
-@property (nonatomic, strong) ResetMyStockAPI *resetMyStockAPI;
+static NSString *myStockKey(NSString *s, NSString *t, NSString *m) {
+    return [NSString stringWithFormat:@"%@|%d|%d", s ?: @"", [m intValue], [t intValue]];
+}
 
+@interface MyStockInfoInstance ()
+{
+    dispatch_queue_t _syncQueue;
+    //当前操作日志所属用户，未登录为 @""
+    NSString *_owner;
+    //操作日志 @{@"op", @"seq", @"s", @"t", @"m", @"n"}
+    NSMutableArray<NSDictionary *> *_pendingOps;
+    long long _lastSeq;      //本地最新修改版本
+    long long _sendingSeq;   //正在提交的版本，0 表示空闲
+    long long _ackedSeq;     //服务端已确认的版本
+    NSInteger _retryCount;
+    NSInteger _flushToken;
+}
 @end
 
 @implementation MyStockInfoInstance
 SYNTHESIZE_SINGLETON_FOR_CLASS(MyStockInfoInstance)
 
-- (GetMyStockAPI *)getMyStockAPI {
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _syncQueue = dispatch_queue_create("com.newstock.mystock.sync", DISPATCH_QUEUE_SERIAL);
 
-    if (_getMyStockAPI == nil) {
-        _getMyStockAPI = [GetMyStockAPI new];
+        dispatch_async(_syncQueue, ^{
+            [self switchOwnerIfNeeded];
+        });
+
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(flushPendingOperations) name:UIApplicationDidBecomeActiveNotification object:nil];
     }
-    return _getMyStockAPI;
+    return self;
 }
 
-- (AddMyStockAPI *)addMyStockAPI {
+//每个用户一份操作日志，切换账号后不会把别人的修改提交到当前账号
+- (NSString *)opLogPathForOwner:(NSString *)owner {
+    NSString *pathOfLibrary = [NSSearchPathForDirectoriesInDomains(NSLibraryDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+    NSString *name = [NSString stringWithFormat:@"myStockOpLog_%@", owner.length ? owner : @"guest"];
+    return [pathOfLibrary stringByAppendingPathComponent:name];
+}
 
-    if (_addMyStockAPI == nil) {
-        _addMyStockAPI = [AddMyStockAPI new];
+- (NSString *)currentOwner {
+    if (![SystemUtil isSignIn]) {
+        return @"";
     }
-    return _addMyStockAPI;
+    return [SystemUtil getCache:USER_ID];
 }
 
-- (DelMyStockAPI *)delMyStockAPI {
-
-    if (_delMyStockAPI == nil) {
-        _delMyStockAPI = [DelMyStockAPI new];
+//在 _syncQueue 上执行。账号变化时原用户的日志留在它自己的文件里，换成新用户的日志
+- (void)switchOwnerIfNeeded {
+    NSString *owner = [self currentOwner];
+    if ([owner isEqualToString:_owner]) {
+        return;
     }
-    return _delMyStockAPI;
-}
+    _owner = owner;
+    _flushToken ++;
+    _sendingSeq = 0;
+    _ackedSeq = 0;
+    _retryCount = 0;
 
-- (ResetMyStockAPI *)resetMyStockAPI {
-    
-    if (_resetMyStockAPI == nil) {
-        _resetMyStockAPI = [[ResetMyStockAPI alloc]initWithArray:self.myStockListArray];
+    NSArray *ops = [NSArray arrayWithContentsOfFile:[self opLogPathForOwner:owner]];
+    _pendingOps = [NSMutableArray arrayWithArray:ops];
+    _lastSeq = [[_pendingOps.lastObject objectForKey:@"seq"] longLongValue];
+
+    if (_pendingOps.count) {
+        [self scheduleFlushAfter:kMyStockSyncDelay];
     }
-    return _resetMyStockAPI;
 }
 
+#pragma mark public
+
 - (void)getAllMyStock:(void (^)(NSArray *))callBack {
-    
-    [self.getMyStockAPI startWithCompletionBlockWithSuccess:^(__kindof APIBaseRequest *request) {
+
+    __block long long ackedSeq;
+    __block NSString *owner;
+    dispatch_sync(_syncQueue, ^{
+        [self switchOwnerIfNeeded];
+        ackedSeq = _ackedSeq;
+        owner = _owner;
+    });
+
+    GetMyStockAPI *getMyStockAPI = [GetMyStockAPI new];
+    [getMyStockAPI startWithCompletionBlockWithSuccess:^(__kindof APIBaseRequest *request) {
 //        NSLog(@"%@",request.responseJSONObject);
         NSArray *array = [MTLJSONAdapter modelsOfClass:[StockCodeInfo class] fromJSONArray:request.responseJSONObject error:nil];
-        callBack(array);
+        dispatch_async(_syncQueue, ^{
+            [self switchOwnerIfNeeded];
+            //拉取期间切换了账号，返回的是上一个账号的列表
+            NSArray *merged = [owner isEqualToString:_owner] ? [self reconcileServerStocks:array ackedSeq:ackedSeq] : nil;
+            dispatch_async(dispatch_get_main_queue(), ^{
+                callBack(merged);
+            });
+        });
     } failure:^(__kindof APIBaseRequest *request) {
-        NSLog(@"fail");
+        NSLog(@"get my stock fail:%@",request.requestOperationError);
     }];
 }
 
 - (void)deleteStockWiths:(NSString *)s t:(NSString *)t m:(NSString *)m {
-    self.delMyStockAPI.modelArray = nil;
-    self.delMyStockAPI.t = [NSString stringWithFormat:@"%lld",t.longLongValue];
-    self.delMyStockAPI.s = s;
-    self.delMyStockAPI.m = [NSString stringWithFormat:@"%lld",m.longLongValue];
-    [self.delMyStockAPI startWithCompletionBlockWithSuccess:^(__kindof APIBaseRequest *request) {
-//        NSLog(@"%@",request.responseJSONObject);
-    } failure:^(__kindof APIBaseRequest *request) {
-        NSLog(@"%@",request.responseString);
-    }];
+    StockCodeInfo *model = [[StockCodeInfo alloc] init];
+    model.s = s;
+    model.t = t;
+    model.m = m;
+    [self enqueueOperation:MY_STOCK_OP_DEL stocks:@[model]];
 }
 
 - (void)addStockWiths:(NSString *)s t:(NSString *)t m:(NSString *)m {
-
-    self.addMyStockAPI.t = [NSString stringWithFormat:@"%lld",t.longLongValue];
-    self.addMyStockAPI.s = s;
-    self.addMyStockAPI.m = [NSString stringWithFormat:@"%lld",m.longLongValue];
-    [self.addMyStockAPI startWithCompletionBlockWithSuccess:^(__kindof APIBaseRequest *request) {
-//        NSLog(@"%@",request.responseJSONObject);
-    } failure:^(__kindof APIBaseRequest *request) {
-        NSLog(@"fail");
-    }];
+    StockCodeInfo *model = [[StockCodeInfo alloc] init];
+    model.s = s;
+    model.t = t;
+    model.m = m;
+    [self enqueueOperation:MY_STOCK_OP_ADD stocks:@[model]];
 }
 
 - (void)deleteStockWith:(StockCodeInfo *)model {
-    [self deleteStockWiths:model.s t:model.t m:model.m];
+    [self enqueueOperation:MY_STOCK_OP_DEL stocks:@[model]];
 }
 
 - (void)deleteStockWithArr:(NSArray<StockCodeInfo *> *)array {
-    self.delMyStockAPI.modelArray = array;
-    [self.delMyStockAPI startWithCompletionBlockWithSuccess:^(__kindof APIBaseRequest *request) {
-        NSLog(@"%@",request.responseJSONObject);
-    } failure:^(__kindof APIBaseRequest *request) {
-        NSLog(@"%@",request.responseString);
-    }];
+    [self enqueueOperation:MY_STOCK_OP_DEL stocks:array];
 }
 
 - (void)addStockWith:(StockCodeInfo *)model {
-    [self addStockWiths:model.s t:model.t m:model.m];
+    [self enqueueOperation:MY_STOCK_OP_ADD stocks:@[model]];
 }
 
+//提交时以本地自选股列表的最新顺序为准
 - (void)resetStockWith:(NSArray<StockCodeInfo *> *)modelArray {
+    [self enqueueOperation:MY_STOCK_OP_REORDER stocks:nil];
+}
 
-    [self.resetMyStockAPI setMyStockArray:modelArray];
-    
-    [self.resetMyStockAPI startWithCompletionBlockWithSuccess:^(__kindof APIBaseRequest *request) {
-//        NSLog(@"%@",request.responseJSONObject);
-    } failure:^(__kindof APIBaseRequest *request) {
-        NSLog(@"fail");
+- (void)flushPendingOperations {
+    dispatch_async(_syncQueue, ^{
+        [self switchOwnerIfNeeded];
+        _retryCount = 0;
+        [self scheduleFlushAfter:0];
+    });
+}
+
+- (NSUInteger)pendingOperationCount {
+    __block NSUInteger count;
+    dispatch_sync(_syncQueue, ^{
+        [self switchOwnerIfNeeded];
+        count = _pendingOps.count;
+    });
+    return count;
+}
+
+#pragma mark operation log
+
+- (void)enqueueOperation:(MY_STOCK_OP)op stocks:(NSArray<StockCodeInfo *> *)stocks {
+    NSMutableArray *ops = [NSMutableArray array];
+    if (op == MY_STOCK_OP_REORDER) {
+        [ops addObject:@{@"op":@(op)}];
+    } else {
+        for (StockCodeInfo *model in stocks) {
+            [ops addObject:@{@"op":@(op),
+                             @"s":model.s ?: @"",
+                             @"t":[NSString stringWithFormat:@"%lld",model.t.longLongValue],
+                             @"m":[NSString stringWithFormat:@"%lld",model.m.longLongValue],
+                             @"n":model.n ?: @""}];
+        }
+    }
+    if (ops.count == 0) {
+        return;
+    }
+
+    dispatch_async(_syncQueue, ^{
+        [self switchOwnerIfNeeded];
+        for (NSDictionary *item in ops) {
+            NSMutableDictionary *dict = [item mutableCopy];
+            dict[@"seq"] = @(++_lastSeq);
+            [_pendingOps addObject:dict];
+        }
+        [self saveOperations];
+        [self scheduleFlushAfter:kMyStockSyncDelay];
+    });
+}
+
+//在 _syncQueue 上执行
+- (void)saveOperations {
+    NSString *path = [self opLogPathForOwner:_owner];
+    if (_pendingOps.count) {
+        [_pendingOps writeToFile:path atomically:YES];
+    } else {
+        [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+    }
+}
+
+//在 _syncQueue 上执行，新的调度会取消之前未执行的调度
+- (void)scheduleFlushAfter:(NSTimeInterval)delay {
+    NSInteger token = ++_flushToken;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), _syncQueue, ^{
+        if (token == _flushToken) {
+            [self flush];
+        }
+    });
+}
+
+//在 _syncQueue 上执行
+- (void)flush {
+    [self switchOwnerIfNeeded];
+    //未登录时的修改先留着，不提交
+    if (_sendingSeq || _pendingOps.count == 0 || _owner.length == 0) {
+        return;
+    }
+
+    //按股票合并：先加后删抵消，先删后加需要重排
+    BOOL needReset = NO;
+    NSMutableDictionary<NSString *, NSDictionary *> *firstOps = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSString *, NSDictionary *> *lastOps = [NSMutableDictionary dictionary];
+    NSMutableArray<NSString *> *keys = [NSMutableArray array];
+    for (NSDictionary *op in _pendingOps) {
+        if ([op[@"op"] integerValue] == MY_STOCK_OP_REORDER) {
+            needReset = YES;
+            continue;
+        }
+        NSString *key = myStockKey(op[@"s"], op[@"t"], op[@"m"]);
+        if (!firstOps[key]) {
+            firstOps[key] = op;
+            [keys addObject:key];
+        }
+        lastOps[key] = op;
+    }
+
+    NSMutableArray<StockCodeInfo *> *adds = [NSMutableArray array];
+    NSMutableArray<StockCodeInfo *> *dels = [NSMutableArray array];
+    for (NSString *key in keys) {
+        MY_STOCK_OP first = [firstOps[key][@"op"] integerValue];
+        MY_STOCK_OP last = [lastOps[key][@"op"] integerValue];
+        if (first == MY_STOCK_OP_ADD && last == MY_STOCK_OP_ADD) {
+            [adds addObject:[self stockWithOperation:lastOps[key]]];
+        } else if (first == MY_STOCK_OP_DEL && last == MY_STOCK_OP_DEL) {
+            [dels addObject:[self stockWithOperation:lastOps[key]]];
+        } else if (first == MY_STOCK_OP_DEL && last == MY_STOCK_OP_ADD) {
+            needReset = YES;
+        }
+    }
+    if (adds.count && dels.count) {
+        needReset = YES;
+    }
+
+    long long seq = _lastSeq;
+    APIRequest *syncRequest = nil;
+    if (needReset) {
+        syncRequest = [[ResetMyStockAPI alloc] initWithArray:[[StockListStore myStockStore] allStocks]];
+    } else if (adds.count) {
+        AddMyStockAPI *addMyStockAPI = [AddMyStockAPI new];
+        addMyStockAPI.modelArray = adds;
+        syncRequest = addMyStockAPI;
+    } else if (dels.count) {
+        DelMyStockAPI *delMyStockAPI = [DelMyStockAPI new];
+        delMyStockAPI.modelArray = dels;
+        syncRequest = delMyStockAPI;
+    }
+
+    if (syncRequest == nil) {
+        //全部相互抵消
+        [self acknowledgeSeq:seq];
+        return;
+    }
+
+    _sendingSeq = seq;
+    NSString *owner = _owner;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [syncRequest startWithCompletionBlockWithSuccess:^(__kindof APIBaseRequest *request) {
+            dispatch_async(_syncQueue, ^{
+                //提交期间切换了账号，结果不属于当前日志
+                if (![owner isEqualToString:_owner]) {
+                    return;
+                }
+                _retryCount = 0;
+                [self acknowledgeSeq:seq];
+            });
+        } failure:^(__kindof APIBaseRequest *request) {
+            NSInteger statusCode = request.responseStatusCode;
+            NSLog(@"sync my stock fail:%ld %@",(long)statusCode,request.requestOperationError);
+            dispatch_async(_syncQueue, ^{
+                if (![owner isEqualToString:_owner]) {
+                    return;
+                }
+                //服务端明确拒绝的请求重试也不会成功，丢弃这批操作
+                if ([self isPermanentFailure:statusCode]) {
+                    _retryCount = 0;
+                    [self acknowledgeSeq:seq];
+                    return;
+                }
+                _sendingSeq = 0;
+                _retryCount ++;
+                if (_retryCount > kMyStockSyncMaxRetryCount) {
+                    return;
+                }
+                [self scheduleFlushAfter:MIN(pow(2, _retryCount), kMyStockSyncMaxRetryDelay)];
+            });
+        }];
+    });
+}
+
+//4xx 中除登录失效、超时和限流外都视为永久失败
+- (BOOL)isPermanentFailure:(NSInteger)statusCode {
+    if (statusCode < 400 || statusCode >= 500) {
+        return NO;
+    }
+    return statusCode != 401 && statusCode != 408 && statusCode != 429;
+}
+
+//在 _syncQueue 上执行
+- (void)acknowledgeSeq:(long long)seq {
+    NSIndexSet *indexes = [_pendingOps indexesOfObjectsPassingTest:^BOOL(NSDictionary *op, NSUInteger idx, BOOL *stop) {
+        return [op[@"seq"] longLongValue] <= seq;
     }];
+    [_pendingOps removeObjectsAtIndexes:indexes];
+    _ackedSeq = MAX(_ackedSeq, seq);
+    _sendingSeq = 0;
+    [self saveOperations];
+
+    if (_pendingOps.count) {
+        [self scheduleFlushAfter:kMyStockSyncDelay];
+    }
+}
+
+- (StockCodeInfo *)stockWithOperation:(NSDictionary *)op {
+    StockCodeInfo *model = [[StockCodeInfo alloc] init];
+    model.s = op[@"s"];
+    model.t = op[@"t"];
+    model.m = op[@"m"];
+    model.n = op[@"n"];
+    return model;
+}
+
+//在 _syncQueue 上执行，返回 nil 表示以本地列表为准
+- (NSArray *)reconcileServerStocks:(NSArray<StockCodeInfo *> *)array ackedSeq:(long long)ackedSeq {
+    if (array == nil) {
+        return nil;
+    }
+    //拉取期间有修改提交成功，服务端返回的是旧版本
+    if (_ackedSeq != ackedSeq) {
+        return nil;
+    }
+    if (_pendingOps.count == 0 && _sendingSeq == 0) {
+        return array;
+    }
+    //有重排或正在提交，本地列表即将推送到服务端
+    if (_sendingSeq) {
+        return nil;
+    }
+
+    NSMutableArray<StockCodeInfo *> *merged = [NSMutableArray arrayWithArray:array];
+    for (NSDictionary *op in _pendingOps) {
+        MY_STOCK_OP type = [op[@"op"] integerValue];
+        if (type == MY_STOCK_OP_REORDER) {
+            return nil;
+        }
+        NSString *key = myStockKey(op[@"s"], op[@"t"], op[@"m"]);
+        NSUInteger index = [merged indexOfObjectPassingTest:^BOOL(StockCodeInfo *item, NSUInteger idx, BOOL *stop) {
+            return [myStockKey(item.s, item.t, item.m) isEqualToString:key];
+        }];
+        if (type == MY_STOCK_OP_DEL && index != NSNotFound) {
+            [merged removeObjectAtIndex:index];
+        } else if (type == MY_STOCK_OP_ADD && index == NSNotFound) {
+            [merged insertObject:[self stockWithOperation:op] atIndex:0];
+        }
+    }
+    return merged;
 }
 
 @end
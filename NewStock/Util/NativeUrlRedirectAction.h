@@ -13,6 +13,9 @@
 
 SYNTHESIZE_SINGLETON_FOR_HEADER(NativeUrlRedirectAction)
 
+//把 native:// 路由注册到 sharedURLRouter，启动时调用一次
++ (void)registerRoutes;
+
 - (void)redictNativeUrl:(NSString *)url;
 
 + (void)nativePushToStock:(NSString *)n s:(NSString *)s t:(NSString *)t m:(NSString *)m;
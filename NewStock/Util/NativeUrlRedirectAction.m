@@ -46,6 +46,7 @@
 #import "SharedInstance.h"
 #import "MsgAlertPopView.h"
 #import "BigVPopView.h"
+#import "URLRouter.h"
 #import <TKOpen/TKOpen.h>
 
 @interface NativeUrlRedirectAction ()<MsgAlertPopViewDelegate,BigVPopViewDelegate>
@@ -58,232 +59,213 @@
 
 @property (nonatomic, strong) AppDelegate *appDelegate;
 
+@property (nonatomic, strong) URLRouter *pageRouter;
+
 @end
 
 @implementation NativeUrlRedirectAction
 SYNTHESIZE_SINGLETON_FOR_CLASS(NativeUrlRedirectAction)
 
-- (void)redictNativeUrl:(NSString *)url {
-    NSLog(@"%@",url);
-    
-    AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-    WXTabBarController *tabbarVC = appDelegate.tabBarController;
++ (void)registerRoutes {
+    URLRouter *router = [URLRouter sharedURLRouter];
     
-    if ([url hasPrefix:@"native://"]) {
-        
-        NSString *subUrl = [url substringFromIndex:9];
-        
-        if ([subUrl hasPrefix:@"Alert?"]) {
-            NSString *subStr = [subUrl substringFromIndex:6];
-            [self dealWithAlert:subStr];
+    [router registerPattern:@"native://Alert" handler:^(URLRouteMatch *match) {
+        [[self sharedNativeUrlRedirectAction] dealWithAlert:match.query];
+    }];
+    [router registerPattern:@"native://HQ0001" handler:^(URLRouteMatch *match) {
+        WXTabBarController *tabbarVC = [self private_popToTabBar];
+        OptionalViewController *optVC = (OptionalViewController *)tabbarVC.backingViewControllers[1];
+        optVC.hangQing = 1;
+        [tabbarVC.tab btnClick:tabbarVC.tab.btn2];
+    }];
+    [router registerPattern:@"native://TG0100" handler:^(URLRouteMatch *match) {
+        [self private_push:[TaoSearchPeopleViewController new]];
+    }];
+    [router registerPattern:@"native://TG0200" handler:^(URLRouteMatch *match) {
+        [self private_push:[TigerSearchViewController new]];
+    }];
+    [router registerPattern:@"native://HQ1000" handler:^(URLRouteMatch *match) {
+        NSString *marketCd = match[@"marketCd"];
+        NSString *symbol = match[@"symbol"];
+        NSString *symbolTyp = match[@"symbolTyp"];
+        if (!(marketCd && symbol && symbolTyp)) {
             return;
         }
+        [self nativePushToStock:@"" s:symbol t:symbolTyp m:marketCd];
+    }];
+    [router registerPattern:@"native://Board" handler:^(URLRouteMatch *match) {
+        BoardListModel *model = [[BoardListModel alloc] init];
+        model.marketCd = match[@"marketCd"];
+        model.symbol = match[@"symbol"];
+        model.industryName = match[@"industryName"];
+        model.symbolTyp = match[@"symbolTyp"];
         
-        if ([subUrl isEqualToString:@"HQ0001"]) {
-            [appDelegate.navigationController popToRootViewControllerAnimated:NO];
-            OptionalViewController *optVC = (OptionalViewController *)tabbarVC.backingViewControllers[1];
-            optVC.hangQing = 1;
-            [tabbarVC.tab btnClick:tabbarVC.tab.btn2];
-        } else if ([subUrl isEqualToString:@"TG0100"]) {
-            TaoSearchPeopleViewController *vc = [TaoSearchPeopleViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl isEqualToString:@"TG0200"]) {
-            TigerSearchViewController *vc = [TigerSearchViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"HQ1000"]) {
-            NSDictionary *dic = [UrlRedirectAction parseURLParams:[subUrl substringFromIndex:7]];
-            NSString *symbolTyp = [dic objectForKey:@"symbolTyp"];
-            if (([symbolTyp intValue] == 1) || ([symbolTyp intValue] == 2)) {
-                IndexChartViewController *viewController = [[IndexChartViewController alloc] init];
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                IndexInfoModel *model = [[IndexInfoModel alloc] init];
-                model.marketCd = [dic objectForKey:@"marketCd"];
-                model.symbol = [dic objectForKey:@"symbol"];
-                model.symbolName = @"";
-                model.symbolTyp = [dic objectForKey:@"symbolTyp"];
-                
-                viewController.indexModel = model;
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
-            } else {
-                StockListModel *model = [[StockListModel alloc] init];
-                model.marketCd = [dic objectForKey:@"marketCd"];
-                model.symbol = [dic objectForKey:@"symbol"];
-                model.symbolName = @"";
-                model.symbolTyp = [dic objectForKey:@"symbolTyp"];
-                
-                StockChartViewController *viewController = [[StockChartViewController alloc] init];
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                viewController.stockListModel = model;
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
-            }
-        } else if ([subUrl hasPrefix:@"Board"]) {
-            NSDictionary *dic = [UrlRedirectAction parseURLParams:[subUrl substringFromIndex:6]];
-            BoardDetailListViewController *viewController = [[BoardDetailListViewController alloc] init];
-            AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-            
-            BoardListModel *model = [[BoardListModel alloc] init];
-            model.marketCd = [dic objectForKey:@"marketCd"];
-            model.symbol = [dic objectForKey:@"symbol"];
-            model.industryName = [dic objectForKey:@"industryName"];
-            model.symbolTyp = [dic objectForKey:@"symbolTyp"];
-            
-            NSAssert(model.symbol.length != 0, @"缺少板块代码");
-            
-            viewController.title = model.industryName;
-            viewController.boardListModel = model;
-            [appDelegate.navigationController pushViewController:viewController animated:YES];
-        } else if ([subUrl hasPrefix:@"Login"]) {
-            if ([SystemUtil isSignIn]) {
-                return;
-            }
-            LoginViewController *loginViewController = [[LoginViewController alloc] init];
-            AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-            [appDelegate.navigationController pushViewController:loginViewController animated:YES];
-        } else if ([subUrl hasPrefix:@"CM0103"]) {
-            TipOffViewController *viewController = [[TipOffViewController alloc] init];
-            NSString *subStr = [subUrl substringFromIndex:10];
-            viewController.contentId = subStr;
-            viewController.ty = @"S_COMMENT";
-            AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-            [appDelegate.navigationController pushViewController:viewController animated:YES];
-        } else if ([subUrl hasPrefix:@"FM0100"]) {
-            NSLog(@"帖子列表");
-            [appDelegate.navigationController popToRootViewControllerAnimated:NO];
-            NewMomentViewController *momentVC = (NewMomentViewController *)tabbarVC.backingViewControllers[3];
-            momentVC.nativePush = 1;
-            [tabbarVC.tab btnClick:tabbarVC.tab.btn4];
-        } else if ([subUrl hasPrefix:@"FM0400"]) {
-            NSLog(@"匿名列表");
-//            [appDelegate.navigationController popToRootViewControllerAnimated:NO];
-//            NewMomentViewController *momentVC = (NewMomentViewController *)tabbarVC.backingViewControllers[3];
-//            momentVC.nativePush = 2;
-//            [tabbarVC.tab btnClick:tabbarVC.tab.btn4];
-        } else if ([subUrl hasPrefix:@"FM0500"]) {
-            NSLog(@"快讯列表");
-            [appDelegate.navigationController popToRootViewControllerAnimated:NO];
-            NewMomentViewController *momentVC = (NewMomentViewController *)tabbarVC.backingViewControllers[3];
-            momentVC.nativePush = 3;
-            [tabbarVC.tab btnClick:tabbarVC.tab.btn4];
-        } else if ([subUrl hasPrefix:@"TG0001"]) {
-            NSLog(@"淘牛股");
-            [appDelegate.navigationController popToRootViewControllerAnimated:NO];
-            [tabbarVC.tab btnClick:tabbarVC.tab.btn3];
-        } else if ([subUrl hasPrefix:@"TG0300"]) {
-            NSLog(@"深度龙虎榜");
-            TaoDeepTigerViewController *vc = [TaoDeepTigerViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"MF0101"]) {
-            NSLog(@"主力股票池");
-            TaoZhuLiStockListViewController *vc = [TaoZhuLiStockListViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"DB0001"]) {
-            NSLog(@"db1");
-            TaoLimitAnalysisViewController *vc = [TaoLimitAnalysisViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"DB0002"]) {
-            NSLog(@"db2");
-            TaoContinueLimitCatchViewController *vc = [TaoContinueLimitCatchViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"DB0003"]) {
-            NSLog(@"db3");
-            TaoCXZYViewController *vc = [TaoCXZYViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"DB0004"]) {
-            NSLog(@"db4");
-            TaoNewStockPoolViewController *vc = [TaoNewStockPoolViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"ZX0200"]) {
-            NSLog(@"自选资讯");
-            if ([SystemUtil isSignIn]) {
-                MyStockOptionalViewController *vc = [MyStockOptionalViewController new];
-                vc.pushIndex = 1;
-                [appDelegate.navigationController pushViewController:vc animated:YES];
-            } else {
-                [appDelegate.navigationController pushViewController:[LoginViewController new] animated:YES];
-            }
-        } else if ([subUrl hasPrefix:@"HQ1003"]) {
-            NSLog(@"自选公告");
-            if ([SystemUtil isSignIn]) {
-                MyStockOptionalViewController *vc = [MyStockOptionalViewController new];
-                vc.pushIndex = 2;
-                [appDelegate.navigationController pushViewController:vc animated:YES];
-            } else {
-                [appDelegate.navigationController pushViewController:[LoginViewController new] animated:YES];
-            }
-        } else if ([subUrl hasPrefix:@"UpdateIcon"]) {
-            NSLog(@"更换头像");
-            if ([SystemUtil isSignIn]) {
-                ChangeHeadViewController *vc = [ChangeHeadViewController new];
-                vc.headerImgUrl = [UserInfoInstance sharedUserInfoInstance].userInfoModel.origin;
-                [appDelegate.navigationController pushViewController:vc animated:YES];
-            } else {
-                [appDelegate.navigationController pushViewController:[LoginViewController new] animated:YES];
-            }
-        } else if ([subUrl hasPrefix:@"UpdateName"]) {
-            NSLog(@"更改昵称");
-            if ([SystemUtil isSignIn]) {
-                ReviseNameViewController *vc = [ReviseNameViewController new];
-                vc.nickName = [UserInfoInstance sharedUserInfoInstance].userInfoModel.n;
-                [appDelegate.navigationController pushViewController:vc animated:YES];
-            } else {
-                [appDelegate.navigationController pushViewController:[LoginViewController new] animated:YES];
-            }
-        } else if ([subUrl hasPrefix:@"Register"]) {
-            NSLog(@"注册");
-            RegisterViewController *vc = [RegisterViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"PubDisclose"]) {
-            NSLog(@"发匿名");
-            if ([SystemUtil isSignIn]) {
-                PostSecretViewController *viewController = [[PostSecretViewController alloc] init];
-                UINavigationController *nav = [[UINavigationController alloc] initWithRootViewController:viewController];
-                [appDelegate.navigationController presentViewController:nav animated:YES completion:^{}];
-            } else {
-                [appDelegate.navigationController pushViewController:[LoginViewController new] animated:YES];
-            }
-        } else if ([subUrl hasPrefix:@"ShareApp"]) {
-            NSLog(@"分享APP");
-            [self shareToFriend];
-        } else if ([subUrl hasPrefix:@"PubForum"]) {
-            NSLog(@"发帖");
-            if ([SystemUtil isSignIn]) {
-                if ([UserInfoInstance sharedUserInfoInstance].userInfoModel.aty.integerValue == 3 || [UserInfoInstance sharedUserInfoInstance].userInfoModel.aty.integerValue == 4) {
-                    PostViewController *viewController = [[PostViewController alloc] init];
-                    UINavigationController *nav = [[UINavigationController alloc] initWithRootViewController:viewController];
-                    [appDelegate.navigationController presentViewController:nav animated:YES completion:^{}];
-                }
-            } else {
-                [appDelegate.navigationController pushViewController:[LoginViewController new] animated:YES];
-            }
-        } else if ([subUrl hasPrefix:@"ApplyNewStock"]) {
-            NewStockCalenderViewController *vc = [NewStockCalenderViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"ApplyV"]) {
-            NSLog(@"applyv");
-            [self popBigV];
-        } else if ([subUrl hasPrefix:@"MY0600"]) {
-            if ([SystemUtil isSignIn]) {
-                [appDelegate.navigationController pushViewController:[ScoreTaskViewController new] animated:YES];
-            } else {
-                [appDelegate.navigationController pushViewController:[LoginViewController new] animated:YES];
+        BoardDetailListViewController *viewController = [[BoardDetailListViewController alloc] init];
+        viewController.title = model.industryName;
+        viewController.boardListModel = model;
+        [self private_push:viewController];
+    }];
+    [router registerPattern:@"native://Login" handler:^(URLRouteMatch *match) {
+        if ([SystemUtil isSignIn]) {
+            return;
+        }
+        [self private_push:[LoginViewController new]];
+    }];
+    [router registerPattern:@"native://Draft" handler:^(URLRouteMatch *match) {
+        PostViewController *viewController = [[PostViewController alloc] init];
+        viewController.fid = match[@"id"];
+        viewController.titleStr = match[@"tt"];
+        viewController.contentStr = match[@"c"];
+        viewController.stag_code = match[@"stag_code"];
+        viewController.ams = match[@"ams"];
+        [[self private_navigationController] presentViewController:viewController animated:YES completion:^{}];
+    }];
+    [router registerPattern:@"native://FM0102" handler:^(URLRouteMatch *match) {
+        if ([self private_checkSignIn]) {
+            UINavigationController *nav = [[UINavigationController alloc] initWithRootViewController:[PostViewController new]];
+            [[self private_navigationController] presentViewController:nav animated:YES completion:^{}];
+        }
+    }];
+    [router registerPattern:@"native://CM0103" handler:^(URLRouteMatch *match) {
+        //native://CM0103?id=xxx，取第一个 = 之后的全部内容
+        NSRange range = [match.query rangeOfString:@"="];
+        TipOffViewController *viewController = [[TipOffViewController alloc] init];
+        viewController.contentId = range.location == NSNotFound ? @"" : [match.query substringFromIndex:NSMaxRange(range)];
+        viewController.ty = @"S_COMMENT";
+        [self private_push:viewController];
+    }];
+    [router registerPattern:@"native://FM0100" handler:^(URLRouteMatch *match) {
+        //帖子列表
+        WXTabBarController *tabbarVC = [self private_popToTabBar];
+        NewMomentViewController *momentVC = (NewMomentViewController *)tabbarVC.backingViewControllers[3];
+        momentVC.nativePush = 1;
+        [tabbarVC.tab btnClick:tabbarVC.tab.btn4];
+    }];
+    [router registerPattern:@"native://FM0400" handler:^(URLRouteMatch *match) {
+        //匿名列表，暂不跳转
+    }];
+    [router registerPattern:@"native://FM0500" handler:^(URLRouteMatch *match) {
+        //快讯列表
+        WXTabBarController *tabbarVC = [self private_popToTabBar];
+        NewMomentViewController *momentVC = (NewMomentViewController *)tabbarVC.backingViewControllers[3];
+        momentVC.nativePush = 3;
+        [tabbarVC.tab btnClick:tabbarVC.tab.btn4];
+    }];
+    [router registerPattern:@"native://TG0001" handler:^(URLRouteMatch *match) {
+        //淘牛股
+        WXTabBarController *tabbarVC = [self private_popToTabBar];
+        [tabbarVC.tab btnClick:tabbarVC.tab.btn3];
+    }];
+    [router registerPattern:@"native://TG0300" handler:^(URLRouteMatch *match) {
+        //深度龙虎榜
+        [self private_push:[TaoDeepTigerViewController new]];
+    }];
+    [router registerPattern:@"native://MF0101" handler:^(URLRouteMatch *match) {
+        //主力股票池
+        [self private_push:[TaoZhuLiStockListViewController new]];
+    }];
+    [router registerPattern:@"native://DB0001" handler:^(URLRouteMatch *match) {
+        [self private_push:[TaoLimitAnalysisViewController new]];
+    }];
+    [router registerPattern:@"native://DB0002" handler:^(URLRouteMatch *match) {
+        [self private_push:[TaoContinueLimitCatchViewController new]];
+    }];
+    [router registerPattern:@"native://DB0003" handler:^(URLRouteMatch *match) {
+        [self private_push:[TaoCXZYViewController new]];
+    }];
+    [router registerPattern:@"native://DB0004" handler:^(URLRouteMatch *match) {
+        [self private_push:[TaoNewStockPoolViewController new]];
+    }];
+    [router registerPattern:@"native://ZX0200" handler:^(URLRouteMatch *match) {
+        //自选资讯
+        if ([self private_checkSignIn]) {
+            MyStockOptionalViewController *vc = [MyStockOptionalViewController new];
+            vc.pushIndex = 1;
+            [self private_push:vc];
+        }
+    }];
+    [router registerPattern:@"native://HQ1003" handler:^(URLRouteMatch *match) {
+        //自选公告
+        if ([self private_checkSignIn]) {
+            MyStockOptionalViewController *vc = [MyStockOptionalViewController new];
+            vc.pushIndex = 2;
+            [self private_push:vc];
+        }
+    }];
+    [router registerPattern:@"native://UpdateIcon" handler:^(URLRouteMatch *match) {
+        //更换头像
+        if ([self private_checkSignIn]) {
+            ChangeHeadViewController *vc = [ChangeHeadViewController new];
+            vc.headerImgUrl = [UserInfoInstance sharedUserInfoInstance].userInfoModel.origin;
+            [self private_push:vc];
+        }
+    }];
+    [router registerPattern:@"native://UpdateName" handler:^(URLRouteMatch *match) {
+        //更改昵称
+        if ([self private_checkSignIn]) {
+            ReviseNameViewController *vc = [ReviseNameViewController new];
+            vc.nickName = [UserInfoInstance sharedUserInfoInstance].userInfoModel.n;
+            [self private_push:vc];
+        }
+    }];
+    [router registerPattern:@"native://Register" handler:^(URLRouteMatch *match) {
+        [self private_push:[RegisterViewController new]];
+    }];
+    [router registerPattern:@"native://PubDisclose" handler:^(URLRouteMatch *match) {
+        //发匿名
+        if ([self private_checkSignIn]) {
+            UINavigationController *nav = [[UINavigationController alloc] initWithRootViewController:[PostSecretViewController new]];
+            [[self private_navigationController] presentViewController:nav animated:YES completion:^{}];
+        }
+    }];
+    [router registerPattern:@"native://ShareApp" handler:^(URLRouteMatch *match) {
+        [[self sharedNativeUrlRedirectAction] shareToFriend];
+    }];
+    [router registerPattern:@"native://PubForum" handler:^(URLRouteMatch *match) {
+        //发帖，只有大V可以发
+        if ([self private_checkSignIn]) {
+            NSInteger aty = [UserInfoInstance sharedUserInfoInstance].userInfoModel.aty.integerValue;
+            if (aty == 3 || aty == 4) {
+                UINavigationController *nav = [[UINavigationController alloc] initWithRootViewController:[PostViewController new]];
+                [[self private_navigationController] presentViewController:nav animated:YES completion:^{}];
             }
-        } else if ([subUrl hasPrefix:@"MY0700"]) {
-            AuthorViewController *vc = [AuthorViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"TH0001"]) {
-            MainThemeViewController *vc = [MainThemeViewController new];
-            vc.ids = [self getPara:@"id" andUrl:[subUrl substringFromIndex:7]];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"TH0000"]) {
-            HotThemeListViewController *vc = [HotThemeListViewController new];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        } else if ([subUrl hasPrefix:@"OpenAccount"]) {
-            TKOpenController *vc = [[TKOpenController alloc] initWithParams:[NSDictionary dictionaryWithObjectsAndKeys:DGZQ_OPENURL,@"h5Url", nil]];//@"channel_url"
-            vc.statusBarBgColor = kUIColorFromRGB(0x00A9FF);
-            vc.statusBarStyle = UIStatusBarStyleLightContent;
-            [appDelegate.navigationController pushViewController:vc animated:YES];
         }
-        
+    }];
+    [router registerPattern:@"native://ApplyNewStock" handler:^(URLRouteMatch *match) {
+        [self private_push:[NewStockCalenderViewController new]];
+    }];
+    [router registerPattern:@"native://ApplyV" handler:^(URLRouteMatch *match) {
+        [[self sharedNativeUrlRedirectAction] popBigV];
+    }];
+    [router registerPattern:@"native://MY0600" handler:^(URLRouteMatch *match) {
+        if ([self private_checkSignIn]) {
+            [self private_push:[ScoreTaskViewController new]];
+        }
+    }];
+    [router registerPattern:@"native://MY0700" handler:^(URLRouteMatch *match) {
+        [self private_push:[AuthorViewController new]];
+    }];
+    [router registerPattern:@"native://TH0001" handler:^(URLRouteMatch *match) {
+        MainThemeViewController *vc = [MainThemeViewController new];
+        vc.ids = match[@"id"] ?: @"";
+        [self private_push:vc];
+    }];
+    [router registerPattern:@"native://TH0000" handler:^(URLRouteMatch *match) {
+        [self private_push:[HotThemeListViewController new]];
+    }];
+    [router registerPattern:@"native://OpenAccount" handler:^(URLRouteMatch *match) {
+        TKOpenController *vc = [[TKOpenController alloc] initWithParams:[NSDictionary dictionaryWithObjectsAndKeys:DGZQ_OPENURL,@"h5Url", nil]];//@"channel_url"
+        vc.statusBarBgColor = kUIColorFromRGB(0x00A9FF);
+        vc.statusBarStyle = UIStatusBarStyleLightContent;
+        [self private_push:vc];
+    }];
+}
+
+- (void)redictNativeUrl:(NSString *)url {
+    NSLog(@"%@",url);
+    
+    if ([url hasPrefix:@"native://"] || [url hasPrefix:@"component://"]) {
+        [[URLRouter sharedURLRouter] routeURLString:url];
     } else if ([url hasPrefix:@"./"]) {
         url = [url stringByReplacingOccurrencesOfString:@"./" withString:API_URL];
         [self jumpUrl:url];
@@ -310,86 +292,16 @@ SYNTHESIZE_SINGLETON_FOR_CLASS(NativeUrlRedirectAction)
         NSString *urlStr = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
         viewController.myUrl = urlStr;
         [appDelegate.navigationController pushViewController:viewController animated:YES];
-        
-    } else if ([url containsString:@"HP0105"]) {
-        
-        WebViewController *viewController = [[WebViewController alloc]init];
-        viewController.myUrl = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-        viewController.type = WEB_VIEW_TYPE_ZIXUN;
-        viewController.hasParam = YES;
-        [appDelegate.navigationController pushViewController:viewController animated:YES];
-        
-    } else if ([url containsString:@"HQ1009"] || [url containsString:@"HQ1008"] || [url containsString:@"HQ1007"] || [url containsString:@"HQ1003"]) {
-        
-        WebViewController *viewController = [[WebViewController alloc]init];
-        viewController.myUrl = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-        viewController.type = WEB_VIEW_TYPE_OTHER;
-        [appDelegate.navigationController pushViewController:viewController animated:YES];
-        
-    } else if ([url containsString:@"FM0301"]) {
-        
-        WebViewController *viewController = [[WebViewController alloc]init];
-        viewController.myUrl = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-        viewController.type = WEB_VIEW_TYPE_BAGUA;
-        [appDelegate.navigationController pushViewController:viewController animated:YES];
-        
-    } else if ([url containsString:@"FM0501"]) {
-        
-        WebViewController *viewController = [[WebViewController alloc]init];
-        viewController.myUrl = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-        viewController.type = WEB_VIEW_TYPE_SHARE;
-        [appDelegate.navigationController pushViewController:viewController animated:YES];
-        
-    } else if ([url containsString:@"MY9902"]) {
-        
-        WebViewController *viewController = [[WebViewController alloc]init];
-        viewController.myUrl = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-        viewController.type = WEB_VIEW_TYPE_PERSONAL;
-        [appDelegate.navigationController pushViewController:viewController animated:YES];
-        
-    } else if ([url containsString:@"MY0500"]) {
-        
-        FollowAndFansController *ffvc = [FollowAndFansController new];
-        ffvc.url0500 = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-        ffvc.view.backgroundColor = [UIColor whiteColor];
-        ffvc.segmentedControl.selectedSegmentIndex = 0;
-        [appDelegate.navigationController pushViewController:ffvc animated:YES];
-        
-    } else if ([url containsString:@"MY0501"]) {
-        
-        FollowAndFansController *ffvc = [FollowAndFansController new];
-        ffvc.url0501 = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-        ffvc.view.backgroundColor = [UIColor whiteColor];
-        ffvc.segmentedControl.selectedSegmentIndex = 1;
-        [appDelegate.navigationController pushViewController:ffvc animated:YES];
-        
-    } else if ([url containsString:@"FM0101"] || [url containsString:@"FM0401"]) {
-        
-        DetailWebViewController *vc = [DetailWebViewController new];
-        vc.type = WEB_VIEW_TYPE_COMMENT;
-        vc.myUrl = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-        [appDelegate.navigationController pushViewController:vc animated:YES];
-        
-    } else if ([url containsString:@"DW1001"]) {
-        
-        WebViewController *viewController = [[WebViewController alloc] init];
-        viewController.myUrl = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-        viewController.type = WEB_VIEW_TYPE_SHARE;
-        [appDelegate.navigationController pushViewController:viewController animated:YES];
-        
-    } else if ([url containsString:@"TR0001"]) {
-        
-        WebViewController *viewController = [[WebViewController alloc] init];
-        if ([url containsString:@"&"]) {
-            url = [NSString stringWithFormat:@"%@&app=%@",url,H5_OPEN_PARAM];
-        } else {
-            url = [NSString stringWithFormat:@"%@?app=%@",url,H5_OPEN_PARAM];
-        }
-        viewController.myUrl = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-        viewController.type = WEB_VIEW_TYPE_NOR;
-        [appDelegate.navigationController pushViewController:viewController animated:YES];
-        
-    } else if ([url hasPrefix:@"http://www.guguaixia.com"] || [url hasPrefix:@"https://www.guguaixia.com"] || [url hasPrefix:API_URL]) {
+        return;
+    }
+    
+    //H5 里的链接和原生入口共用的页面在 sharedURLRouter 里，只从原生入口打开的页面在 pageRouter 里
+    NSString *urlStr = [url stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
+    if ([[URLRouter sharedURLRouter] routeURLString:urlStr] || [self.pageRouter routeURLString:urlStr]) {
+        return;
+    }
+    
+    if ([url hasPrefix:@"http://www.guguaixia.com"] || [url hasPrefix:@"https://www.guguaixia.com"] || [url hasPrefix:API_URL]) {
         
         WebViewController *viewController = [[WebViewController alloc] init];
         viewController.myUrl = url;
@@ -488,19 +400,33 @@ SYNTHESIZE_SINGLETON_FOR_CLASS(NativeUrlRedirectAction)
     }
 }
 
-#pragma mark func 
+#pragma mark private
 
-- (NSString *)getPara:(NSString *)key andUrl:(NSString *)url {
-    NSArray *aArr = [url componentsSeparatedByString:@"&"];
-    for (NSString *str in aArr) {
-        NSArray *tempArr = [str componentsSeparatedByString:@"="];
-        if ([key isEqualToString:tempArr[0]]) {
-            return tempArr[1];
-        }
++ (UINavigationController *)private_navigationController {
+    return [self sharedNativeUrlRedirectAction].appDelegate.navigationController;
+}
+
++ (void)private_push:(UIViewController *)viewController {
+    [[self private_navigationController] pushViewController:viewController animated:YES];
+}
+
++ (WXTabBarController *)private_popToTabBar {
+    AppDelegate *appDelegate = [self sharedNativeUrlRedirectAction].appDelegate;
+    [appDelegate.navigationController popToRootViewControllerAnimated:NO];
+    return appDelegate.tabBarController;
+}
+
+//未登录时跳到登录页
++ (BOOL)private_checkSignIn {
+    if ([SystemUtil isSignIn]) {
+        return YES;
     }
-    return @"";
+    [self private_push:[LoginViewController new]];
+    return NO;
 }
 
+#pragma mark func 
+
 - (void)dealWithAlert:(NSString *)url {
     [self.nmDict removeAllObjects];
     
@@ -573,6 +499,42 @@ SYNTHESIZE_SINGLETON_FOR_CLASS(NativeUrlRedirectAction)
     return _bigVPopView;
 }
 
+//只从原生入口打开的页面，H5 里点到这些链接仍按帖子详情处理
+- (URLRouter *)pageRouter {
+    if (_pageRouter == nil) {
+        _pageRouter = [[URLRouter alloc] init];
+        
+        [_pageRouter registerPattern:[API_URL stringByAppendingString:@"jiabei/FM0501"] handler:^(URLRouteMatch *match) {
+            WebViewController *viewController = [[WebViewController alloc] init];
+            viewController.myUrl = match.URLString;
+            viewController.type = WEB_VIEW_TYPE_SHARE;
+            [NativeUrlRedirectAction private_push:viewController];
+        }];
+        URLRouteHandler commentHandler = ^(URLRouteMatch *match) {
+            DetailWebViewController *vc = [DetailWebViewController new];
+            vc.type = WEB_VIEW_TYPE_COMMENT;
+            vc.myUrl = match.URLString;
+            [NativeUrlRedirectAction private_push:vc];
+        };
+        [_pageRouter registerPattern:[API_URL stringByAppendingString:@"jiabei/FM0101"] handler:commentHandler];
+        [_pageRouter registerPattern:[API_URL stringByAppendingString:@"jiabei/FM0401"] handler:commentHandler];
+        [_pageRouter registerPattern:[API_URL stringByAppendingString:@"jiabei/DW1001"] handler:^(URLRouteMatch *match) {
+            WebViewController *viewController = [[WebViewController alloc] init];
+            viewController.myUrl = match.URLString;
+            viewController.type = WEB_VIEW_TYPE_SHARE;
+            [NativeUrlRedirectAction private_push:viewController];
+        }];
+        [_pageRouter registerPattern:[API_URL stringByAppendingString:@"jiabei/TR0001"] handler:^(URLRouteMatch *match) {
+            NSString *param = [H5_OPEN_PARAM stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
+            WebViewController *viewController = [[WebViewController alloc] init];
+            viewController.myUrl = [NSString stringWithFormat:@"%@%@app=%@", match.URLString, match.query ? @"&" : @"?", param];
+            viewController.type = WEB_VIEW_TYPE_NOR;
+            [NativeUrlRedirectAction private_push:viewController];
+        }];
+    }
+    return _pageRouter;
+}
+
 - (AppDelegate *)appDelegate {
     if (_appDelegate == nil) {
         _appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
@@ -0,0 +1,52 @@
+//
+//  PostImageUploader.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "UploadImageEncoder.h"
+
+//index 为图片下标，progress 为该图片的上传进度 0~1
+typedef void(^PostImageUploadProgressBlock)(NSUInteger index, float progress);
+
+//成功时 responses 与 files 一一对应，为上传接口返回的字典(含 origin)；失败时 responses 为 nil
+typedef void(^PostImageUploadCompletionBlock)(NSArray<NSDictionary *> *responses, NSError *error);
+
+/**
+ *  帖子图片上传
+ *
+ *  每张图片单独走 API_UPLOAD_IMG，最多 maxConcurrentUploads 张同时上传，
+ *  单张失败只重传这一张。上传成功的结果按当前用户和文件 md5 保存在磁盘上，
+ *  同一用户重试发帖或重启应用后再发同一张图片时直接复用，不再上传。
+ *  所有回调都在主线程。
+ */
+@interface PostImageUploader : NSObject
+
+//PostFeedPicAPI.ty，默认 forum
+@property (nonatomic, copy) NSString *ty;
+
+//默认 3
+@property (nonatomic, assign) NSUInteger maxConcurrentUploads;
+
+//每张图片失败后的重试次数，默认 2
+@property (nonatomic, assign) NSUInteger maxRetryCount;
+
+@property (nonatomic, copy) PostImageUploadProgressBlock progressBlock;
+
+//全部图片的平均进度
+@property (nonatomic, assign, readonly) float progress;
+
+//已上传完成的张数
+@property (nonatomic, assign, readonly) NSUInteger finishedCount;
+
+@property (nonatomic, assign, readonly, getter=isUploading) BOOL uploading;
+
+- (void)uploadFiles:(NSArray<UploadImageFile *> *)files completion:(PostImageUploadCompletionBlock)completion;
+
+//停止所有上传，不再回调；已完成的图片结果保留
+- (void)cancel;
+
+@end
@@ -0,0 +1,262 @@
+//
+//  PostImageUploader.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "PostImageUploader.h"
+#import "PostFeedPicAPI.h"
+#import "SystemUtil.h"
+#import "Defination.h"
+
+//已上传图片的结果保留多久
+static const NSTimeInterval kPostImageUploadKeepInterval = 3 * 24 * 3600;
+
+/**
+ *  已上传图片的结果，userId|ty|md5 -> {time, response}，写入 Caches/post_image_uploads.plist
+ *  图片地址属于上传的账号，换账号后不复用
+ */
+@interface PostImageUploadStore : NSObject
+
++ (instancetype)sharedStore;
+
+- (NSDictionary *)responseForKey:(NSString *)key;
+- (void)setResponse:(NSDictionary *)response forKey:(NSString *)key;
+
+@end
+
+@implementation PostImageUploadStore
+{
+    NSMutableDictionary *_entries;
+    NSString *_path;
+    dispatch_queue_t _ioQueue;
+}
+
++ (instancetype)sharedStore {
+    static PostImageUploadStore *store;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        store = [[PostImageUploadStore alloc] init];
+    });
+    return store;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        NSString *caches = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        _path = [caches stringByAppendingPathComponent:@"post_image_uploads.plist"];
+        _ioQueue = dispatch_queue_create("com.newstock.postimageupload", DISPATCH_QUEUE_SERIAL);
+
+        //去掉过期的记录
+        _entries = [NSMutableDictionary dictionary];
+        NSTimeInterval now = [NSDate date].timeIntervalSince1970;
+        [[NSDictionary dictionaryWithContentsOfFile:_path] enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSDictionary *entry, BOOL *stop) {
+            if ([entry isKindOfClass:[NSDictionary class]] && now - [entry[@"time"] doubleValue] < kPostImageUploadKeepInterval) {
+                _entries[key] = entry;
+            }
+        }];
+    }
+    return self;
+}
+
+- (NSDictionary *)responseForKey:(NSString *)key {
+    return key ? _entries[key][@"response"] : nil;
+}
+
+- (void)setResponse:(NSDictionary *)response forKey:(NSString *)key {
+    if (key == nil || response == nil) {
+        return;
+    }
+    _entries[key] = @{@"time" : @([NSDate date].timeIntervalSince1970), @"response" : response};
+    NSDictionary *snapshot = [_entries copy];
+    NSString *path = _path;
+    dispatch_async(_ioQueue, ^{
+        [snapshot writeToFile:path atomically:YES];
+    });
+}
+
+@end
+
+
+@interface PostImageUploader ()
+
+@property (nonatomic, assign, readwrite) NSUInteger finishedCount;
+@property (nonatomic, assign, readwrite, getter=isUploading) BOOL uploading;
+
+@end
+
+@implementation PostImageUploader
+{
+    NSArray<UploadImageFile *> *_files;
+    NSMutableArray *_responses;
+    NSMutableArray<NSNumber *> *_progresses;
+    NSMutableArray<NSNumber *> *_retries;
+    NSMutableIndexSet *_pending;
+    NSMutableDictionary<NSNumber *, PostFeedPicAPI *> *_running;
+    PostImageUploadCompletionBlock _completion;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _ty = @"forum";
+        _maxConcurrentUploads = 3;
+        _maxRetryCount = 2;
+    }
+    return self;
+}
+
+- (float)progress {
+    if (_progresses.count == 0) {
+        return 0;
+    }
+    float total = 0;
+    for (NSNumber *progress in _progresses) {
+        total += progress.floatValue;
+    }
+    return total / _progresses.count;
+}
+
+- (void)uploadFiles:(NSArray<UploadImageFile *> *)files completion:(PostImageUploadCompletionBlock)completion {
+    NSAssert([NSThread isMainThread], @"upload must be started on main thread");
+    [self cancel];
+
+    _files = [files copy];
+    _completion = [completion copy];
+    _responses = [NSMutableArray arrayWithCapacity:_files.count];
+    _progresses = [NSMutableArray arrayWithCapacity:_files.count];
+    _retries = [NSMutableArray arrayWithCapacity:_files.count];
+    _pending = [NSMutableIndexSet indexSet];
+    _running = [NSMutableDictionary dictionary];
+    self.finishedCount = 0;
+    self.uploading = YES;
+
+    //上次已传过的直接复用
+    PostImageUploadStore *store = [PostImageUploadStore sharedStore];
+    [_files enumerateObjectsUsingBlock:^(UploadImageFile *file, NSUInteger idx, BOOL *stop) {
+        NSDictionary *response = [store responseForKey:[self private_storeKeyForFile:file]];
+        [_responses addObject:response ?: [NSNull null]];
+        [_progresses addObject:@(response ? 1 : 0)];
+        [_retries addObject:@0];
+        if (response) {
+            self.finishedCount++;
+        } else {
+            [_pending addIndex:idx];
+        }
+    }];
+    for (NSUInteger idx = 0; idx < _files.count; idx++) {
+        if (_responses[idx] != [NSNull null] && self.progressBlock) {
+            self.progressBlock(idx, 1);
+        }
+    }
+    [self private_startNext];
+}
+
+- (void)cancel {
+    _completion = nil;
+    for (PostFeedPicAPI *api in _running.allValues) {
+        [api clearCompletionBlock];
+        [api stop];
+    }
+    [_running removeAllObjects];
+    [_pending removeAllIndexes];
+    self.uploading = NO;
+}
+
+#pragma mark private
+
+- (NSString *)private_storeKeyForFile:(UploadImageFile *)file {
+    if (file.digest.length == 0) {
+        return nil;
+    }
+    return [NSString stringWithFormat:@"%@|%@|%@", [SystemUtil getCache:USER_ID], _ty, file.digest];
+}
+
+- (void)private_startNext {
+    if (!self.uploading) {
+        return;
+    }
+    if (_pending.count == 0 && _running.count == 0) {
+        PostImageUploadCompletionBlock completion = _completion;
+        NSArray *responses = [_responses copy];
+        _completion = nil;
+        self.uploading = NO;
+        if (completion) {
+            completion(responses, nil);
+        }
+        return;
+    }
+    while (_running.count < MAX(_maxConcurrentUploads, 1) && _pending.count) {
+        NSUInteger idx = _pending.firstIndex;
+        [_pending removeIndex:idx];
+        [self private_uploadAtIndex:idx];
+    }
+}
+
+- (void)private_uploadAtIndex:(NSUInteger)idx {
+    __weak typeof(self) weakSelf = self;
+    PostFeedPicAPI *api = [PostFeedPicAPI new];
+    api.ty = _ty;
+    api.imageFiles = @[_files[idx]];
+    api.uploadProgressBlock = ^(NSUInteger bytesWritten, long long totalBytesWritten, long long totalBytesExpectedToWrite) {
+        if (totalBytesExpectedToWrite > 0) {
+            //留一点给服务器响应
+            [weakSelf private_setProgress:0.95 * totalBytesWritten / totalBytesExpectedToWrite atIndex:idx];
+        }
+    };
+    _running[@(idx)] = api;
+
+    [api startWithCompletionBlockWithSuccess:^(__kindof APIBaseRequest *request) {
+        NSDictionary *response = request.responseJSONObject;
+        if ([response isKindOfClass:[NSDictionary class]] && response[@"origin"]) {
+            [weakSelf private_finishIndex:idx response:response];
+        } else {
+            [weakSelf private_failIndex:idx error:nil];
+        }
+    } failure:^(__kindof APIBaseRequest *request) {
+        [weakSelf private_failIndex:idx error:request.requestOperationError];
+    }];
+}
+
+- (void)private_setProgress:(float)progress atIndex:(NSUInteger)idx {
+    if (idx >= _progresses.count) {
+        return;
+    }
+    _progresses[idx] = @(progress);
+    if (self.progressBlock) {
+        self.progressBlock(idx, progress);
+    }
+}
+
+- (void)private_finishIndex:(NSUInteger)idx response:(NSDictionary *)response {
+    [_running removeObjectForKey:@(idx)];
+    _responses[idx] = response;
+    [[PostImageUploadStore sharedStore] setResponse:response forKey:[self private_storeKeyForFile:_files[idx]]];
+    self.finishedCount++;
+    [self private_setProgress:1 atIndex:idx];
+    [self private_startNext];
+}
+
+- (void)private_failIndex:(NSUInteger)idx error:(NSError *)error {
+    [_running removeObjectForKey:@(idx)];
+    NSUInteger retry = _retries[idx].unsignedIntegerValue;
+    if (retry < _maxRetryCount) {
+        //只重传这一张
+        _retries[idx] = @(retry + 1);
+        [self private_setProgress:0 atIndex:idx];
+        [_pending addIndex:idx];
+        [self private_startNext];
+        return;
+    }
+
+    PostImageUploadCompletionBlock completion = _completion;
+    [self cancel];
+    if (completion) {
+        completion(nil, error ?: [NSError errorWithDomain:@"PostImageUploader" code:-1 userInfo:nil]);
+    }
+}
+
+@end
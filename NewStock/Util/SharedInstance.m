@@ -33,12 +33,22 @@ SYNTHESIZE_SINGLETON_FOR_CLASS(SharedInstance)
 - (void)shareWithImg:(NSString *)img file:(UIImage *)file url:(NSString *)url c:(NSString *)c tt:(NSString *)tt ty:(NSString *)ty sid:(NSString *)sid res_code:(NSString *)res_code to:(NSString *)to {
     
     ShareAPI *shareAPI = [[ShareAPI alloc] initWithImg:img url:url tt:tt c:c ty:ty sid:sid res_code:res_code to:to];
-    shareAPI.file = file;
     
-    [shareAPI startWithCompletionBlockWithSuccess:^(__kindof APIBaseRequest *request) {
-        NSLog(@"%@",request.responseJSONObject);
-    } failure:^(__kindof APIBaseRequest *request) {
-        NSLog(@"%@",request.requestOperationError);
+    void (^startBlock)(void) = ^{
+        [shareAPI startWithCompletionBlockWithSuccess:^(__kindof APIBaseRequest *request) {
+            NSLog(@"%@",request.responseJSONObject);
+        } failure:^(__kindof APIBaseRequest *request) {
+            NSLog(@"%@",request.requestOperationError);
+        }];
+    };
+    if (file == nil) {
+        startBlock();
+        return;
+    }
+    //截图在后台编码成文件后再上传
+    [[UploadImageEncoder sharedUploadImageEncoder] encodeImages:@[file] maxPixel:kUploadImageShareMaxPixel quality:0.9 completion:^(NSArray<UploadImageFile *> *files) {
+        shareAPI.file = files.firstObject;
+        startBlock();
     }];
     
 }
@@ -11,16 +11,30 @@
 #import "StockCodesModel.h"
 #import "TaoHotPeopleModel.h"
 
+//码表更新(含首次解析过程中的部分数据)，object 为 StockCodesInstance
+#define STOCK_CODES_UPDATE_NOTIFICATION @"stockCodesUpdateNotification"
+
 @interface StockCodesInstance : NSObject
 {
 }
 @property (strong, nonatomic) StockCodesModel *stockCodesModel;
+//不可变快照，整体替换，可在任意线程读取(与名称索引在同一把锁下读写)
 @property (strong, nonatomic) NSArray *stockCodesArray;
 @property (strong, nonatomic) NSArray *departmentArray;
 @property (strong, nonatomic) NSArray <TaoHotPeopleModel *> *userArray;
 @property (strong, nonatomic) NSArray <TaoHotPeopleModel *> *pureUserArray;
 
+//码表解析进度 0~1，没有在解析时为 1
+@property (assign, atomic, readonly) float stockCodesProgress;
+
 SYNTHESIZE_SINGLETON_FOR_HEADER(StockCodesInstance)
 
 -(NSString *)getStockNameWithSymbol:(NSString *)s type:(NSString *)t market:(NSString *)m;
+
+//后台分段解析 gxCodeList，首次(本地无码表)时分几批发布部分数据；completion 在主线程回调
+- (void)decodeStockCodes:(NSArray<NSDictionary *> *)jsonArray completion:(void(^)(NSArray *array))completion;
+
+//按代码、名称、拼音匹配，最多返回 limit 个，前缀匹配的在前，可在任意线程调用
+- (NSArray<StockCodeInfo *> *)searchStockCodes:(NSString *)searchText limit:(NSUInteger)limit;
+
 @end
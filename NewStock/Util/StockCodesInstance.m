@@ -8,23 +8,246 @@
 
 #import "StockCodesInstance.h"
 
+//每段解析的条数
+static const NSUInteger kStockCodesChunkSize = 2000;
+
+static NSString *stockCodeKey(id s, id t, id m) {
+    return [NSString stringWithFormat:@"%@|%d|%d", s ?: @"", [m intValue], [t intValue]];
+}
+
+//前缀索引的一项：代码、名称或拼音 -> StockCodeInfo
+@interface StockCodePrefixEntry : NSObject
+@property (copy, nonatomic) NSString *key;
+@property (strong, nonatomic) StockCodeInfo *item;
+@end
+
+@implementation StockCodePrefixEntry
+@end
+
+static NSComparisonResult comparePrefixEntries(StockCodePrefixEntry *a, StockCodePrefixEntry *b) {
+    return [a.key compare:b.key options:NSLiteralSearch];
+}
+
+static void addPrefixEntries(NSMutableArray<StockCodePrefixEntry *> *entries, StockCodeInfo *item) {
+    for (NSString *key in @[item.s ?: @"", item.n ?: @"", item.p ?: @""]) {
+        if (![key isKindOfClass:[NSString class]] || key.length == 0) {
+            continue;
+        }
+        StockCodePrefixEntry *entry = [[StockCodePrefixEntry alloc] init];
+        entry.key = key;
+        entry.item = item;
+        [entries addObject:entry];
+    }
+}
+
+//解析过程中不断追加的码表，发布时才拷贝成不可变快照
+@interface StockCodesBuilder : NSObject
+@property (strong, nonatomic, readonly) NSMutableArray<StockCodeInfo *> *array;
+@property (strong, nonatomic, readonly) NSMutableDictionary<NSString *, StockCodeInfo *> *symbolIndex;
+@property (strong, nonatomic, readonly) NSMutableArray<StockCodePrefixEntry *> *prefixEntries;
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+- (void)addStockCode:(StockCodeInfo *)item;
+@end
+
+@implementation StockCodesBuilder
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    self = [super init];
+    if (self) {
+        _array = [NSMutableArray arrayWithCapacity:capacity];
+        _symbolIndex = [NSMutableDictionary dictionaryWithCapacity:capacity];
+        _prefixEntries = [NSMutableArray arrayWithCapacity:capacity * 3];
+    }
+    return self;
+}
+
+- (void)addStockCode:(StockCodeInfo *)item {
+    [_array addObject:item];
+    _symbolIndex[stockCodeKey(item.s, item.t, item.m)] = item;
+    addPrefixEntries(_prefixEntries, item);
+}
+
+@end
+
+@interface StockCodesInstance ()
+
+@property (assign, atomic, readwrite) float stockCodesProgress;
+
+@end
+
 @implementation StockCodesInstance
+{
+    dispatch_queue_t _decodeQueue;
+    //s|m|t -> StockCodeInfo，与 _stockCodesArray 在 @synchronized(self) 下同时替换
+    NSDictionary<NSString *, StockCodeInfo *> *_symbolIndex;
+    //按 key 排序的前缀索引，与 _stockCodesArray 同时替换
+    NSArray<StockCodePrefixEntry *> *_prefixIndex;
+}
 SYNTHESIZE_SINGLETON_FOR_CLASS(StockCodesInstance)
 
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _decodeQueue = dispatch_queue_create("com.newstock.stockcodes", DISPATCH_QUEUE_SERIAL);
+        self.stockCodesProgress = 1;
+    }
+    return self;
+}
 
 - (NSString *)getStockNameWithSymbol:(NSString *)s type:(NSString *)t market:(NSString *)m {
-    NSArray *array = self.stockCodesArray;
-    
-    for (int i = 0; i < [array count]; i ++) {
-        StockCodeInfo *item = [array objectAtIndex:i];
-        NSString *symbol = item.s;
-        NSString *market = item.m;
-        NSString *type = item.t;
-        if([symbol isEqualToString:s]&&([market intValue] == [m intValue])&&([type intValue] == [t intValue])) {
-            return item.n;
+    NSDictionary *index;
+    @synchronized (self) {
+        index = _symbolIndex;
+    }
+    StockCodeInfo *item = index[stockCodeKey(s, t, m)];
+    return item.n ?: @"";
+}
+
+- (NSArray *)stockCodesArray {
+    @synchronized (self) {
+        return _stockCodesArray;
+    }
+}
+
+- (void)setStockCodesArray:(NSArray *)stockCodesArray {
+    StockCodesBuilder *builder = [[StockCodesBuilder alloc] initWithCapacity:stockCodesArray.count];
+    for (StockCodeInfo *item in stockCodesArray) {
+        [builder addStockCode:item];
+    }
+    [self publishStockCodes:builder];
+}
+
+//把 builder 当前的内容拷贝成不可变快照发布，builder 之后可以继续追加
+- (void)publishStockCodes:(StockCodesBuilder *)builder {
+    NSArray *array = [builder.array copy];
+    NSDictionary *index = [builder.symbolIndex copy];
+    NSArray *prefixIndex = [builder.prefixEntries sortedArrayUsingComparator:^NSComparisonResult(StockCodePrefixEntry *a, StockCodePrefixEntry *b) {
+        return comparePrefixEntries(a, b);
+    }];
+    @synchronized (self) {
+        _stockCodesArray = array;
+        _symbolIndex = index;
+        _prefixIndex = prefixIndex;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [[NSNotificationCenter defaultCenter] postNotificationName:STOCK_CODES_UPDATE_NOTIFICATION object:self];
+    });
+}
+
+- (void)decodeStockCodes:(NSArray<NSDictionary *> *)jsonArray completion:(void (^)(NSArray *))completion {
+    dispatch_async(_decodeQueue, ^{
+        BOOL progressive = self.stockCodesArray.count == 0;
+        NSUInteger total = jsonArray.count;
+        StockCodesBuilder *builder = [[StockCodesBuilder alloc] initWithCapacity:total];
+        self.stockCodesProgress = 0;
+
+        //部分数据只在第一段和之后每满四分之一时发布，避免每段都拷贝一遍全表
+        NSUInteger published = 0;
+        for (NSUInteger start = 0; start < total; start += kStockCodesChunkSize) {
+            @autoreleasepool {
+                NSUInteger end = MIN(start + kStockCodesChunkSize, total);
+                for (NSUInteger i = start; i < end; i++) {
+                    StockCodeInfo *item = [self stockCodeWithJSON:jsonArray[i]];
+                    if (item == nil) {
+                        continue;
+                    }
+                    [builder addStockCode:item];
+                }
+                self.stockCodesProgress = (float)end / total;
+                if (progressive && end < total && (published == 0 || end - published >= total / 4)) {
+                    [self publishStockCodes:builder];
+                    published = end;
+                }
+            }
+        }
+
+        [self publishStockCodes:builder];
+        NSArray *result = self.stockCodesArray;
+        self.stockCodesProgress = 1;
+
+        if (completion) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(result);
+            });
+        }
+    });
+}
+
+//与 MTLJSONAdapter 的结果一致：原值直接赋给属性，NSNull 视为 nil
+- (StockCodeInfo *)stockCodeWithJSON:(NSDictionary *)json {
+    if (![json isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+    id (^value)(NSString *) = ^id(NSString *key) {
+        id v = json[key];
+        return v == [NSNull null] ? nil : v;
+    };
+
+    StockCodeInfo *item = [[StockCodeInfo alloc] init];
+    item.t = value(@"t");
+    item.s = value(@"s");
+    item.m = value(@"m");
+    item.n = value(@"n");
+    item.p = value(@"p");
+    item.d = value(@"d");
+    item.h = value(@"h");
+    item.r = value(@"r");
+    item.th = value(@"th");
+    return item;
+}
+
+- (NSArray<StockCodeInfo *> *)searchStockCodes:(NSString *)searchText limit:(NSUInteger)limit {
+    if (searchText.length == 0 || limit == 0) {
+        return @[];
+    }
+
+    NSArray *array;
+    NSArray *prefixIndex;
+    @synchronized (self) {
+        array = _stockCodesArray;
+        prefixIndex = _prefixIndex;
+    }
+    NSString *text = [searchText lowercaseString];
+    NSMutableOrderedSet *result = [NSMutableOrderedSet orderedSet];
+
+    //先查前缀索引，与下面的包含匹配一样：代码、名称按原文，拼音按小写
+    [self private_collectPrefix:searchText inIndex:prefixIndex into:result limit:limit];
+    if (![text isEqualToString:searchText]) {
+        [self private_collectPrefix:text inIndex:prefixIndex into:result limit:limit];
+    }
+
+    //不够时再按包含匹配补齐，如输入名称中间的字
+    if (result.count < limit) {
+        for (StockCodeInfo *item in array) {
+            if ([item.s containsString:searchText]
+                || [item.n containsString:searchText]
+                || [item.p containsString:text]) {
+                [result addObject:item];
+                if (result.count >= limit) {
+                    break;
+                }
+            }
+        }
+    }
+    return result.array;
+}
+
+- (void)private_collectPrefix:(NSString *)prefix inIndex:(NSArray<StockCodePrefixEntry *> *)prefixIndex into:(NSMutableOrderedSet *)result limit:(NSUInteger)limit {
+    StockCodePrefixEntry *probe = [[StockCodePrefixEntry alloc] init];
+    probe.key = prefix;
+    NSUInteger i = [prefixIndex indexOfObject:probe
+                                inSortedRange:NSMakeRange(0, prefixIndex.count)
+                                      options:NSBinarySearchingFirstEqual | NSBinarySearchingInsertionIndex
+                              usingComparator:^NSComparisonResult(StockCodePrefixEntry *a, StockCodePrefixEntry *b) {
+                                  return comparePrefixEntries(a, b);
+                              }];
+    for (; i < prefixIndex.count && result.count < limit; i++) {
+        StockCodePrefixEntry *entry = prefixIndex[i];
+        if (![entry.key hasPrefix:prefix]) {
+            break;
         }
+        [result addObject:entry.item];
     }
-    return @"";
 }
 
 - (void)setUserArray:(NSArray *)userArray {
@@ -26,8 +26,9 @@ typedef NS_ENUM(NSInteger, ADD_STOCK_STATU) {
 
 + (NSString *)getStockCodesPath;
 + (NSString *)getStockDepartsmentPath;
-+ (NSString *)getMyStockPath;
 + (NSString *)getallUserPath;
+//旧版自选股、历史记录归档文件，仅用于迁移到 StockListStore
++ (NSString *)getMyStockPath;
 + (NSString *)getStockHistoryPath;
 
 + (BOOL)addStockToHistory:(NSString *)symbol symbolName:(NSString *)symbolName symbolTyp:(NSString *)symbolTyp marketCd:(NSString *)marketCd;
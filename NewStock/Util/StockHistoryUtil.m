@@ -12,6 +12,7 @@
 #import "UMMobClick/MobClick.h"
 #import "Defination.h"
 #import "MyStockInfoInstance.h"
+#import "StockListStore.h"
 
 @implementation StockHistoryUtil
 
@@ -100,55 +101,21 @@
 
 + (BOOL)addStockToHistory:(StockCodeInfo *)model
 {
-    NSString *path = [StockHistoryUtil getStockHistoryPath];
-    NSMutableArray *array = [StockHistoryUtil getStockHistory];
+    StockListStore *store = [StockListStore historyStore];
     
-    if(array == nil)array = [[NSMutableArray alloc] init];
-    
-    //检查是否已存在
-    for (int i = 0; i < [array count]; i ++)
-    {
-        StockCodeInfo *item = [array objectAtIndex:i];
-        if (([item.s isEqualToString:model.s ])
-            &&([item.m intValue] == [model.m intValue])
-            &&([item.t intValue] == [model.t intValue]))
-        {
-            [array removeObjectAtIndex:i];
-        }
-    }
-    
-    [array insertObject:model atIndex:0];
-    //[array addObject:model];
-    
-    if ([array count] > HIS_STOCK_MAX_NUM)
-    {
-        [array removeLastObject];
-    }
-
-    BOOL b = [NSKeyedArchiver archiveRootObject:array toFile:path];
+    //已存在的移到最前
+    [store insertStock:model atIndex:0];
+    [store removeLastStocksToCount:HIS_STOCK_MAX_NUM];
 
-    return b;
+    return YES;
 }
 + (NSMutableArray *)getStockHistory
 {
-    NSString *path = [StockHistoryUtil getStockHistoryPath];
-    NSMutableArray *array = [NSKeyedUnarchiver unarchiveObjectWithFile:path];
-    return array;
+    return [[StockListStore historyStore] allStocks];
 }
 + (BOOL)searchStockFromHistory:(StockCodeInfo *)model
 {
-    NSMutableArray *array = [StockHistoryUtil getStockHistory];
-    for (int i=0; i< [array count]; i++)
-    {
-        StockCodeInfo *item = [array objectAtIndex:i];
-        if (([item.s isEqualToString:model.s ])
-            &&([item.m intValue] == [model.m intValue])
-            &&([item.t intValue] == [model.t intValue]))
-        {
-            return YES;
-        }
-    }
-    return NO;
+    return [[StockListStore historyStore] containsStock:model];
 }
 
 
@@ -170,49 +137,34 @@
     NSDictionary *dict = @{@"name":model.n};
     [MobClick event:ADD_MY_STOCK attributes:dict];
     
+    StockListStore *store = [StockListStore myStockStore];
     
-    
-    NSString *path = [StockHistoryUtil getMyStockPath];
-
-    NSMutableArray *array = [StockHistoryUtil getMyStock];
-    if(array == nil)array = [[NSMutableArray alloc] init];
-    //[array addObject:model];
-    [array insertObject:model atIndex:0];
-    
-    if ([StockHistoryUtil searchStockFromMyStock:model])
+    if ([store containsStock:model])
     {
         return ADD_STOCK_EXIST;
     }
         
-    if ([array count]>MY_STOCK_MAX_NUM)
+    if ([store count] >= MY_STOCK_MAX_NUM)
     {
         return ADD_STOCK_FULL;
     }
+    
+    [store insertStock:model atIndex:0];
     [[MyStockInfoInstance sharedMyStockInfoInstance]addStockWith:model];
-    BOOL b = [NSKeyedArchiver archiveRootObject:array toFile:path];
     
-    if (b)
-    {
-        return ADD_STOCK_SUC;
-    }
-    else
-    {
-        return ADD_STOCK_FALSE;
-    }
+    return ADD_STOCK_SUC;
 }
 
 + (NSMutableArray *)getMyStock
 {
-    NSString *path = [StockHistoryUtil getMyStockPath];
-    NSMutableArray *array = [NSKeyedUnarchiver unarchiveObjectWithFile:path];
-    return array;
+    return [[StockListStore myStockStore] allStocks];
 }
 
 + (void)getMyStockFromServer {
     
     [[MyStockInfoInstance sharedMyStockInfoInstance]getAllMyStock:^(NSArray *arr) {
         if (arr != nil) {
-            [NSKeyedArchiver archiveRootObject:arr toFile:[self getMyStockPath]];
+            [[StockListStore myStockStore] replaceAllStocks:arr];
         }
     }];
     
@@ -220,98 +172,48 @@
 
 + (BOOL)searchStockFromMyStock:(StockCodeInfo *)model
 {
-    NSMutableArray *array = [StockHistoryUtil getMyStock];
-    for (int i=0; i< [array count]; i++)
-    {
-        StockCodeInfo *item = [array objectAtIndex:i];
-        if (([item.s isEqualToString:model.s ])
-            &&([item.m intValue] == [model.m intValue])
-            &&([item.t intValue] == [model.t intValue]))
-        {
-            return YES;
-        }
-    }
-    return NO;
+    return [[StockListStore myStockStore] containsStock:model];
 }
 
 + (BOOL)searchStockFromMyStock:(NSString *)symbol symbolTyp:(NSString *)symbolTyp marketCd:(NSString *)marketCd
 {
-    NSMutableArray *array = [StockHistoryUtil getMyStock];
-    for (int i=0; i< [array count]; i++)
-    {
-        StockCodeInfo *item = [array objectAtIndex:i];
-        if (([item.s isEqualToString:symbol ])
-            &&([item.m intValue] == [marketCd intValue])
-            &&([item.t intValue] == [symbolTyp intValue]))
-        {
-            return YES;
-        }
-    }
-    return NO;
+    return [[StockListStore myStockStore] stockWithSymbol:symbol type:symbolTyp market:marketCd] != nil;
 }
 
 + (void)deleteMyStock:(NSString *)symbol symbolName:(NSString *)symbolName symbolTyp:(NSString *)symbolTyp marketCd:(NSString *)marketCd
 {
-    NSMutableArray *array = [StockHistoryUtil getMyStock];
-    
-    for (int i=0; i< [array count]; i++)
+    StockCodeInfo *item = [[StockListStore myStockStore] removeStockWithSymbol:symbol type:symbolTyp market:marketCd];
+    if (item == nil)
     {
-        StockCodeInfo *item = [array objectAtIndex:i];
-        if (([item.s isEqualToString:symbol ])
-            &&([item.m intValue] == [marketCd intValue])
-            &&([item.t intValue] == [symbolTyp intValue]))
-        {
-            [array removeObjectAtIndex:i];
-            
-            NSString *path = [StockHistoryUtil getMyStockPath];
-
-            [[MyStockInfoInstance sharedMyStockInfoInstance]deleteStockWith:item];
-            BOOL b = [NSKeyedArchiver archiveRootObject:array toFile:path];
-            NSLog(@"delete my stock:%d",b);
-            
-            //事件统计
-            NSDictionary *dict = @{@"name":item.n};
-            [MobClick event:DEL_MY_STOCK attributes:dict];
-            
-            
-            return;
-        }
+        return;
     }
+    
+    [[MyStockInfoInstance sharedMyStockInfoInstance]deleteStockWith:item];
+    
+    //事件统计
+    NSDictionary *dict = @{@"name":item.n};
+    [MobClick event:DEL_MY_STOCK attributes:dict];
 }
 
 + (void)cleanAllMyStock
 {
-    NSMutableArray *array = [StockHistoryUtil getMyStock];
-    [[MyStockInfoInstance sharedMyStockInfoInstance]deleteStockWithArr:array];
-    [array removeAllObjects];
-    NSString *path = [StockHistoryUtil getMyStockPath];
-
-    
-    BOOL b = [NSKeyedArchiver archiveRootObject:array toFile:path];
-    NSLog(@"delete my stock:%d",b);
+    StockListStore *store = [StockListStore myStockStore];
+    [[MyStockInfoInstance sharedMyStockInfoInstance]deleteStockWithArr:[store allStocks]];
+    [store removeAllStocks];
 }
 
 + (void)exchangeObjectAtIndex:(NSUInteger)i withObjectAtIndex:(NSUInteger)ii
 {
-    NSMutableArray *array = [StockHistoryUtil getMyStock];
-    [array exchangeObjectAtIndex:i withObjectAtIndex:ii];
-    
-    NSString *path = [StockHistoryUtil getMyStockPath];
-    [[MyStockInfoInstance sharedMyStockInfoInstance]resetStockWith:array];
-    [NSKeyedArchiver archiveRootObject:array toFile:path];
-    //BOOL b =
+    StockListStore *store = [StockListStore myStockStore];
+    [store exchangeStockAtIndex:i withStockAtIndex:ii];
+    [[MyStockInfoInstance sharedMyStockInfoInstance]resetStockWith:[store allStocks]];
 }
 
 + (void)moveObjectAtIndex:(NSUInteger)i atIndex:(NSUInteger)ii
 {
-    NSMutableArray *array = [StockHistoryUtil getMyStock];
-    StockCodeInfo *item = [array objectAtIndex:i];
-    [array removeObjectAtIndex:i];
-    [array insertObject:item atIndex:ii];
-    [[MyStockInfoInstance sharedMyStockInfoInstance]resetStockWith:array];
-    NSString *path = [StockHistoryUtil getMyStockPath];
-    [NSKeyedArchiver archiveRootObject:array toFile:path];
-    //BOOL b =
+    StockListStore *store = [StockListStore myStockStore];
+    [store moveStockAtIndex:i toIndex:ii];
+    [[MyStockInfoInstance sharedMyStockInfoInstance]resetStockWith:[store allStocks]];
 }
 
 @end
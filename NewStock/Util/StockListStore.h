@@ -0,0 +1,46 @@
+//
+//  StockListStore.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "StockCodesModel.h"
+
+/**
+ *  本地股票列表(自选股、搜索历史)存储
+ *
+ *  内存中保存有序列表和 s|m|t 索引，查询不读磁盘；
+ *  修改后合并成一次事务异步写入 SQLite(WAL)，进入后台时立即落盘。
+ *  首次打开时会导入旧版 NSKeyedArchiver 文件。
+ */
+@interface StockListStore : NSObject
+
++ (StockListStore *)myStockStore;
++ (StockListStore *)historyStore;
+
+- (instancetype)initWithName:(NSString *)name legacyPath:(NSString *)legacyPath;
+
+//返回当前列表的拷贝，可随意修改
+- (NSMutableArray<StockCodeInfo *> *)allStocks;
+- (NSUInteger)count;
+
+- (BOOL)containsStock:(StockCodeInfo *)model;
+- (StockCodeInfo *)stockWithSymbol:(NSString *)s type:(NSString *)t market:(NSString *)m;
+
+//已存在的股票会先移除再插入
+- (void)insertStock:(StockCodeInfo *)model atIndex:(NSUInteger)index;
+- (StockCodeInfo *)removeStockWithSymbol:(NSString *)s type:(NSString *)t market:(NSString *)m;
+- (void)removeLastStocksToCount:(NSUInteger)count;
+- (void)removeAllStocks;
+- (void)replaceAllStocks:(NSArray<StockCodeInfo *> *)array;
+
+- (void)exchangeStockAtIndex:(NSUInteger)i withStockAtIndex:(NSUInteger)ii;
+- (void)moveStockAtIndex:(NSUInteger)i toIndex:(NSUInteger)ii;
+
+//立即写入未落盘的修改
+- (void)synchronize;
+
+@end
@@ -0,0 +1,357 @@
+//
+//  StockListStore.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "StockListStore.h"
+#import "StockHistoryUtil.h"
+#import <UIKit/UIKit.h>
+#import <sqlite3.h>
+
+//合并写入的延迟
+static const NSTimeInterval kStockListFlushDelay = 0.3;
+
+static NSArray *stockListColumns(void) {
+    return @[@"t", @"s", @"m", @"n", @"p", @"d", @"h", @"r", @"th"];
+}
+
+static NSString *stockListKey(NSString *s, NSString *t, NSString *m) {
+    return [NSString stringWithFormat:@"%@|%d|%d", s ?: @"", [m intValue], [t intValue]];
+}
+
+//所有列表共用一个连接，只在该队列上访问
+static dispatch_queue_t stockListQueue(void) {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.newstock.stocklist", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
+}
+
+static sqlite3 *stockListDB(void) {
+    static sqlite3 *db = NULL;
+    if (db) {
+        return db;
+    }
+
+    NSString *pathOfLibrary = [NSSearchPathForDirectoriesInDomains(NSLibraryDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+    NSString *path = [pathOfLibrary stringByAppendingPathComponent:@"stockList.db"];
+    if (sqlite3_open(path.UTF8String, &db) != SQLITE_OK) {
+        NSLog(@"stock list db open fail:%s", sqlite3_errmsg(db));
+        sqlite3_close(db);
+        db = NULL;
+        return NULL;
+    }
+
+    sqlite3_exec(db, "PRAGMA journal_mode=WAL;", NULL, NULL, NULL);
+    sqlite3_exec(db, "PRAGMA synchronous=NORMAL;", NULL, NULL, NULL);
+    sqlite3_exec(db, "CREATE TABLE IF NOT EXISTS stock_list (list TEXT NOT NULL, pos INTEGER NOT NULL, "
+                     "t TEXT, s TEXT, m TEXT, n TEXT, p TEXT, d TEXT, h TEXT, r TEXT, th TEXT, "
+                     "PRIMARY KEY(list, pos));", NULL, NULL, NULL);
+    return db;
+}
+
+
+@interface StockListStore ()
+{
+    NSString *_name;
+    NSString *_legacyPath;
+    NSMutableArray<StockCodeInfo *> *_stocks;
+    NSMutableDictionary<NSString *, StockCodeInfo *> *_index;
+    BOOL _flushScheduled;
+}
+@end
+
+@implementation StockListStore
+
++ (StockListStore *)myStockStore {
+    static StockListStore *store = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        store = [[StockListStore alloc] initWithName:@"myStock" legacyPath:[StockHistoryUtil getMyStockPath]];
+    });
+    return store;
+}
+
++ (StockListStore *)historyStore {
+    static StockListStore *store = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        store = [[StockListStore alloc] initWithName:@"stockHistory" legacyPath:[StockHistoryUtil getStockHistoryPath]];
+    });
+    return store;
+}
+
+- (instancetype)initWithName:(NSString *)name legacyPath:(NSString *)legacyPath {
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _legacyPath = [legacyPath copy];
+        _stocks = [NSMutableArray array];
+        _index = [NSMutableDictionary dictionary];
+
+        dispatch_sync(stockListQueue(), ^{
+            [self load];
+        });
+
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(synchronize) name:UIApplicationDidEnterBackgroundNotification object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(synchronize) name:UIApplicationWillTerminateNotification object:nil];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark read
+
+- (NSMutableArray<StockCodeInfo *> *)allStocks {
+    @synchronized (self) {
+        return [_stocks mutableCopy];
+    }
+}
+
+- (NSUInteger)count {
+    @synchronized (self) {
+        return _stocks.count;
+    }
+}
+
+- (BOOL)containsStock:(StockCodeInfo *)model {
+    return [self stockWithSymbol:model.s type:model.t market:model.m] != nil;
+}
+
+- (StockCodeInfo *)stockWithSymbol:(NSString *)s type:(NSString *)t market:(NSString *)m {
+    @synchronized (self) {
+        return _index[stockListKey(s, t, m)];
+    }
+}
+
+#pragma mark write
+
+- (void)insertStock:(StockCodeInfo *)model atIndex:(NSUInteger)index {
+    if (model == nil) {
+        return;
+    }
+    @synchronized (self) {
+        NSString *key = stockListKey(model.s, model.t, model.m);
+        StockCodeInfo *exist = _index[key];
+        if (exist) {
+            [_stocks removeObjectIdenticalTo:exist];
+        }
+        [_stocks insertObject:model atIndex:MIN(index, _stocks.count)];
+        _index[key] = model;
+        [self setNeedsFlush];
+    }
+}
+
+- (StockCodeInfo *)removeStockWithSymbol:(NSString *)s type:(NSString *)t market:(NSString *)m {
+    @synchronized (self) {
+        NSString *key = stockListKey(s, t, m);
+        StockCodeInfo *exist = _index[key];
+        if (exist) {
+            [_stocks removeObjectIdenticalTo:exist];
+            [_index removeObjectForKey:key];
+            [self setNeedsFlush];
+        }
+        return exist;
+    }
+}
+
+- (void)removeLastStocksToCount:(NSUInteger)count {
+    @synchronized (self) {
+        if (_stocks.count <= count) {
+            return;
+        }
+        while (_stocks.count > count) {
+            StockCodeInfo *item = _stocks.lastObject;
+            [_index removeObjectForKey:stockListKey(item.s, item.t, item.m)];
+            [_stocks removeLastObject];
+        }
+        [self setNeedsFlush];
+    }
+}
+
+- (void)removeAllStocks {
+    [self replaceAllStocks:@[]];
+}
+
+- (void)replaceAllStocks:(NSArray<StockCodeInfo *> *)array {
+    @synchronized (self) {
+        [self resetWithArray:array];
+        [self setNeedsFlush];
+    }
+}
+
+- (void)exchangeStockAtIndex:(NSUInteger)i withStockAtIndex:(NSUInteger)ii {
+    @synchronized (self) {
+        if (i >= _stocks.count || ii >= _stocks.count) {
+            return;
+        }
+        [_stocks exchangeObjectAtIndex:i withObjectAtIndex:ii];
+        [self setNeedsFlush];
+    }
+}
+
+- (void)moveStockAtIndex:(NSUInteger)i toIndex:(NSUInteger)ii {
+    @synchronized (self) {
+        if (i >= _stocks.count || ii >= _stocks.count) {
+            return;
+        }
+        StockCodeInfo *item = [_stocks objectAtIndex:i];
+        [_stocks removeObjectAtIndex:i];
+        [_stocks insertObject:item atIndex:ii];
+        [self setNeedsFlush];
+    }
+}
+
+- (void)synchronize {
+    dispatch_sync(stockListQueue(), ^{
+        [self flush];
+    });
+}
+
+#pragma mark private
+
+//调用方需持有 self 锁
+- (void)resetWithArray:(NSArray<StockCodeInfo *> *)array {
+    [_stocks removeAllObjects];
+    [_index removeAllObjects];
+    for (StockCodeInfo *item in array) {
+        NSString *key = stockListKey(item.s, item.t, item.m);
+        if (_index[key]) {
+            continue;
+        }
+        _index[key] = item;
+        [_stocks addObject:item];
+    }
+}
+
+//调用方需持有 self 锁
+- (void)setNeedsFlush {
+    if (_flushScheduled) {
+        return;
+    }
+    _flushScheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(kStockListFlushDelay * NSEC_PER_SEC)), stockListQueue(), ^{
+        [self flush];
+    });
+}
+
+//在 stockListQueue 上执行
+- (void)load {
+    sqlite3 *db = stockListDB();
+    if (db == NULL) {
+        return;
+    }
+
+    NSArray *columns = stockListColumns();
+    NSString *sql = [NSString stringWithFormat:@"SELECT %@ FROM stock_list WHERE list = ? ORDER BY pos;", [columns componentsJoinedByString:@","]];
+    sqlite3_stmt *stmt = NULL;
+    NSMutableArray *array = [NSMutableArray array];
+    if (sqlite3_prepare_v2(db, sql.UTF8String, -1, &stmt, NULL) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, _name.UTF8String, -1, SQLITE_TRANSIENT);
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            StockCodeInfo *item = [[StockCodeInfo alloc] init];
+            for (int i = 0; i < columns.count; i++) {
+                const unsigned char *text = sqlite3_column_text(stmt, i);
+                if (text) {
+                    [item setValue:[NSString stringWithUTF8String:(const char *)text] forKey:columns[i]];
+                }
+            }
+            [array addObject:item];
+        }
+    }
+    sqlite3_finalize(stmt);
+
+    //旧版本归档文件，导入后删除
+    BOOL migrated = NO;
+    if (array.count == 0 && [[NSFileManager defaultManager] fileExistsAtPath:_legacyPath]) {
+        NSArray *legacy = [NSKeyedUnarchiver unarchiveObjectWithFile:_legacyPath];
+        if ([legacy isKindOfClass:[NSArray class]]) {
+            [array addObjectsFromArray:legacy];
+            migrated = YES;
+        }
+    }
+
+    @synchronized (self) {
+        [self resetWithArray:array];
+    }
+
+    if (migrated) {
+        if ([self flush]) {
+            [[NSFileManager defaultManager] removeItemAtPath:_legacyPath error:nil];
+        }
+    }
+}
+
+//在 stockListQueue 上执行，整表一次事务写入
+- (BOOL)flush {
+    NSMutableArray<NSArray *> *rows = [NSMutableArray array];
+    NSArray *columns = stockListColumns();
+    @synchronized (self) {
+        _flushScheduled = NO;
+        for (StockCodeInfo *item in _stocks) {
+            NSMutableArray *row = [NSMutableArray arrayWithCapacity:columns.count];
+            for (NSString *column in columns) {
+                id value = [item valueForKey:column];
+                [row addObject:[value isKindOfClass:[NSString class]] ? value : (value ? [value description] : [NSNull null])];
+            }
+            [rows addObject:row];
+        }
+    }
+
+    sqlite3 *db = stockListDB();
+    if (db == NULL) {
+        return NO;
+    }
+
+    BOOL ok = sqlite3_exec(db, "BEGIN IMMEDIATE;", NULL, NULL, NULL) == SQLITE_OK;
+
+    sqlite3_stmt *stmt = NULL;
+    if (ok && sqlite3_prepare_v2(db, "DELETE FROM stock_list WHERE list = ?;", -1, &stmt, NULL) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, _name.UTF8String, -1, SQLITE_TRANSIENT);
+        ok = sqlite3_step(stmt) == SQLITE_DONE;
+    } else {
+        ok = NO;
+    }
+    sqlite3_finalize(stmt);
+    stmt = NULL;
+
+    NSString *sql = [NSString stringWithFormat:@"INSERT INTO stock_list (list,pos,%@) VALUES (?,?%@);", [columns componentsJoinedByString:@","], [@"" stringByPaddingToLength:columns.count * 2 withString:@",?" startingAtIndex:0]];
+    if (ok && sqlite3_prepare_v2(db, sql.UTF8String, -1, &stmt, NULL) == SQLITE_OK) {
+        for (int pos = 0; pos < rows.count && ok; pos++) {
+            NSArray *row = rows[pos];
+            sqlite3_bind_text(stmt, 1, _name.UTF8String, -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int(stmt, 2, pos);
+            for (int i = 0; i < row.count; i++) {
+                if (row[i] == [NSNull null]) {
+                    sqlite3_bind_null(stmt, i + 3);
+                } else {
+                    sqlite3_bind_text(stmt, i + 3, [row[i] UTF8String], -1, SQLITE_TRANSIENT);
+                }
+            }
+            ok = sqlite3_step(stmt) == SQLITE_DONE;
+            sqlite3_reset(stmt);
+        }
+    } else {
+        ok = NO;
+    }
+    sqlite3_finalize(stmt);
+
+    if (ok) {
+        ok = sqlite3_exec(db, "COMMIT;", NULL, NULL, NULL) == SQLITE_OK;
+    }
+    if (!ok) {
+        NSLog(@"stock list %@ write fail:%s", _name, sqlite3_errmsg(db));
+        sqlite3_exec(db, "ROLLBACK;", NULL, NULL, NULL);
+    }
+    return ok;
+}
+
+@end
@@ -0,0 +1,42 @@
+//
+//  StockMentionMatcher.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ARCSingletonTemplate.h"
+#import "StockCodesModel.h"
+
+/**
+ *  文本中提到的一只股票
+ */
+@interface StockMention : NSObject
+
+@property (nonatomic, assign, readonly) NSRange range;
+@property (nonatomic, strong, readonly) StockCodeInfo *stock;
+
+@end
+
+/**
+ *  在帖子、资讯文字里找股票名称和代码
+ *
+ *  用码表的名称和代码建 Aho-Corasick 自动机，一次扫描找出全部提及，与码表大小无关；
+ *  码表更新(STOCK_CODES_UPDATE_NOTIFICATION)后在后台重建，建好前没有结果。
+ *  可在任意线程调用。
+ */
+@interface StockMentionMatcher : NSObject
+
+SYNTHESIZE_SINGLETON_FOR_HEADER(StockMentionMatcher)
+
+/**
+ *  每次重建加一，0 表示还没有码表；按文字缓存结果时用来判断是否过期
+ */
+@property (assign, atomic, readonly) NSUInteger generation;
+
+//重叠时取最靠左、再取最长的一个，结果按位置升序；代码只在前后不是字母数字时算数
+- (NSArray<StockMention *> *)mentionsInString:(NSString *)text;
+
+@end
@@ -0,0 +1,368 @@
+//
+//  StockMentionMatcher.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "StockMentionMatcher.h"
+#import "StockCodesInstance.h"
+
+//名称至少 2 个字，代码至少 5 位数字，再短误匹配太多
+static const NSUInteger kStockMentionMinNameLength = 2;
+static const NSUInteger kStockMentionMinCodeLength = 5;
+
+//自动机节点；子节点用 firstChild/nextSibling 串起来，只在求失败指针时用
+typedef struct {
+    uint32_t fail;
+    uint32_t firstChild;
+    uint32_t nextSibling;
+    int32_t output;         //以此结尾的最长模式，-1 为没有
+    unichar ch;
+} StockMentionNode;
+
+typedef struct {
+    NSUInteger start;
+    NSUInteger length;
+    int32_t pattern;
+} StockMentionCandidate;
+
+static int StockMentionCandidateCompare(const void *a, const void *b) {
+    const StockMentionCandidate *x = a, *y = b;
+    if (x->start != y->start) {
+        return x->start < y->start ? -1 : 1;
+    }
+    if (x->length != y->length) {
+        return x->length > y->length ? -1 : 1;
+    }
+    return 0;
+}
+
+static BOOL StockMentionIsAlnum(unichar ch) {
+    return (ch >= '0' && ch <= '9') || (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z');
+}
+
+static BOOL StockMentionIsIndex(StockCodeInfo *item) {
+    return [item.t intValue] == 1 || [item.t intValue] == 2;
+}
+
+@implementation StockMention
+
+- (instancetype)initWithRange:(NSRange)range stock:(StockCodeInfo *)stock {
+    self = [super init];
+    if (self) {
+        _range = range;
+        _stock = stock;
+    }
+    return self;
+}
+
+@end
+
+#pragma mark - 自动机
+
+/**
+ *  建好后只读，可多线程同时匹配
+ */
+@interface StockMentionAutomaton : NSObject
+{
+    StockMentionNode *_nodes;
+    uint32_t _nodeCount;
+    uint32_t _nodeCapacity;
+
+    //边表 (节点, 字符) -> 子节点，开放寻址，key 为 0 表示空位
+    uint64_t *_edgeKeys;
+    uint32_t *_edgeValues;
+    uint32_t _edgeMask;
+    uint32_t _edgeCount;
+
+    NSMutableArray<StockCodeInfo *> *_stocks;
+    NSMutableData *_patternLengths;     //uint16_t
+    NSMutableData *_patternIsCode;      //uint8_t
+}
+
+- (instancetype)initWithStockCodes:(NSArray<StockCodeInfo *> *)array;
+- (NSArray<StockMention *> *)mentionsInString:(NSString *)text;
+
+@end
+
+@implementation StockMentionAutomaton
+
+static inline uint64_t StockMentionEdgeKey(uint32_t node, unichar ch) {
+    return (((uint64_t)node << 16) | ch) + 1;
+}
+
+static inline uint32_t StockMentionEdgeSlot(uint64_t key, uint32_t mask) {
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+static inline uint32_t StockMentionChild(const uint64_t *keys, const uint32_t *values, uint32_t mask, uint32_t node, unichar ch) {
+    uint64_t key = StockMentionEdgeKey(node, ch);
+    for (uint32_t slot = StockMentionEdgeSlot(key, mask); keys[slot]; slot = (slot + 1) & mask) {
+        if (keys[slot] == key) {
+            return values[slot];
+        }
+    }
+    return 0;
+}
+
+- (instancetype)initWithStockCodes:(NSArray<StockCodeInfo *> *)array {
+    self = [super init];
+    if (self) {
+        _nodeCapacity = 1024;
+        _nodes = malloc(_nodeCapacity * sizeof(StockMentionNode));
+        _nodes[0] = (StockMentionNode){0, 0, 0, -1, 0};
+        _nodeCount = 1;
+
+        _edgeMask = 1023;
+        _edgeKeys = calloc(_edgeMask + 1, sizeof(uint64_t));
+        _edgeValues = malloc((_edgeMask + 1) * sizeof(uint32_t));
+
+        _stocks = [NSMutableArray arrayWithCapacity:array.count * 2];
+        _patternLengths = [NSMutableData dataWithCapacity:array.count * 2 * sizeof(uint16_t)];
+        _patternIsCode = [NSMutableData dataWithCapacity:array.count * 2];
+
+        for (StockCodeInfo *item in array) {
+            NSString *name = [item.n isKindOfClass:[NSString class]] ? item.n : nil;
+            if (name.length >= kStockMentionMinNameLength) {
+                [self addPattern:name stock:item isCode:NO];
+            }
+            NSString *code = item.s ? [NSString stringWithFormat:@"%@", item.s] : nil;
+            if (code.length >= kStockMentionMinCodeLength
+                && [code rangeOfCharacterFromSet:[[NSCharacterSet decimalDigitCharacterSet] invertedSet]].location == NSNotFound) {
+                [self addPattern:code stock:item isCode:YES];
+            }
+        }
+        [self buildFailureLinks];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_nodes);
+    free(_edgeKeys);
+    free(_edgeValues);
+}
+
+- (uint32_t)childOf:(uint32_t)node ch:(unichar)ch {
+    return StockMentionChild(_edgeKeys, _edgeValues, _edgeMask, node, ch);
+}
+
+- (void)setChild:(uint32_t)child of:(uint32_t)node ch:(unichar)ch {
+    //装填超过一半时加倍
+    if ((_edgeCount + 1) * 2 > _edgeMask + 1) {
+        uint32_t oldMask = _edgeMask;
+        uint64_t *oldKeys = _edgeKeys;
+        uint32_t *oldValues = _edgeValues;
+        _edgeMask = oldMask * 2 + 1;
+        _edgeKeys = calloc(_edgeMask + 1, sizeof(uint64_t));
+        _edgeValues = malloc((_edgeMask + 1) * sizeof(uint32_t));
+        for (uint32_t i = 0; i <= oldMask; i++) {
+            if (oldKeys[i]) {
+                uint32_t slot = StockMentionEdgeSlot(oldKeys[i], _edgeMask);
+                while (_edgeKeys[slot]) {
+                    slot = (slot + 1) & _edgeMask;
+                }
+                _edgeKeys[slot] = oldKeys[i];
+                _edgeValues[slot] = oldValues[i];
+            }
+        }
+        free(oldKeys);
+        free(oldValues);
+    }
+    uint64_t key = StockMentionEdgeKey(node, ch);
+    uint32_t slot = StockMentionEdgeSlot(key, _edgeMask);
+    while (_edgeKeys[slot]) {
+        slot = (slot + 1) & _edgeMask;
+    }
+    _edgeKeys[slot] = key;
+    _edgeValues[slot] = child;
+    _edgeCount++;
+}
+
+- (void)addPattern:(NSString *)pattern stock:(StockCodeInfo *)stock isCode:(BOOL)isCode {
+    if (pattern.length > UINT16_MAX) {
+        return;
+    }
+    uint32_t node = 0;
+    for (NSUInteger i = 0; i < pattern.length; i++) {
+        unichar ch = [pattern characterAtIndex:i];
+        uint32_t next = [self childOf:node ch:ch];
+        if (next == 0) {
+            if (_nodeCount == _nodeCapacity) {
+                _nodeCapacity *= 2;
+                _nodes = realloc(_nodes, _nodeCapacity * sizeof(StockMentionNode));
+            }
+            next = _nodeCount++;
+            _nodes[next] = (StockMentionNode){0, 0, _nodes[node].firstChild, -1, ch};
+            _nodes[node].firstChild = next;
+            [self setChild:next of:node ch:ch];
+        }
+        node = next;
+    }
+
+    //同一个名称或代码对应多只时取第一只，代码同时是指数和个股时取个股
+    int32_t existing = _nodes[node].output;
+    if (existing >= 0) {
+        if (!(StockMentionIsIndex(_stocks[existing]) && !StockMentionIsIndex(stock))) {
+            return;
+        }
+        _stocks[existing] = stock;
+        return;
+    }
+    uint16_t length = (uint16_t)pattern.length;
+    uint8_t code = isCode;
+    _nodes[node].output = (int32_t)_stocks.count;
+    [_stocks addObject:stock];
+    [_patternLengths appendBytes:&length length:sizeof(length)];
+    [_patternIsCode appendBytes:&code length:sizeof(code)];
+}
+
+//按层求失败指针；没有自己模式的节点继承失败指针上的最长模式
+- (void)buildFailureLinks {
+    uint32_t *queue = malloc(_nodeCount * sizeof(uint32_t));
+    uint32_t head = 0, tail = 0;
+    for (uint32_t c = _nodes[0].firstChild; c; c = _nodes[c].nextSibling) {
+        _nodes[c].fail = 0;
+        queue[tail++] = c;
+    }
+    while (head < tail) {
+        uint32_t u = queue[head++];
+        for (uint32_t c = _nodes[u].firstChild; c; c = _nodes[c].nextSibling) {
+            unichar ch = _nodes[c].ch;
+            uint32_t f = _nodes[u].fail;
+            uint32_t g;
+            while ((g = [self childOf:f ch:ch]) == 0 && f != 0) {
+                f = _nodes[f].fail;
+            }
+            _nodes[c].fail = g;
+            if (_nodes[c].output < 0) {
+                _nodes[c].output = _nodes[g].output;
+            }
+            queue[tail++] = c;
+        }
+    }
+    free(queue);
+}
+
+- (NSArray<StockMention *> *)mentionsInString:(NSString *)text {
+    NSUInteger length = text.length;
+    if (length == 0 || _stocks.count == 0) {
+        return @[];
+    }
+    unichar *chars = malloc(length * sizeof(unichar));
+    [text getCharacters:chars range:NSMakeRange(0, length)];
+    const uint16_t *lengths = _patternLengths.bytes;
+    const uint8_t *isCode = _patternIsCode.bytes;
+
+    NSUInteger candidateCapacity = 16, candidateCount = 0;
+    StockMentionCandidate *candidates = malloc(candidateCapacity * sizeof(StockMentionCandidate));
+
+    uint32_t state = 0;
+    for (NSUInteger i = 0; i < length; i++) {
+        unichar ch = chars[i];
+        uint32_t next;
+        while ((next = StockMentionChild(_edgeKeys, _edgeValues, _edgeMask, state, ch)) == 0 && state != 0) {
+            state = _nodes[state].fail;
+        }
+        state = next;
+        int32_t pattern = _nodes[state].output;
+        if (pattern < 0) {
+            continue;
+        }
+        NSUInteger end = i + 1;
+        NSUInteger start = end - lengths[pattern];
+        if (isCode[pattern]
+            && ((start > 0 && StockMentionIsAlnum(chars[start - 1])) || (end < length && StockMentionIsAlnum(chars[end])))) {
+            continue;
+        }
+        if (candidateCount == candidateCapacity) {
+            candidateCapacity *= 2;
+            candidates = realloc(candidates, candidateCapacity * sizeof(StockMentionCandidate));
+        }
+        candidates[candidateCount++] = (StockMentionCandidate){start, lengths[pattern], pattern};
+    }
+    free(chars);
+
+    qsort(candidates, candidateCount, sizeof(StockMentionCandidate), StockMentionCandidateCompare);
+    NSMutableArray *mentions = [NSMutableArray array];
+    NSUInteger lastEnd = 0;
+    for (NSUInteger i = 0; i < candidateCount; i++) {
+        if (candidates[i].start < lastEnd) {
+            continue;
+        }
+        lastEnd = candidates[i].start + candidates[i].length;
+        NSRange range = NSMakeRange(candidates[i].start, candidates[i].length);
+        [mentions addObject:[[StockMention alloc] initWithRange:range stock:_stocks[candidates[i].pattern]]];
+    }
+    free(candidates);
+    return mentions;
+}
+
+@end
+
+#pragma mark -
+
+@interface StockMentionMatcher ()
+
+@property (strong, atomic) StockMentionAutomaton *automaton;
+@property (assign, atomic, readwrite) NSUInteger generation;
+
+@end
+
+@implementation StockMentionMatcher
+{
+    dispatch_queue_t _buildQueue;
+    BOOL _buildScheduled;
+    NSArray *_builtArray;
+}
+SYNTHESIZE_SINGLETON_FOR_CLASS(StockMentionMatcher)
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _buildQueue = dispatch_queue_create("com.newstock.stockmention", DISPATCH_QUEUE_SERIAL);
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(stockCodesDidUpdate:) name:STOCK_CODES_UPDATE_NOTIFICATION object:nil];
+        [self scheduleBuild];
+    }
+    return self;
+}
+
+- (void)stockCodesDidUpdate:(NSNotification *)notification {
+    [self scheduleBuild];
+}
+
+//首次解析码表时会连续发布几次部分数据，排队中的重建只保留一次，建时取最新的码表
+- (void)scheduleBuild {
+    @synchronized (self) {
+        if (_buildScheduled) {
+            return;
+        }
+        _buildScheduled = YES;
+    }
+    dispatch_async(_buildQueue, ^{
+        @synchronized (self) {
+            _buildScheduled = NO;
+        }
+        NSArray *array = [StockCodesInstance sharedStockCodesInstance].stockCodesArray;
+        if (array.count == 0 || array == _builtArray) {
+            return;
+        }
+        _builtArray = array;
+        @autoreleasepool {
+            self.automaton = [[StockMentionAutomaton alloc] initWithStockCodes:array];
+        }
+        self.generation = self.generation + 1;
+    });
+}
+
+- (NSArray<StockMention *> *)mentionsInString:(NSString *)text {
+    StockMentionAutomaton *automaton = self.automaton;
+    if (automaton == nil || text.length == 0) {
+        return @[];
+    }
+    return [automaton mentionsInString:text];
+}
+
+@end
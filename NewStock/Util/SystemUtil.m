@@ -33,6 +33,7 @@
 #import "AppDelegate.h"
 
 #import "JPUSHService.h"
+#import "CacheStore.h"
 
 @implementation SystemUtil
 
@@ -156,23 +157,13 @@
 
 //判断用户是否登录
 + (BOOL)isSignIn {
-    BOOL flag = NO;
-    if ([[NSUserDefaults standardUserDefaults] objectForKey:USER_NAME]) {
-        if (! [[[NSUserDefaults standardUserDefaults] objectForKey:USER_NAME] isEqualToString:@""]) {
-            flag = YES;
-        }
-    }
-    return flag;
+    return [SystemUtil getCache:USER_NAME].length > 0;
 }
 
 //退出登录
 + (void)signOut {
-    [[NSUserDefaults standardUserDefaults] setObject:@"" forKey:USER_ID];
-    [[NSUserDefaults standardUserDefaults] removeObjectForKey:USER_ID];
-    
-    [[NSUserDefaults standardUserDefaults] setObject:@"" forKey:USER_NAME];
-    [[NSUserDefaults standardUserDefaults] removeObjectForKey:USER_NAME];
-    [[NSUserDefaults standardUserDefaults] synchronize];
+    [[CacheStore sharedCacheStore] removeObjectForKey:USER_ID];
+    [[CacheStore sharedCacheStore] removeObjectForKey:USER_NAME];
     
     //设置推送别名
     [JPUSHService setTags:nil alias:@"" fetchCompletionHandle:nil];
@@ -215,17 +206,12 @@
     [[UIApplication sharedApplication] openURL:[NSURL URLWithString:[@"telprompt://" stringByAppendingString:num]]];
 }
 
-//用NSUserDefaults来保存用户注册的用户名密码。
+//用CacheStore来保存用户注册的用户名密码及各类配置，异步落盘。
 + (NSString *)getCache:(NSString *)k {
-    NSString *v = [[NSUserDefaults standardUserDefaults] objectForKey:k];
-    if (!v) {
-        v = @"";
-    }
-    return v;
+    return [[CacheStore sharedCacheStore] stringForKey:k];
 }
 + (void)putCache:(NSString *)k value:(NSString *)v {
-    [[NSUserDefaults standardUserDefaults] setObject:v forKey:k];
-    [[NSUserDefaults standardUserDefaults] synchronize];
+    [[CacheStore sharedCacheStore] setString:v forKey:k];
     
     if ([k isEqualToString:USER_ID])
     {
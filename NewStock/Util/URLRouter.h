@@ -0,0 +1,69 @@
+//
+//  URLRouter.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import "ARCSingletonTemplate.h"
+
+/**
+ *  一次匹配的结果
+ */
+@interface URLRouteMatch : NSObject
+
+@property (nonatomic, copy, readonly) NSString *URLString;
+
+//命中的路由
+@property (nonatomic, copy, readonly) NSString *pattern;
+
+//路径参数(:name)和 query 参数，同名时路径参数优先；值已做百分号解码
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, NSString *> *parameters;
+
+//原始 query，不含 ?，没有时为 nil
+@property (nonatomic, copy, readonly) NSString *query;
+
+//* 匹配到的剩余路径，没有时为 nil
+@property (nonatomic, copy, readonly) NSString *wildcardPath;
+
+//取不到或为空串时返回 nil
+- (NSString *)stringForKey:(NSString *)key;
+- (NSInteger)integerForKey:(NSString *)key;
+- (BOOL)boolForKey:(NSString *)key;
+
+//同 stringForKey:
+- (NSString *)objectForKeyedSubscript:(NSString *)key;
+
+@end
+
+typedef void(^URLRouteHandler)(URLRouteMatch *match);
+
+/**
+ *  URL 路由
+ *
+ *  路由形如 native://HQ1000、component://CM0102、https://www.guguaixia.com/eagle-frontap/jiabei/:code、
+ *  shortcut://*。注册时按 scheme、host、各级路径拆成节点建前缀树，匹配时逐段查表，耗时只与 URL 段数有关。
+ *
+ *  - scheme 和 host 不区分大小写，http 与 https 视为同一个 scheme；路径区分大小写
+ *  - :name 匹配任意一段并作为参数取出；* 只能放在最后，匹配剩下的零到多段
+ *  - 同一位置精确段优先于 :name，走不通时退回到经过的最深一个 *，不再回头试 :name
+ *  - 不依赖 NSURL 解析，未转义的中文、JSON 参数也能匹配
+ *
+ *  推送、3D Touch、原生入口和 H5 里的链接都经 sharedURLRouter 分发，只在主线程使用。
+ */
+@interface URLRouter : NSObject
+
+SYNTHESIZE_SINGLETON_FOR_HEADER(URLRouter)
+
+//同一个路由重复注册时后注册的生效
+- (void)registerPattern:(NSString *)pattern handler:(URLRouteHandler)handler;
+
+//只匹配不执行，没有命中返回 nil
+- (URLRouteMatch *)matchURLString:(NSString *)URLString;
+
+//命中时执行 handler 并返回 YES
+- (BOOL)routeURLString:(NSString *)URLString;
+
+@end
@@ -0,0 +1,236 @@
+//
+//  URLRouter.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "URLRouter.h"
+#import "UrlRedirectAction.h"
+
+static NSString * const kURLRouterWildcard = @"*";
+
+//scheme://host/a/b?query#fragment -> [scheme, host, a, b]，scheme、host 转小写，http 记作 https
+static NSArray<NSString *> *URLRouterTokens(NSString *string, NSString **query) {
+    NSRange schemeRange = [string rangeOfString:@"://"];
+    if (schemeRange.location == NSNotFound || schemeRange.location == 0) {
+        return nil;
+    }
+    NSString *scheme = [string substringToIndex:schemeRange.location].lowercaseString;
+    if ([scheme isEqualToString:@"http"]) {
+        scheme = @"https";
+    }
+
+    NSString *rest = [string substringFromIndex:NSMaxRange(schemeRange)];
+    NSRange queryRange = [rest rangeOfString:@"?"];
+    NSRange fragmentRange = [rest rangeOfString:@"#"];
+    if (fragmentRange.location != NSNotFound && (queryRange.location == NSNotFound || fragmentRange.location < queryRange.location)) {
+        queryRange = NSMakeRange(NSNotFound, 0);
+    }
+    if (queryRange.location != NSNotFound) {
+        if (query) {
+            NSString *tail = [rest substringFromIndex:NSMaxRange(queryRange)];
+            NSRange end = [tail rangeOfString:@"#"];
+            *query = end.location == NSNotFound ? tail : [tail substringToIndex:end.location];
+        }
+        rest = [rest substringToIndex:queryRange.location];
+    } else if (fragmentRange.location != NSNotFound) {
+        rest = [rest substringToIndex:fragmentRange.location];
+    }
+
+    NSMutableArray *tokens = [NSMutableArray arrayWithObject:scheme];
+    for (NSString *segment in [rest componentsSeparatedByString:@"/"]) {
+        if (segment.length == 0) {
+            continue;
+        }
+        [tokens addObject:tokens.count == 1 ? segment.lowercaseString : segment];
+    }
+    return tokens;
+}
+
+@interface URLRouteNode : NSObject
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, URLRouteNode *> *children;
+@property (nonatomic, strong) URLRouteNode *paramChild;
+@property (nonatomic, copy) NSString *paramName;
+
+//到这个节点正好结束的路由
+@property (nonatomic, copy) NSString *pattern;
+@property (nonatomic, copy) URLRouteHandler handler;
+
+//这个节点之后接 * 的路由
+@property (nonatomic, copy) NSString *wildcardPattern;
+@property (nonatomic, copy) URLRouteHandler wildcardHandler;
+
+@end
+
+@implementation URLRouteNode
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _children = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+@end
+
+@interface URLRouteMatch ()
+
+@property (nonatomic, copy, readwrite) NSString *URLString;
+@property (nonatomic, copy, readwrite) NSString *pattern;
+@property (nonatomic, copy, readwrite) NSDictionary<NSString *, NSString *> *parameters;
+@property (nonatomic, copy, readwrite) NSString *query;
+@property (nonatomic, copy, readwrite) NSString *wildcardPath;
+@property (nonatomic, copy) URLRouteHandler handler;
+
+@end
+
+@implementation URLRouteMatch
+
+- (NSString *)stringForKey:(NSString *)key {
+    NSString *value = self.parameters[key];
+    return value.length ? value : nil;
+}
+
+- (NSInteger)integerForKey:(NSString *)key {
+    return [self stringForKey:key].integerValue;
+}
+
+- (BOOL)boolForKey:(NSString *)key {
+    return [self stringForKey:key].boolValue;
+}
+
+- (NSString *)objectForKeyedSubscript:(NSString *)key {
+    return [self stringForKey:key];
+}
+
+@end
+
+@implementation URLRouter
+{
+    URLRouteNode *_root;
+}
+SYNTHESIZE_SINGLETON_FOR_CLASS(URLRouter)
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _root = [URLRouteNode new];
+    }
+    return self;
+}
+
+- (void)registerPattern:(NSString *)pattern handler:(URLRouteHandler)handler {
+    NSArray<NSString *> *tokens = URLRouterTokens(pattern, NULL);
+    NSAssert(tokens.count && handler, @"invalid route %@", pattern);
+    if (tokens.count == 0 || handler == nil) {
+        return;
+    }
+
+    URLRouteNode *node = _root;
+    for (NSUInteger i = 0; i < tokens.count; i++) {
+        NSString *token = tokens[i];
+        if ([token isEqualToString:kURLRouterWildcard]) {
+            NSAssert(i == tokens.count - 1, @"* must be the last segment: %@", pattern);
+            node.wildcardPattern = pattern;
+            node.wildcardHandler = handler;
+            return;
+        }
+        if ([token hasPrefix:@":"] && token.length > 1) {
+            NSString *name = [token substringFromIndex:1];
+            if (node.paramChild == nil) {
+                node.paramChild = [URLRouteNode new];
+                node.paramChild.paramName = name;
+            }
+            NSAssert([node.paramChild.paramName isEqualToString:name], @"conflicting parameter name in %@", pattern);
+            node = node.paramChild;
+            continue;
+        }
+        URLRouteNode *child = node.children[token];
+        if (child == nil) {
+            child = [URLRouteNode new];
+            node.children[token] = child;
+        }
+        node = child;
+    }
+    node.pattern = pattern;
+    node.handler = handler;
+}
+
+- (URLRouteMatch *)matchURLString:(NSString *)URLString {
+    NSString *query = nil;
+    NSArray<NSString *> *tokens = URLRouterTokens(URLString, &query);
+    if (tokens.count == 0) {
+        return nil;
+    }
+
+    NSMutableDictionary *pathParameters = [NSMutableDictionary dictionary];
+    URLRouteNode *node = _root;
+    //经过的最深一个 *
+    URLRouteNode *wildcardNode = nil;
+    NSUInteger wildcardIndex = 0;
+    NSDictionary *wildcardParameters = nil;
+
+    NSUInteger index = 0;
+    for (; index < tokens.count; index++) {
+        if (node.wildcardHandler) {
+            wildcardNode = node;
+            wildcardIndex = index;
+            wildcardParameters = [pathParameters copy];
+        }
+        NSString *token = tokens[index];
+        URLRouteNode *next = node.children[token];
+        if (next == nil && node.paramChild) {
+            next = node.paramChild;
+            pathParameters[next.paramName] = [token stringByRemovingPercentEncoding] ?: token;
+        }
+        if (next == nil) {
+            node = nil;
+            break;
+        }
+        node = next;
+    }
+
+    URLRouteMatch *match = [URLRouteMatch new];
+    if (node.handler) {
+        match.pattern = node.pattern;
+        match.handler = node.handler;
+    } else if (node.wildcardHandler) {
+        //* 匹配零段
+        match.pattern = node.wildcardPattern;
+        match.handler = node.wildcardHandler;
+        match.wildcardPath = @"";
+    } else if (wildcardNode) {
+        match.pattern = wildcardNode.wildcardPattern;
+        match.handler = wildcardNode.wildcardHandler;
+        match.wildcardPath = [[tokens subarrayWithRange:NSMakeRange(wildcardIndex, tokens.count - wildcardIndex)] componentsJoinedByString:@"/"];
+        pathParameters = [wildcardParameters mutableCopy];
+    } else {
+        return nil;
+    }
+
+    NSMutableDictionary *parameters = [NSMutableDictionary dictionary];
+    if (query.length) {
+        [parameters addEntriesFromDictionary:[UrlRedirectAction parseURLParams:query]];
+    }
+    [parameters addEntriesFromDictionary:pathParameters];
+
+    match.URLString = URLString;
+    match.query = query;
+    match.parameters = parameters;
+    return match;
+}
+
+- (BOOL)routeURLString:(NSString *)URLString {
+    URLRouteMatch *match = [self matchURLString:URLString];
+    if (match == nil) {
+        return NO;
+    }
+    match.handler(match);
+    return YES;
+}
+
+@end
@@ -0,0 +1,54 @@
+//
+//  UploadImageEncoder.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import "ARCSingletonTemplate.h"
+
+//各场景上传图片的长边上限(px)
+static const CGFloat kUploadImagePostMaxPixel = 5000;
+static const CGFloat kUploadImageAvatarMaxPixel = 640;
+static const CGFloat kUploadImageShareMaxPixel = 1600;
+
+/**
+ *  编码好的待上传图片，对应 tmp 下的一个 jpg 文件，对象释放时删除文件
+ */
+@interface UploadImageFile : NSObject
+
+@property (nonatomic, strong, readonly) NSURL *fileURL;
+
+//文件字节数，用于上传前的总大小检查
+@property (nonatomic, assign, readonly) unsigned long long length;
+
+//编码后的像素尺寸
+@property (nonatomic, assign, readonly) CGSize pixelSize;
+
+//文件内容的 md5，同一张图片重复上传时据此复用上次的结果
+@property (nonatomic, copy, readonly) NSString *digest;
+
+@end
+
+/**
+ *  上传图片编码
+ *
+ *  在后台串行队列上逐张把图片缩到长边不超过 maxPixel，以 quality 编码成 jpg 写入临时文件，
+ *  同一时刻只有一张图片的位图在内存中。上传时 multipart body 直接从这些文件读取，
+ *  大小检查也只看文件长度，不再重复编码。
+ */
+@interface UploadImageEncoder : NSObject
+
+SYNTHESIZE_SINGLETON_FOR_HEADER(UploadImageEncoder)
+
+//完成后在主线程回调，files 与 images 一一对应；任意一张失败时 files 为 nil
+- (void)encodeImages:(NSArray<UIImage *> *)images
+            maxPixel:(CGFloat)maxPixel
+             quality:(CGFloat)quality
+          completion:(void (^)(NSArray<UploadImageFile *> *files))completion;
+
++ (unsigned long long)totalLengthOfFiles:(NSArray<UploadImageFile *> *)files;
+
+@end
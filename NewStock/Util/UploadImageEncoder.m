@@ -0,0 +1,174 @@
+//
+//  UploadImageEncoder.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "UploadImageEncoder.h"
+#import <ImageIO/ImageIO.h>
+#import <CommonCrypto/CommonDigest.h>
+
+static NSString *UploadImageDirectory(void) {
+    return [NSTemporaryDirectory() stringByAppendingPathComponent:@"upload_images"];
+}
+
+//UIImageOrientation 对应的 EXIF 方向
+static NSInteger UploadImageEXIFOrientation(UIImageOrientation orientation) {
+    switch (orientation) {
+        case UIImageOrientationUp:            return 1;
+        case UIImageOrientationUpMirrored:    return 2;
+        case UIImageOrientationDown:          return 3;
+        case UIImageOrientationDownMirrored:  return 4;
+        case UIImageOrientationLeftMirrored:  return 5;
+        case UIImageOrientationRight:         return 6;
+        case UIImageOrientationRightMirrored: return 7;
+        case UIImageOrientationLeft:          return 8;
+    }
+    return 1;
+}
+
+static NSString *UploadImageFileDigest(NSURL *fileURL) {
+    NSData *data = [NSData dataWithContentsOfURL:fileURL options:NSDataReadingMappedIfSafe error:nil];
+    if (data == nil) {
+        return nil;
+    }
+    unsigned char result[CC_MD5_DIGEST_LENGTH];
+    CC_MD5(data.bytes, (CC_LONG)data.length, result);
+    NSMutableString *digest = [NSMutableString stringWithCapacity:CC_MD5_DIGEST_LENGTH * 2];
+    for (NSInteger i = 0; i < CC_MD5_DIGEST_LENGTH; i++) {
+        [digest appendFormat:@"%02x", result[i]];
+    }
+    return digest;
+}
+
+@interface UploadImageFile ()
+
+@property (nonatomic, strong, readwrite) NSURL *fileURL;
+@property (nonatomic, assign, readwrite) unsigned long long length;
+@property (nonatomic, assign, readwrite) CGSize pixelSize;
+@property (nonatomic, copy, readwrite) NSString *digest;
+
+@end
+
+@implementation UploadImageFile
+
+- (void)dealloc {
+    if (_fileURL) {
+        [[NSFileManager defaultManager] removeItemAtURL:_fileURL error:nil];
+    }
+}
+
+@end
+
+@implementation UploadImageEncoder
+{
+    dispatch_queue_t _queue;
+}
+SYNTHESIZE_SINGLETON_FOR_CLASS(UploadImageEncoder)
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("com.newstock.uploadimage", DISPATCH_QUEUE_SERIAL);
+        dispatch_async(_queue, ^{
+            //上次异常退出时留下的文件
+            NSFileManager *fileManager = [NSFileManager defaultManager];
+            [fileManager removeItemAtPath:UploadImageDirectory() error:nil];
+            [fileManager createDirectoryAtPath:UploadImageDirectory() withIntermediateDirectories:YES attributes:nil error:nil];
+        });
+    }
+    return self;
+}
+
+- (void)encodeImages:(NSArray<UIImage *> *)images
+            maxPixel:(CGFloat)maxPixel
+             quality:(CGFloat)quality
+          completion:(void (^)(NSArray<UploadImageFile *> *))completion {
+    NSArray *pending = [images copy];
+    dispatch_async(_queue, ^{
+        NSMutableArray *files = [NSMutableArray arrayWithCapacity:pending.count];
+        for (UIImage *image in pending) {
+            UploadImageFile *file = nil;
+            @autoreleasepool {
+                file = [self private_encodeImage:image maxPixel:maxPixel quality:quality];
+            }
+            if (file == nil) {
+                files = nil;
+                break;
+            }
+            [files addObject:file];
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (completion) {
+                completion(files);
+            }
+        });
+    });
+}
+
++ (unsigned long long)totalLengthOfFiles:(NSArray<UploadImageFile *> *)files {
+    unsigned long long length = 0;
+    for (UploadImageFile *file in files) {
+        length += file.length;
+    }
+    return length;
+}
+
+#pragma mark private
+
+- (UploadImageFile *)private_encodeImage:(UIImage *)image maxPixel:(CGFloat)maxPixel quality:(CGFloat)quality {
+    CGSize pixelSize = CGSizeMake(image.size.width * image.scale, image.size.height * image.scale);
+    if (pixelSize.width <= 0 || pixelSize.height <= 0) {
+        return nil;
+    }
+
+    //不用缩放时直接写原 CGImage 并带上方向，省一次重绘
+    CGImageRef imageRef = image.CGImage;
+    NSInteger orientation = UploadImageEXIFOrientation(image.imageOrientation);
+    UIImage *resized = nil;
+    CGFloat longEdge = MAX(pixelSize.width, pixelSize.height);
+    if (imageRef == NULL || (maxPixel > 0 && longEdge > maxPixel)) {
+        CGFloat factor = (maxPixel > 0 && longEdge > maxPixel) ? maxPixel / longEdge : 1;
+        pixelSize = CGSizeMake(floor(pixelSize.width * factor), floor(pixelSize.height * factor));
+        UIGraphicsBeginImageContextWithOptions(pixelSize, YES, 1);
+        [[UIColor whiteColor] setFill];
+        UIRectFill(CGRectMake(0, 0, pixelSize.width, pixelSize.height));
+        [image drawInRect:CGRectMake(0, 0, pixelSize.width, pixelSize.height)];
+        resized = UIGraphicsGetImageFromCurrentImageContext();
+        UIGraphicsEndImageContext();
+        imageRef = resized.CGImage;
+        orientation = 1;
+    }
+    if (imageRef == NULL) {
+        return nil;
+    }
+
+    NSString *path = [UploadImageDirectory() stringByAppendingPathComponent:[[NSUUID UUID].UUIDString stringByAppendingPathExtension:@"jpg"]];
+    NSURL *fileURL = [NSURL fileURLWithPath:path];
+    CGImageDestinationRef destination = CGImageDestinationCreateWithURL((__bridge CFURLRef)fileURL, CFSTR("public.jpeg"), 1, NULL);
+    if (destination == NULL) {
+        return nil;
+    }
+    NSDictionary *properties = @{
+                                 (id)kCGImageDestinationLossyCompressionQuality : @(quality),
+                                 (id)kCGImagePropertyOrientation : @(orientation),
+                                 };
+    CGImageDestinationAddImage(destination, imageRef, (__bridge CFDictionaryRef)properties);
+    BOOL finished = CGImageDestinationFinalize(destination);
+    CFRelease(destination);
+    if (!finished) {
+        [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+        return nil;
+    }
+
+    UploadImageFile *file = [UploadImageFile new];
+    file.fileURL = fileURL;
+    file.length = [[[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil] fileSize];
+    file.pixelSize = pixelSize;
+    file.digest = UploadImageFileDigest(fileURL);
+    return file;
+}
+
+@end
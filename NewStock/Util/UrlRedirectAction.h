@@ -34,6 +34,9 @@
 
 SYNTHESIZE_SINGLETON_FOR_HEADER(UrlRedirectAction)
 
+//把 component:// 和 H5 页面路由注册到 sharedURLRouter，启动时调用一次
++ (void)registerRoutes;
+
 
 + (BOOL)redirectActionWithUrl:(NSURL *)url from:(NSString *)fromUrlStr navigationType:(UIWebViewNavigationType)navigationType;
 
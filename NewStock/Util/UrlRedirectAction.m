@@ -23,6 +23,7 @@
 
 #import "NewMomentViewController.h"
 #import "FollowAndFansController.h"
+#import "URLRouter.h"
 
 @interface UrlRedirectAction ()
 
@@ -33,214 +34,110 @@
 @implementation UrlRedirectAction
 SYNTHESIZE_SINGLETON_FOR_CLASS(UrlRedirectAction)
 
-+ (BOOL)redirectActionWithUrl:(NSURL *)url from:(NSString *)fromUrlStr navigationType:(UIWebViewNavigationType)navigationType {
-
-    NSLog(@"%@",url.relativeString);
-    NSLog(@"%@",url.absoluteString);
-    NSLog(@"%@",url.parameterString);
-    NSLog(@"%@",url.path);
-    NSLog(@"%@",url.relativePath);
-    NSLog(@"%@",url.query);
-    NSString *strUrl = url.absoluteString;
-
-    if ([strUrl hasPrefix:@"native://"])
-    {
-        NSString *subUrl = [strUrl substringFromIndex:9];
++ (void)registerRoutes {
+    URLRouter *router = [URLRouter sharedURLRouter];
+    
+    //component://
+    [router registerPattern:@"component://CM0103" handler:^(URLRouteMatch *match) {
+        NSRange range = [match.query rangeOfString:@"="];
+        TipOffViewController *viewController = [[TipOffViewController alloc] init];
+        viewController.contentId = range.location == NSNotFound ? @"" : [match.query substringFromIndex:NSMaxRange(range)];
+        viewController.ty = @"S_COMMENT";
+        [[self private_navigationController] pushViewController:viewController animated:YES];
+    }];
+    [router registerPattern:@"component://CM0102" handler:^(URLRouteMatch *match) {
+        [UrlRedirectAction sharedUrlRedirectAction].fid = match[@"fid"];
+        [UrlRedirectAction sharedUrlRedirectAction].rpid = match[@"id"];
+        [UrlRedirectAction sharedUrlRedirectAction].rpuid = match[@"rpuid"];
+        [BlurCommentView commentshowDelegate:[UrlRedirectAction sharedUrlRedirectAction]];
+    }];
+    [router registerPattern:@"component://FX0000" handler:^(URLRouteMatch *match) {
+        NSString *tt = match[@"tt"];
+        UIImage *image = [UIImage imageNamed:@"shareLogo"];
         
-        if ([subUrl hasPrefix:@"HQ1000"])
-        {
-            NSLog(@"%@",[subUrl substringFromIndex:7]);
-
-            NSDictionary *dic = [UrlRedirectAction parseURLParams:[subUrl substringFromIndex:7]];
-            
-            NSString *symbolTyp = [dic objectForKey:@"symbolTyp"];
-            if (([symbolTyp intValue] == 1) || ([symbolTyp intValue] == 2))
-            {
-                IndexChartViewController *viewController = [[IndexChartViewController alloc] init];
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                
-                IndexInfoModel *model = [[IndexInfoModel alloc] init];
-                model.marketCd = [dic objectForKey:@"marketCd"];
-                model.symbol = [dic objectForKey:@"symbol"];
-                model.symbolName = @"";
-                model.symbolTyp = [dic objectForKey:@"symbolTyp"];
-                if (!(model.marketCd && model.symbol && model.symbolTyp)) {
-                    return NO;
-                }
-                viewController.indexModel = model;
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
-            } else {
-                StockListModel *model = [[StockListModel alloc] init];
-                model.marketCd = [dic objectForKey:@"marketCd"];
-                model.symbol = [dic objectForKey:@"symbol"];
-                model.symbolName = @"";
-                model.symbolTyp = [dic objectForKey:@"symbolTyp"];
-                if (!(model.marketCd && model.symbol && model.symbolTyp)) {
-                    return NO;
-                }
-                StockChartViewController *viewController = [[StockChartViewController alloc] init];
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                viewController.stockListModel = model;
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
+        NSString *u = [NSString stringWithFormat:@"%@%@?id=%@",API_URL,H5_TALK_SHARE,match[@"id"]];
+        u = [u stringByReplacingOccurrencesOfString:@"https://" withString:@"http://"];
+        u = [u stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
+        u = [u stringByAppendingString:@"&from=ios"];
+        NSString *content = [NSString stringWithFormat:@"股怪侠-%@",@"说闻解股"];
+        
+        [SharedInstance sharedSharedInstance].image = image;
+        [SharedInstance sharedSharedInstance].tt = tt;
+        [SharedInstance sharedSharedInstance].c = content;
+        [SharedInstance sharedSharedInstance].url = u;
+        [SharedInstance sharedSharedInstance].sid = match[@"id"];
+        [SharedInstance sharedSharedInstance].res_code = @"S_HOTNEWS";
+        [[SharedInstance sharedSharedInstance] shareWithImage:NO];
+    }];
+    [router registerPattern:@"component://sheet" handler:^(URLRouteMatch *match) {
+        [[NSNotificationCenter defaultCenter] postNotificationName:HOLDING_SHEET_MSG object:nil userInfo:nil];
+    }];
+    
+    //H5 页面，match.URLString 已转义
+    [router registerPattern:[API_URL stringByAppendingString:@"jiabei/HP0105"] handler:^(URLRouteMatch *match) {
+        WebViewController *viewController = [[WebViewController alloc] init];
+        viewController.myUrl = match.URLString;
+        viewController.type = WEB_VIEW_TYPE_ZIXUN;
+        viewController.hasParam = YES;
+        [[self private_navigationController] pushViewController:viewController animated:YES];
+    }];
+    URLRouteHandler otherHandler = ^(URLRouteMatch *match) {
+        WebViewController *viewController = [[WebViewController alloc] init];
+        viewController.myUrl = match.URLString;
+        viewController.type = WEB_VIEW_TYPE_OTHER;
+        [[self private_navigationController] pushViewController:viewController animated:YES];
+    };
+    for (NSString *code in @[@"HQ1003", @"HQ1007", @"HQ1008", @"HQ1009"]) {
+        [router registerPattern:[NSString stringWithFormat:@"%@jiabei/%@", API_URL, code] handler:otherHandler];
+    }
+    [router registerPattern:[API_URL stringByAppendingString:@"jiabei/FM0301"] handler:^(URLRouteMatch *match) {
+        WebViewController *viewController = [[WebViewController alloc] init];
+        viewController.myUrl = match.URLString;
+        viewController.type = WEB_VIEW_TYPE_BAGUA;
+        [[self private_navigationController] pushViewController:viewController animated:YES];
+    }];
+    [router registerPattern:[API_URL stringByAppendingString:@"jiabei/MY9902"] handler:^(URLRouteMatch *match) {
+        WebViewController *viewController = [[WebViewController alloc] init];
+        viewController.myUrl = match.URLString;
+        viewController.type = WEB_VIEW_TYPE_PERSONAL;
+        [[self private_navigationController] pushViewController:viewController animated:YES];
+    }];
+    [router registerPattern:[API_URL stringByAppendingString:@"jiabei/MY0500"] handler:^(URLRouteMatch *match) {
+        FollowAndFansController *ffvc = [FollowAndFansController new];
+        ffvc.url0500 = match.URLString;
+        ffvc.view.backgroundColor = [UIColor whiteColor];
+        ffvc.segmentedControl.selectedSegmentIndex = 0;
+        [[self private_navigationController] pushViewController:ffvc animated:YES];
+    }];
+    [router registerPattern:[API_URL stringByAppendingString:@"jiabei/MY0501"] handler:^(URLRouteMatch *match) {
+        FollowAndFansController *ffvc = [FollowAndFansController new];
+        ffvc.url0501 = match.URLString;
+        ffvc.view.backgroundColor = [UIColor whiteColor];
+        ffvc.segmentedControl.selectedSegmentIndex = 1;
+        [[self private_navigationController] pushViewController:ffvc animated:YES];
+    }];
+}
 
-            }
-        }
-        else if ([subUrl hasPrefix:@"Board"])
-        {
-            NSLog(@"%@",[subUrl substringFromIndex:6]);
-            NSDictionary *dic = [UrlRedirectAction parseURLParams:[subUrl substringFromIndex:6]];
-            
-            BoardDetailListViewController *viewController = [[BoardDetailListViewController alloc] init];
-            AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-            
-            BoardListModel *model = [[BoardListModel alloc] init];
-            model.marketCd = [dic objectForKey:@"marketCd"];
-            model.symbol = [dic objectForKey:@"symbol"];
-            model.industryName = [dic objectForKey:@"industryName"];
-            model.symbolTyp = [dic objectForKey:@"symbolTyp"];
-            
-            viewController.title = model.industryName;
-            viewController.boardListModel = model;
-            [appDelegate.navigationController pushViewController:viewController animated:YES];
-            
-        }
-        else if ([subUrl hasPrefix:@"Draft"])
-        {
-            NSLog(@"%@",[subUrl substringFromIndex:6]);
-            NSDictionary *dic = [UrlRedirectAction parseURLParams:[subUrl substringFromIndex:6]];
-            [dic objectForKey:@"id"];
-            [dic objectForKey:@"tt"];
-            [dic objectForKey:@"c"];
-            [dic objectForKey:@"stag_code"];
-            [dic objectForKey:@"ams"];
-            
-            PostViewController *viewController = [[PostViewController alloc] init];
-            viewController.fid = [dic objectForKey:@"id"];
-            viewController.titleStr = [dic objectForKey:@"tt"];
-            viewController.contentStr = [dic objectForKey:@"c"];
-            viewController.stag_code = [dic objectForKey:@"stag_code"];
-            viewController.ams = [dic objectForKey:@"ams"];
-            
-            AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-            [appDelegate.navigationController presentViewController:viewController animated:YES completion:^{}];
-            
-        }
-        else if ([subUrl hasPrefix:@"Login"])
-        {
-            LoginViewController *loginViewController = [[LoginViewController alloc] init];
-            AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-            [appDelegate.navigationController pushViewController:loginViewController animated:YES];
-        }
-        else if ([subUrl hasPrefix:@"FM0102"])
-        {
-            PostViewController *viewController = [[PostViewController alloc] init];
-            AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-            UINavigationController *nav = [[UINavigationController alloc]initWithRootViewController:viewController];
++ (BOOL)redirectActionWithUrl:(NSURL *)url from:(NSString *)fromUrlStr navigationType:(UIWebViewNavigationType)navigationType {
 
-            if ([SystemUtil isSignIn]) {
-                [appDelegate.navigationController presentViewController:nav animated:YES completion:^{}];
-            }else {
-                LoginViewController *loginViewController = [[LoginViewController alloc] init];
-                [appDelegate.navigationController pushViewController:loginViewController animated:YES];
-            }
+    NSString *strUrl = url.absoluteString;
 
-        }
-        else if ([subUrl hasPrefix:@"CM0103"])
-        {
-            
-            TipOffViewController *viewController = [[TipOffViewController alloc] init];
-            
-            NSString *subStr = [subUrl substringFromIndex:10];
-            viewController.contentId = subStr;
-            viewController.ty = @"S_COMMENT";
-            AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-            [appDelegate.navigationController pushViewController:viewController animated:YES];
-            
-        }
-        else if ([subUrl hasPrefix:@"OpenAccount"])
-        {
-            TKOpenController *vc = [[TKOpenController alloc] initWithParams:[NSDictionary dictionaryWithObjectsAndKeys:DGZQ_OPENURL,@"h5Url", nil]];//@"channel_url"
-            vc.statusBarBgColor = kUIColorFromRGB(0x00A9FF);
-            vc.statusBarStyle = UIStatusBarStyleLightContent;
-            AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-            [appDelegate.navigationController pushViewController:vc animated:YES];
-        }
-        
-        return NO;
-    }
-    
-    if ([strUrl hasPrefix:@"component://"])
-    {
-        NSString *subUrl = [strUrl substringFromIndex:12];
-        if ([subUrl hasPrefix:@"CM0103"]){
-            
-            TipOffViewController *viewController = [[TipOffViewController alloc] init];
-            
-            NSString *subStr = [subUrl substringFromIndex:10];
-            viewController.contentId = subStr;
-            viewController.ty = @"S_COMMENT";
-            AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication]delegate];
-            [appDelegate.navigationController pushViewController:viewController animated:YES];
-            
-        }
-        if ([subUrl hasPrefix:@"CM0102"]){
-            NSString *subStr = [subUrl substringFromIndex:7];
-            NSDictionary *dic = [UrlRedirectAction parseURLParams:subStr];
-            
-            [UrlRedirectAction sharedUrlRedirectAction].fid = [dic objectForKey:@"fid"];
-            [UrlRedirectAction sharedUrlRedirectAction].rpid = [dic objectForKey:@"id"];
-            [UrlRedirectAction sharedUrlRedirectAction].rpuid = [dic objectForKey:@"rpuid"];
-            [BlurCommentView commentshowDelegate:[UrlRedirectAction sharedUrlRedirectAction]];
-            
-        }
-        if ([subUrl hasPrefix:@"FX0000"]){
-            
-            NSDictionary *dic = [UrlRedirectAction parseURLParams:[subUrl substringFromIndex:7]];
-            NSString *tt = [dic objectForKey:@"tt"];
-            UIImage *image = [UIImage imageNamed:@"shareLogo"];
-            
-            NSString *u = [NSString stringWithFormat:@"%@%@?id=%@",API_URL,H5_TALK_SHARE,[dic objectForKey:@"id"]];
-            u = [u stringByReplacingOccurrencesOfString:@"https://" withString:@"http://"];
-            u = [u stringByAddingPercentEscapesUsingEncoding:NSUTF8StringEncoding];
-            u = [u stringByAppendingString:@"&from=ios"];
-            NSString *content = [NSString stringWithFormat:@"股怪侠-%@",@"说闻解股"];
-            
-            [SharedInstance sharedSharedInstance].image = image;
-            [SharedInstance sharedSharedInstance].tt = tt;
-            [SharedInstance sharedSharedInstance].c = content;
-            [SharedInstance sharedSharedInstance].url = u;
-            [SharedInstance sharedSharedInstance].sid = [dic objectForKey:@"id"];
-            [SharedInstance sharedSharedInstance].res_code = @"S_HOTNEWS";
-            [[SharedInstance sharedSharedInstance] shareWithImage:NO];
-            
-        }
-        if ([subUrl hasPrefix:@"sheet"]) {
-            NSNotificationCenter * center = [NSNotificationCenter defaultCenter];
-            [center postNotificationName:HOLDING_SHEET_MSG object:nil userInfo:nil];
-        }
+    //native:// 和 component:// 只触发原生跳转，不在 webView 里加载
+    if ([strUrl hasPrefix:@"native://"] || [strUrl hasPrefix:@"component://"]) {
+        [[URLRouter sharedURLRouter] routeURLString:strUrl];
         return NO;
     }
     
     if (navigationType == UIWebViewNavigationTypeLinkClicked) {
         if ([strUrl hasPrefix:@"http://www.guguaixia.com"]||[strUrl hasPrefix:@"https://www.guguaixia.com"]||[strUrl hasPrefix:API_URL]) {
             WebViewController *viewController = [[WebViewController alloc] init];
-
+            viewController.myUrl = url.absoluteString;
             if ([url.path hasSuffix:@"MY9902"]) {
-                viewController.myUrl = url.absoluteString;
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
                 viewController.type = WEB_VIEW_TYPE_PERSONAL;
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
-                return NO;
-            }else {
-                viewController.myUrl = url.absoluteString;
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
-                return NO;
             }
-
-        }else {
-            return NO;
+            [[self private_navigationController] pushViewController:viewController animated:YES];
         }
+        return NO;
     }
     
     NSRange range = [fromUrlStr rangeOfString:url.path];
@@ -249,97 +146,27 @@ SYNTHESIZE_SINGLETON_FOR_CLASS(UrlRedirectAction)
         NSLog(@"url.path:%@",url.path);
         
         if(![fromUrlStr isEqualToString:url.absoluteString]) {
-            if ([url.path hasSuffix:@"HP0105"]) {
-                WebViewController *viewController = [[WebViewController alloc] init];
-                viewController.myUrl = url.absoluteString;
-                viewController.type = WEB_VIEW_TYPE_ZIXUN;
-                viewController.hasParam = YES;
-                
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
-                
-                return NO;
-                
-            } else if ([url.path hasSuffix:@"HQ1009"] || [url.path hasSuffix:@"HQ1008"] || [url.path hasSuffix:@"HQ1007"] || [url.path hasSuffix:@"HQ1003"]) {
-                
-                WebViewController *viewController = [[WebViewController alloc]init];
-                viewController.myUrl = url.absoluteString;
-                viewController.type = WEB_VIEW_TYPE_OTHER;
-                
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
-                
-                return NO;
-            
-            } else if ([url.path hasSuffix:@"FM0301"]) {
-            
-                WebViewController *viewController = [[WebViewController alloc]init];
-                viewController.myUrl = url.absoluteString;
-                viewController.type = WEB_VIEW_TYPE_BAGUA;
-                
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
-                
-                return NO;
-                
-                
-            } else if ([url.path hasSuffix:@"MY9902"]) {
-                
-                WebViewController *viewController = [[WebViewController alloc]init];
-                viewController.myUrl = url.absoluteString;
-                viewController.type = WEB_VIEW_TYPE_PERSONAL;
-                
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
-                return NO;
-                
-            } else if ([url.path hasSuffix:@"MY0500"]) {
-                
-                FollowAndFansController *ffvc = [FollowAndFansController new];
-                ffvc.url0500 = url.absoluteString;
-                ffvc.view.backgroundColor = [UIColor whiteColor];
-                ffvc.segmentedControl.selectedSegmentIndex = 0;
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                [appDelegate.navigationController pushViewController:ffvc animated:YES];
+            if ([[URLRouter sharedURLRouter] routeURLString:strUrl]) {
                 return NO;
+            }
             
-            } else if ([url.path hasSuffix:@"MY0501"]) {
-                FollowAndFansController *ffvc = [FollowAndFansController new];
-                ffvc.url0501 = url.absoluteString;
-                ffvc.view.backgroundColor = [UIColor whiteColor];
-                ffvc.segmentedControl.selectedSegmentIndex = 1;
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                [appDelegate.navigationController pushViewController:ffvc animated:YES];
-                return NO;
-                
-            } else if ([strUrl hasPrefix:@"http://www.guguaixia.com"]||[strUrl hasPrefix:@"https://www.guguaixia.com"]||[strUrl hasPrefix:API_URL]) {
+            if ([strUrl hasPrefix:@"http://www.guguaixia.com"]||[strUrl hasPrefix:@"https://www.guguaixia.com"]||[strUrl hasPrefix:API_URL]) {
                 //帖子详情
                 DetailWebViewController *viewController = [[DetailWebViewController alloc] init];
-
                 viewController.myUrl = url.absoluteString;
-
                 [UrlRedirectAction sharedUrlRedirectAction].detailVC = viewController;
                 
                 NSRange urlRange = [url.absoluteString rangeOfString:@"comment=true"];
                 if (urlRange.length > 0) {
                     viewController.type = WEB_VIEW_TYPE_COMMENT;
                 }
-                
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
-                
-                return NO;
+                [[self private_navigationController] pushViewController:viewController animated:YES];
             } else if ([strUrl containsString:@"dgzq.com.cn"]) {
                 WebViewController *viewController = [[WebViewController alloc] init];
                 viewController.myUrl = url.absoluteString;
-                AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
-                [appDelegate.navigationController pushViewController:viewController animated:YES];
-                
-                return NO;
-            }
-              else {
-                return NO;
+                [[self private_navigationController] pushViewController:viewController animated:YES];
             }
+            return NO;
         }
         
     }
@@ -347,6 +174,11 @@ SYNTHESIZE_SINGLETON_FOR_CLASS(UrlRedirectAction)
     return YES;
 }
 
++ (UINavigationController *)private_navigationController {
+    AppDelegate *appDelegate = (AppDelegate *)[[UIApplication sharedApplication] delegate];
+    return appDelegate.navigationController;
+}
+
 /**
  * 解析URL参数的工具方法。
  */
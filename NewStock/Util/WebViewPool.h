@@ -0,0 +1,55 @@
+//
+//  WebViewPool.h
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+#import <WebKit/WebKit.h>
+#import "ARCSingletonTemplate.h"
+
+//页面高度的 script message 名，消息体为 document.body.scrollHeight
+extern NSString * const kWebViewScrollHeightMessage;
+
+/**
+ *  WKUserContentController 会强引用 handler，经它转一道避免循环引用
+ */
+@interface WebScriptMessageProxy : NSObject <WKScriptMessageHandler>
+
+@property (nonatomic, weak) id<WKScriptMessageHandler> target;
+
+- (instancetype)initWithTarget:(id<WKScriptMessageHandler>)target;
+
+@end
+
+/**
+ *  预热的 WKWebView 池
+ *
+ *  所有实例共用一个 WKProcessPool，只起一个 WebContent 进程；池里预先建好 capacity 个实例
+ *  并加载空页面把进程拉起来，取走后在主线程空闲时逐个补齐，收到内存警告时清空。
+ *  取走的实例用完直接释放，不放回池里，免得上一个页面的历史和 JS 状态带到下一个页面。
+ *
+ *  每个实例都注入了高度脚本：页面加载、DOM 变化、图片加载完成时，若 body 高度有变化，
+ *  通过 kWebViewScrollHeightMessage 异步回传；H5 原先调用的 getScrollHeight() 也走这里。
+ */
+@interface WebViewPool : NSObject
+
+SYNTHESIZE_SINGLETON_FOR_HEADER(WebViewPool)
+
+@property (nonatomic, strong, readonly) WKProcessPool *processPool;
+
+//默认 2
+@property (nonatomic, assign) NSUInteger capacity;
+
+//补齐池子，每次只建一个，没满时在空闲时继续；主线程调用
+- (void)prewarm;
+
+//取一个实例，池空时现建；已带上当前登录的 cookie
+- (WKWebView *)dequeueWebView;
+
+//带上 NSHTTPCookieStorage 中 cookie 的请求，iOS 11 以前 WKWebView 不读共享的 cookie
++ (NSURLRequest *)requestWithURL:(NSURL *)url;
+
+@end
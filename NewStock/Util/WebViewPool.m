@@ -0,0 +1,160 @@
+//
+//  WebViewPool.m
+//  NewStock
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "WebViewPool.h"
+#import "Defination.h"
+
+NSString * const kWebViewScrollHeightMessage = @"scrollHeight";
+
+//补齐池子前等待的时间，避开页面切换的动画
+static const NSTimeInterval kWebViewPoolRefillDelay = 0.5;
+
+//高度有变化才回传，同一帧内的多次变化只算一次
+static NSString * const kWebViewScrollHeightScript =
+@"(function(){"
+"var last=-1,pending=false;"
+"function post(){"
+    "pending=false;"
+    "var b=document.body,m=window.webkit&&window.webkit.messageHandlers.scrollHeight;"
+    "if(!b||!m)return;"
+    "var h=b.scrollHeight;"
+    "if(h!=last){last=h;m.postMessage(h);}"
+"}"
+"function schedule(){"
+    "if(pending)return;"
+    "pending=true;"
+    "(window.requestAnimationFrame||setTimeout)(post);"
+"}"
+"window.getScrollHeight=schedule;"
+"window.addEventListener('load',schedule);"
+"window.addEventListener('resize',schedule);"
+"document.addEventListener('load',schedule,true);"
+"if(window.MutationObserver){"
+    "new MutationObserver(schedule).observe(document.documentElement,{childList:true,subtree:true,attributes:true,characterData:true});"
+"}"
+"schedule();"
+"})();";
+
+@implementation WebScriptMessageProxy
+
+- (instancetype)initWithTarget:(id<WKScriptMessageHandler>)target {
+    self = [super init];
+    if (self) {
+        _target = target;
+    }
+    return self;
+}
+
+- (void)userContentController:(WKUserContentController *)userContentController didReceiveScriptMessage:(WKScriptMessage *)message {
+    [self.target userContentController:userContentController didReceiveScriptMessage:message];
+}
+
+@end
+
+@implementation WebViewPool
+{
+    NSMutableArray<WKWebView *> *_webViews;
+}
+SYNTHESIZE_SINGLETON_FOR_CLASS(WebViewPool)
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _processPool = [[WKProcessPool alloc] init];
+        _capacity = 2;
+        _webViews = [NSMutableArray array];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(private_didReceiveMemoryWarning) name:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    }
+    return self;
+}
+
+- (void)prewarm {
+    if (_webViews.count >= _capacity) {
+        return;
+    }
+    WKWebView *webView = [self private_createWebView];
+    //加载一次空页面，让 WebContent 进程和 JS 引擎先起来
+    [webView loadHTMLString:@"" baseURL:nil];
+    [_webViews addObject:webView];
+
+    if (_webViews.count < _capacity) {
+        [self private_scheduleRefill];
+    }
+}
+
+- (WKWebView *)dequeueWebView {
+    WKWebView *webView = _webViews.firstObject;
+    if (webView) {
+        [_webViews removeObjectAtIndex:0];
+    } else {
+        webView = [self private_createWebView];
+    }
+
+    NSString *cookieScript = [self private_cookieScript];
+    if (cookieScript) {
+        WKUserScript *script = [[WKUserScript alloc] initWithSource:cookieScript injectionTime:WKUserScriptInjectionTimeAtDocumentStart forMainFrameOnly:NO];
+        [webView.configuration.userContentController addUserScript:script];
+    }
+
+    [self private_scheduleRefill];
+    return webView;
+}
+
++ (NSURLRequest *)requestWithURL:(NSURL *)url {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
+    NSArray *cookies = url ? [[NSHTTPCookieStorage sharedHTTPCookieStorage] cookiesForURL:url] : nil;
+    if (cookies.count) {
+        [request setAllHTTPHeaderFields:[NSHTTPCookie requestHeaderFieldsWithCookies:cookies]];
+    }
+    return request;
+}
+
+#pragma mark private
+
+- (WKWebView *)private_createWebView {
+    WKUserContentController *userContentController = [[WKUserContentController alloc] init];
+    WKUserScript *heightScript = [[WKUserScript alloc] initWithSource:kWebViewScrollHeightScript injectionTime:WKUserScriptInjectionTimeAtDocumentEnd forMainFrameOnly:YES];
+    [userContentController addUserScript:heightScript];
+
+    WKWebViewConfiguration *configuration = [[WKWebViewConfiguration alloc] init];
+    configuration.processPool = _processPool;
+    configuration.userContentController = userContentController;
+    return [[WKWebView alloc] initWithFrame:CGRectZero configuration:configuration];
+}
+
+- (void)private_scheduleRefill {
+    //滑动时不建，等主线程空下来
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(prewarm) object:nil];
+    [self performSelector:@selector(prewarm) withObject:nil afterDelay:kWebViewPoolRefillDelay inModes:@[NSDefaultRunLoopMode]];
+}
+
+//XHR 请求要用的登录 cookie，HttpOnly 的写不进 document.cookie，由 requestWithURL: 带上
+- (NSString *)private_cookieScript {
+    NSArray *cookies = [[NSHTTPCookieStorage sharedHTTPCookieStorage] cookiesForURL:[NSURL URLWithString:API_URL]];
+    NSMutableArray *items = [NSMutableArray array];
+    for (NSHTTPCookie *cookie in cookies) {
+        if (cookie.isHTTPOnly) {
+            continue;
+        }
+        [items addObject:[NSString stringWithFormat:@"%@=%@; path=%@", cookie.name, cookie.value, cookie.path.length ? cookie.path : @"/"]];
+    }
+    if (items.count == 0) {
+        return nil;
+    }
+    NSData *data = [NSJSONSerialization dataWithJSONObject:items options:0 error:nil];
+    NSString *json = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+    return [NSString stringWithFormat:@"%@.forEach(function(c){document.cookie=c;});", json];
+}
+
+- (void)private_didReceiveMemoryWarning {
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(prewarm) object:nil];
+    [_webViews removeAllObjects];
+}
+
+@end
@@ -9,7 +9,7 @@
 #import "QingHuaiCollectionViewCell.h"
 #import <Masonry.h>
 #import "Defination.h"
-#import <UIImageView+WebCache.h>
+#import "UIImageView+Thumbnail.h"
 
 @interface QingHuaiCollectionViewCell ()
 
@@ -208,7 +208,7 @@
     
     if (model.imgs.count > 0) {
         ImageListModel *imgModel = model.imgs[0];
-        [self.center_img sd_setImageWithURL:[NSURL URLWithString:imgModel.origin]];
+        [self.center_img setThumbnailWithURLString:imgModel.origin size:CGSizeMake(CGRectGetWidth(self.bounds), 206 * kScale)];
     }
 
     
@@ -8,9 +8,9 @@
 
 #import "UserDynamicCell.h"
 #import <Masonry.h>
-#import <UIImageView+WebCache.h>
+#import "UIImageView+Thumbnail.h"
 #import "Defination.h"
-#import "EmotionModel.h"
+#import "EmotionManager.h"
 
 @interface UserDynamicCell ()
 
@@ -28,28 +28,10 @@
 
 @property (nonatomic, strong) UIButton *delete_btn;
 
-@property (nonatomic, strong) NSArray *emojiDataArray;
-
 @end
 
 @implementation UserDynamicCell
 
-- (NSArray *)emojiDataArray {
-    if (_emojiDataArray == nil) {
-        NSString *path = [[NSBundle mainBundle] pathForResource:@"Emoticons.bundle" ofType:nil];
-        NSBundle *bundle = [[NSBundle alloc] initWithPath:path];
-        _emojiDataArray = [NSArray arrayWithContentsOfFile:[bundle pathForResource:@"default/EmoInfo.plist" ofType:nil]];
-        NSMutableArray *nmArr = [NSMutableArray array];
-        for (NSDictionary *dic in _emojiDataArray) {
-            EmotionModel *model = [EmotionModel new];
-            [model setValuesForKeysWithDictionary:dic];
-            [nmArr addObject:model];
-        }
-        _emojiDataArray = nmArr.copy;
-    }
-    return _emojiDataArray;
-}
-
 - (UILabel *)desc_lb {
     if (_desc_lb == nil) {
         _desc_lb = [UILabel new];
@@ -185,7 +167,7 @@
 
     self.time_lb.text = model.tm;
     self.name_lb.text = model.userName;
-    [self.userIcon sd_setImageWithURL:[NSURL URLWithString:model.origin]];
+    [self.userIcon setThumbnailWithURLString:model.origin size:CGSizeMake(32, 32)];
     self.bigVIcon.hidden = !(model.aty.integerValue == 3 || model.aty.integerValue == 4);
     NSString *content = [NSString stringWithFormat:@"%@%@",model.n,model.sn];
     if (listModel.tt.length) {
@@ -220,31 +202,21 @@
 
 - (NSMutableAttributedString *)dealWithSy:(NSString *)sy :(CGFloat)lineHeight {
     
-    NSString *pattren = @"\\[.*?\\]";
-    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:pattren options:0 error:nil];
     NSMutableAttributedString *nmAttrStr = [[NSMutableAttributedString alloc] initWithString:@""];
-    
-    __block NSInteger index = 0;
-    [regex enumerateMatchesInString:sy options:0 range:NSMakeRange(0, sy.length) usingBlock:^(NSTextCheckingResult * _Nullable result, NSMatchingFlags flags, BOOL * _Nonnull stop) {
-        
-        NSRange range = [result rangeAtIndex:0];
-        NSString *str = [sy substringWithRange:NSMakeRange(index, range.location - index)];
-        NSAttributedString *attrS = [[NSAttributedString alloc] initWithString:str];
-        [nmAttrStr appendAttributedString:attrS];
-        
-        index = range.location + range.length;
-        
-        NSString *chs = [sy substringWithRange:range];
-        UIImage *img = [self getChsImage:chs];
+    __block BOOL hasEmotion = NO;
+    [[EmotionManager sharedEmotionManager] enumerateString:sy usingBlock:^(NSString *segment, UIImage *image) {
+        if (image == nil) {
+            [nmAttrStr appendAttributedString:[[NSAttributedString alloc] initWithString:segment]];
+            return;
+        }
+        hasEmotion = YES;
         NSTextAttachment *attach = [[NSTextAttachment alloc] init];
-        attach.image = img;
+        attach.image = image;
         attach.bounds = CGRectMake(0, -3, lineHeight, lineHeight);
-        NSAttributedString *attrS1 = [NSAttributedString attributedStringWithAttachment:attach];
-        [nmAttrStr appendAttributedString:attrS1];
-        
+        [nmAttrStr appendAttributedString:[NSAttributedString attributedStringWithAttachment:attach]];
     }];
     
-    return (nmAttrStr.length != 0) ? nmAttrStr : [[NSMutableAttributedString alloc] initWithString:[NSString stringWithFormat:@"   %@",sy]];
+    return hasEmotion ? nmAttrStr : [[NSMutableAttributedString alloc] initWithString:[NSString stringWithFormat:@"   %@",sy]];
 }
 
 - (void)btnClick:(UIButton *)btn {
@@ -259,17 +231,4 @@
     }
 }
 
-- (UIImage *)getChsImage:(NSString *)chs {
-    for (EmotionModel *model in self.emojiDataArray) {
-        if ([model.chs isEqualToString:chs]) {
-            NSString *bundleStr = [[NSBundle mainBundle] pathForResource:@"Emoticons.bundle" ofType:nil];
-            NSBundle *bundle = [[NSBundle alloc] initWithPath:bundleStr];
-            NSString *imgPath = [NSString stringWithFormat:@"default/%@",model.png];
-            UIImage *image = [UIImage imageNamed:imgPath inBundle:bundle compatibleWithTraitCollection:nil];
-            return image;
-        }
-    }
-    return nil;
-}
-
 @end
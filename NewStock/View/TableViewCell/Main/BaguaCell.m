@@ -11,7 +11,7 @@
 #import "MarketConfig.h"
 #import <Masonry.h>
 #import "UIView+Masonry_Arrange.h"
-#import <UIImageView+WebCache.h>
+#import "UIImageView+Thumbnail.h"
 
 @interface BaguaCell (){
 
@@ -208,9 +208,10 @@
         ImageListModel *imgModel2 = model.imgs[1];
         ImageListModel *imgModel3 = model.imgs[2];
         
-        [_imgView1 sd_setImageWithURL:[NSURL URLWithString:imgModel1.origin]];
-        [_imgView2 sd_setImageWithURL:[NSURL URLWithString:imgModel2.origin]];
-        [_imgView3 sd_setImageWithURL:[NSURL URLWithString:imgModel3.origin]];
+        CGSize size = CGSizeMake((int)((MAIN_SCREEN_WIDTH - 24 * kScale - 10 * kScale) / 3), (int)(90 * kScale));
+        [_imgView1 setThumbnailWithURLString:imgModel1.origin size:size];
+        [_imgView2 setThumbnailWithURLString:imgModel2.origin size:size];
+        [_imgView3 setThumbnailWithURLString:imgModel3.origin size:size];
   
     }else {
         _imgView1.hidden = YES;
@@ -263,7 +264,7 @@
             make.left.equalTo(_nameLb.mas_right).offset(10);
         }];
 
-        [_iconIv sd_setImageWithURL:[NSURL URLWithString:(NSString *)(model.uico)]];
+        [_iconIv setThumbnailWithURLString:(NSString *)(model.uico) size:CGSizeMake(28 * kScale, 28 * kScale)];
         
         _nameLb.text = model.un;
         if (model.uaty.integerValue == 3 || model.uaty.integerValue == 4) {
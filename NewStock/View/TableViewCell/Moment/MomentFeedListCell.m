@@ -11,10 +11,11 @@
 #import <YYText/YYText.h>
 #import <YYLabel.h>
 #import <Masonry.h>
-#import <SDWebImage/UIImageView+WebCache.h>
+#import "UIImageView+Thumbnail.h"
 #import "NSString+getLength.h"
 #import "UserInfoInstance.h"
 #import "SystemUtil.h"
+#import "FeedListLayout.h"
 
 @interface MomentFeedListCell ()
 
@@ -22,15 +23,12 @@
 @property (nonatomic, strong) UIImageView *bigV;
 @property (nonatomic, strong) UILabel *nameLb;
 @property (nonatomic, strong) UILabel *timeLb;
-@property (nonatomic, strong) UILabel *titleLb;
+@property (nonatomic, strong) YYLabel *titleLb;
 @property (nonatomic, strong) YYLabel *contentLb;
 @property (nonatomic, strong) UILabel *readCountLb;
 @property (nonatomic, strong) UILabel *writeComLb;
 @property (nonatomic, strong) UIButton *followBtn;
 @property (nonatomic, strong) UIImageView *centerimageView;
-@property (nonatomic, strong) NSMutableArray *rangeArray;
-@property (nonatomic, strong) NSAttributedString *jingAttr;
-@property (nonatomic, strong) NSAttributedString *hotAttr;
 
 @end
 
@@ -88,6 +86,7 @@
         make.left.equalTo(self.contentView).offset(12 * kScale);
         make.right.equalTo(self.contentView).offset(-12 * kScale);
         make.top.equalTo(_iconIv.mas_bottom).offset(20 * kScale);
+        make.height.equalTo(@0);
     }];
     
     [_followBtn mas_makeConstraints:^(MASConstraintMaker *make) {
@@ -101,6 +100,7 @@
         make.left.equalTo(self.contentView).offset(12 * kScale);
         make.right.equalTo(self.contentView).offset(-12 * kScale);
         make.top.equalTo(_titleLb.mas_bottom).offset(12 * kScale);
+        make.height.equalTo(@0);
     }];
     
     [_centerimageView mas_makeConstraints:^(MASConstraintMaker *make) {
@@ -125,121 +125,45 @@
     
     _model = model;
     
-    if (!_model.contentStr.length) {
-        [self dealWithImageAndContent:model.c];
-    }
+    //排版在列表拿到数据时已在后台算好
+    FeedListLayout *layout = [FeedListLayout layoutForModel:model style:FeedListLayoutStyleTalk width:MAIN_SCREEN_WIDTH];
     
     _followBtn.selected = model.u.fld.integerValue == 1;
     _followBtn.layer.borderColor = !_followBtn.isSelected ? kTitleColor.CGColor : kUIColorFromRGB(0xbfbfbf).CGColor;
     _followBtn.hidden = [[UserInfoInstance sharedUserInfoInstance].userInfoModel.userId isEqualToString:model.u.uid];
     
-    [self dealWithImg];
-    [self dealWithTitleLb];
-    [self dealWithContentLb];
+    [self dealWithImg:layout];
+    [self dealWithTitleAndContent:layout];
     [self dealWithTmAndSrLb];
     
-    [_iconIv sd_setImageWithURL:[NSURL URLWithString:(NSString *)(model.u.ico.origin)]];
+    [_iconIv setThumbnailWithURLString:(NSString *)(model.u.ico.origin) size:CGSizeMake(36 * kScale, 36 * kScale)];
     _nameLb.text = model.u.n;
     _readCountLb.text = [NSString stringWithFormat:@"阅读 %zd",_model.ss.clk.integerValue];
-
-    [self.contentView layoutIfNeeded];
 }
 
-- (void)dealWithTitleLb {
-    NSString *tt = _model.tt;
-    tt = [tt stringByReplacingOccurrencesOfString:@" " withString:@""];
-    tt = [tt stringByReplacingOccurrencesOfString:@"\n" withString:@""];
-    if (tt.length == 0) {
-        [_contentLb mas_makeConstraints:^(MASConstraintMaker *make) {
-            make.top.equalTo(_titleLb.mas_bottom).offset(0 * kScale);
-        }];
-        return;
-    }
-    
-    NSMutableParagraphStyle *para = [[NSMutableParagraphStyle alloc] init];
-    
-    CGFloat width = [_model.tt boundingRectWithSize:CGSizeMake(MAXFLOAT, _titleLb.font.lineHeight) options:1 attributes:@{NSFontAttributeName : _titleLb.font} context:nil].size.width;
-    if (width > _titleLb.bounds.size.width) {
-        para.lineSpacing = 4 * kScale;
-    } else {
-        para.lineSpacing = 0 * kScale;
-    }
-    
-    NSMutableAttributedString *nmAttrS = [[NSMutableAttributedString alloc] initWithString:_model.tt attributes:@{NSParagraphStyleAttributeName : para}];
-    
-    if (_model.tag.integerValue == 1) {
-        [nmAttrS appendAttributedString:self.jingAttr];
-    } else if (_model.tag.integerValue == 2) {
-        [nmAttrS appendAttributedString:self.hotAttr];
-    } else if (_model.tag.integerValue == 3) {
-        [nmAttrS appendAttributedString:self.hotAttr];
-        [nmAttrS appendAttributedString:self.jingAttr];
-    } 
-    
-    _titleLb.attributedText = nmAttrS;
-    
-    [_contentLb mas_makeConstraints:^(MASConstraintMaker *make) {
-        make.top.equalTo(_titleLb.mas_bottom).offset(12 * kScale);
+- (void)dealWithTitleAndContent:(FeedListLayout *)layout {
+    _titleLb.textLayout = layout.titleLayout;
+    _contentLb.textLayout = layout.contentLayout;
+    [_titleLb mas_updateConstraints:^(MASConstraintMaker *make) {
+        make.height.equalTo(@(layout.titleHeight));
+    }];
+    [_contentLb mas_updateConstraints:^(MASConstraintMaker *make) {
+        make.top.equalTo(_titleLb.mas_bottom).offset(layout.titleLayout ? 12 * kScale : 0);
+        make.height.equalTo(@(layout.contentHeight));
     }];
-    
-    [_titleLb sizeToFit];
-}
-
-- (void)dealWithContentLb {
-    if (_model.saveAttr != nil) {
-        _contentLb.attributedText = _model.saveAttr;
-        [_contentLb sizeToFit];
-        [self.contentView layoutIfNeeded];
-        return;
-    }
-    NSString *content = @"";
-    NSInteger count = 80;
-    [self.rangeArray removeAllObjects];
-    if (_model.contentStr.length > count) {
-        content = [_model.contentStr substringToIndex:count];
-    } else {
-        content = _model.contentStr;
-    }
-    
-    for (FeedListSLModel *slModel in _model.sl) {
-        for (NSString *c in slModel.c) {
-            NSArray *rangeArr = [SystemUtil rangesOfString:c inString:content];
-            [self.rangeArray addObjectsFromArray:rangeArr];
-        }
-    }
-
-    NSMutableAttributedString *nmAttrs = [[NSMutableAttributedString alloc] initWithString:content attributes:@{NSFontAttributeName : [UIFont systemFontOfSize:15 * kScale], NSForegroundColorAttributeName : kUIColorFromRGB(0x808080)}];
-    
-//    if (_model.contentStr.length > count) {
-//        NSAttributedString *m = [[NSAttributedString alloc] initWithString:@"  ...全文" attributes:@{NSFontAttributeName : [UIFont systemFontOfSize:14 * kScale],NSForegroundColorAttributeName : kNameColor}];
-//        [nmAttrs appendAttributedString:m];
-//    }
-//    
-    for (int i = 0 ; i < self.rangeArray.count ; i ++) {
-        NSValue *value = self.rangeArray[i];
-        NSRange range = value.rangeValue;
-        [nmAttrs yy_setTextHighlightRange:range color:kUIColorFromRGB(0x358ee7) backgroundColor:nil tapAction:^(UIView * _Nonnull containerView, NSAttributedString * _Nonnull text, NSRange range, CGRect rect) {
-            text = [text attributedSubstringFromRange:range];
-            [self pushToStock:text.string];
-        }];
-    }
-    _model.saveAttr = nmAttrs.copy;
-    _contentLb.attributedText = _model.saveAttr;
-    [_contentLb sizeToFit];
-    [self.contentView layoutIfNeeded];
 }
 
-- (CGFloat)dealWithImg {
-    if (_model.imgStr.length) {
-        [_centerimageView sd_setImageWithURL:[NSURL URLWithString:_model.imgStr]];
+- (void)dealWithImg:(FeedListLayout *)layout {
+    if (layout.imageURL.length) {
+        [_centerimageView setThumbnailWithURLString:layout.imageURL size:layout.imageSize];
         [_centerimageView mas_updateConstraints:^(MASConstraintMaker *make) {
-            make.height.equalTo(@(175 * kScale));
+            make.height.equalTo(@(layout.imageSize.height));
         }];
         [_readCountLb mas_updateConstraints:^(MASConstraintMaker *make) {
-            make.top.equalTo(_contentLb.mas_bottom).offset((18 + 175 + 10) * kScale);
+            make.top.equalTo(_contentLb.mas_bottom).offset(18 * kScale + layout.imageSize.height + 10 * kScale);
         }];
-        return (175 + 10 + 18) * kScale;
     } else {
+        [_centerimageView cancelThumbnailLoad];
         _centerimageView.image = nil;
         [_centerimageView mas_updateConstraints:^(MASConstraintMaker *make) {
             make.height.equalTo(@(0.1));
@@ -247,7 +171,6 @@
         [_readCountLb mas_updateConstraints:^(MASConstraintMaker *make) {
             make.top.equalTo(_contentLb.mas_bottom).offset(18 * kScale);
         }];
-        return 18 * kScale;
     }
 }
 
@@ -271,39 +194,12 @@
     }
 }
 
-- (void)dealWithImageAndContent:(NSString *)content {
-    NSError *error = NULL;
-    NSString *partten = @"<img src=\"(.*?)\".*?/>";
-    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:partten options:0 error:&error];
-    
-    if (_model.imgs.count) {
-        _model.imgStr = _model.imgs[0][@"origin"];
-    } else {
-        NSArray *resArr = [regex matchesInString:content options:0 range:NSMakeRange(0, content.length)];
-        if (resArr.count > 0) {
-            NSTextCheckingResult *res = resArr[0];
-            NSString *imgStr = [content substringWithRange:[res rangeAtIndex:1]];
-            _model.imgStr = imgStr;
-        }
-    }
-    
-    NSMutableString *nmStr = [NSMutableString stringWithString:content];
-    [regex replaceMatchesInString:nmStr options:0 range:NSMakeRange(0, content.length) withTemplate:@""];
-    _model.contentStr = nmStr.copy;
-}
-
 #pragma mark aciton
 
-- (void)pushToStock:(NSString *)str {
-    for (FeedListSLModel *model in _model.sl) {
-        for (NSString *c in model.c) {
-            if ([str isEqualToString:c]) {
-                if (self.pushStock) {
-                    self.pushStock(model);
-                    return;
-                }
-            }
-        }
+- (void)pushToStock:(StockCodeInfo *)stock {
+    FeedListSLModel *model = [FeedListSLModel modelWithStockCode:stock inList:_model.sl];
+    if (model && self.pushStock) {
+        self.pushStock(model);
     }
 }
 
@@ -322,7 +218,13 @@
     }
 
     if (self.photoBlock) {
-        self.photoBlock(tap.view.tag,@[self.centerimageView]);
+        //列表里是缩小后的图，浏览前换成原图
+        __weak typeof(self) weakSelf = self;
+        [self.centerimageView loadOriginalImageWithURLString:_model.layout.imageURL completion:^{
+            if (weakSelf.photoBlock) {
+                weakSelf.photoBlock(tap.view.tag,@[weakSelf.centerimageView]);
+            }
+        }];
     }
 }
 
@@ -374,15 +276,13 @@
     return _nameLb;
 }
 
-- (UILabel *)titleLb {
+- (YYLabel *)titleLb {
     if (_titleLb == nil) {
-        _titleLb = [[UILabel alloc] init];
+        _titleLb = [[YYLabel alloc] init];
         _titleLb.layer.masksToBounds = YES;
         _titleLb.backgroundColor = [UIColor whiteColor];
-        _titleLb.textColor = kUIColorFromRGB(0x333333);
-        _titleLb.font = [UIFont boldSystemFontOfSize:18 * kScale];
-        _titleLb.preferredMaxLayoutWidth = MAIN_SCREEN_WIDTH - 24 * kScale;
-        _titleLb.numberOfLines = 2;
+        _titleLb.displaysAsynchronously = YES;
+        _titleLb.ignoreCommonProperties = YES;
     }
     return _titleLb;
 }
@@ -392,13 +292,13 @@
         _contentLb = [[YYLabel alloc] init];
         _contentLb.layer.masksToBounds = YES;
         _contentLb.backgroundColor = [UIColor whiteColor];
-        _contentLb.font = [UIFont systemFontOfSize:15 * kScale];
-        _contentLb.preferredMaxLayoutWidth = MAIN_SCREEN_WIDTH - 24 * kScale;
-        _contentLb.numberOfLines = 3;
-        _contentLb.textColor = kUIColorFromRGB(0x888888);
-        YYTextLinePositionSimpleModifier *modifier = [YYTextLinePositionSimpleModifier new];
-        modifier.fixedLineHeight = _contentLb.font.lineHeight + 2;
-        _contentLb.linePositionModifier = modifier;
+        _contentLb.displaysAsynchronously = YES;
+        _contentLb.ignoreCommonProperties = YES;
+        __weak typeof(self) weakSelf = self;
+        _contentLb.highlightTapAction = ^(UIView *containerView, NSAttributedString *text, NSRange range, CGRect rect) {
+            YYTextHighlight *highlight = [text yy_attribute:YYTextHighlightAttributeName atIndex:range.location];
+            [weakSelf pushToStock:highlight.userInfo[FeedListLayoutStockKey]];
+        };
     }
     return _contentLb;
 }
@@ -480,37 +380,4 @@
     return _centerimageView;
 }
 
-- (NSAttributedString *)jingAttr {
-    if (_jingAttr == nil) {
-        NSMutableAttributedString *attr = [[NSMutableAttributedString alloc] initWithString:@" " attributes:nil];;
-        NSTextAttachment *attachJing = [[NSTextAttachment alloc] init];
-        attachJing.image = [UIImage imageNamed:@"ic_forum_jing"];
-        attachJing.bounds = CGRectMake(0, -1.5 * kScale, 16 * kScale, 16 * kScale);
-        NSAttributedString *attrSJing = [NSAttributedString attributedStringWithAttachment:attachJing];
-        [attr appendAttributedString:attrSJing];
-        _jingAttr = attr;
-    }
-    return _jingAttr;
-}
-
-- (NSAttributedString *)hotAttr {
-    if (_hotAttr == nil) {
-        NSMutableAttributedString *attr = [[NSMutableAttributedString alloc] initWithString:@" " attributes:nil];;
-        NSTextAttachment *attachJing = [[NSTextAttachment alloc] init];
-        attachJing.image = [UIImage imageNamed:@"ic_forum_hot"];
-        attachJing.bounds = CGRectMake(0, -1.5 * kScale, 16 * kScale, 16 * kScale);
-        NSAttributedString *attrSJing = [NSAttributedString attributedStringWithAttachment:attachJing];
-        [attr appendAttributedString:attrSJing];
-        _hotAttr = attr;
-    }
-    return _hotAttr;
-}
-
-- (NSMutableArray *)rangeArray {
-    if (_rangeArray == nil) {
-        _rangeArray = [NSMutableArray array];
-    }
-    return _rangeArray;
-}
-
 @end
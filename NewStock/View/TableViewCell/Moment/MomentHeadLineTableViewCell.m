@@ -7,9 +7,10 @@
 //
 
 #import "MomentHeadLineTableViewCell.h"
-#import <UIImageView+WebCache.h>
+#import "UIImageView+Thumbnail.h"
 #import "Defination.h"
 #import "SystemUtil.h"
+#import "StockMentionMatcher.h"
 #import <Masonry.h>
 
 @interface MomentHeadLineTableViewCell ()
@@ -91,19 +92,25 @@
 - (void)setModel:(FeedListModel *)model {
     _model = model;
     [self dealWithImg:model];
-    self.lb_title.text = model.tt;
+    [self dealWithTitle:model];
     if (model.tm) {
         self.lb_time.text = [SystemUtil getDateString:model.tm];
     }
     
     self.lb_source.text = model.sr;
-    if (model.imgs.count == 1 || model.imgs.count == 2) {
-        [self.singleImg sd_setImageWithURL:[NSURL URLWithString:model.imgs[0][@"origin"]]];
-    } else if (model.imgs.count >= 3) {
-        [self.iv1 sd_setImageWithURL:[NSURL URLWithString:model.imgs[0][@"origin"]]];
-        [self.iv2 sd_setImageWithURL:[NSURL URLWithString:model.imgs[1][@"origin"]]];
-        [self.iv3 sd_setImageWithURL:[NSURL URLWithString:model.imgs[2][@"origin"]]];
+}
+
+- (void)dealWithTitle:(FeedListModel *)model {
+    NSArray *mentions = [model titleStockMentions];
+    if (mentions.count == 0) {
+        self.lb_title.text = model.tt;
+        return;
     }
+    NSMutableAttributedString *title = [[NSMutableAttributedString alloc] initWithString:model.tt attributes:@{NSFontAttributeName : self.lb_title.font, NSForegroundColorAttributeName : self.lb_title.textColor}];
+    for (StockMention *mention in mentions) {
+        [title addAttribute:NSForegroundColorAttributeName value:kUIColorFromRGB(0x358ee7) range:mention.range];
+    }
+    self.lb_title.attributedText = title;
 }
 
 - (void)dealWithImg:(FeedListModel *)model {
@@ -112,9 +119,10 @@
         _iv2.hidden = NO;
         _iv3.hidden = NO;
         _singleImg.hidden = YES;
-        [_iv1 sd_setImageWithURL:[NSURL URLWithString:model.imgs[0][@"origin"]]];
-        [_iv2 sd_setImageWithURL:[NSURL URLWithString:model.imgs[1][@"origin"]]];
-        [_iv3 sd_setImageWithURL:[NSURL URLWithString:model.imgs[2][@"origin"]]];
+        CGSize size = CGSizeMake(109 * kScale, 62 * kScale);
+        [_iv1 setThumbnailWithURLString:model.imgs[0][@"origin"] size:size];
+        [_iv2 setThumbnailWithURLString:model.imgs[1][@"origin"] size:size];
+        [_iv3 setThumbnailWithURLString:model.imgs[2][@"origin"] size:size];
         _lb_title.numberOfLines = 1;
         [self.lb_title mas_updateConstraints:^(MASConstraintMaker *make) {
             make.right.equalTo(self.contentView).offset(-12 * kScale);//124
@@ -124,7 +132,7 @@
         _iv2.hidden = YES;
         _iv3.hidden = YES;
         _singleImg.hidden = NO;
-        [_singleImg sd_setImageWithURL:[NSURL URLWithString:model.imgs[0][@"origin"]]];
+        [_singleImg setThumbnailWithURLString:model.imgs[0][@"origin"] size:CGSizeMake(100 * kScale, 70 * kScale)];
         _lb_title.numberOfLines = 2;
         [self.lb_title mas_updateConstraints:^(MASConstraintMaker *make) {
             make.right.equalTo(self.contentView).offset(-124 * kScale);//124
@@ -149,15 +157,33 @@
         return;
     }
     
+    NSArray *imageViews = nil;
     if (index == 4) {
         if (self.singleImg.image != nil) {
-            [self.delegate MomentHeadLineTableViewCellPhotoDelegate:@[_singleImg] andIndex:0];
+            imageViews = @[_singleImg];
+            index = 0;
         }
     } else {
         if (_iv1.image != nil && _iv2.image != nil && _iv3.image != nil) {
-            [self.delegate MomentHeadLineTableViewCellPhotoDelegate:@[_iv1,_iv2,_iv3] andIndex:index];
+            imageViews = @[_iv1,_iv2,_iv3];
         }
     }
+    if (imageViews == nil) {
+        return;
+    }
+
+    //列表里是缩小后的图，浏览前换成原图
+    dispatch_group_t group = dispatch_group_create();
+    [imageViews enumerateObjectsUsingBlock:^(UIImageView *imageView, NSUInteger idx, BOOL *stop) {
+        dispatch_group_enter(group);
+        [imageView loadOriginalImageWithURLString:self.model.imgs[idx][@"origin"] completion:^{
+            dispatch_group_leave(group);
+        }];
+    }];
+    __weak typeof(self) weakSelf = self;
+    dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+        [weakSelf.delegate MomentHeadLineTableViewCellPhotoDelegate:imageViews andIndex:index];
+    });
 }
 
 #pragma mark lazyloading
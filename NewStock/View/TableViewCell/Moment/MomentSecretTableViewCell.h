@@ -29,6 +29,4 @@
 
 @property (nonatomic, weak) id <MomentSecretTableViewCellDelegate> delegate;
 
-- (CGFloat)getRowHeight:(FeedListModel *)model;
-
 @end
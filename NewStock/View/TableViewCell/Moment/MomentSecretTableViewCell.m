@@ -8,13 +8,12 @@
 
 #import "MomentSecretTableViewCell.h"
 #import "NSString+getLength.h"
-#import "EmotionModel.h"
+#import "FeedListLayout.h"
 #import "Defination.h"
-#import "SystemUtil.h"
 #import <YYLabel.h>
 #import <Masonry.h>
 #import <YYText/YYText.h>
-#import <SDWebImage/UIImageView+WebCache.h>
+#import "UIImageView+Thumbnail.h"
 
 @interface MomentSecretTableViewCell ()
 
@@ -27,10 +26,7 @@
 @property (nonatomic, strong) UILabel *readCountLb;
 
 @property (nonatomic, strong) UIImageView *centerImg;
-@property (nonatomic, copy) NSString *imgStr;
-@property (nonatomic, strong) NSArray *emojiDataArray;
-
-@property (nonatomic, strong) NSMutableArray *rangeArray;
+@property (nonatomic, strong) FeedListLayout *layout;
 
 //topic
 
@@ -83,6 +79,7 @@
         make.top.equalTo(self.iconIv.mas_bottom).offset(20 * kScale);
         make.left.equalTo(self.contentView).offset(12 * kScale);
         make.right.equalTo(self.contentView).offset(-12 * kScale);
+        make.height.equalTo(@0);
     }];
     
     [self.centerImg mas_makeConstraints:^(MASConstraintMaker *make) {
@@ -130,15 +127,18 @@
 - (void)setModel:(FeedListModel *)model {
     _model = model;
     
+    //排版在列表拿到数据时已在后台算好
+    self.layout = [FeedListLayout layoutForModel:model style:FeedListLayoutStyleSecret width:MAIN_SCREEN_WIDTH];
+    
     if (model.ty.integerValue == 2) {
         [self dealWithty];
         return;
     }
     self.topicImg.hidden = YES;
     
-    [self dealWithArr:model.c];
+    [self dealWithContent];
     [self dealWithImage];
-    [self.iconIv sd_setImageWithURL:[NSURL URLWithString:model.u.ico.origin]];
+    [self.iconIv setThumbnailWithURLString:model.u.ico.origin size:CGSizeMake(36 * kScale, 36 * kScale)];
 
     self.nameLb.text = model.u.n;
     _readCountLb.text = [NSString stringWithFormat:@"阅读 %zd",_model.ss.clk.integerValue];
@@ -152,65 +152,28 @@
 
 - (void)dealWithty {
     self.topicImg.hidden = NO;
-    [self.topicImg sd_setImageWithURL:[NSURL URLWithString:_model.imgs[0][@"origin"]]];
+    [self.topicImg setThumbnailWithURLString:self.layout.imageURL size:CGSizeMake(MAIN_SCREEN_WIDTH, self.layout.height - 5 * kScale)];
 }
 
-- (void)setImgStr:(NSString *)imgStr {
-    _imgStr = imgStr;
-    
-    if (_imgStr.length == 0) {
-        return;
-    }
-    
-    [self.centerImg sd_setImageWithURL:[NSURL URLWithString:_imgStr] completed:^(UIImage *image, NSError *error, SDImageCacheType cacheType, NSURL *imageURL) {
-//        [self dealWithSize:image.size];
-    }];
-}
-
-- (void)dealWithSize:(CGSize)size {
-    
-    if (size.height == 0 || size.width == 0) {
-        CGFloat radis = size.height / 160 * kScale;
-        CGFloat width = size.width / radis;
-        [self.centerImg mas_updateConstraints:^(MASConstraintMaker *make) {
-            make.height.equalTo(@(160 * kScale));
-            make.width.equalTo(@(width));
-        }];
-        return;
-    }
-    
-    if (size.width >= size.height) {
-        if (size.width > 160 * kScale) {
-            CGFloat radis = size.width / (160 * kScale);
-            size.width = 160 * kScale;
-            size.height = size.height / radis;
-        }
-    } else {
-        if (size.height > 160 * kScale) {
-            CGFloat radis = size.height / (160 * kScale);
-            size.height = 160 * kScale;
-            size.width = size.width / radis;
-        }
-    }
-    
-    [self.centerImg mas_updateConstraints:^(MASConstraintMaker *make) {
-        make.height.equalTo(@(size.height));
-        make.width.equalTo(@(size.width));
+- (void)dealWithContent {
+    self.contentLb.textLayout = self.layout.contentLayout;
+    [self.contentLb mas_updateConstraints:^(MASConstraintMaker *make) {
+        make.height.equalTo(@(self.layout.contentHeight));
     }];
 }
 
 - (void)dealWithImage {
-    if (_imgStr.length) {
+    CGSize size = self.layout.imageSize;
+    if (self.layout.imageURL.length) {
+        [self.centerImg setThumbnailWithURLString:self.layout.imageURL size:size];
         [self.centerImg mas_updateConstraints:^(MASConstraintMaker *make) {
             make.top.equalTo(self.contentLb.mas_bottom).offset(18 * kScale);
+            make.height.equalTo(@(size.height));
+            make.width.equalTo(@(size.width));
         }];
-        NSDictionary *dict = _model.imgs.firstObject;
-        NSString *widthS = [dict objectForKey:@"w"];
-        NSString *heightS = [dict objectForKey:@"h"];
-        CGFloat width = widthS.floatValue;
-        CGFloat height = heightS.floatValue;
-        [self dealWithSize:CGSizeMake(width, height)];
     } else {
+        [self.centerImg cancelThumbnailLoad];
+        self.centerImg.image = nil;
         [self.centerImg mas_updateConstraints:^(MASConstraintMaker *make) {
             make.height.equalTo(@(0.01));
             make.width.equalTo(@(0.01));
@@ -219,183 +182,23 @@
     }
 }
 
-- (void)dealWithArr:(NSString *)content {
-    
-    if (_model.imgStr.length) {
-        self.imgStr = _model.imgStr;
-        [self dealWithContentLbEmotion:_model.c];
-        return;
-    }
-    if (self.model.imgs.count > 0) {
-        NSDictionary *dic = self.model.imgs.firstObject;
-        NSString *imgStr = dic[@"origin"];
-        self.imgStr = imgStr;
-        _model.imgStr = _imgStr;
-    } else {
-        _imgStr = @"";
-    }
-    
-    [self dealWithContentLbEmotion:_model.c];
-}
-
-- (NSMutableAttributedString *)dealWithContentLbEmotion:(NSString *)content {
-    
-    if (_model.saveAttr.length) {
-        self.contentLb.attributedText = _model.saveAttr;
-        return _model.saveAttr;
-    }
-    
-    [self.rangeArray removeAllObjects];
-#pragma mark emotion
-    NSString *pattren = @"\\[.*?\\]";
-    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:pattren options:0 error:nil];
-    
-    NSMutableAttributedString *nmAttrStr = [[NSMutableAttributedString alloc] init];
-    NSMutableString *tempStr = [NSMutableString string];
-    
-    __block NSInteger index = 0;
-    [regex enumerateMatchesInString:content options:0 range:NSMakeRange(0, content.length) usingBlock:^(NSTextCheckingResult * _Nullable result, NSMatchingFlags flags, BOOL * _Nonnull stop) {
-        
-        NSRange range = [result rangeAtIndex:0];
-        NSString *str = [content substringWithRange:NSMakeRange(index, range.location - index)];
-        [tempStr appendString:str];
-        NSAttributedString *attrS = [[NSAttributedString alloc] initWithString:str];
-        [nmAttrStr appendAttributedString:attrS];
-        
-        index = range.location + range.length;
-        
-        NSString *chs = [content substringWithRange:range];
-        UIImage *img = [self getChsImage:chs];
-        if (img == nil) {
-            NSAttributedString *attrS1 = [[NSAttributedString alloc] initWithString:chs];
-            [nmAttrStr appendAttributedString:attrS1];
-            [tempStr appendString:chs];
-        } else {
-            NSAttributedString *attrS1 = [NSAttributedString yy_attachmentStringWithEmojiImage:img fontSize:17 * kScale];
-            [nmAttrStr appendAttributedString:attrS1];
-            [tempStr appendString:@"好"];
-        }
-    }];
-    
-    if (index < content.length) {
-        NSString *str = [content substringWithRange:NSMakeRange(index, content.length - index)];
-        NSAttributedString *attrS = [[NSAttributedString alloc] initWithString:str];
-        [nmAttrStr appendAttributedString:attrS];
-        [tempStr appendString:str];
-    }
-    
-    if (nmAttrStr.length == 0) {
-        [nmAttrStr appendAttributedString:[[NSAttributedString alloc] initWithString:content]];
-        tempStr = [NSMutableString stringWithString:content];
-    }
-    
-#pragma mark 拿到高亮范围
-    
-    for (FeedListSLModel *slModel in _model.sl) {
-        for (NSString *c in slModel.c) {
-            NSArray *rangeArr = [SystemUtil rangesOfString:c inString:tempStr];
-            [self.rangeArray addObjectsFromArray:rangeArr];
-        }
-    }
-    
-#pragma mark 行间距 和 字号
-    
-    NSMutableParagraphStyle *para = [NSMutableParagraphStyle new];
-    para.lineSpacing = nmAttrStr.length > 19 ? 9 * kScale : 0;
-    
-    [nmAttrStr addAttributes:@{
-                               NSParagraphStyleAttributeName : para,
-                               NSFontAttributeName : _contentLb.font,
-                               } range:NSMakeRange(0, nmAttrStr.length)];
-    
-#pragma mark 正则处理完成 给文字加高亮点击事件
-    for (int i = 0 ; i < self.rangeArray.count ; i ++) {
-        NSValue *value = self.rangeArray[i];
-        NSRange range = value.rangeValue;
-        [nmAttrStr yy_setTextHighlightRange:range color:kUIColorFromRGB(0x358ee7) backgroundColor:nil tapAction:^(UIView * _Nonnull containerView, NSAttributedString * _Nonnull text, NSRange range, CGRect rect) {
-            text = [text attributedSubstringFromRange:range];
-            [self pushToStock:text.string];
-        }];
-    }
-    
-    _model.saveAttr = nmAttrStr.copy;
-    self.contentLb.attributedText = nmAttrStr;
-    [self.contentLb sizeToFit];
-    return nmAttrStr;
-}
-
-- (CGFloat)getRowHeight:(FeedListModel *)model {
-    if (model == nil) {
-        return 0;
-    }
-    if (model.ty.integerValue == 2) {
-        return 198 * kScale;
-    }
-    NSMutableAttributedString *getEmtionAttrS = [self dealWithContentLbEmotion:model.c];
-    YYTextContainer *container = [YYTextContainer containerWithSize:CGSizeMake(MAIN_SCREEN_WIDTH - 24 * kScale, MAXFLOAT)];
-    YYTextLayout *layout = [YYTextLayout layoutWithContainer:container text:getEmtionAttrS];
-    
-    CGRect rect = layout.textBoundingRect;
-    
-    CGFloat contentHeight = model.c.length == 0 ? -18 * kScale : (rect.size.height);
-    if (model.imgs.count == 0) {
-        CGFloat height = 115 * kScale + contentHeight;
-        model.height = height;
-        return height;
-    }
-    
-    NSDictionary *dict = model.imgs.firstObject;
-    NSString *widthS = [dict objectForKey:@"w"] == NULL ? nil : [dict objectForKey:@"w"];
-    NSString *heightS = [dict objectForKey:@"h"] == NULL ? nil : [dict objectForKey:@"h"];
-
-    CGFloat width = widthS.floatValue;
-    CGFloat height = heightS.floatValue;
-    
-    if (width == 0 || height == 0) {
-        return 115 * kScale + contentHeight + 18 * kScale + 160 * kScale;
-    }
-    
-    if (width >= height) {
-        if (width > 160 * kScale) {
-            CGFloat radis = width / (160 * kScale);
-            width = 160 * kScale;
-            height = height / radis;
-        }
-    } else {
-        if (height > 160 * kScale) {
-            CGFloat radis = height / (160 * kScale);
-            height = 160 * kScale;
-            width = width / radis;
-        }
-    }
-    
-    return 115 * kScale + contentHeight + height + 18 * kScale;
-}
-
-- (UIImage *)getChsImage:(NSString *)chs {
-    for (EmotionModel *model in self.emojiDataArray) {
-        if ([model.chs isEqualToString:chs]) {
-            NSString *bundleStr = [[NSBundle mainBundle] pathForResource:@"Emoticons.bundle" ofType:nil];
-            NSBundle *bundle = [[NSBundle alloc] initWithPath:bundleStr];
-            NSString *imgPath = [NSString stringWithFormat:@"default/%@",model.png];
-            UIImage *image = [UIImage imageNamed:imgPath inBundle:bundle compatibleWithTraitCollection:nil];
-            return image;
-        }
-    }
-    return nil;
-}
-
 #pragma action
 
 - (void)tap:(UITapGestureRecognizer *)tap {
-    if (self.imgStr.length == 0) {
+    if (self.layout.imageURL.length == 0) {
         return;
     }
     
     CGRect rect = self.centerImg.frame;
     
     if (self.photoBlock && self.centerImg.image != nil) {
-        self.photoBlock(self.centerImg,rect);
+        //列表里是缩小后的图，浏览前换成原图
+        __weak typeof(self) weakSelf = self;
+        [self.centerImg loadOriginalImageWithURLString:self.layout.imageURL completion:^{
+            if (weakSelf.photoBlock) {
+                weakSelf.photoBlock(weakSelf.centerImg,rect);
+            }
+        }];
     }
     
 }
@@ -408,16 +211,10 @@
     }
 }
 
-- (void)pushToStock:(NSString *)str {
-    for (FeedListSLModel *model in _model.sl) {
-        for (NSString *c in model.c) {
-            if ([str isEqualToString:c]) {
-                if (self.pushStock) {
-                    self.pushStock(model);
-                    return;
-                }
-            }
-        }
+- (void)pushToStock:(StockCodeInfo *)stock {
+    FeedListSLModel *model = [FeedListSLModel modelWithStockCode:stock inList:_model.sl];
+    if (model && self.pushStock) {
+        self.pushStock(model);
     }
 }
 
@@ -502,10 +299,13 @@
 - (YYLabel *)contentLb {
     if (_contentLb == nil) {
         _contentLb = [[YYLabel alloc] init];
-        _contentLb.numberOfLines = 0;
-        _contentLb.textColor = kUIColorFromRGB(0x333333);
-        _contentLb.font = [UIFont systemFontOfSize:17 * kScale];
-        _contentLb.preferredMaxLayoutWidth = MAIN_SCREEN_WIDTH - 24 * kScale;
+        _contentLb.displaysAsynchronously = YES;
+        _contentLb.ignoreCommonProperties = YES;
+        __weak typeof(self) weakSelf = self;
+        _contentLb.highlightTapAction = ^(UIView *containerView, NSAttributedString *text, NSRange range, CGRect rect) {
+            YYTextHighlight *highlight = [text yy_attribute:YYTextHighlightAttributeName atIndex:range.location];
+            [weakSelf pushToStock:highlight.userInfo[FeedListLayoutStockKey]];
+        };
     }
     return _contentLb;
 }
@@ -532,29 +332,6 @@
     return _writeComBtn;
 }
 
-- (NSArray *)emojiDataArray {
-    if (_emojiDataArray == nil) {
-        NSString *path = [[NSBundle mainBundle] pathForResource:@"Emoticons.bundle" ofType:nil];
-        NSBundle *bundle = [[NSBundle alloc] initWithPath:path];
-        _emojiDataArray = [NSArray arrayWithContentsOfFile:[bundle pathForResource:@"default/EmoInfo.plist" ofType:nil]];
-        NSMutableArray *nmArr = [NSMutableArray array];
-        for (NSDictionary *dic in _emojiDataArray) {
-            EmotionModel *model = [EmotionModel new];
-            [model setValuesForKeysWithDictionary:dic];
-            [nmArr addObject:model];
-        }
-        _emojiDataArray = nmArr.copy;
-    }
-    return _emojiDataArray;
-}
-
-- (NSMutableArray *)rangeArray {
-    if (_rangeArray == nil) {
-        _rangeArray = [NSMutableArray array];
-    }
-    return _rangeArray;
-}
-
 #pragma mark topic
 
 - (UIImageView *)topicImg {
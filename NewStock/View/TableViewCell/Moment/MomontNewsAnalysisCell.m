@@ -9,6 +9,7 @@
 #import "MomontNewsAnalysisCell.h"
 #import "MomentNewsBottomStockView.h"
 #import "SystemUtil.h"
+#import "StockMentionMatcher.h"
 #import "Defination.h"
 #import <Masonry.h>
 
@@ -146,6 +147,7 @@
     }
     
     NSMutableAttributedString *attrTt = [[NSMutableAttributedString alloc] initWithString:tt attributes:@{NSParagraphStyleAttributeName : ttPara}];
+    [self dealWithStockColor:attrTt text:tt];
     [self dealWithStringColor:attrTt andArray:self.titleColorDictArray];
     self.tt_lable.attributedText = attrTt;
     [self.tt_lable sizeToFit];
@@ -176,7 +178,8 @@
     
     NSMutableAttributedString *c = [[NSMutableAttributedString alloc] initWithString:sy attributes:@{NSParagraphStyleAttributeName : cPara}];
     
-    //处理 颜色
+    //处理 颜色，span 标的颜色优先
+    [self dealWithStockColor:c text:oriSy];
     [self dealWithStringColor:c andArray:self.colorDictArray];
     
     //拼接 ...全文
@@ -287,6 +290,16 @@
     }
 }
 
+//text 为 c 截断前的文字，只标完整落在 c 中的股票
+- (void)dealWithStockColor:(NSMutableAttributedString *)c text:(NSString *)text {
+    for (StockMention *mention in [_model stockMentionsInText:text]) {
+        if (NSMaxRange(mention.range) > c.length) {
+            break;
+        }
+        [c addAttribute:NSForegroundColorAttributeName value:kUIColorFromRGB(0x358ee7) range:mention.range];
+    }
+}
+
 - (void)showOrHideContentLabel {
     _model.isShow = !_model.isShow;
     if (_model.isShow && _model.showStr != nil) {
@@ -17,7 +17,11 @@
 }
 @property (assign, nonatomic) id <ProductSelViewDelegate> delegate;
 
-//-(void)setSelectedIndex:(int)index;
+//titles 为各按钮标题，从上到下排列；init 为 成交量、MACD、KDJ、RSI、BOLL
+- (id)initWithTitles:(NSArray<NSString *> *)titles;
+
+//选中并通知 delegate，与点击相同
+-(void)setSelectedIndex:(int)index;
 //-(int)getSelectedIndex;
 
 @end
@@ -28,5 +32,7 @@
 @optional
 
 - (void)productSelView:(ProductSelView *)productSelView selectedIndex:(int)index;
+//长按按钮，用于修改指标参数
+- (void)productSelView:(ProductSelView *)productSelView longPressedIndex:(int)index;
 
 @end
@@ -11,12 +11,16 @@
 @synthesize delegate;
 
 - (id)init {
+    return [self initWithTitles:@[@"成交量",@"MACD",@"KDJ",@"RSI",@"BOLL"]];
+}
+
+- (id)initWithTitles:(NSArray<NSString *> *)titles {
     if (self = [super init]) {
         self.backgroundColor = kUIColorFromRGB(0xf0f4f7);
         _nCurSelIndex = 0;
         _productItemArray = [[NSMutableArray alloc] init];
         
-        NSArray *productArray = [[NSArray alloc] initWithObjects:@"成交量",@"MACD",@"KDJ",@"RSI",@"BOLL",nil];
+        NSArray *productArray = titles;
 
         _nItemHeigh = 35;
         for (int i = 0; i<[productArray count]; i++) {
@@ -25,6 +29,7 @@
             [btn setTitle:title forState:UIControlStateNormal];
             btn.tag = i;
             [btn addTarget:self action:@selector(buttonClicked:) forControlEvents:UIControlEventTouchUpInside];
+            [btn addGestureRecognizer:[[UILongPressGestureRecognizer alloc] initWithTarget:self action:@selector(buttonLongPressed:)]];
             [btn setTitleColor:kUIColorFromRGB(0x666666) forState:UIControlStateNormal];
             [btn setTitleColor:[UIColor whiteColor] forState:UIControlStateSelected];
             btn.titleLabel.font = [UIFont systemFontOfSize:13];
@@ -73,4 +78,20 @@
     }
 }
 
+- (void)setSelectedIndex:(int)index {
+    if (index < 0 || index >= [_productItemArray count]) {
+        return;
+    }
+    [self buttonClicked:[_productItemArray objectAtIndex:index]];
+}
+
+- (void)buttonLongPressed:(UILongPressGestureRecognizer *)recognizer {
+    if (recognizer.state != UIGestureRecognizerStateBegan) {
+        return;
+    }
+    if([delegate respondsToSelector:@selector(productSelView:longPressedIndex:)]) {
+        [delegate productSelView:self longPressedIndex:(int)recognizer.view.tag];
+    }
+}
+
 @end
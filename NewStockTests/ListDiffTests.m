@@ -0,0 +1,201 @@
+//
+//  ListDiffTests.m
+//  NewStockTests
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "ListDiff.h"
+
+@interface ListDiffTests : XCTestCase <UITableViewDataSource>
+
+@end
+
+@implementation ListDiffTests
+{
+    //tableView 的数据源，元素为 @{@"id", @"v"}
+    NSArray<NSDictionary *> *_rows;
+    UIWindow *_window;
+}
+
+- (void)tearDown {
+    _window.hidden = YES;
+    _window = nil;
+    [super tearDown];
+}
+
+- (void)testNoChanges {
+    NSArray *rows = [self private_rows:@"a b c"];
+    ListDiffResult *diff = [self private_diffFrom:rows to:[self private_rows:@"a b c"]];
+    XCTAssertFalse(diff.hasChanges);
+}
+
+- (void)testInsertAndDeleteDoNotCountAsMoves {
+    ListDiffResult *diff = [self private_diffFrom:[self private_rows:@"a b c d"] to:[self private_rows:@"x a c d y"]];
+    XCTAssertEqualObjects(diff.deletes, [NSIndexSet indexSetWithIndex:1]);
+    NSMutableIndexSet *inserts = [NSMutableIndexSet indexSetWithIndex:0];
+    [inserts addIndex:4];
+    XCTAssertEqualObjects(diff.inserts, inserts);
+    XCTAssertEqual(diff.moves.count, 0u);
+    XCTAssertEqual(diff.updates.count, 0u);
+}
+
+- (void)testMovesOnlyRowsOutsideTheLongestStableRun {
+    ListDiffResult *diff = [self private_diffFrom:[self private_rows:@"a b c d"] to:[self private_rows:@"d a b c"]];
+    XCTAssertEqualObjects(diff.moves, @{@3 : @0});
+    XCTAssertEqual(diff.deletes.count, 0u);
+    XCTAssertEqual(diff.inserts.count, 0u);
+}
+
+- (void)testUpdatesUseNewIndexes {
+    NSArray *newRows = @[[self private_row:@"x" value:0], [self private_row:@"a" value:0], [self private_row:@"b" value:1]];
+    ListDiffResult *diff = [self private_diffFrom:[self private_rows:@"a b"] to:newRows];
+    XCTAssertEqualObjects(diff.updates, [NSIndexSet indexSetWithIndex:2]);
+    XCTAssertEqualObjects(diff.inserts, [NSIndexSet indexSetWithIndex:0]);
+}
+
+- (void)testDuplicateIdentifiersPairOnlyOnce {
+    ListDiffResult *diff = [self private_diffFrom:[self private_rows:@"a a b"] to:[self private_rows:@"a b b"]];
+    XCTAssertEqualObjects(diff.deletes, [NSIndexSet indexSetWithIndex:1]);
+    XCTAssertEqualObjects(diff.inserts, [NSIndexSet indexSetWithIndex:2]);
+    XCTAssertEqual(diff.moves.count, 0u);
+}
+
+- (void)testRandomDiffsAreConsistent {
+    srand48(20261019);
+    for (NSUInteger round = 0; round < 200; round++) {
+        NSArray *oldRows = [self private_randomRows];
+        NSArray *newRows = [self private_randomRows];
+        ListDiffResult *diff = [self private_diffFrom:oldRows to:newRows];
+
+        XCTAssertEqual(oldRows.count - diff.deletes.count, newRows.count - diff.inserts.count);
+        //配对上的行标识相同；没移动的行保持原来的相对顺序
+        NSMutableIndexSet *pairedOld = [NSMutableIndexSet indexSet];
+        NSUInteger oldIndex = 0;
+        for (NSUInteger j = 0; j < newRows.count; j++) {
+            if ([diff.inserts containsIndex:j]) {
+                continue;
+            }
+            NSNumber *from = [diff.moves allKeysForObject:@(j)].firstObject;
+            if (from) {
+                [pairedOld addIndex:from.unsignedIntegerValue];
+                XCTAssertEqualObjects(oldRows[from.unsignedIntegerValue][@"id"], newRows[j][@"id"]);
+                continue;
+            }
+            //不移动的行按顺序出现在旧数组剩下的行里
+            while (oldIndex < oldRows.count && ([diff.deletes containsIndex:oldIndex] || diff.moves[@(oldIndex)])) {
+                oldIndex++;
+            }
+            XCTAssertLessThan(oldIndex, oldRows.count);
+            XCTAssertEqualObjects(oldRows[oldIndex][@"id"], newRows[j][@"id"]);
+            [pairedOld addIndex:oldIndex++];
+        }
+        [diff.deletes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+            XCTAssertFalse([pairedOld containsIndex:idx]);
+        }];
+        XCTAssertEqual(pairedOld.count + diff.deletes.count, oldRows.count);
+    }
+}
+
+- (void)testAppliesToVisibleTableView {
+    UITableView *tableView = [self private_visibleTableViewWithRows:[self private_rows:@"a b c d e"]];
+
+    NSArray *oldRows = _rows;
+    NSMutableArray *newRows = [[self private_rows:@"e x a c d"] mutableCopy];
+    newRows[3] = [self private_row:@"c" value:7];
+    ListDiffResult *diff = [self private_diffFrom:oldRows to:newRows];
+
+    _rows = newRows;
+    NSMutableArray *reconfigured = [NSMutableArray array];
+    //批量更新和数据源对不上时 UITableView 会抛异常
+    XCTAssertNoThrow([diff applyToTableView:tableView section:0 reconfigure:^(UITableViewCell *cell, NSIndexPath *indexPath) {
+        [reconfigured addObject:@(indexPath.row)];
+    }]);
+    XCTAssertEqual([tableView numberOfRowsInSection:0], 5);
+    XCTAssertEqualObjects(reconfigured, @[@3]);
+}
+
+- (void)testChangedIndexes {
+    NSIndexSet *changed = [ListDiff changedIndexesFromArray:@[@1, @2, @3] toArray:@[@1, @5, @3, @4]];
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndex:1];
+    [expected addIndex:3];
+    XCTAssertEqualObjects(changed, expected);
+}
+
+- (void)testCoalescerRunsOncePerFrame {
+    __block NSUInteger calls = 0;
+    ListUpdateCoalescer *coalescer = [[ListUpdateCoalescer alloc] initWithBlock:^{
+        calls++;
+    }];
+    [coalescer setNeedsUpdate];
+    [coalescer setNeedsUpdate];
+    [coalescer setNeedsUpdate];
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    XCTAssertEqual(calls, 1u);
+
+    [coalescer setNeedsUpdate];
+    [coalescer cancel];
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.2]];
+    XCTAssertEqual(calls, 1u);
+}
+
+#pragma mark UITableViewDataSource
+
+- (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
+    return _rows.count;
+}
+
+- (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath {
+    UITableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:@"cell" forIndexPath:indexPath];
+    cell.textLabel.text = _rows[indexPath.row][@"id"];
+    return cell;
+}
+
+#pragma mark private
+
+- (NSDictionary *)private_row:(NSString *)identifier value:(NSInteger)value {
+    return @{@"id" : identifier, @"v" : @(value)};
+}
+
+//"a b c" -> 三行，内容都为 0
+- (NSArray<NSDictionary *> *)private_rows:(NSString *)identifiers {
+    NSMutableArray *rows = [NSMutableArray array];
+    for (NSString *identifier in [identifiers componentsSeparatedByString:@" "]) {
+        [rows addObject:[self private_row:identifier value:0]];
+    }
+    return rows;
+}
+
+//标识从 10 个里取，可能重复
+- (NSArray<NSDictionary *> *)private_randomRows {
+    NSUInteger count = (NSUInteger)(drand48() * 12);
+    NSMutableArray *rows = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        NSString *identifier = [NSString stringWithFormat:@"%c", 'a' + (int)(drand48() * 10)];
+        [rows addObject:[self private_row:identifier value:(NSInteger)(drand48() * 2)]];
+    }
+    return rows;
+}
+
+- (ListDiffResult *)private_diffFrom:(NSArray *)oldRows to:(NSArray *)newRows {
+    return [ListDiff diffFromArray:oldRows toArray:newRows identifier:^id<NSCopying>(NSDictionary *row) {
+        return row[@"id"];
+    }];
+}
+
+- (UITableView *)private_visibleTableViewWithRows:(NSArray *)rows {
+    _rows = rows;
+    //applyToTableView: 只在 tableView 有 window 时做批量更新
+    _window = [[UIWindow alloc] initWithFrame:CGRectMake(0, 0, 320, 480)];
+    UITableView *tableView = [[UITableView alloc] initWithFrame:_window.bounds style:UITableViewStylePlain];
+    [tableView registerClass:[UITableViewCell class] forCellReuseIdentifier:@"cell"];
+    tableView.dataSource = self;
+    [_window addSubview:tableView];
+    _window.hidden = NO;
+    [tableView layoutIfNeeded];
+    return tableView;
+}
+
+@end
@@ -0,0 +1,41 @@
+//
+//  MockUploadServer.h
+//  NewStockTests
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  单张图片上传接口(API_UPLOAD_IMG)的本地模拟
+ *
+ *  以 NSURLProtocol 拦截上传请求，从 multipart body 中取出 file 部分，
+ *  按其 md5 记录上传次数，成功时返回 {"origin": "https://mock.upload/<md5>.jpg"}。
+ *  可以让指定图片失败若干次，也可以给每个请求加延迟来观察并发数。
+ */
+@interface MockUploadServer : NSURLProtocol
+
+//注册并清空所有记录和规则
++ (void)start;
++ (void)stop;
+
+//每个请求延迟多久返回，默认 0
++ (void)setResponseDelay:(NSTimeInterval)delay;
+
+//md5 为 digest 的图片接下来 times 次上传都返回 500
++ (void)failUploadsOfDigest:(NSString *)digest times:(NSUInteger)times;
+
+//收到的 md5 为 digest 的上传次数，含失败的
++ (NSUInteger)uploadCountOfDigest:(NSString *)digest;
+
+//收到的上传请求总数
++ (NSUInteger)requestCount;
+
+//同时在处理的请求数的峰值
++ (NSUInteger)maxConcurrentRequests;
+
++ (NSString *)originForDigest:(NSString *)digest;
+
+@end
@@ -0,0 +1,218 @@
+//
+//  MockUploadServer.m
+//  NewStockTests
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import "MockUploadServer.h"
+#import <CommonCrypto/CommonDigest.h>
+#import "Defination.h"
+
+//下面的状态都在 @synchronized([MockUploadServer class]) 里读写
+static BOOL sStarted;
+static NSTimeInterval sResponseDelay;
+static NSUInteger sRequestCount;
+static NSUInteger sRunningCount;
+static NSUInteger sMaxRunningCount;
+static NSMutableDictionary<NSString *, NSNumber *> *sUploadCounts;
+static NSMutableDictionary<NSString *, NSNumber *> *sFailures;
+
+static NSString *MockUploadDigest(NSData *data) {
+    unsigned char result[CC_MD5_DIGEST_LENGTH];
+    CC_MD5(data.bytes, (CC_LONG)data.length, result);
+    NSMutableString *digest = [NSMutableString stringWithCapacity:CC_MD5_DIGEST_LENGTH * 2];
+    for (NSInteger i = 0; i < CC_MD5_DIGEST_LENGTH; i++) {
+        [digest appendFormat:@"%02x", result[i]];
+    }
+    return digest;
+}
+
+@implementation MockUploadServer
+{
+    NSInteger _statusCode;
+    NSDictionary *_responseObject;
+    BOOL _running;
+}
+
++ (void)start {
+    @synchronized (self) {
+        sStarted = YES;
+        sResponseDelay = 0;
+        sRequestCount = 0;
+        sRunningCount = 0;
+        sMaxRunningCount = 0;
+        sUploadCounts = [NSMutableDictionary dictionary];
+        sFailures = [NSMutableDictionary dictionary];
+    }
+    [NSURLProtocol registerClass:self];
+}
+
++ (void)stop {
+    [NSURLProtocol unregisterClass:self];
+    @synchronized (self) {
+        sStarted = NO;
+    }
+}
+
++ (void)setResponseDelay:(NSTimeInterval)delay {
+    @synchronized (self) {
+        sResponseDelay = delay;
+    }
+}
+
++ (void)failUploadsOfDigest:(NSString *)digest times:(NSUInteger)times {
+    @synchronized (self) {
+        sFailures[digest] = @(times);
+    }
+}
+
++ (NSUInteger)uploadCountOfDigest:(NSString *)digest {
+    @synchronized (self) {
+        return sUploadCounts[digest].unsignedIntegerValue;
+    }
+}
+
++ (NSUInteger)requestCount {
+    @synchronized (self) {
+        return sRequestCount;
+    }
+}
+
++ (NSUInteger)maxConcurrentRequests {
+    @synchronized (self) {
+        return sMaxRunningCount;
+    }
+}
+
++ (NSString *)originForDigest:(NSString *)digest {
+    return [NSString stringWithFormat:@"https://mock.upload/%@.jpg", digest];
+}
+
+#pragma mark NSURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request {
+    @synchronized (self) {
+        if (!sStarted) {
+            return NO;
+        }
+    }
+    return [request.HTTPMethod isEqualToString:@"POST"] && [request.URL.path hasSuffix:@"/" API_UPLOAD_IMG];
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request {
+    return request;
+}
+
+- (void)startLoading {
+    NSData *file = [MockUploadServer private_filePartOfRequest:self.request];
+    NSString *digest = file ? MockUploadDigest(file) : nil;
+
+    NSTimeInterval delay;
+    @synchronized ([MockUploadServer class]) {
+        sRequestCount++;
+        sRunningCount++;
+        sMaxRunningCount = MAX(sMaxRunningCount, sRunningCount);
+        delay = sResponseDelay;
+
+        NSUInteger failures = digest ? sFailures[digest].unsignedIntegerValue : 0;
+        if (digest) {
+            sUploadCounts[digest] = @(sUploadCounts[digest].unsignedIntegerValue + 1);
+        }
+        if (digest == nil) {
+            _statusCode = 400;
+            _responseObject = @{@"error" : @"no file part"};
+        } else if (failures > 0) {
+            sFailures[digest] = @(failures - 1);
+            _statusCode = 500;
+            _responseObject = @{@"error" : @"mock failure"};
+        } else {
+            _statusCode = 200;
+            _responseObject = @{@"origin" : [MockUploadServer originForDigest:digest]};
+        }
+    }
+    _running = YES;
+
+    //回调要在 startLoading 所在线程上，延迟用这个线程的 runloop
+    [self performSelector:@selector(private_respond) withObject:nil afterDelay:delay];
+}
+
+- (void)stopLoading {
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(private_respond) object:nil];
+    [self private_finishRunning];
+}
+
+#pragma mark private
+
+- (void)private_respond {
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                                              statusCode:_statusCode
+                                                             HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{@"Content-Type" : @"application/json"}];
+    NSData *data = [NSJSONSerialization dataWithJSONObject:_responseObject options:0 error:nil];
+    [self private_finishRunning];
+    [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    [self.client URLProtocol:self didLoadData:data];
+    [self.client URLProtocolDidFinishLoading:self];
+}
+
+- (void)private_finishRunning {
+    if (!_running) {
+        return;
+    }
+    _running = NO;
+    @synchronized ([MockUploadServer class]) {
+        sRunningCount--;
+    }
+}
+
++ (NSData *)private_bodyOfRequest:(NSURLRequest *)request {
+    if (request.HTTPBody) {
+        return request.HTTPBody;
+    }
+    NSInputStream *stream = request.HTTPBodyStream;
+    if (stream == nil) {
+        return nil;
+    }
+    NSMutableData *body = [NSMutableData data];
+    uint8_t buffer[16 * 1024];
+    NSInteger length;
+    [stream open];
+    while ((length = [stream read:buffer maxLength:sizeof(buffer)]) > 0) {
+        [body appendBytes:buffer length:length];
+    }
+    [stream close];
+    return body;
+}
+
+//multipart 中 name="file" 那一段的内容
++ (NSData *)private_filePartOfRequest:(NSURLRequest *)request {
+    NSString *contentType = [request valueForHTTPHeaderField:@"Content-Type"];
+    NSRange range = [contentType rangeOfString:@"boundary="];
+    NSData *body = [self private_bodyOfRequest:request];
+    if (range.location == NSNotFound || body == nil) {
+        return nil;
+    }
+    NSString *boundary = [contentType substringFromIndex:NSMaxRange(range)];
+    NSData *delimiter = [[@"\r\n--" stringByAppendingString:boundary] dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *disposition = [@"name=\"file\"" dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *headerEnd = [@"\r\n\r\n" dataUsingEncoding:NSUTF8StringEncoding];
+
+    NSRange part = [body rangeOfData:disposition options:0 range:NSMakeRange(0, body.length)];
+    if (part.location == NSNotFound) {
+        return nil;
+    }
+    NSRange header = [body rangeOfData:headerEnd options:0 range:NSMakeRange(part.location, body.length - part.location)];
+    if (header.location == NSNotFound) {
+        return nil;
+    }
+    NSUInteger start = NSMaxRange(header);
+    NSRange end = [body rangeOfData:delimiter options:0 range:NSMakeRange(start, body.length - start)];
+    if (end.location == NSNotFound) {
+        return nil;
+    }
+    return [body subdataWithRange:NSMakeRange(start, end.location - start)];
+}
+
+@end
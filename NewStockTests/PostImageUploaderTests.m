@@ -0,0 +1,166 @@
+//
+//  PostImageUploaderTests.m
+//  NewStockTests
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "PostImageUploader.h"
+#import "UploadImageEncoder.h"
+#import "CacheStore.h"
+#import "Defination.h"
+#import "MockUploadServer.h"
+
+@interface PostImageUploaderTests : XCTestCase
+
+@end
+
+@implementation PostImageUploaderTests
+{
+    NSString *_savedUserId;
+}
+
+- (void)setUp {
+    [super setUp];
+    [MockUploadServer start];
+    //每个用例用新的用户，磁盘上之前留下的上传结果不会被复用
+    _savedUserId = [[CacheStore sharedCacheStore] stringForKey:USER_ID];
+    [self private_signInAs:[NSUUID UUID].UUIDString];
+}
+
+- (void)tearDown {
+    [self private_signInAs:_savedUserId];
+    [MockUploadServer stop];
+    [super tearDown];
+}
+
+- (void)testUploadsEachImageSeparatelyInParallel {
+    NSArray<UploadImageFile *> *files = [self private_filesWithCount:5];
+    [MockUploadServer setResponseDelay:0.3];
+
+    PostImageUploader *uploader = [PostImageUploader new];
+    uploader.maxConcurrentUploads = 3;
+    NSError *error = nil;
+    NSArray *responses = [self private_upload:files uploader:uploader error:&error];
+
+    XCTAssertNil(error);
+    XCTAssertEqual(responses.count, files.count);
+    XCTAssertEqual([MockUploadServer requestCount], files.count);
+    XCTAssertEqual([MockUploadServer maxConcurrentRequests], 3u);
+    [files enumerateObjectsUsingBlock:^(UploadImageFile *file, NSUInteger idx, BOOL *stop) {
+        XCTAssertEqual([MockUploadServer uploadCountOfDigest:file.digest], 1u);
+        XCTAssertEqualObjects(responses[idx][@"origin"], [MockUploadServer originForDigest:file.digest]);
+    }];
+    XCTAssertEqual(uploader.finishedCount, files.count);
+    XCTAssertEqualWithAccuracy(uploader.progress, 1, 0.001);
+}
+
+- (void)testRetriesOnlyTheFailedImage {
+    NSArray<UploadImageFile *> *files = [self private_filesWithCount:3];
+    [MockUploadServer failUploadsOfDigest:files[1].digest times:2];
+
+    PostImageUploader *uploader = [PostImageUploader new];
+    uploader.maxRetryCount = 2;
+    NSError *error = nil;
+    NSArray *responses = [self private_upload:files uploader:uploader error:&error];
+
+    XCTAssertNil(error);
+    XCTAssertEqual(responses.count, files.count);
+    XCTAssertEqual([MockUploadServer uploadCountOfDigest:files[0].digest], 1u);
+    XCTAssertEqual([MockUploadServer uploadCountOfDigest:files[1].digest], 3u);
+    XCTAssertEqual([MockUploadServer uploadCountOfDigest:files[2].digest], 1u);
+}
+
+- (void)testResumesFromTheFirstUnfinishedImage {
+    NSArray<UploadImageFile *> *files = [self private_filesWithCount:3];
+    [MockUploadServer failUploadsOfDigest:files[1].digest times:1];
+
+    //一张一张传，第二张失败时第一张已完成，第三张还没开始
+    PostImageUploader *uploader = [PostImageUploader new];
+    uploader.maxConcurrentUploads = 1;
+    uploader.maxRetryCount = 0;
+    NSError *error = nil;
+    NSArray *responses = [self private_upload:files uploader:uploader error:&error];
+    XCTAssertNil(responses);
+    XCTAssertNotNil(error);
+    XCTAssertEqual([MockUploadServer uploadCountOfDigest:files[0].digest], 1u);
+    XCTAssertEqual([MockUploadServer uploadCountOfDigest:files[2].digest], 0u);
+
+    //重新发帖，新的 uploader 也只传没完成的两张
+    error = nil;
+    responses = [self private_upload:files uploader:[PostImageUploader new] error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqual(responses.count, files.count);
+    XCTAssertEqual([MockUploadServer uploadCountOfDigest:files[0].digest], 1u);
+    XCTAssertEqual([MockUploadServer uploadCountOfDigest:files[1].digest], 2u);
+    XCTAssertEqual([MockUploadServer uploadCountOfDigest:files[2].digest], 1u);
+    [files enumerateObjectsUsingBlock:^(UploadImageFile *file, NSUInteger idx, BOOL *stop) {
+        XCTAssertEqualObjects(responses[idx][@"origin"], [MockUploadServer originForDigest:file.digest]);
+    }];
+}
+
+- (void)testDoesNotReuseAnotherUsersUploads {
+    NSArray<UploadImageFile *> *files = [self private_filesWithCount:2];
+    NSError *error = nil;
+    XCTAssertNotNil([self private_upload:files uploader:[PostImageUploader new] error:&error]);
+    XCTAssertEqual([MockUploadServer requestCount], 2u);
+
+    //同一用户再发不用上传
+    XCTAssertNotNil([self private_upload:files uploader:[PostImageUploader new] error:&error]);
+    XCTAssertEqual([MockUploadServer requestCount], 2u);
+
+    [self private_signInAs:[NSUUID UUID].UUIDString];
+    XCTAssertNotNil([self private_upload:files uploader:[PostImageUploader new] error:&error]);
+    XCTAssertEqual([MockUploadServer requestCount], 4u);
+}
+
+#pragma mark private
+
+- (void)private_signInAs:(NSString *)userId {
+    //直接写 CacheStore，不走 SystemUtil putCache 里的推送别名设置
+    [[CacheStore sharedCacheStore] setString:userId ?: @"" forKey:USER_ID];
+}
+
+//颜色各不相同的纯色图片，md5 互不相同
+- (NSArray<UploadImageFile *> *)private_filesWithCount:(NSUInteger)count {
+    NSMutableArray *images = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        UIGraphicsBeginImageContextWithOptions(CGSizeMake(64, 64), YES, 1);
+        [[UIColor colorWithHue:(CGFloat)i / count saturation:1 brightness:1 alpha:1] setFill];
+        UIRectFill(CGRectMake(0, 0, 64, 64));
+        //同一颜色在不同用例里也不重复
+        [[NSUUID UUID].UUIDString drawAtPoint:CGPointZero withAttributes:nil];
+        [images addObject:UIGraphicsGetImageFromCurrentImageContext()];
+        UIGraphicsEndImageContext();
+    }
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"encode"];
+    __block NSArray<UploadImageFile *> *files = nil;
+    [[UploadImageEncoder sharedUploadImageEncoder] encodeImages:images maxPixel:kUploadImagePostMaxPixel quality:0.8 completion:^(NSArray<UploadImageFile *> *result) {
+        files = result;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    XCTAssertEqual(files.count, count);
+    return files;
+}
+
+- (NSArray *)private_upload:(NSArray<UploadImageFile *> *)files uploader:(PostImageUploader *)uploader error:(NSError **)error {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"upload"];
+    __block NSArray *responses = nil;
+    __block NSError *uploadError = nil;
+    [uploader uploadFiles:files completion:^(NSArray<NSDictionary *> *result, NSError *resultError) {
+        responses = result;
+        uploadError = resultError;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+    if (error) {
+        *error = uploadError;
+    }
+    return responses;
+}
+
+@end
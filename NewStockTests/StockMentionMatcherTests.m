@@ -0,0 +1,121 @@
+//
+//  StockMentionMatcherTests.m
+//  NewStockTests
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "StockMentionMatcher.h"
+
+//StockMentionMatcher 单例取的是全局码表，这里直接用它内部的自动机建指定的码表
+@protocol StockMentionAutomatonTesting <NSObject>
+- (instancetype)initWithStockCodes:(NSArray<StockCodeInfo *> *)array;
+- (NSArray<StockMention *> *)mentionsInString:(NSString *)text;
+@end
+
+@interface StockMentionMatcherTests : XCTestCase
+
+@end
+
+@implementation StockMentionMatcherTests
+
+- (void)testFindsNamesAndCodesInOrder {
+    NSArray *mentions = [self private_mentionsIn:@"看好平安银行，601318 也不错" stocks:@[
+        [self private_stock:@"平安银行" code:@"000001" type:@"3"],
+        [self private_stock:@"中国平安" code:@"601318" type:@"3"],
+    ]];
+    XCTAssertEqual(mentions.count, 2u);
+    XCTAssertTrue(NSEqualRanges([mentions[0] range], NSMakeRange(2, 4)));
+    XCTAssertEqualObjects([mentions[0] stock].n, @"平安银行");
+    XCTAssertTrue(NSEqualRanges([mentions[1] range], NSMakeRange(7, 6)));
+    XCTAssertEqualObjects([mentions[1] stock].n, @"中国平安");
+}
+
+- (void)testPrefersLeftmostThenLongest {
+    NSArray *stocks = @[
+        [self private_stock:@"中国平安" code:@"601318" type:@"3"],
+        [self private_stock:@"平安银行" code:@"000001" type:@"3"],
+        [self private_stock:@"招商" code:@"000002" type:@"3"],
+        [self private_stock:@"招商银行" code:@"600036" type:@"3"],
+    ];
+
+    NSArray *mentions = [self private_mentionsIn:@"中国平安银行" stocks:stocks];
+    XCTAssertEqual(mentions.count, 1u);
+    XCTAssertEqualObjects([mentions[0] stock].n, @"中国平安");
+
+    mentions = [self private_mentionsIn:@"招商银行" stocks:stocks];
+    XCTAssertEqual(mentions.count, 1u);
+    XCTAssertEqualObjects([mentions[0] stock].n, @"招商银行");
+}
+
+- (void)testFollowsFailureLinksAfterPartialMatch {
+    NSArray *mentions = [self private_mentionsIn:@"兴业平安银行" stocks:@[
+        [self private_stock:@"兴业银行" code:@"601166" type:@"3"],
+        [self private_stock:@"平安银行" code:@"000001" type:@"3"],
+    ]];
+    XCTAssertEqual(mentions.count, 1u);
+    XCTAssertTrue(NSEqualRanges([mentions[0] range], NSMakeRange(2, 4)));
+}
+
+- (void)testCodesNeedNonAlphanumericBoundaries {
+    NSArray *stocks = @[[self private_stock:@"招商银行" code:@"600036" type:@"3"]];
+    XCTAssertEqual([self private_mentionsIn:@"SH600036" stocks:stocks].count, 0u);
+    XCTAssertEqual([self private_mentionsIn:@"6000361" stocks:stocks].count, 0u);
+    XCTAssertEqual([self private_mentionsIn:@"代码600036。" stocks:stocks].count, 1u);
+    XCTAssertEqual([self private_mentionsIn:@"600036" stocks:stocks].count, 1u);
+}
+
+- (void)testStockWinsOverIndexWithTheSameCode {
+    StockCodeInfo *index = [self private_stock:@"上证指数" code:@"000001" type:@"1"];
+    StockCodeInfo *stock = [self private_stock:@"平安银行" code:@"000001" type:@"3"];
+
+    NSArray *mentions = [self private_mentionsIn:@"000001" stocks:@[index, stock]];
+    XCTAssertEqual(mentions.count, 1u);
+    XCTAssertEqual([mentions[0] stock], stock);
+
+    mentions = [self private_mentionsIn:@"000001" stocks:@[stock, index]];
+    XCTAssertEqual(mentions.count, 1u);
+    XCTAssertEqual([mentions[0] stock], stock);
+}
+
+- (void)testIgnoresShortPatterns {
+    NSArray *stocks = @[[self private_stock:@"茅" code:@"1234" type:@"3"]];
+    XCTAssertEqual([self private_mentionsIn:@"茅 1234" stocks:stocks].count, 0u);
+    XCTAssertEqual([self private_mentionsIn:@"" stocks:stocks].count, 0u);
+}
+
+- (void)testLargeCodeTable {
+    //超过初始容量，触发节点和边表扩容
+    NSMutableArray *stocks = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 5000; i++) {
+        NSString *code = [NSString stringWithFormat:@"%06lu", (unsigned long)(300000 + i)];
+        [stocks addObject:[self private_stock:[@"股票" stringByAppendingString:code] code:code type:@"3"]];
+    }
+    NSArray *mentions = [self private_mentionsIn:@"今天 304999 和股票300123 都涨了" stocks:stocks];
+    XCTAssertEqual(mentions.count, 2u);
+    XCTAssertEqualObjects([mentions[0] stock].s, @"304999");
+    XCTAssertEqualObjects([mentions[1] stock].s, @"300123");
+    XCTAssertEqual([mentions[1] range].length, 8u);
+}
+
+#pragma mark private
+
+- (StockCodeInfo *)private_stock:(NSString *)name code:(NSString *)code type:(NSString *)type {
+    StockCodeInfo *info = [StockCodeInfo new];
+    info.n = name;
+    info.s = code;
+    info.t = type;
+    info.m = @"1";
+    return info;
+}
+
+- (NSArray<StockMention *> *)private_mentionsIn:(NSString *)text stocks:(NSArray<StockCodeInfo *> *)stocks {
+    Class automatonClass = NSClassFromString(@"StockMentionAutomaton");
+    XCTAssertNotNil(automatonClass);
+    id<StockMentionAutomatonTesting> automaton = [(id<StockMentionAutomatonTesting>)[automatonClass alloc] initWithStockCodes:stocks];
+    return [automaton mentionsInString:text];
+}
+
+@end
@@ -0,0 +1,120 @@
+//
+//  URLRouterTests.m
+//  NewStockTests
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "URLRouter.h"
+
+@interface URLRouterTests : XCTestCase
+
+@end
+
+@implementation URLRouterTests
+{
+    //不动 sharedURLRouter 上 App 注册的路由
+    URLRouter *_router;
+}
+
+- (void)setUp {
+    [super setUp];
+    _router = [URLRouter new];
+}
+
+- (void)testExactRoutes {
+    [self private_register:@"native://HQ1000"];
+    [self private_register:@"component://CM0102"];
+
+    XCTAssertEqualObjects([_router matchURLString:@"native://HQ1000"].pattern, @"native://HQ1000");
+    XCTAssertEqualObjects([_router matchURLString:@"component://CM0102?a=1"].pattern, @"component://CM0102");
+    XCTAssertNil([_router matchURLString:@"native://HQ1001"]);
+    XCTAssertNil([_router matchURLString:@"native://HQ1000/more"]);
+    XCTAssertNil([_router matchURLString:@"not a url"]);
+}
+
+- (void)testSchemeAndHostIgnoreCaseButPathDoesNot {
+    [self private_register:@"https://www.guguaixia.com/eagle-frontap/jiabei/detail"];
+
+    XCTAssertNotNil([_router matchURLString:@"HTTP://WWW.GUGUAIXIA.COM/eagle-frontap/jiabei/detail"]);
+    XCTAssertNotNil([_router matchURLString:@"http://www.guguaixia.com/eagle-frontap/jiabei/detail"]);
+    XCTAssertNil([_router matchURLString:@"https://www.guguaixia.com/eagle-frontap/jiabei/Detail"]);
+}
+
+- (void)testPathAndQueryParameters {
+    [self private_register:@"https://www.guguaixia.com/eagle-frontap/jiabei/:code"];
+
+    URLRouteMatch *match = [_router matchURLString:@"https://www.guguaixia.com/eagle-frontap/jiabei/%E5%B9%B3%E5%AE%89?code=ignored&page=3&flag=true#top"];
+    XCTAssertNotNil(match);
+    XCTAssertEqualObjects(match[@"code"], @"平安");
+    XCTAssertEqual([match integerForKey:@"page"], 3);
+    XCTAssertTrue([match boolForKey:@"flag"]);
+    XCTAssertEqualObjects(match.query, @"code=ignored&page=3&flag=true");
+    XCTAssertNil(match[@"missing"]);
+}
+
+- (void)testExactSegmentBeatsParameter {
+    [self private_register:@"native://stock/:code"];
+    [self private_register:@"native://stock/list"];
+
+    XCTAssertEqualObjects([_router matchURLString:@"native://stock/list"].pattern, @"native://stock/list");
+    URLRouteMatch *match = [_router matchURLString:@"native://stock/600036"];
+    XCTAssertEqualObjects(match.pattern, @"native://stock/:code");
+    XCTAssertEqualObjects(match[@"code"], @"600036");
+}
+
+- (void)testWildcardMatchesRemainingSegments {
+    [self private_register:@"shortcut://*"];
+    [self private_register:@"native://news/*"];
+    [self private_register:@"native://news/:id/comments"];
+
+    URLRouteMatch *match = [_router matchURLString:@"shortcut://a/b/c"];
+    XCTAssertEqualObjects(match.pattern, @"shortcut://*");
+    XCTAssertEqualObjects(match.wildcardPath, @"a/b/c");
+
+    XCTAssertEqualObjects([_router matchURLString:@"native://news"].wildcardPath, @"");
+
+    match = [_router matchURLString:@"native://news/42/comments"];
+    XCTAssertEqualObjects(match.pattern, @"native://news/:id/comments");
+    XCTAssertEqualObjects(match[@"id"], @"42");
+
+    //参数分支走不通时退回到 *，参数不带出来
+    match = [_router matchURLString:@"native://news/42/likes"];
+    XCTAssertEqualObjects(match.pattern, @"native://news/*");
+    XCTAssertEqualObjects(match.wildcardPath, @"42/likes");
+    XCTAssertNil(match[@"id"]);
+}
+
+- (void)testUnescapedCharactersAndJSONParameters {
+    [self private_register:@"native://search"];
+
+    URLRouteMatch *match = [_router matchURLString:@"native://search?keyword=招商银行&extra={\"a\":1}"];
+    XCTAssertNotNil(match);
+    XCTAssertEqualObjects(match[@"keyword"], @"招商银行");
+    XCTAssertEqualObjects(match[@"extra"], @"{\"a\":1}");
+}
+
+- (void)testLaterRegistrationWinsAndRouteRunsHandler {
+    __block NSString *handled = nil;
+    [_router registerPattern:@"native://HQ1000" handler:^(URLRouteMatch *match) {
+        handled = @"first";
+    }];
+    [_router registerPattern:@"native://HQ1000" handler:^(URLRouteMatch *match) {
+        handled = match.URLString;
+    }];
+
+    XCTAssertTrue([_router routeURLString:@"native://HQ1000?x=1"]);
+    XCTAssertEqualObjects(handled, @"native://HQ1000?x=1");
+    XCTAssertFalse([_router routeURLString:@"native://HQ2000"]);
+}
+
+#pragma mark private
+
+- (void)private_register:(NSString *)pattern {
+    [_router registerPattern:pattern handler:^(URLRouteMatch *match) {
+    }];
+}
+
+@end
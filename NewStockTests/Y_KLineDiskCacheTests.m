@@ -0,0 +1,148 @@
+//
+//  Y_KLineDiskCacheTests.m
+//  NewStockTests
+//
+//  Created by Willey on 2026/10/19.
+//  Copyright © 2026年 Willey. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "Y_KLineDiskCache.h"
+
+@interface Y_KLineDiskCacheTests : XCTestCase
+
+@end
+
+@implementation Y_KLineDiskCacheTests
+{
+    //每个用例一个新 key，不会读到别的用例或 App 的缓存
+    NSString *_key;
+}
+
+- (void)setUp {
+    [super setUp];
+    _key = [Y_KLineDiskCache keyWithSymbolTyp:@"2" symbol:[NSUUID UUID].UUIDString marketCd:@"1" chartTyp:@"4"];
+}
+
+- (void)testSinceTimeOnlyForIncrementalPeriods {
+    NSArray *bars = [self private_barsFrom:0 count:3];
+    long long last = [bars.lastObject[@"createChartTime"] longLongValue];
+
+    XCTAssertEqual([Y_KLineDiskCache sinceTimeForBars:@[] chartType:@"4"], 0);
+    XCTAssertEqual([Y_KLineDiskCache sinceTimeForBars:bars chartType:@"4"], last);
+    XCTAssertEqual([Y_KLineDiskCache sinceTimeForBars:bars chartType:@"15"], last);
+    //分时整段替换
+    XCTAssertEqual([Y_KLineDiskCache sinceTimeForBars:bars chartType:@"2"], 0);
+    XCTAssertEqual([Y_KLineDiskCache sinceTimeForGroup:nil chartType:@"4"], 0);
+}
+
+- (void)testMissingComponentsGiveNoKey {
+    XCTAssertNil([Y_KLineDiskCache keyWithSymbolTyp:@"2" symbol:nil marketCd:@"1" chartTyp:@"4"]);
+    XCTAssertNil([Y_KLineDiskCache keyWithSymbolTyp:@"2" symbol:@"600036" marketCd:@"" chartTyp:@"4"]);
+    XCTAssertNil([Y_KLineDiskCache keyWithSymbolTyp:(NSString *)[NSNull null] symbol:@"600036" marketCd:@"1" chartTyp:@"4"]);
+    XCTAssertEqualObjects([Y_KLineDiskCache keyWithSymbolTyp:@"2" symbol:@"600036" marketCd:@"1" chartTyp:@"4"], @"2_1_600036_4");
+
+    //没有 key 时不读写缓存，保存原样返回
+    _key = nil;
+    NSArray *bars = [self private_barsFrom:0 count:2];
+    XCTAssertEqual([self private_save:bars incremental:YES].count, 2u);
+    XCTAssertNil([self private_load]);
+}
+
+- (void)testRoundTrip {
+    NSMutableArray *bars = [[self private_barsFrom:0 count:3] mutableCopy];
+    NSMutableDictionary *noAverage = [bars[1] mutableCopy];
+    [noAverage removeObjectForKey:@"averagePrice"];
+    bars[1] = noAverage;
+
+    [self private_save:bars incremental:NO];
+    NSArray *loaded = [self private_load];
+    XCTAssertEqual(loaded.count, 3u);
+    for (NSUInteger i = 0; i < loaded.count; i++) {
+        XCTAssertEqualObjects(loaded[i][@"createChartTime"], bars[i][@"createChartTime"]);
+        XCTAssertEqualWithAccuracy([loaded[i][@"close"] doubleValue], [bars[i][@"close"] doubleValue], 1e-9);
+        XCTAssertEqualWithAccuracy([loaded[i][@"volume"] doubleValue], [bars[i][@"volume"] doubleValue], 1e-9);
+    }
+    XCTAssertEqualWithAccuracy([loaded[0][@"averagePrice"] doubleValue], [bars[0][@"averagePrice"] doubleValue], 1e-9);
+    XCTAssertNil(loaded[1][@"averagePrice"]);
+}
+
+- (void)testIncrementalMergesAndKeepsTheWindow {
+    [self private_save:[self private_barsFrom:0 count:5] incremental:NO];
+
+    //最后一根更新，再来一根新的
+    NSMutableArray *update = [[self private_barsFrom:4 count:2] mutableCopy];
+    NSMutableDictionary *changed = [update[0] mutableCopy];
+    changed[@"close"] = @99.5;
+    update[0] = changed;
+
+    NSArray *merged = [self private_save:update incremental:YES];
+    XCTAssertEqual(merged.count, 5u);
+    XCTAssertEqualObjects(merged.firstObject[@"createChartTime"], [self private_barsFrom:1 count:1][0][@"createChartTime"]);
+    XCTAssertEqualWithAccuracy([merged[3][@"close"] doubleValue], 99.5, 1e-9);
+    XCTAssertEqualObjects(merged.lastObject[@"createChartTime"], update.lastObject[@"createChartTime"]);
+
+    NSArray *loaded = [self private_load];
+    XCTAssertEqual(loaded.count, 5u);
+    XCTAssertEqualObjects(loaded.firstObject[@"createChartTime"], merged.firstObject[@"createChartTime"]);
+}
+
+- (void)testIncrementalWithoutCacheWritesEverything {
+    NSArray *bars = [self private_barsFrom:0 count:4];
+    XCTAssertEqual([self private_save:bars incremental:YES].count, 4u);
+    XCTAssertEqual([self private_load].count, 4u);
+}
+
+- (void)testEmptyResponseKeepsTheCache {
+    [self private_save:[self private_barsFrom:0 count:3] incremental:NO];
+
+    XCTAssertEqual([self private_save:@[] incremental:NO].count, 0u);
+    XCTAssertEqual([self private_load].count, 3u);
+
+    //增量没有新 K 线时返回缓存
+    XCTAssertEqual([self private_save:@[] incremental:YES].count, 3u);
+    XCTAssertEqual([self private_save:(NSArray *)[NSNull null] incremental:YES].count, 3u);
+    XCTAssertEqual([self private_load].count, 3u);
+}
+
+#pragma mark private
+
+//从 2026-01-05 起每天一根
+- (NSArray<NSDictionary *> *)private_barsFrom:(NSUInteger)from count:(NSUInteger)count {
+    NSMutableArray *bars = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = from; i < from + count; i++) {
+        double close = 10 + i * 0.1;
+        [bars addObject:@{@"createChartTime" : @(1767571200000LL + (long long)i * 86400000LL),
+                          @"open" : @(close - 0.05),
+                          @"high" : @(close + 0.2),
+                          @"low" : @(close - 0.2),
+                          @"close" : @(close),
+                          @"volume" : @(1000 + i),
+                          @"averagePrice" : @(close - 0.01)}];
+    }
+    return bars;
+}
+
+- (NSArray<NSDictionary *> *)private_save:(NSArray *)bars incremental:(BOOL)incremental {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"save"];
+    __block NSArray *result = nil;
+    [[Y_KLineDiskCache sharedY_KLineDiskCache] saveBars:bars forKey:_key incremental:incremental completion:^(NSArray<NSDictionary *> *merged) {
+        result = merged;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    return result;
+}
+
+- (NSArray<NSDictionary *> *)private_load {
+    XCTestExpectation *expectation = [self expectationWithDescription:@"load"];
+    __block NSArray *result = nil;
+    [[Y_KLineDiskCache sharedY_KLineDiskCache] loadBarsForKey:_key completion:^(NSArray<NSDictionary *> *bars) {
+        result = bars;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    return result;
+}
+
+@end